@@ -0,0 +1,196 @@
+#pragma once
+
+/*!
+  * @file benchmark.h
+  * @brief Header file for the Benchmark runner used by the engine's microbenchmarks.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+// Local includes
+
+#include "maths/maths.h"
+
+
+// Namespaces
+
+namespace engine { namespace bench {
+
+	extern const void* volatile g_sink; /*!< Written to by doNotOptimize() so the compiler has to keep the values it is given. */
+
+	//! Stop the compiler from optimizing away a value that is only computed to be timed.
+	/*! @param value The value to keep alive. */
+	template <typename T>
+	inline void doNotOptimize(const T& value)
+	{
+		g_sink = &value;
+	}
+
+	//! Get a random number from std::rand(), so that every run of the benchmarks sees the same inputs.
+	/*! @param min The smallest number to return.
+	  * @param max The largest number to return. */
+	inline float randomFloat(float min, float max)
+	{
+		return min + (max - min) * (std::rand() / (float)RAND_MAX);
+	}
+
+	//! Get a random vector.
+	/*! @param range The largest magnitude of each component. */
+	inline maths::Vec3 randomVec3(float range)
+	{
+		return maths::Vec3(randomFloat(-range, range), randomFloat(-range, range), randomFloat(-range, range));
+	}
+
+	//! Get a random vector.
+	/*! @param range The largest magnitude of each component. */
+	inline maths::Vec4 randomVec4(float range)
+	{
+		return maths::Vec4(randomFloat(-range, range), randomFloat(-range, range), randomFloat(-range, range), randomFloat(-range, range));
+	}
+
+	//! Get a random box, between 0.2 and 4 units along each side.
+	/*! @param range The largest magnitude of each component of the box's centre. */
+	inline maths::AABB randomBox(float range)
+	{
+		const maths::Vec3 centre = randomVec3(range);
+		const maths::Vec3 extents(randomFloat(0.1f, 2.0f), randomFloat(0.1f, 2.0f), randomFloat(0.1f, 2.0f));
+		return maths::AABB(centre - extents, centre + extents);
+	}
+
+	//! Check whether a result is close enough to the expected value.
+	/*! @param a The result.
+	  * @param b The expected value.
+	  * @param tolerance The largest difference allowed, relative to the larger of @p minScale and the expected value's magnitude.
+	  * @param minScale The smallest magnitude the tolerance is relative to, so values near 0 aren't held to a tolerance near 0. When terms
+	  * ... of about this size cancel, the FMA kernels' different rounding shows relative to the terms rather than the result. */
+	inline bool nearlyEqual(float a, float b, float tolerance, float minScale = 1.0f)
+	{
+		return std::fabs(a - b) <= tolerance * std::fmax(minScale, std::fabs(b));
+	}
+
+	//! Check whether each component of a result is close enough to the expected value's, as nearlyEqual(float, float, float, float) does.
+	inline bool nearlyEqual(const maths::Vec3& a, const maths::Vec3& b, float tolerance)
+	{
+		return nearlyEqual(a.x(), b.x(), tolerance) && nearlyEqual(a.y(), b.y(), tolerance) && nearlyEqual(a.z(), b.z(), tolerance);
+	}
+
+	//! Check whether each element of a result is close enough to the expected value's, as nearlyEqual(float, float, float, float) does.
+	inline bool nearlyEqual(const maths::Mat4& a, const maths::Mat4& b, float tolerance)
+	{
+		for (int col = 0; col < 4; col++)
+			for (int row = 0; row < 4; row++)
+				if (!nearlyEqual(a(col, row), b(col, row), tolerance))
+					return false;
+
+		return true;
+	}
+
+	//! The timing of a single benchmark.
+	struct Result
+	{
+		std::string name; /*!< The benchmark's name. */
+		unsigned long long ops; /*!< The number of operations that were timed. */
+		double seconds; /*!< The total time taken by all @p ops operations. */
+
+		//! Average time per operation.
+		/*! @return Nanoseconds per operation. */
+		double nsPerOp() const;
+
+		//! Average throughput.
+		/*! @return Operations per second. */
+		double opsPerSecond() const;
+	};
+
+	//! Times benchmarks and reports their results.
+	class Runner
+	{
+	public:
+		//! Runner constructor.
+		/*! @param minSeconds The minimum amount of time to spend timing each benchmark. */
+		Runner(double minSeconds = 0.25);
+
+		//! Time a benchmark.
+		/*! Repeatedly calls @p func, doubling the number of calls until at least the minimum time has been spent, and then logs the result.
+		  * @param name The benchmark's name.
+		  * @param opsPerCall The number of operations a single call to @p func performs.
+		  * @param func The code to time.
+		  * @return The benchmark's result. */
+		template <typename Func>
+		const Result& run(const std::string& name, unsigned long long opsPerCall, Func func)
+		{
+			typedef std::chrono::steady_clock Clock;
+
+			// Warm up caches and branch predictors before timing anything.
+			func();
+
+			unsigned long long calls = 1;
+			double seconds = 0.0;
+
+			for (;;)
+			{
+				Clock::time_point start = Clock::now();
+
+				for (unsigned long long i = 0; i < calls; i++)
+					func();
+
+				seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+				if (seconds >= m_minSeconds)
+					break;
+
+				calls *= 2;
+			}
+
+			Result result;
+			result.name = name;
+			result.ops = calls * opsPerCall;
+			result.seconds = seconds;
+
+			return record(result);
+		}
+
+		//! Record the outcome of a correctness check.
+		/*! Failed checks are logged and counted.
+		  * @param name A description of what was checked.
+		  * @param passed Whether the check passed.
+		  * @return @p passed. */
+		bool check(const std::string& name, bool passed);
+
+		//! Get the results of every benchmark that has been run.
+		/*! @return A reference to an immutable vector of Results. */
+		const std::vector<Result>& results() const;
+
+		//! Get the number of checks that have failed.
+		int failures() const;
+
+		//! Add a note about the conditions the benchmarks were run under, such as the instruction set, to the JSON output.
+		/*! @param key The note's name.
+		  * @param value The note's value. */
+		void addContext(const std::string& key, const std::string& value);
+
+		//! Write the context and the result of every benchmark that has been run to a JSON file.
+		/*! Results are written one per line in the order they were run, so the files from two runs can be compared with a text diff.
+		  * @param path The file to write.
+		  * @return False if the file couldn't be written. */
+		bool writeJson(const std::string& path) const;
+
+	private:
+		double m_minSeconds; /*!< The minimum amount of time to spend timing each benchmark. */
+		int m_failures; /*!< The number of checks which have failed. */
+		std::vector<Result> m_results; /*!< The results of every benchmark that has been run. */
+		std::vector<std::pair<std::string, std::string>> m_context; /*!< Notes about the conditions the benchmarks were run under. */
+
+		//! Store and log a benchmark result.
+		const Result& record(const Result& result);
+	};
+
+} }
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+/*!
+  * @file suites.h
+  * @brief Declarations of the benchmark suites.
+  * @author George McDonagh */
+
+
+// Local includes
+
+#include "benchmark.h"
+
+
+// Namespaces
+
+namespace engine { namespace bench {
+
+	//! Vec2, Vec3, and Vec4 arithmetic, Mat3 and Mat4 multiplies, transposes, determinants, and Mat3 inverses, and building view, projection, and rotation matrices.
+	void benchArithmetic(Runner& runner);
+
+	//! Mat4 inverses: general, affine, and rigid, against the original Mat3 cofactor implementation.
+	void benchInverse(Runner& runner);
+
+	//! Batched point and direction transforms, for every supported instruction set.
+	void benchTransform(Runner& runner);
+
+	//! Camera updates and per-object transform maths. Build with ENGINE_MATHS_OUT_OF_LINE defined to compare against the out-of-line maths.
+	void benchCamera(Runner& runner);
+
+	//! Euler, matrix, and quaternion rotations, against the original matrix product implementation.
+	void benchRotation(Runner& runner);
+
+	//! Vec3Stream and Vec4Stream arithmetic for every supported instruction set, against the same maths one Vec3/Vec4 at a time.
+	void benchStream(Runner& runner);
+
+	//! Bounding volume and frustum tests, and bounding sphere screen sizes, for every supported instruction set, against one box or sphere at a time.
+	void benchFrustum(Runner& runner);
+
+	//! Ray and box, sphere, and triangle intersections for every supported instruction set, against one ray at a time. The ops/s column is rays per second.
+	void benchRay(Runner& runner);
+
+	//! SceneObject component lookups by type, against the original map of components searched by type.
+	void benchComponents(Runner& runner);
+
+	//! Propagating world matrices through a transform hierarchy with Scene3D::update(), against recalculating every world matrix.
+	void benchHierarchy(Runner& runner);
+
+	//! Creating and destroying SceneObjects with Scene3D::create() and Scene3D::destroy(), against allocating each SceneObject and component on the heap.
+	void benchSpawn(Runner& runner);
+
+	//! Building and querying a BVH, and keeping a scene's BVH up to date as its SceneObjects move, against testing every box.
+	void benchBVH(Runner& runner);
+
+	//! Radius and box queries with a SpatialHash, against searching every SceneObject in the scene.
+	void benchSpatialHash(Runner& runner);
+
+	//! Running Systems with the SystemScheduler, one after another and across each number of threads up to the hardware's.
+	void benchSystems(Runner& runner);
+
+	//! Handing frames from an update thread to a render thread through a TripleBuffer, against doing each frame's update and render work one after another.
+	void benchPipeline(Runner& runner);
+
+} }
\ No newline at end of file
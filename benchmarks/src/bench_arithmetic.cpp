@@ -0,0 +1,320 @@
+/*!
+ * @file bench_arithmetic.cpp
+ * @brief Benchmarks for the basic vector and matrix operations.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+
+// Local includes
+
+#include "maths/maths.h"
+#include "maths/simd.h"
+#include "suites.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+using namespace engine::maths;
+
+
+namespace {
+
+	// Each benchmark works through this many inputs per call, so successive operations can't reuse a previous result.
+	const size_t count = 256;
+
+	Vec2 randomVec2()
+	{
+		return Vec2(randomFloat(-100.0f, 100.0f), randomFloat(-100.0f, 100.0f));
+	}
+
+	Mat3 randomMat3()
+	{
+		return Mat3(
+			randomFloat(-2.0f, 2.0f), randomFloat(-2.0f, 2.0f), randomFloat(-2.0f, 2.0f),
+			randomFloat(-2.0f, 2.0f), randomFloat(-2.0f, 2.0f), randomFloat(-2.0f, 2.0f),
+			randomFloat(-2.0f, 2.0f), randomFloat(-2.0f, 2.0f), randomFloat(-2.0f, 2.0f));
+	}
+
+	Mat4 randomMat4()
+	{
+		return translation(randomVec3(100.0f)) * rotation(randomVec3(100.0f)) * scale(Vec3(randomFloat(0.5f, 2.0f)));
+	}
+
+	void benchVectors(Runner& runner)
+	{
+		std::vector<Vec2> a2(count), b2(count), out2(count);
+		std::vector<Vec3> a3(count), b3(count), out3(count);
+		std::vector<Vec4> a4(count), b4(count), out4(count);
+		std::vector<float> results(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			a2[i] = randomVec2();
+			b2[i] = randomVec2();
+			a3[i] = randomVec3(100.0f);
+			b3[i] = randomVec3(100.0f);
+			a4[i] = randomVec4(100.0f);
+			b4[i] = randomVec4(100.0f);
+		}
+
+		runner.run("arithmetic/Vec2 add", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out2[i] = a2[i] + b2[i];
+			doNotOptimize(out2[0]);
+		});
+
+		runner.run("arithmetic/Vec2 multiply-add", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out2[i] = a2[i] * 0.5f + b2[i];
+			doNotOptimize(out2[0]);
+		});
+
+		runner.run("arithmetic/Vec2 normalize", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out2[i] = normalize(a2[i]);
+			doNotOptimize(out2[0]);
+		});
+
+		runner.run("arithmetic/Vec3 add", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out3[i] = a3[i] + b3[i];
+			doNotOptimize(out3[0]);
+		});
+
+		runner.run("arithmetic/Vec3 multiply-add", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out3[i] = a3[i] * 0.5f + b3[i];
+			doNotOptimize(out3[0]);
+		});
+
+		runner.run("arithmetic/Vec3 dot", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				results[i] = dot(a3[i], b3[i]);
+			doNotOptimize(results[0]);
+		});
+
+		runner.run("arithmetic/Vec3 cross", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out3[i] = cross(a3[i], b3[i]);
+			doNotOptimize(out3[0]);
+		});
+
+		runner.run("arithmetic/Vec3 magnitude", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				results[i] = a3[i].magnitude();
+			doNotOptimize(results[0]);
+		});
+
+		runner.run("arithmetic/Vec3 normalize", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out3[i] = normalize(a3[i]);
+			doNotOptimize(out3[0]);
+		});
+
+		runner.run("arithmetic/Vec4 add", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out4[i] = a4[i] + b4[i];
+			doNotOptimize(out4[0]);
+		});
+
+		runner.run("arithmetic/Vec4 multiply-add", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out4[i] = a4[i] * 0.5f + b4[i];
+			doNotOptimize(out4[0]);
+		});
+
+		runner.run("arithmetic/Vec4 normalize", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out4[i] = normalize(a4[i]);
+			doNotOptimize(out4[0]);
+		});
+	}
+
+	bool nearlyEqual(const float* a, const float* b, int count)
+	{
+		for (int i = 0; i < count; i++)
+			if (!bench::nearlyEqual(a[i], b[i], 1e-4f))
+				return false;
+
+		return true;
+	}
+
+	// Every instruction set's Mat4 kernels should give the scalar kernels' results, including when the output is also an input.
+	void checkMat4Kernels(Runner& runner, const std::vector<Mat4>& a, const std::vector<Mat4>& b, const std::vector<Vec4>& v)
+	{
+		for (int set = simd::SIMD_SCALAR; set <= simd::supportedInstructionSet(); set++)
+		{
+			simd::setInstructionSet((simd::InstructionSet)set);
+			const std::string isa = simd::instructionSetName((simd::InstructionSet)set);
+
+			bool multiplies = true, aliases = true, transforms = true;
+
+			for (size_t i = 0; i < a.size(); i++)
+			{
+				float expected[16], out[16], outIsA[16], outIsB[16];
+
+				simd::mat4Mul_scalar(a[i].data_ptr(), b[i].data_ptr(), expected);
+				simd::mat4Mul(a[i].data_ptr(), b[i].data_ptr(), out);
+				multiplies = multiplies && nearlyEqual(out, expected, 16);
+
+				std::copy(a[i].data_ptr(), a[i].data_ptr() + 16, outIsA);
+				simd::mat4Mul(outIsA, b[i].data_ptr(), outIsA);
+				std::copy(b[i].data_ptr(), b[i].data_ptr() + 16, outIsB);
+				simd::mat4Mul(a[i].data_ptr(), outIsB, outIsB);
+				aliases = aliases && nearlyEqual(outIsA, expected, 16) && nearlyEqual(outIsB, expected, 16);
+
+				float expectedVec4[4], outVec4[4], outIsV[4];
+
+				simd::mat4MulVec4_scalar(a[i].data_ptr(), &v[i].x(), expectedVec4);
+				simd::mat4MulVec4(a[i].data_ptr(), &v[i].x(), outVec4);
+				std::copy(&v[i].x(), &v[i].x() + 4, outIsV);
+				simd::mat4MulVec4(a[i].data_ptr(), outIsV, outIsV);
+				transforms = transforms && nearlyEqual(outVec4, expectedVec4, 4) && nearlyEqual(outIsV, expectedVec4, 4);
+			}
+
+			runner.check("arithmetic/Mat4 multiply/" + isa, multiplies);
+			runner.check("arithmetic/Mat4 multiply in place/" + isa, aliases);
+			runner.check("arithmetic/Mat4 x Vec4/" + isa, transforms);
+		}
+
+		simd::setInstructionSet(simd::supportedInstructionSet());
+	}
+
+	void benchMatrices(Runner& runner)
+	{
+		std::vector<Mat3> a3(count), b3(count), out3(count);
+		std::vector<Mat4> a4(count), b4(count), out4(count);
+		std::vector<Vec4> v4(count), outVec4(count);
+		std::vector<float> results(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			a3[i] = randomMat3();
+			b3[i] = randomMat3();
+			a4[i] = randomMat4();
+			b4[i] = randomMat4();
+			v4[i] = randomVec4(100.0f);
+		}
+
+		// A Mat3 multiplied by its inverse should give the identity, unless it is close to singular.
+		bool inverts = true;
+		for (size_t i = 0; i < count; i++)
+		{
+			if (std::fabs(a3[i].determinant()) < 0.1f)
+				continue;
+
+			Mat3 identity = a3[i] * inverse(a3[i]);
+			for (int col = 0; col < 3; col++)
+				for (int row = 0; row < 3; row++)
+					inverts = inverts && std::fabs(identity(col, row) - (col == row ? 1.0f : 0.0f)) < 1e-3f;
+		}
+		runner.check("arithmetic/Mat3 inverse", inverts);
+
+		checkMat4Kernels(runner, a4, b4, v4);
+
+		runner.run("arithmetic/Mat3 multiply", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out3[i] = a3[i] * b3[i];
+			doNotOptimize(out3[0]);
+		});
+
+		runner.run("arithmetic/Mat3 transpose", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out3[i] = transpose(a3[i]);
+			doNotOptimize(out3[0]);
+		});
+
+		runner.run("arithmetic/Mat3 determinant", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				results[i] = a3[i].determinant();
+			doNotOptimize(results[0]);
+		});
+
+		runner.run("arithmetic/Mat3 inverse", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out3[i] = inverse(a3[i]);
+			doNotOptimize(out3[0]);
+		});
+
+		runner.run("arithmetic/Mat4 multiply", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out4[i] = a4[i] * b4[i];
+			doNotOptimize(out4[0]);
+		});
+
+		runner.run("arithmetic/Mat4 x Vec4", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				outVec4[i] = a4[i] * v4[i];
+			doNotOptimize(outVec4[0]);
+		});
+
+		runner.run("arithmetic/Mat4 transpose", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out4[i] = transpose(a4[i]);
+			doNotOptimize(out4[0]);
+		});
+
+		runner.run("arithmetic/Mat4 determinant", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				results[i] = a4[i].determinant();
+			doNotOptimize(results[0]);
+		});
+	}
+
+	void benchBuilders(Runner& runner)
+	{
+		std::vector<Vec3> eyes(count), targets(count), angles(count);
+		std::vector<float> fovs(count);
+		std::vector<Mat4> out(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			eyes[i] = randomVec3(100.0f);
+			targets[i] = randomVec3(100.0f);
+			angles[i] = randomVec3(100.0f);
+			fovs[i] = radians(randomFloat(45.0f, 90.0f));
+		}
+
+		runner.run("arithmetic/lookAt", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out[i] = lookAt(eyes[i], targets[i], Vec3(0.0f, 1.0f, 0.0f));
+			doNotOptimize(out[0]);
+		});
+
+		runner.run("arithmetic/perspective", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out[i] = perspective(fovs[i], 16.0f / 9.0f, 0.1f, 100.0f);
+			doNotOptimize(out[0]);
+		});
+
+		runner.run("arithmetic/rotation", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out[i] = rotation(angles[i]);
+			doNotOptimize(out[0]);
+		});
+
+		runner.run("arithmetic/rotationX", count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out[i] = rotationX(angles[i].x());
+			doNotOptimize(out[0]);
+		});
+	}
+
+}
+
+
+void engine::bench::benchArithmetic(Runner& runner)
+{
+	benchVectors(runner);
+	benchMatrices(runner);
+	benchBuilders(runner);
+}
\ No newline at end of file
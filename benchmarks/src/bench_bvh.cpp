@@ -0,0 +1,350 @@
+/*!
+ * @file bench_bvh.cpp
+ * @brief Benchmarks for the BVH and the scene's spatial index.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+// Local includes
+
+#include "graphics/scene_3d.h"
+#include "maths/geometry/bvh.h"
+#include "maths/maths.h"
+#include "bounds_component.h"
+#include "scene_object.h"
+#include "suites.h"
+#include "utils/thread_pool.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+using namespace engine::maths;
+
+
+namespace {
+
+	// The items a BVH query found, sorted so they can be compared with a brute force search.
+	std::vector<uint32_t> sorted(std::vector<uint32_t> items)
+	{
+		std::sort(items.begin(), items.end());
+		return items;
+	}
+
+	std::vector<SceneObjectHandle> sorted(std::vector<SceneObjectHandle> handles)
+	{
+		std::sort(handles.begin(), handles.end(), [](const SceneObjectHandle& a, const SceneObjectHandle& b) { return a.index < b.index; });
+		return handles;
+	}
+
+	// Brute force searches, for checking the BVH against and for timing it against.
+	void queryLoop(const std::vector<AABB>& boxes, const Frustum& frustum, std::vector<uint32_t>& items)
+	{
+		for (uint32_t i = 0; i < boxes.size(); i++)
+			if (frustum.test(boxes[i]))
+				items.push_back(i);
+	}
+
+	void queryLoop(const std::vector<AABB>& boxes, const AABB& box, std::vector<uint32_t>& items)
+	{
+		for (uint32_t i = 0; i < boxes.size(); i++)
+			if (boxes[i].intersects(box))
+				items.push_back(i);
+	}
+
+	bool raycastLoop(const std::vector<AABB>& boxes, const Ray& ray, float& t, uint32_t& item)
+	{
+		bool hit = false;
+
+		for (uint32_t i = 0; i < boxes.size(); i++)
+		{
+			float boxT;
+
+			if (intersect(ray, boxes[i], boxT) && (!hit || boxT < t))
+			{
+				t = boxT;
+				item = i;
+				hit = true;
+			}
+		}
+
+		return hit;
+	}
+
+	void queryLoop(const graphics::Scene3D& scene, const Frustum& frustum, std::vector<SceneObjectHandle>& handles)
+	{
+		for (auto object : scene.getObjects())
+		{
+			const BoundsComponent* bounds = object->getComponent<BoundsComponent>();
+
+			if (bounds && frustum.test(transform(object->getComponent<TransformComponent>()->getWorldMatrix(), bounds->bounds())))
+				handles.push_back(object->getHandle());
+		}
+	}
+
+	// Time a whole frame's upkeep of a scene the size of an open world's: a million static bounded SceneObjects and ten thousand moving
+	// ... ones. Reported per frame, so the result can be read against the frame budget directly.
+	void benchSceneScale(Runner& runner)
+	{
+		const size_t staticCount = 1000000;
+		const size_t movingCount = 10000;
+
+		graphics::Scene3D scene;
+
+		for (size_t i = 0; i < staticCount + movingCount; i++)
+		{
+			SceneObject* object = scene.get(scene.create());
+			object->getComponent<TransformComponent>()->setPosition(randomVec3(5000.0f));
+			object->addComponent(BoundsComponent(AABB(Vec3(-1.0f), Vec3(1.0f))));
+		}
+
+		// Spread the moving SceneObjects through the scene. Pointers in to the component columns are only stable once every component has
+		// ... been added.
+		const std::vector<SceneObject*>& objects = scene.getObjects();
+		std::vector<TransformComponent*> moving;
+
+		for (size_t i = 0; i < objects.size() && moving.size() < movingCount; i += staticCount / movingCount + 1)
+			moving.push_back(objects[i]->getComponent<TransformComponent>());
+
+		scene.update();
+
+		size_t frame = 0;
+		auto moveObjects = [&](utils::ThreadPool* threadPool) {
+			frame++;
+
+			for (size_t i = 0; i < moving.size(); i++)
+				moving[i]->setPosition(moving[i]->position() + Vec3(0.0f, 0.0f, (i + frame) % 2 ? 0.5f : -0.5f));
+
+			scene.update(0.0f, threadPool);
+		};
+
+		// Let the moving SceneObjects settle in to the dynamic BVH before timing, as they would after their first few frames.
+		for (int i = 0; i < 4; i++)
+			moveObjects(nullptr);
+
+		runner.check("bvh/scene index at scale", scene.getBVH().size() == staticCount + movingCount &&
+			scene.getBVH().dynamicSize() == moving.size());
+
+		const std::string suffix = " (1M static, 10k moving, per frame)";
+		runner.run("bvh/scene update" + suffix, 1, [&]() { moveObjects(nullptr); });
+
+		utils::ThreadPool threadPool(std::max(1u, std::thread::hardware_concurrency()));
+		runner.run("bvh/scene update, threaded" + suffix, 1, [&]() { moveObjects(&threadPool); });
+	}
+
+}
+
+
+void engine::bench::benchBVH(Runner& runner)
+{
+	// The same camera as the frustum benchmarks, looking in to a much bigger world, so only a small part of it is visible.
+	const Mat4 view = translation(Vec3(0.0f, 0.0f, -10.0f));
+	const Mat4 projection = perspective(radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+	const Frustum frustum(projection * view);
+
+	const size_t count = 200000;
+	std::vector<AABB> boxes(count);
+
+	for (size_t i = 0; i < count; i++)
+		boxes[i] = randomBox(500.0f);
+
+	BVH bvh;
+	bvh.build(boxes);
+
+	std::vector<uint32_t> expected, items;
+	queryLoop(boxes, frustum, expected);
+	bvh.query(frustum, items);
+	bool frustumMatches = sorted(items) == sorted(expected);
+
+	const AABB region(Vec3(-40.0f), Vec3(40.0f));
+	expected.clear();
+	items.clear();
+	queryLoop(boxes, region, expected);
+	bvh.query(region, items);
+	bool boxMatches = sorted(items) == sorted(expected);
+
+	bool raysMatch = true;
+	std::vector<Ray> rays(256);
+
+	for (size_t i = 0; i < rays.size(); i++)
+	{
+		rays[i] = Ray(randomVec3(100.0f), randomVec3(1.0f));
+
+		float expectedT = 0.0f, t = 0.0f;
+		uint32_t expectedItem = 0, item = 0;
+		bool expectedHit = raycastLoop(boxes, rays[i], expectedT, expectedItem);
+		bool hit = bvh.raycast(rays[i], t, item);
+
+		raysMatch = raysMatch && hit == expectedHit && (!hit || t == expectedT);
+	}
+
+	runner.check("bvh/frustum query", frustumMatches);
+	runner.check("bvh/box query", boxMatches);
+	runner.check("bvh/raycast", raysMatch);
+
+	// Move a tenth of the boxes and remove a few, then check the refitted tree still agrees with a brute force search.
+	for (uint32_t i = 0; i < count; i += 10)
+	{
+		boxes[i] = randomBox(500.0f);
+		bvh.update(i, boxes[i]);
+	}
+
+	for (uint32_t i = 5; i < count; i += 1000)
+	{
+		boxes[i] = AABB(Vec3(1.0f), Vec3(-1.0f));
+		bvh.remove(i);
+	}
+
+	bvh.refit();
+
+	expected.clear();
+	items.clear();
+	queryLoop(boxes, frustum, expected);
+	bvh.query(frustum, items);
+
+	// Frustum::test() doesn't expect empty boxes, so leave the removed ones out of the brute force search's results.
+	expected.erase(std::remove_if(expected.begin(), expected.end(), [&](uint32_t i) { return boxes[i].min().x() > boxes[i].max().x(); }), expected.end());
+	runner.check("bvh/refit", sorted(items) == sorted(expected));
+
+	bvh.build(boxes);
+	const float builtCost = bvh.cost();
+
+	runner.run("bvh/build", count, [&]() {
+		bvh.build(boxes);
+		doNotOptimize(bvh.nodeCount());
+	});
+
+	runner.run("bvh/frustum query loop", count, [&]() {
+		items.clear();
+		queryLoop(boxes, frustum, items);
+		doNotOptimize(items.size());
+	});
+
+	runner.run("bvh/frustum query", count, [&]() {
+		items.clear();
+		bvh.query(frustum, items);
+		doNotOptimize(items.size());
+	});
+
+	// Testing every box is slow enough that a few rays will do.
+	runner.run("bvh/raycast loop", 4, [&]() {
+		float t;
+		uint32_t item;
+
+		for (size_t i = 0; i < 4; i++)
+			doNotOptimize(raycastLoop(boxes, rays[i], t, item));
+	});
+
+	runner.run("bvh/raycast", rays.size(), [&]() {
+		float t;
+		uint32_t item;
+
+		for (size_t i = 0; i < rays.size(); i++)
+			doNotOptimize(bvh.raycast(rays[i], t, item));
+	});
+
+	// Nudge a thousand boxes a frame, as moving objects would be, and refit around them.
+	const uint32_t moving = 1000;
+	uint32_t frame = 0;
+
+	runner.run("bvh/update and refit", moving, [&]() {
+		const Vec3 offset(0.01f * (frame++ % 2 ? 1.0f : -1.0f));
+
+		for (uint32_t i = 0; i < moving; i++)
+		{
+			const AABB& box = bvh.bounds(i * 97);
+			bvh.update(i * 97, AABB(box.min() + offset, box.max() + offset));
+		}
+
+		bvh.refit();
+	});
+
+	runner.check("bvh/cost", bvh.cost() > 0.0f && bvh.cost() < 2.0f * builtCost);
+
+	// A scene of static bounded SceneObjects, some of which start moving.
+	const size_t sceneCount = 50000;
+	graphics::Scene3D scene;
+	std::vector<SceneObjectHandle> handles(sceneCount);
+
+	for (size_t i = 0; i < sceneCount; i++)
+	{
+		handles[i] = scene.create();
+		SceneObject* object = scene.get(handles[i]);
+		object->getComponent<TransformComponent>()->setPosition(randomVec3(500.0f));
+		object->addComponent(BoundsComponent(AABB(Vec3(-1.0f), Vec3(1.0f))));
+	}
+
+	// A SceneObject without bounds isn't indexed.
+	scene.create();
+
+	scene.update();
+	const SceneBVH& index = scene.getBVH();
+	bool built = index.size() == sceneCount && index.dynamicSize() == 0;
+
+	const size_t sceneMoving = 1000;
+	size_t sceneFrame = 0;
+
+	// Each SceneObject steps back and forth, so they don't drift apart however many times the benchmark runs.
+	auto moveObjects = [&]() {
+		sceneFrame++;
+
+		for (size_t i = 0; i < sceneMoving; i++)
+		{
+			TransformComponent* transform = scene.get(handles[sceneCount - 1 - i * 37])->getComponent<TransformComponent>();
+			transform->setPosition(transform->position() + Vec3(0.0f, 0.0f, (i + sceneFrame) % 2 ? 0.5f : -0.5f));
+		}
+
+		scene.update();
+	};
+
+	moveObjects();
+	bool moved = index.dynamicSize() == sceneMoving;
+
+	// Destroy a few and swap a few for new ones, to check the index forgets destroyed SceneObjects even if their slots are reused.
+	for (size_t i = 0; i < 100; i++)
+		scene.destroy(handles[i * 101]);
+	for (size_t i = 0; i < 50; i++)
+	{
+		handles[i * 101] = scene.create();
+		scene.get(handles[i * 101])->addComponent(BoundsComponent(AABB(Vec3(-2.0f), Vec3(2.0f))));
+	}
+
+	moveObjects();
+
+	std::vector<SceneObjectHandle> expectedHandles, found;
+	queryLoop(scene, frustum, expectedHandles);
+	index.query(frustum, found);
+
+	runner.check("bvh/scene index", built && moved && index.size() == sceneCount - 50 && sorted(found) == sorted(expectedHandles));
+
+	runner.run("bvh/scene frustum query loop", sceneCount, [&]() {
+		found.clear();
+		queryLoop(scene, frustum, found);
+		doNotOptimize(found.size());
+	});
+
+	runner.run("bvh/scene frustum query", sceneCount, [&]() {
+		found.clear();
+		index.query(frustum, found);
+		doNotOptimize(found.size());
+	});
+
+	// Keeping the index up to date as SceneObjects move. Includes the world matrix updates, which the hierarchy benchmarks time on their own.
+	runner.run("bvh/scene update", sceneMoving, moveObjects);
+
+	found.clear();
+	expectedHandles.clear();
+	queryLoop(scene, frustum, expectedHandles);
+	index.query(frustum, found);
+	runner.check("bvh/scene index after updates", sorted(found) == sorted(expectedHandles));
+
+	benchSceneScale(runner);
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+/*!
+ * @file bench_camera.cpp
+ * @brief Benchmarks for the per-frame camera and object transform maths.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <vector>
+
+
+// Local includes
+
+#include "graphics/camera.h"
+#include "maths/maths.h"
+#include "suites.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+using namespace engine::maths;
+
+
+namespace {
+
+#ifndef ENGINE_MATHS_OUT_OF_LINE
+	// The header-only build can evaluate these entirely at compile time.
+	static_assert(dot(Vec3(1.0f, 2.0f, 3.0f), Vec3(4.0f, 5.0f, 6.0f)) == 32.0f, "dot() should be constexpr.");
+	static_assert(cross(Vec3(1.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f)) == Vec3(0.0f, 0.0f, 1.0f), "cross() should be constexpr.");
+
+	constexpr Mat4 g_transposedTranslation = transpose(translation(Vec3(1.0f, 2.0f, 3.0f)));
+	static_assert(g_transposedTranslation(0, 3) == 1.0f, "translation() and transpose() should be constexpr.");
+
+	constexpr Mat4 g_scale = Mat4(Mat3(scale(Vec3(2.0f))));
+	static_assert(g_scale.determinant() == 8.0f, "Matrix conversions and determinants should be constexpr.");
+#endif
+
+}
+
+
+void engine::bench::benchCamera(Runner& runner)
+{
+	const size_t count = 1024;
+
+	graphics::Camera camera(Vec3(0.0f, 2.0f, 10.0f), Vec3(0.0f, 0.0f, -1.0f), 67.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+
+	runner.run("camera/move", 1, [&]() {
+		camera.move(Vec3(1.0f, 0.0f, -1.0f), 1.0f / 60.0f);
+		doNotOptimize(camera.getViewMatrix());
+	});
+
+	runner.run("camera/rotate", 1, [&]() {
+		camera.rotate(Vec3(0.1f, 0.2f, 0.0f));
+		doNotOptimize(camera.getViewMatrix());
+	});
+
+	Mat4 result;
+	float fov = 60.0f;
+
+	runner.run("camera/perspective", 1, [&]() {
+		fov = fov < 90.0f ? fov + 0.01f : 60.0f;
+		result = perspective(radians(fov), 16.0f / 9.0f, 0.1f, 100.0f);
+		doNotOptimize(result);
+	});
+
+	runner.run("camera/lookAt", 1, [&]() {
+		result = lookAt(camera.position(), camera.position() + camera.direction(), Vec3(0.0f, 1.0f, 0.0f));
+		doNotOptimize(result);
+	});
+
+	// What the renderer does for every object: build its model matrix and combine it with the camera's.
+
+	std::vector<Vec3> positions(count), scales(count), orientations(count);
+	std::vector<Mat4> mvps(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		positions[i] = Vec3(randomFloat(-50.0f, 50.0f), randomFloat(-50.0f, 50.0f), randomFloat(-50.0f, 50.0f));
+		scales[i] = Vec3(randomFloat(0.5f, 2.0f));
+		orientations[i] = Vec3(randomFloat(0.0f, 360.0f), randomFloat(0.0f, 360.0f), randomFloat(0.0f, 360.0f));
+	}
+
+	runner.run("transform/model matrix (T*R*S)", count, [&]() {
+		for (size_t i = 0; i < count; i++)
+			mvps[i] = translation(positions[i]) * rotation(orientations[i]) * scale(scales[i]);
+		doNotOptimize(mvps[0]);
+	});
+
+	runner.run("transform/model-view-projection", count, [&]() {
+		Mat4 vp = camera.getPerspectiveMatrix() * camera.getViewMatrix();
+		for (size_t i = 0; i < count; i++)
+			mvps[i] = vp * translation(positions[i]) * rotation(orientations[i]) * scale(scales[i]);
+		doNotOptimize(mvps[0]);
+	});
+
+	// Vec3 arithmetic in a tight loop, where the out-of-line accessors hurt the most.
+
+	std::vector<Vec3> normals(count);
+
+	runner.run("vec3/face normals", count - 2, [&]() {
+		for (size_t i = 0; i + 2 < count; i++)
+			normals[i] = normalize(cross(positions[i + 1] - positions[i], positions[i + 2] - positions[i]));
+		doNotOptimize(normals[0]);
+	});
+
+	const Vec3 light = normalize(Vec3(1.0f, 1.0f, 1.0f));
+	float lit = 0.0f;
+
+	runner.run("vec3/dot", count, [&]() {
+		for (size_t i = 0; i < count; i++)
+			lit += dot(positions[i], light);
+		doNotOptimize(lit);
+	});
+}
\ No newline at end of file
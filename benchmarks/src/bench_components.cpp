@@ -0,0 +1,159 @@
+/*!
+ * @file bench_components.cpp
+ * @brief Benchmarks for looking up and iterating SceneObject components.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+
+// Local includes
+
+#include "graphics/scene_3d.h"
+#include "scene_object.h"
+#include "suites.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+using namespace engine::maths;
+
+
+namespace {
+
+	// Stands in for MeshComponent, which would pull in the OpenGL and Assimp headers. Only its type matters to the lookups.
+	class BenchMeshComponent : public Component
+	{
+	public:
+		static const ComponentType TYPE = COMPONENT_MESH;
+	};
+
+	// The original SceneObject component storage: a map keyed on the component's type, searched and dynamic_cast on every lookup.
+	class MapSceneObject
+	{
+	public:
+		template <typename T>
+		void addComponent(T* component)
+		{
+			m_components[typeid(T)] = component;
+		}
+
+		template <typename T>
+		T* getComponent()
+		{
+			if (!m_components.empty() && m_components.find(typeid(T)) != m_components.end())
+				return dynamic_cast<T*>(m_components[typeid(T)]);
+
+			return nullptr;
+		}
+
+		template <typename T>
+		bool hasComponent()
+		{
+			return !m_components.empty() && m_components.find(typeid(T)) != m_components.end();
+		}
+
+	private:
+		std::unordered_map<std::type_index, Component*> m_components;
+	};
+
+}
+
+
+void engine::bench::benchComponents(Runner& runner)
+{
+	// Enough objects that a frame's lookups don't all sit in cache, with every other one renderable.
+	const size_t count = 100000;
+
+	// Each object and component is allocated separately, as they are in a game, so the baseline has to chase pointers around the heap.
+	std::vector<MapSceneObject*> mapObjects(count);
+	graphics::Scene3D scene;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const Vec3 position((float)i, 0.0f, 0.0f);
+
+		mapObjects[i] = new MapSceneObject();
+		mapObjects[i]->addComponent(new TransformComponent(position, Vec3(1.0f), Vec3()));
+
+		SceneObject* object = scene.get(scene.create());
+		object->getComponent<TransformComponent>()->setPosition(position);
+
+		if (i % 2 == 0)
+		{
+			mapObjects[i]->addComponent(new BenchMeshComponent());
+			object->addComponent(new BenchMeshComponent());
+		}
+	}
+
+	const std::vector<SceneObject*>& objects = scene.getObjects();
+
+	// New SceneObjects start out in the archetype with no components, so it's there too, empty.
+	bool matches = scene.getComponents().archetypes().size() == 3;
+	for (size_t i = 0; i < count; i++)
+		matches = matches && objects[i]->getComponent<TransformComponent>()->position() == mapObjects[i]->getComponent<TransformComponent>()->position() &&
+			objects[i]->hasComponent<BenchMeshComponent>() == mapObjects[i]->hasComponent<BenchMeshComponent>() &&
+			objects[i]->hasComponents(componentMask<TransformComponent, BenchMeshComponent>()) == (i % 2 == 0);
+	runner.check("components/same components as map", matches);
+
+	// Adding a component moves the object to another archetype, and the last object in the old one in to its place.
+	SceneObject* moved = objects[1];
+	moved->addComponent(new BenchMeshComponent());
+	bool moves = moved->hasComponent<BenchMeshComponent>() && moved->getComponent<TransformComponent>()->position() == Vec3(1.0f, 0.0f, 0.0f) &&
+		objects[count - 1]->getComponent<TransformComponent>()->position() == Vec3((float)(count - 1), 0.0f, 0.0f);
+	moved->addComponent<BenchMeshComponent>(nullptr);
+	runner.check("components/move between archetypes", moves && !moved->hasComponent<BenchMeshComponent>() && moved->getComponent<TransformComponent>()->position() == Vec3(1.0f, 0.0f, 0.0f));
+
+	float expected = 0.0f;
+	for (size_t i = 0; i < count; i += 2)
+		expected += (float)i;
+
+	float eachSum = 0.0f;
+	scene.each<TransformComponent, BenchMeshComponent>([&](TransformComponent& transform, BenchMeshComponent&) { eachSum += transform.position().x(); });
+	runner.check("components/each", eachSum == expected);
+
+	// The renderer's per-object pattern: check for a mesh, then fetch the transform.
+
+	runner.run("components/map getComponent and hasComponent", count, [&]() {
+		float sum = 0.0f;
+		for (size_t i = 0; i < count; i++)
+			if (mapObjects[i]->hasComponent<BenchMeshComponent>())
+			{
+				const TransformComponent* transform = mapObjects[i]->getComponent<TransformComponent>();
+				sum += transform->position().x();
+			}
+		doNotOptimize(sum);
+	});
+
+	runner.run("components/handle getComponent and hasComponent", count, [&]() {
+		const ComponentMask renderable = componentMask<TransformComponent, BenchMeshComponent>();
+
+		float sum = 0.0f;
+		for (size_t i = 0; i < count; i++)
+			if (objects[i]->hasComponents(renderable))
+			{
+				const TransformComponent* transform = objects[i]->getComponent<TransformComponent>();
+				sum += transform->position().x();
+			}
+		doNotOptimize(sum);
+	});
+
+	runner.run("components/each", count, [&]() {
+		float sum = 0.0f;
+		scene.each<TransformComponent, BenchMeshComponent>([&](const TransformComponent& transform, BenchMeshComponent&) { sum += transform.position().x(); });
+		doNotOptimize(sum);
+	});
+
+	for (size_t i = 0; i < count; i++)
+	{
+		delete mapObjects[i]->getComponent<TransformComponent>();
+		delete mapObjects[i]->getComponent<BenchMeshComponent>();
+		delete mapObjects[i];
+	}
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+/*!
+ * @file bench_frustum.cpp
+ * @brief Benchmarks for the bounding volumes and frustum tests.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+// Local includes
+
+#include "maths/maths.h"
+#include "maths/simd.h"
+#include "suites.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+using namespace engine::maths;
+
+
+namespace {
+
+	// The original way of bounding a transformed box: transform all eight corners.
+	AABB transformCorners(const Mat4& m, const AABB& aabb)
+	{
+		AABB result;
+
+		for (int i = 0; i < 8; i++)
+		{
+			Vec3 corner((i & 1) ? aabb.max().x() : aabb.min().x(), (i & 2) ? aabb.max().y() : aabb.min().y(), (i & 4) ? aabb.max().z() : aabb.min().z());
+			Vec4 transformed = m * Vec4(corner.x(), corner.y(), corner.z(), 1.0f);
+			Vec3 point(transformed.x(), transformed.y(), transformed.z());
+
+			if (i == 0)
+				result = AABB(point, point);
+			else
+				result.expand(point);
+		}
+
+		return result;
+	}
+
+	// One sphere's screen size at a time, as the LOD selection would find it without the batched kernels.
+	float screenSizeOne(const Sphere& sphere, const Vec3& eye, float scale)
+	{
+		const float distance = (sphere.center() - eye).magnitude();
+		return sphere.radius() * scale / std::fmax(distance, sphere.radius());
+	}
+
+}
+
+
+void engine::bench::benchFrustum(Runner& runner)
+{
+	// A camera at (0, 0, 10) looking down -Z, with the view matrix built the same way the Camera class builds it.
+	const Mat4 view = translation(Vec3(0.0f, 0.0f, -10.0f));
+	const Mat4 projection = perspective(radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+	const Frustum frustum(projection * view);
+
+	runner.check("frustum/extract planes", frustum.test(Vec3(0.0f, 0.0f, 0.0f)) && !frustum.test(Vec3(0.0f, 0.0f, 20.0f)) && !frustum.test(Vec3(0.0f, 0.0f, -95.0f)) &&
+		!frustum.test(Vec3(50.0f, 0.0f, 0.0f)) && !frustum.test(Vec3(0.0f, -50.0f, 0.0f)));
+
+	runner.check("frustum/sphere", frustum.test(Sphere(Vec3(0.0f, 0.0f, 20.0f), 11.0f)) && !frustum.test(Sphere(Vec3(0.0f, 0.0f, 20.0f), 9.0f)));
+
+	runner.check("frustum/box", frustum.test(AABB(Vec3(-1.0f, -1.0f, 9.0f), Vec3(1.0f, 1.0f, 11.0f))) && !frustum.test(AABB(Vec3(-1.0f, -1.0f, 11.0f), Vec3(1.0f, 1.0f, 12.0f))) &&
+		frustum.test(AABB(Vec3(-100.0f), Vec3(100.0f))));
+
+	// Bounding a transformed box, against transforming its corners.
+	const Mat4 model = translation(Vec3(1.0f, -2.0f, 3.0f)) * rotation(Vec3(30.0f, 45.0f, 60.0f)) * scale(Vec3(2.0f, 0.5f, 1.0f));
+	const AABB local(Vec3(-1.0f, -2.0f, -3.0f), Vec3(4.0f, 5.0f, 6.0f));
+	const AABB expected = transformCorners(model, local);
+	const AABB transformed = transform(model, local);
+	runner.check("frustum/transform AABB", nearlyEqual(transformed.min(), expected.min(), 1e-3f) && nearlyEqual(transformed.max(), expected.max(), 1e-3f));
+
+	runner.run("frustum/transform AABB corners", 1, [&]() {
+		doNotOptimize(transformCorners(model, local));
+	});
+
+	runner.run("frustum/transform AABB", 1, [&]() {
+		doNotOptimize(transform(model, local));
+	});
+
+	// A scene's worth of boxes scattered around the camera, roughly a quarter of them visible. The odd count exercises the scalar tail.
+	const size_t count = 100003;
+	std::vector<AABB> boxes(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		Vec3 centre = randomVec3(60.0f);
+		Vec3 extents(randomFloat(0.1f, 2.0f), randomFloat(0.1f, 2.0f), randomFloat(0.1f, 2.0f));
+		boxes[i] = AABB(centre - extents, centre + extents);
+	}
+
+	std::vector<uint8_t> expectedVisible(count), visible(count);
+	for (size_t i = 0; i < count; i++)
+		expectedVisible[i] = frustum.test(boxes[i]) ? 1 : 0;
+
+	runner.run("frustum/test AABB loop", count, [&]() {
+		for (size_t i = 0; i < count; i++)
+			visible[i] = frustum.test(boxes[i]) ? 1 : 0;
+		doNotOptimize(visible[0]);
+	});
+
+	for (int set = simd::SIMD_SCALAR; set <= simd::supportedInstructionSet(); set++)
+	{
+		simd::setInstructionSet((simd::InstructionSet)set);
+		const std::string isa = simd::instructionSetName((simd::InstructionSet)set);
+
+		// The FMA kernel may disagree on boxes touching a plane, so allow a handful of mismatches.
+		frustum.test(&boxes[0], count, &visible[0]);
+		size_t mismatches = 0;
+		for (size_t i = 0; i < count; i++)
+			mismatches += visible[i] != expectedVisible[i];
+		runner.check("frustum/test AABBs/" + isa, mismatches <= count / 10000);
+
+		runner.run("frustum/test AABBs/" + isa, count, [&]() {
+			frustum.test(&boxes[0], count, &visible[0]);
+			doNotOptimize(visible[0]);
+		});
+	}
+
+	// Screen sizes of the boxes' bounding spheres, as the renderer finds them to pick levels of detail.
+	const Vec3 eye(0.0f, 0.0f, 10.0f);
+	const float projectionScale = projection(1, 1);
+
+	std::vector<Sphere> spheres(count);
+	Vec3Stream centres(count);
+	std::vector<float> radii(count), expectedSizes(count), sizes(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		spheres[i] = Sphere(boxes[i].center(), boxes[i].extents().magnitude());
+		centres.set(i, spheres[i].center());
+		radii[i] = spheres[i].radius();
+		expectedSizes[i] = screenSizeOne(spheres[i], eye, projectionScale);
+	}
+
+	// Known answers for a sphere ten units in front of the eye, and one around it.
+	const Sphere knownSpheres[2] = { Sphere(Vec3(0.0f), 1.0f), Sphere(Vec3(0.0f, 0.0f, 9.0f), 2.0f) };
+	Vec3Stream knownCentres(2);
+	float knownRadii[2], knownSizes[2];
+
+	for (size_t i = 0; i < 2; i++)
+	{
+		knownCentres.set(i, knownSpheres[i].center());
+		knownRadii[i] = knownSpheres[i].radius();
+	}
+
+	runner.run("frustum/screen size loop", count, [&]() {
+		for (size_t i = 0; i < count; i++)
+			sizes[i] = screenSizeOne(spheres[i], eye, projectionScale);
+		doNotOptimize(sizes[0]);
+	});
+
+	for (int set = simd::SIMD_SCALAR; set <= simd::supportedInstructionSet(); set++)
+	{
+		simd::setInstructionSet((simd::InstructionSet)set);
+		const std::string isa = simd::instructionSetName((simd::InstructionSet)set);
+
+		screenSize(knownCentres, knownRadii, eye, projectionScale, knownSizes);
+		bool known = std::fabs(knownSizes[0] - projectionScale / 10.0f) <= 1e-6f && knownSizes[1] == projectionScale;
+
+		screenSize(centres, &radii[0], eye, projectionScale, &sizes[0]);
+		size_t mismatches = 0;
+		for (size_t i = 0; i < count; i++)
+			mismatches += std::fabs(sizes[i] - expectedSizes[i]) > 1e-5f * expectedSizes[i];
+		runner.check("frustum/screen size/" + isa, known && mismatches == 0);
+
+		runner.run("frustum/screen size/" + isa, count, [&]() {
+			screenSize(centres, &radii[0], eye, projectionScale, &sizes[0]);
+			doNotOptimize(sizes[0]);
+		});
+	}
+
+	simd::setInstructionSet(simd::supportedInstructionSet());
+}
\ No newline at end of file
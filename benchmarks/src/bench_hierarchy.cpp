@@ -0,0 +1,228 @@
+/*!
+ * @file bench_hierarchy.cpp
+ * @brief Benchmarks for propagating world matrices through a scene's transform hierarchy.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// Local includes
+
+#include "graphics/scene_3d.h"
+#include "scene_object.h"
+#include "suites.h"
+#include "utils/thread_pool.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+using namespace engine::maths;
+
+
+namespace {
+
+	// World matrices are products of several matrices, so are allowed a little more rounding than a single one.
+	const float tolerance = 1e-3f;
+
+	// Each root has ten children, each with ten children of their own.
+	const size_t fanOut = 10;
+	const size_t objectsPerRoot = 1 + fanOut + fanOut * fanOut;
+
+	// Fill a scene with three-level hierarchies, and return their roots.
+	std::vector<SceneObject*> buildHierarchies(graphics::Scene3D& scene, size_t roots)
+	{
+		std::vector<SceneObject*> rootObjects;
+
+		auto create = [&](SceneObject* parent, const Vec3& position) {
+			SceneObject* object = scene.get(scene.create());
+			object->getComponent<TransformComponent>()->setPosition(position);
+			object->getComponent<TransformComponent>()->setOrientation(Vec3(0.0f, radians(10.0f), 0.0f));
+			object->setParent(parent);
+			return object;
+		};
+
+		for (size_t r = 0; r < roots; r++)
+		{
+			SceneObject* root = create(nullptr, Vec3((float)r, 0.0f, 0.0f));
+			rootObjects.push_back(root);
+
+			for (size_t c = 0; c < fanOut; c++)
+			{
+				SceneObject* child = create(root, Vec3(0.0f, 1.0f, 0.0f));
+
+				for (size_t g = 0; g < fanOut; g++)
+					create(child, Vec3(0.0f, 0.0f, 1.0f));
+			}
+		}
+
+		return rootObjects;
+	}
+
+	// Time updating every world matrix in a scene of about @p count transforms, for each number of threads up to the hardware's.
+	void benchScaling(Runner& runner, size_t count)
+	{
+		graphics::Scene3D scene;
+		const std::vector<SceneObject*> rootObjects = buildHierarchies(scene, std::max<size_t>(count / objectsPerRoot, 1));
+		const size_t transforms = rootObjects.size() * objectsPerRoot;
+
+		const std::string suffix = " (n=" + std::to_string(transforms) + ")";
+		const unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+		// Check the threaded update against a single-threaded one, using more threads than there are cores if need be.
+		scene.update();
+		const SceneObject* last = scene.getObjects().back();
+		const Mat4 expected = last->getComponent<TransformComponent>()->getWorldMatrix();
+
+		utils::ThreadPool checkPool(std::max(4u, maxThreads));
+		rootObjects.back()->getComponent<TransformComponent>()->setPosition(Vec3(0.0f));
+		scene.update(0.0f, &checkPool);
+		bool moves = !nearlyEqual(last->getComponent<TransformComponent>()->getWorldMatrix(), expected, tolerance);
+		rootObjects.back()->getComponent<TransformComponent>()->setPosition(Vec3((float)(rootObjects.size() - 1), 0.0f, 0.0f));
+		scene.update(0.0f, &checkPool);
+		runner.check("hierarchy/threaded update" + suffix, moves && nearlyEqual(last->getComponent<TransformComponent>()->getWorldMatrix(), expected, tolerance));
+
+		// Powers of two up to the number of hardware threads, and the number of hardware threads itself.
+		std::vector<unsigned int> threadCounts;
+		for (unsigned int threads = 1; threads < maxThreads; threads *= 2)
+			threadCounts.push_back(threads);
+		threadCounts.push_back(maxThreads);
+
+		size_t frame = 0;
+
+		for (auto threads : threadCounts)
+		{
+			utils::ThreadPool threadPool(threads);
+
+			// Moving every root makes every world matrix stale.
+			runner.run("hierarchy/update every transform/threads=" + std::to_string(threads) + suffix, transforms, [&]() {
+				for (size_t r = 0; r < rootObjects.size(); r++)
+					rootObjects[r]->getComponent<TransformComponent>()->setPosition(Vec3((float)r, (float)(frame & 1), 0.0f));
+				frame++;
+				scene.update(0.0f, &threadPool);
+			});
+		}
+	}
+
+	// Recalculate an object's and its descendants' world matrices from scratch, as every frame would without caching.
+	void recalculateWorldMatrices(SceneObject* object, const Mat4& parentWorld, std::vector<Mat4>& worlds, size_t& next)
+	{
+		const TransformComponent* transform = object->getComponent<TransformComponent>();
+
+		const Mat4 world = parentWorld * translation(transform->position()) * rotation(transform->rotation()) * scale(transform->scale());
+		worlds[next++] = world;
+
+		for (auto child : object->getChildren())
+			recalculateWorldMatrices(child, world, worlds, next);
+	}
+
+}
+
+
+void engine::bench::benchHierarchy(Runner& runner)
+{
+	// 111k objects.
+	const size_t roots = 1000;
+	const size_t count = roots * objectsPerRoot;
+
+	graphics::Scene3D scene;
+	const std::vector<SceneObject*> rootObjects = buildHierarchies(scene, roots);
+
+	scene.update();
+
+	// Check a grandchild's world matrix against the product of its ancestors' local matrices.
+	SceneObject* root = rootObjects[5];
+	SceneObject* child = root->getChildren()[3];
+	SceneObject* grandchild = child->getChildren()[7];
+	const Mat4 expected = root->getComponent<TransformComponent>()->getMatrix() * child->getComponent<TransformComponent>()->getMatrix() *
+		grandchild->getComponent<TransformComponent>()->getMatrix();
+	runner.check("hierarchy/world matrix", nearlyEqual(grandchild->getComponent<TransformComponent>()->getWorldMatrix(), expected, tolerance));
+
+	// Nothing has moved, so a second update shouldn't recalculate anything.
+	const unsigned long long version = grandchild->getComponent<TransformComponent>()->worldVersion();
+	scene.update();
+	runner.check("hierarchy/static update", grandchild->getComponent<TransformComponent>()->worldVersion() == version);
+
+	// Setting a transform to its current value isn't a change either. Read it through a const pointer, as the mutable accessors count as changes.
+	const TransformComponent* rootTransform = root->getComponent<TransformComponent>();
+	root->getComponent<TransformComponent>()->setPosition(rootTransform->position());
+	scene.update();
+	runner.check("hierarchy/unchanged setter", grandchild->getComponent<TransformComponent>()->worldVersion() == version);
+
+	// Moving the root moves its descendants.
+	root->getComponent<TransformComponent>()->setPosition(Vec3(5.0f, 10.0f, 0.0f));
+	scene.update();
+	const Mat4 moved = translation(Vec3(0.0f, 10.0f, 0.0f)) * expected;
+	runner.check("hierarchy/moved root", nearlyEqual(grandchild->getComponent<TransformComponent>()->getWorldMatrix(), moved, tolerance));
+
+	// Halfway between the last two updates, the grandchild is halfway between where it was and where it is. Objects which didn't move in
+	// ... the last update are where they are.
+	const unsigned long long latestUpdate = scene.getHierarchy().updates();
+	const TransformComponent* still = rootObjects[6]->getChildren()[3]->getChildren()[7]->getComponent<TransformComponent>();
+	runner.check("hierarchy/interpolated", nearlyEqual(grandchild->getComponent<TransformComponent>()->getInterpolatedWorldMatrix(latestUpdate, 0.5f),
+		0.5f * (expected + moved), tolerance) && nearlyEqual(still->getInterpolatedWorldMatrix(latestUpdate, 0.5f), still->getWorldMatrix(), tolerance));
+
+	runner.check("hierarchy/cycles rejected", !root->setParent(grandchild) && !root->setParent(root) && root->getParent() == nullptr);
+
+	// Reparenting makes the world matrix relative to the new parent.
+	grandchild->setParent(nullptr);
+	scene.update();
+	bool reparents = nearlyEqual(grandchild->getComponent<TransformComponent>()->getWorldMatrix(), grandchild->getComponent<TransformComponent>()->getMatrix(), tolerance);
+	grandchild->setParent(child);
+	scene.update();
+	runner.check("hierarchy/reparent", reparents && nearlyEqual(grandchild->getComponent<TransformComponent>()->getWorldMatrix(), moved, tolerance));
+
+	// Replacing a transform in place doesn't rebuild the hierarchy, so the new transform must still be tracked, both for the replacement
+	// ... itself and for any change made to it afterwards.
+	SceneObject* replaced = rootObjects[7];
+	replaced->addComponent(TransformComponent(Vec3(1.0f, 2.0f, 3.0f), Vec3(1.0f), Vec3(0.0f)));
+	scene.update();
+	bool replacedMoves = nearlyEqual(replaced->getComponent<TransformComponent>()->getWorldMatrix(), translation(Vec3(1.0f, 2.0f, 3.0f)), tolerance);
+	replaced->getComponent<TransformComponent>()->setPosition(Vec3(4.0f, 5.0f, 6.0f));
+	scene.update();
+	runner.check("hierarchy/replaced transform", replacedMoves &&
+		nearlyEqual(replaced->getComponent<TransformComponent>()->getWorldMatrix(), translation(Vec3(4.0f, 5.0f, 6.0f)), tolerance));
+
+	std::vector<Mat4> worlds(count);
+
+	runner.run("hierarchy/recalculate every world matrix", count, [&]() {
+		size_t next = 0;
+		for (auto object : rootObjects)
+			recalculateWorldMatrices(object, Mat4(1.0f), worlds, next);
+		doNotOptimize(worlds[0]);
+	});
+
+	runner.run("hierarchy/update, nothing moved", count, [&]() {
+		scene.update();
+	});
+
+	// A few objects moving each frame, as in a mostly static scene. Each root comes round every hundred frames, so it moves back and forth
+	// ... with each hundred rather than with each frame, which would put it back where it was.
+	size_t frame = 0;
+	runner.run("hierarchy/update, 1% of roots moved", count, [&]() {
+		for (size_t r = frame % 100; r < roots; r += 100)
+			rootObjects[r]->getComponent<TransformComponent>()->setPosition(Vec3((float)r, (float)((frame / 100) & 1), 0.0f));
+		frame++;
+		scene.update();
+	});
+
+	runner.run("hierarchy/update, every root moved", count, [&]() {
+		for (size_t r = 0; r < roots; r++)
+			rootObjects[r]->getComponent<TransformComponent>()->setPosition(Vec3((float)r, (float)(frame & 1), 0.0f));
+		frame++;
+		scene.update();
+	});
+
+	// Splitting the update across threads, for scenes where much of the hierarchy moves each frame.
+	benchScaling(runner, 10000);
+	benchScaling(runner, 100000);
+	benchScaling(runner, 1000000);
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+/*!
+ * @file bench_inverse.cpp
+ * @brief Benchmarks for the Mat4 inverse functions.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <cmath>
+#include <string>
+
+
+// Local includes
+
+#include "maths/maths.h"
+#include "maths/simd.h"
+#include "suites.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+using namespace engine::maths;
+
+
+namespace {
+
+	// The original implementation of maths::inverse(const Mat4&), kept as the baseline to measure against.
+	Mat4 inverseMat3Cofactors(const Mat4& mat4)
+	{
+		return (1.0f / mat4.determinant()) * transpose(Mat4(
+			 Mat3(mat4(1, 1), mat4(1, 2), mat4(1, 3), mat4(2, 1), mat4(2, 2), mat4(2, 3), mat4(3, 1), mat4(3, 2), mat4(3, 3)).determinant(),
+			-Mat3(mat4(1, 0), mat4(1, 2), mat4(1, 3), mat4(2, 0), mat4(2, 2), mat4(2, 3), mat4(3, 0), mat4(3, 2), mat4(3, 3)).determinant(),
+			 Mat3(mat4(1, 0), mat4(1, 1), mat4(1, 3), mat4(2, 0), mat4(2, 1), mat4(2, 3), mat4(3, 0), mat4(3, 1), mat4(3, 3)).determinant(),
+			-Mat3(mat4(1, 0), mat4(1, 1), mat4(1, 2), mat4(2, 0), mat4(2, 1), mat4(2, 2), mat4(3, 0), mat4(3, 1), mat4(3, 2)).determinant(),
+
+			-Mat3(mat4(0, 1), mat4(0, 2), mat4(0, 3), mat4(2, 1), mat4(2, 2), mat4(2, 3), mat4(3, 1), mat4(3, 2), mat4(3, 3)).determinant(),
+			 Mat3(mat4(0, 0), mat4(0, 2), mat4(0, 3), mat4(2, 0), mat4(2, 2), mat4(2, 3), mat4(3, 0), mat4(3, 2), mat4(3, 3)).determinant(),
+			-Mat3(mat4(0, 0), mat4(0, 1), mat4(0, 3), mat4(2, 0), mat4(2, 1), mat4(2, 3), mat4(3, 0), mat4(3, 1), mat4(3, 3)).determinant(),
+			 Mat3(mat4(0, 0), mat4(0, 1), mat4(0, 2), mat4(2, 0), mat4(2, 1), mat4(2, 2), mat4(3, 0), mat4(3, 1), mat4(3, 2)).determinant(),
+
+			 Mat3(mat4(0, 1), mat4(0, 2), mat4(0, 3), mat4(1, 1), mat4(1, 2), mat4(1, 3), mat4(3, 1), mat4(3, 2), mat4(3, 3)).determinant(),
+			-Mat3(mat4(0, 0), mat4(0, 2), mat4(0, 3), mat4(1, 0), mat4(1, 2), mat4(1, 3), mat4(3, 0), mat4(3, 2), mat4(3, 3)).determinant(),
+			 Mat3(mat4(0, 0), mat4(0, 1), mat4(0, 3), mat4(1, 0), mat4(1, 1), mat4(1, 3), mat4(3, 0), mat4(3, 1), mat4(3, 3)).determinant(),
+			-Mat3(mat4(0, 0), mat4(0, 1), mat4(0, 2), mat4(1, 0), mat4(1, 1), mat4(1, 2), mat4(3, 0), mat4(3, 1), mat4(3, 2)).determinant(),
+
+			-Mat3(mat4(0, 1), mat4(0, 2), mat4(0, 3), mat4(1, 1), mat4(1, 2), mat4(1, 3), mat4(2, 1), mat4(2, 2), mat4(2, 3)).determinant(),
+			 Mat3(mat4(0, 0), mat4(0, 2), mat4(0, 3), mat4(1, 0), mat4(1, 2), mat4(1, 3), mat4(2, 0), mat4(2, 2), mat4(2, 3)).determinant(),
+			-Mat3(mat4(0, 0), mat4(0, 1), mat4(0, 3), mat4(1, 0), mat4(1, 1), mat4(1, 3), mat4(2, 0), mat4(2, 1), mat4(2, 3)).determinant(),
+			 Mat3(mat4(0, 0), mat4(0, 1), mat4(0, 2), mat4(1, 0), mat4(1, 1), mat4(1, 2), mat4(2, 0), mat4(2, 1), mat4(2, 2)).determinant()));
+	}
+
+	// Alternates between a few matrices so each call can't simply reuse the previous result.
+	struct MatrixSet
+	{
+		Mat4 matrices[4];
+		Mat4 result;
+		int next = 0;
+
+		const Mat4& get()
+		{
+			next = (next + 1) & 3;
+			return matrices[next];
+		}
+	};
+
+}
+
+
+void engine::bench::benchInverse(Runner& runner)
+{
+	MatrixSet general, affine, rigid;
+
+	for (int i = 0; i < 4; i++)
+	{
+		float f = (float)i;
+
+		Mat4 r = rotation(Vec3(10.0f + f, 20.0f * f, 30.0f - f));
+		Mat4 t = translation(Vec3(f, -2.0f * f, 3.0f));
+
+		rigid.matrices[i] = r * t;
+		affine.matrices[i] = t * r * scale(Vec3(1.0f + f, 2.0f, 0.5f));
+		general.matrices[i] = perspective(radians(60.0f + f), 1.5f, 0.1f, 100.0f) * affine.matrices[i];
+	}
+
+	runner.run("inverse/Mat3 cofactors (original)", 1, [&]() {
+		general.result = inverseMat3Cofactors(general.get());
+		doNotOptimize(general.result);
+	});
+
+	for (int set = simd::SIMD_SCALAR; set <= simd::supportedInstructionSet(); set++)
+	{
+		simd::setInstructionSet((simd::InstructionSet)set);
+		const std::string isa = simd::instructionSetName((simd::InstructionSet)set);
+
+		for (int i = 0; i < 4; i++)
+			runner.check("inverse/" + isa, nearlyEqual(inverse(general.matrices[i]), inverseMat3Cofactors(general.matrices[i]), 1e-4f));
+
+		// The specialised inverses must agree with the general one wherever they are valid.
+		for (int i = 0; i < 4; i++)
+		{
+			runner.check("inverseAffine/" + isa, nearlyEqual(inverseAffine(affine.matrices[i]), inverseMat3Cofactors(affine.matrices[i]), 1e-4f));
+			runner.check("inverseRigid/" + isa, nearlyEqual(inverseRigid(rigid.matrices[i]), inverseMat3Cofactors(rigid.matrices[i]), 1e-4f));
+		}
+
+		runner.run("inverse/" + isa, 1, [&]() {
+			general.result = inverse(general.get());
+			doNotOptimize(general.result);
+		});
+
+		runner.run("inverseAffine/" + isa, 1, [&]() {
+			affine.result = inverseAffine(affine.get());
+			doNotOptimize(affine.result);
+		});
+
+		runner.run("inverseRigid/" + isa, 1, [&]() {
+			rigid.result = inverseRigid(rigid.get());
+			doNotOptimize(rigid.result);
+		});
+	}
+
+	simd::setInstructionSet(simd::supportedInstructionSet());
+}
\ No newline at end of file
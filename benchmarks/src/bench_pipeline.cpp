@@ -0,0 +1,156 @@
+/*!
+ * @file bench_pipeline.cpp
+ * @brief Benchmarks for pipelining update and render work through a TripleBuffer.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+
+// Local includes
+
+#include "suites.h"
+#include "utils/triple_buffer.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+
+
+namespace {
+
+	// Stands in for a RenderSnapshot: a frame number, and a block of values which all depend on it, so a half-written frame shows.
+	struct TestFrame
+	{
+		unsigned long long number;
+		std::vector<unsigned long long> values;
+
+		TestFrame()
+			: number(0), values(256, 0) { }
+
+		void fill(unsigned long long frameNumber)
+		{
+			number = frameNumber;
+			for (size_t i = 0; i < values.size(); i++)
+				values[i] = frameNumber * 31 + i;
+		}
+
+		bool whole() const
+		{
+			for (size_t i = 0; i < values.size(); i++)
+				if (values[i] != number * 31 + i)
+					return false;
+
+			return true;
+		}
+	};
+
+	// A fixed amount of arithmetic, standing in for a frame's update or render submission.
+	float work(float seed, size_t iterations)
+	{
+		float value = seed;
+		for (size_t i = 0; i < iterations; i++)
+			value = std::sqrt(value * value + (float)i) * 0.5f;
+		return value;
+	}
+
+	// Update and render work per frame, each a few tens of microseconds.
+	const size_t updateWork = 4000;
+	const size_t renderWork = 4000;
+
+}
+
+
+void engine::bench::benchPipeline(Runner& runner)
+{
+	// A producer publishing as fast as it can and a consumer taking whatever is newest: every frame taken must be whole, and newer than the
+	// ... last.
+	{
+		utils::TripleBuffer<TestFrame> frames;
+		const unsigned long long frameCount = 20000;
+		std::atomic<bool> done(false);
+
+		std::thread producer([&]() {
+			for (unsigned long long number = 1; number <= frameCount; number++)
+			{
+				frames.back().fill(number);
+				frames.publish();
+			}
+
+			done = true;
+		});
+
+		bool ordered = true;
+		unsigned long long last = 0;
+		size_t taken = 0;
+
+		while (last < frameCount)
+		{
+			if (!frames.consume())
+			{
+				// The producer may have finished between the consume and this check, with its last frame still to be taken.
+				if (done && !frames.pending())
+					break;
+
+				std::this_thread::yield();
+				continue;
+			}
+
+			const TestFrame& frame = frames.front();
+			ordered = ordered && frame.whole() && frame.number > last;
+			last = frame.number;
+			taken++;
+		}
+
+		producer.join();
+		runner.check("pipeline/triple buffer", ordered && last == frameCount && taken > 0);
+	}
+
+	// A frame's update and render work one after another, as EngineCore::run did on one thread.
+	float results = 0.0f;
+
+	runner.run("pipeline/update then render", 1, [&]() {
+		results += work(results, updateWork);
+		results += work(results, renderWork);
+		doNotOptimize(results);
+	});
+
+	// The same work with updating on a thread of its own, one frame ahead of the rendering, as EngineCore::run does now. The ops/s column
+	// ... is frames per second, which should approach one over the slower half's time given two free cores.
+	utils::TripleBuffer<TestFrame> frames;
+	std::atomic<bool> running(true);
+	float updateResult = 0.0f;
+
+	std::thread updateThread([&]() {
+		unsigned long long number = 0;
+
+		while (running)
+		{
+			while (frames.pending() && running)
+				std::this_thread::yield();
+
+			updateResult = work(updateResult, updateWork);
+			doNotOptimize(updateResult);
+			frames.back().fill(++number);
+			frames.publish();
+		}
+	});
+
+	runner.run("pipeline/pipelined", 1, [&]() {
+		while (!frames.consume())
+			std::this_thread::yield();
+
+		results += work(results + (float)frames.front().number, renderWork);
+		doNotOptimize(results);
+	});
+
+	running = false;
+	updateThread.join();
+}
\ No newline at end of file
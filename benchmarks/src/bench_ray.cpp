@@ -0,0 +1,132 @@
+/*!
+ * @file bench_ray.cpp
+ * @brief Benchmarks for the ray intersection kernels.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+
+// Local includes
+
+#include "maths/maths.h"
+#include "maths/simd.h"
+#include "suites.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+using namespace engine::maths;
+
+
+namespace {
+
+	// Count the rays whose batched result doesn't match the single ray result. The FMA kernels may disagree on rays which graze an edge, so
+	// ... distances only need to be close.
+	size_t countMismatches(const std::vector<float>& a, const std::vector<float>& b)
+	{
+		size_t mismatches = 0;
+
+		for (size_t i = 0; i < b.size(); i++)
+		{
+			bool aHit = a[i] != std::numeric_limits<float>::infinity();
+			bool bHit = b[i] != std::numeric_limits<float>::infinity();
+
+			if (aHit != bHit || (bHit && std::fabs(a[i] - b[i]) > 1e-4f * std::fmax(1.0f, std::fabs(b[i]))))
+				mismatches++;
+		}
+
+		return mismatches;
+	}
+
+}
+
+
+void engine::bench::benchRay(Runner& runner)
+{
+	const AABB box(Vec3(-1.0f), Vec3(1.0f));
+	const Sphere sphere(Vec3(0.0f), 1.0f);
+	const Vec3 a(-1.0f, -1.0f, 0.0f), b(1.0f, -1.0f, 0.0f), c(0.0f, 1.0f, 0.0f);
+
+	// Known answers for a ray down -Z through the origin, one starting inside the shapes, and one pointing away from them.
+	const Ray towards(Vec3(0.0f, 0.0f, 10.0f), Vec3(0.0f, 0.0f, -1.0f));
+	const Ray inside(Vec3(0.0f, 0.0f, 0.5f), Vec3(0.0f, 0.0f, -1.0f));
+	const Ray away(Vec3(0.0f, 0.0f, 10.0f), Vec3(0.0f, 0.0f, 1.0f));
+	float tBox = -1.0f, tSphere = -1.0f, tTriangle = -1.0f, tInside = -1.0f, tMiss = -1.0f;
+
+	runner.check("ray/AABB", intersect(towards, box, tBox) && tBox == 9.0f && intersect(inside, box, tInside) && tInside == 0.0f && !intersect(away, box, tMiss));
+	runner.check("ray/sphere", intersect(towards, sphere, tSphere) && tSphere == 9.0f && intersect(inside, sphere, tInside) && tInside == 0.0f && !intersect(away, sphere, tMiss));
+	runner.check("ray/triangle", intersect(towards, a, b, c, tTriangle) && tTriangle == 10.0f && !intersect(away, a, b, c, tMiss) &&
+		!intersect(Ray(Vec3(2.0f, 0.0f, 10.0f), Vec3(0.0f, 0.0f, -1.0f)), a, b, c, tMiss) && tMiss == -1.0f);
+
+	// Rays from a shell around the shapes aimed near the origin, so that roughly half of them hit. The odd count exercises the scalar tail.
+	const size_t count = 65539;
+	std::vector<Ray> rays(count);
+	Vec3Stream origins(count), directions(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		Vec3 origin = normalize(randomVec3(1.0f)) * 10.0f;
+		rays[i] = Ray(origin, normalize(randomVec3(1.5f) - origin));
+		origins.set(i, rays[i].origin());
+		directions.set(i, rays[i].direction());
+	}
+
+	const float infinity = std::numeric_limits<float>::infinity();
+	std::vector<float> expectedBox(count, infinity), expectedSphere(count, infinity), expectedTriangle(count, infinity), t(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		intersect(rays[i], box, expectedBox[i]);
+		intersect(rays[i], sphere, expectedSphere[i]);
+		intersect(rays[i], a, b, c, expectedTriangle[i]);
+	}
+
+	runner.run("ray/AABB one at a time", count, [&]() {
+		float hit = 0.0f;
+		for (size_t i = 0; i < count; i++)
+			intersect(rays[i], box, hit);
+		doNotOptimize(hit);
+	});
+
+	for (int set = simd::SIMD_SCALAR; set <= simd::supportedInstructionSet(); set++)
+	{
+		simd::setInstructionSet((simd::InstructionSet)set);
+		const std::string isa = simd::instructionSetName((simd::InstructionSet)set);
+
+		// Check each kernel against the single ray results before timing it.
+
+		intersect(origins, directions, box, &t[0]);
+		runner.check("ray/AABB stream/" + isa, countMismatches(t, expectedBox) <= count / 10000);
+
+		intersect(origins, directions, sphere, &t[0]);
+		runner.check("ray/sphere stream/" + isa, countMismatches(t, expectedSphere) <= count / 10000);
+
+		intersect(origins, directions, a, b, c, &t[0]);
+		runner.check("ray/triangle stream/" + isa, countMismatches(t, expectedTriangle) <= count / 10000);
+
+		runner.run("ray/AABB stream/" + isa, count, [&]() {
+			intersect(origins, directions, box, &t[0]);
+			doNotOptimize(t[0]);
+		});
+
+		runner.run("ray/sphere stream/" + isa, count, [&]() {
+			intersect(origins, directions, sphere, &t[0]);
+			doNotOptimize(t[0]);
+		});
+
+		runner.run("ray/triangle stream/" + isa, count, [&]() {
+			intersect(origins, directions, a, b, c, &t[0]);
+			doNotOptimize(t[0]);
+		});
+	}
+
+	simd::setInstructionSet(simd::supportedInstructionSet());
+}
\ No newline at end of file
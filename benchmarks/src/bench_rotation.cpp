@@ -0,0 +1,193 @@
+/*!
+ * @file bench_rotation.cpp
+ * @brief Benchmarks for building and composing rotations.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+// Local includes
+
+#include "maths/maths.h"
+#include "maths/simd.h"
+#include "suites.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+using namespace engine::maths;
+
+
+namespace {
+
+	bool sameRotation(const Quat& a, const Quat& b)
+	{
+		// q and -q are the same rotation.
+		return std::fabs(std::fabs(dot(a, b)) - 1.0f) < 1e-5f;
+	}
+
+	// The original implementation of maths::rotation(const Vec3&), kept as the baseline to measure against.
+	Mat4 rotationMatrixProduct(const Vec3& r)
+	{
+		return rotationZ(r.z()) * rotationY(r.y()) * rotationX(r.x());
+	}
+
+}
+
+
+void engine::bench::benchRotation(Runner& runner)
+{
+	const size_t count = 1024;
+
+	std::vector<Vec3> eulers(count);
+	std::vector<Quat> quats(count);
+	std::vector<Mat4> matrices(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		// Keep Y away from +-90 degrees, where Euler angles stop being unique.
+		eulers[i] = Vec3(randomFloat(-180.0f, 180.0f), randomFloat(-85.0f, 85.0f), randomFloat(-180.0f, 180.0f));
+		quats[i] = rotationQuat(eulers[i]);
+	}
+
+	bool matricesMatch = true, eulersRoundTrip = true, matricesRoundTrip = true, vectorsMatch = true;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		Mat4 expected = rotationMatrixProduct(eulers[i]);
+
+		matricesMatch = matricesMatch && nearlyEqual(rotationEuler(eulers[i]), expected, 1e-5f) && nearlyEqual(rotation(quats[i]), expected, 1e-5f);
+		eulersRoundTrip = eulersRoundTrip && sameRotation(rotationQuat(eulerAngles(quats[i])), quats[i]);
+		matricesRoundTrip = matricesRoundTrip && sameRotation(rotationQuat(expected), quats[i]);
+
+		Vec3 v(1.0f, -2.0f, 3.0f);
+		Vec3 a = quats[i] * v;
+		Vec3 b = Vec3(expected * Vec4(v));
+		vectorsMatch = vectorsMatch && (a - b).magnitude() < 1e-4f;
+	}
+
+	runner.check("rotationEuler(Vec3) matches rotationZ * rotationY * rotationX", matricesMatch);
+	runner.check("rotationQuat(eulerAngles(q)) == q", eulersRoundTrip);
+	runner.check("rotationQuat(rotation(r)) == rotationQuat(r)", matricesRoundTrip);
+	runner.check("Quat * Vec3 matches Mat4 * Vec4", vectorsMatch);
+
+	const Quat qa = rotationQuat(Vec3(0.0f, 1.0f, 0.0f), 10.0f);
+	const Quat qb = rotationQuat(Vec3(0.0f, 1.0f, 0.0f), 130.0f);
+	runner.check("slerp endpoints", sameRotation(slerp(qa, qb, 0.0f), qa) && sameRotation(slerp(qa, qb, 1.0f), qb));
+	runner.check("slerp midpoint", sameRotation(slerp(qa, qb, 0.5f), rotationQuat(Vec3(0.0f, 1.0f, 0.0f), 70.0f)));
+
+	runner.run("rotation/Euler via matrix products (original)", count, [&]() {
+		for (size_t i = 0; i < count; i++)
+			matrices[i] = rotationMatrixProduct(eulers[i]);
+		doNotOptimize(matrices[0]);
+	});
+
+	runner.run("rotation/Euler via quaternion", count, [&]() {
+		for (size_t i = 0; i < count; i++)
+			matrices[i] = rotation(rotationQuat(eulers[i]));
+		doNotOptimize(matrices[0]);
+	});
+
+	runner.run("rotation/Euler closed form", count, [&]() {
+		for (size_t i = 0; i < count; i++)
+			matrices[i] = rotationEuler(eulers[i]);
+		doNotOptimize(matrices[0]);
+	});
+
+	runner.run("rotation/Quat to Mat4", count, [&]() {
+		for (size_t i = 0; i < count; i++)
+			matrices[i] = rotation(quats[i]);
+		doNotOptimize(matrices[0]);
+	});
+
+	Quat composed;
+
+	runner.run("rotation/compose Mat4 * Mat4", count - 1, [&]() {
+		Mat4 m;
+		for (size_t i = 0; i + 1 < count; i++)
+			m = matrices[i] * matrices[i + 1];
+		doNotOptimize(m);
+	});
+
+	runner.run("rotation/compose Quat * Quat", count - 1, [&]() {
+		for (size_t i = 0; i + 1 < count; i++)
+			composed = quats[i] * quats[i + 1];
+		doNotOptimize(composed);
+	});
+
+	runner.run("rotation/nlerp", count - 1, [&]() {
+		for (size_t i = 0; i + 1 < count; i++)
+			composed = nlerp(quats[i], quats[i + 1], 0.3f);
+		doNotOptimize(composed);
+	});
+
+	runner.run("rotation/slerp", count - 1, [&]() {
+		for (size_t i = 0; i + 1 < count; i++)
+			composed = slerp(quats[i], quats[i + 1], 0.3f);
+		doNotOptimize(composed);
+	});
+
+	// Bulk sines and cosines, as animation would use them.
+
+	const size_t angleCount = 4099;
+	std::vector<float> angles(angleCount), sines(angleCount), cosines(angleCount);
+
+	for (size_t i = 0; i < angleCount; i++)
+		angles[i] = randomFloat(-2.0f * MATH_PI, 2.0f * MATH_PI);
+
+	runner.run("sincos/std::sin and std::cos", angleCount, [&]() {
+		for (size_t i = 0; i < angleCount; i++)
+		{
+			sines[i] = std::sin(angles[i]);
+			cosines[i] = std::cos(angles[i]);
+		}
+		doNotOptimize(sines[0]);
+		doNotOptimize(cosines[0]);
+	});
+
+	// Measure the error over the whole supported range, including the exact octant boundaries and the range's ends.
+	std::vector<float> errorAngles;
+	for (float a = -8192.0f; a <= 8192.0f; a += 0.0137f)
+		errorAngles.push_back(a);
+	for (int octant = -8; octant <= 8; octant++)
+		errorAngles.push_back(octant * MATH_PI / 4.0f);
+	errorAngles.push_back(0.0f);
+	errorAngles.push_back(-0.0f);
+	errorAngles.push_back(8192.0f);
+
+	std::vector<float> errorSines(errorAngles.size()), errorCosines(errorAngles.size());
+
+	for (int set = simd::SIMD_SCALAR; set <= simd::supportedInstructionSet(); set++)
+	{
+		simd::setInstructionSet((simd::InstructionSet)set);
+		const std::string isa = simd::instructionSetName((simd::InstructionSet)set);
+
+		sinCos(&errorAngles[0], &errorSines[0], &errorCosines[0], errorAngles.size());
+
+		double maxError = 0.0;
+		for (size_t i = 0; i < errorAngles.size(); i++)
+		{
+			maxError = std::fmax(maxError, std::fabs(errorSines[i] - std::sin((double)errorAngles[i])));
+			maxError = std::fmax(maxError, std::fabs(errorCosines[i] - std::cos((double)errorAngles[i])));
+		}
+
+		std::printf("sincos/%s max error vs double precision: %.3g\n", isa.c_str(), maxError);
+		runner.check("sincos/" + isa + " within documented error", maxError <= 1e-7);
+
+		runner.run("sincos/" + isa, angleCount, [&]() {
+			sinCos(&angles[0], &sines[0], &cosines[0], angleCount);
+			doNotOptimize(sines[0]);
+			doNotOptimize(cosines[0]);
+		});
+	}
+
+	simd::setInstructionSet(simd::supportedInstructionSet());
+}
\ No newline at end of file
@@ -0,0 +1,234 @@
+/*!
+ * @file bench_spatial_hash.cpp
+ * @brief Benchmarks for the SpatialHash proximity queries.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <algorithm>
+#include <vector>
+
+
+// Local includes
+
+#include "graphics/scene_3d.h"
+#include "maths/maths.h"
+#include "scene_object.h"
+#include "spatial_hash.h"
+#include "suites.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+using namespace engine::maths;
+
+
+namespace {
+
+	Vec3 worldPosition(const SceneObject* object)
+	{
+		const Mat4& world = object->getComponent<TransformComponent>()->getWorldMatrix();
+		return Vec3(world(3, 0), world(3, 1), world(3, 2));
+	}
+
+	// The handles a query found, sorted so they can be compared with the linear scan's.
+	std::vector<SceneObjectHandle> sorted(const SceneObjectHandle* handles, size_t count)
+	{
+		std::vector<SceneObjectHandle> result(handles, handles + count);
+		std::sort(result.begin(), result.end(), [](const SceneObjectHandle& a, const SceneObjectHandle& b) { return a.index < b.index; });
+		return result;
+	}
+
+	// Searching every SceneObject in the scene, which is all Scene3D::getObjects() allows.
+	size_t queryRadiusLoop(const graphics::Scene3D& scene, const Vec3& centre, float radius, SceneObjectHandle* results, size_t capacity)
+	{
+		size_t found = 0;
+
+		for (auto object : scene.getObjects())
+		{
+			const Vec3 offset = worldPosition(object) - centre;
+
+			if (dot(offset, offset) <= radius * radius)
+			{
+				if (found < capacity)
+					results[found] = object->getHandle();
+
+				found++;
+			}
+		}
+
+		return found;
+	}
+
+	size_t queryBoxLoop(const graphics::Scene3D& scene, const AABB& box, SceneObjectHandle* results, size_t capacity)
+	{
+		size_t found = 0;
+
+		for (auto object : scene.getObjects())
+		{
+			if (box.contains(worldPosition(object)))
+			{
+				if (found < capacity)
+					results[found] = object->getHandle();
+
+				found++;
+			}
+		}
+
+		return found;
+	}
+
+}
+
+
+void engine::bench::benchSpatialHash(Runner& runner)
+{
+	// Agents scattered over a flat world, each sensing the others within a few metres.
+	const size_t count = 20000;
+	const float worldSize = 1000.0f;
+	const float radius = 10.0f;
+
+	graphics::Scene3D scene;
+	SpatialHash hash(radius);
+	std::vector<SceneObjectHandle> handles(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		handles[i] = scene.create();
+		scene.get(handles[i])->getComponent<TransformComponent>()->setPosition(Vec3(randomFloat(0.0f, worldSize), randomFloat(0.0f, 2.0f), randomFloat(0.0f, worldSize)));
+	}
+
+	scene.update();
+
+	for (size_t i = 0; i < count; i++)
+		hash.insert(handles[i], worldPosition(scene.get(handles[i])));
+
+	const size_t capacity = 4096;
+	std::vector<SceneObjectHandle> expected(capacity), results(capacity);
+
+	// Query around a sample of the agents, and a few points between them.
+	const size_t queries = 1000;
+	std::vector<Vec3> centres(queries);
+
+	for (size_t i = 0; i < queries; i++)
+		centres[i] = i % 10 ? worldPosition(scene.get(handles[i * 7])) : Vec3(randomFloat(0.0f, worldSize), 1.0f, randomFloat(0.0f, worldSize));
+
+	auto radiusMatches = [&]() {
+		for (size_t i = 0; i < queries; i++)
+		{
+			size_t expectedCount = queryRadiusLoop(scene, centres[i], radius, &expected[0], capacity);
+			size_t found = hash.queryRadius(centres[i], radius, &results[0], capacity);
+
+			if (found != expectedCount || sorted(&results[0], found) != sorted(&expected[0], expectedCount))
+				return false;
+		}
+
+		return true;
+	};
+
+	bool boxMatches = true;
+	for (size_t i = 0; i < 100; i++)
+	{
+		const AABB box(centres[i] - Vec3(15.0f, 1.0f, 5.0f), centres[i] + Vec3(5.0f, 1.0f, 25.0f));
+		size_t expectedCount = queryBoxLoop(scene, box, &expected[0], capacity);
+		size_t found = hash.queryBox(box, &results[0], capacity);
+
+		boxMatches = boxMatches && found == expectedCount && sorted(&results[0], found) == sorted(&expected[0], expectedCount);
+	}
+
+	runner.check("spatial hash/radius query", radiusMatches());
+	runner.check("spatial hash/box query", boxMatches);
+
+	// A radius bigger than the world checks the whole-grid path, and that a full buffer is reported rather than overrun.
+	SceneObjectHandle few[16];
+	runner.check("spatial hash/capacity", hash.queryRadius(Vec3(worldSize * 0.5f), worldSize * 2.0f, few, 16) == count);
+
+	// The batched query should give each point the same results as querying it alone.
+	std::vector<SceneObjectHandle> batch(queries * 64);
+	std::vector<size_t> offsets(queries + 1);
+	size_t batchFound = hash.queryRadius(&centres[0], queries, radius, &batch[0], batch.size(), &offsets[0]);
+	bool batchMatches = batchFound <= batch.size() && offsets[queries] == batchFound;
+
+	for (size_t i = 0; i < queries && batchMatches; i++)
+	{
+		size_t found = hash.queryRadius(centres[i], radius, &results[0], capacity);
+		batchMatches = sorted(&batch[offsets[i]], offsets[i + 1] - offsets[i]) == sorted(&results[0], found);
+	}
+
+	runner.check("spatial hash/batched query", batchMatches);
+
+	// Move some agents in the scene and follow them with update(), destroy a few, and check the queries still agree with the scene.
+	for (size_t i = 0; i < count; i += 3)
+	{
+		TransformComponent* transform = scene.get(handles[i])->getComponent<TransformComponent>();
+		transform->setPosition(transform->position() + Vec3(randomFloat(-20.0f, 20.0f), 0.0f, randomFloat(-20.0f, 20.0f)));
+	}
+
+	scene.update();
+	hash.update(scene.getHierarchy().moved());
+
+	for (size_t i = 1; i < count; i += 100)
+	{
+		hash.remove(handles[i]);
+		scene.destroy(handles[i]);
+	}
+
+	runner.check("spatial hash/move and remove", radiusMatches() && hash.size() == scene.getObjects().size() && !hash.contains(handles[1]) && !hash.remove(handles[1]));
+
+	runner.run("spatial hash/radius query loop", queries / 100, [&]() {
+		for (size_t i = 0; i < queries / 100; i++)
+			doNotOptimize(queryRadiusLoop(scene, centres[i], radius, &results[0], capacity));
+	});
+
+	runner.run("spatial hash/radius query", queries, [&]() {
+		for (size_t i = 0; i < queries; i++)
+			doNotOptimize(hash.queryRadius(centres[i], radius, &results[0], capacity));
+	});
+
+	// Every agent sensing its neighbours, with the agents in creation order and then sorted in to rows of cells, so that agents in the same
+	// ... cell are queried together.
+	std::vector<Vec3> agents;
+	for (auto object : scene.getObjects())
+		agents.push_back(worldPosition(object));
+
+	std::vector<SceneObjectHandle> neighbours(agents.size() * 64);
+	std::vector<size_t> agentOffsets(agents.size() + 1);
+
+	runner.run("spatial hash/radius query each agent", agents.size(), [&]() {
+		size_t found = 0;
+		for (size_t i = 0; i < agents.size(); i++)
+			found += hash.queryRadius(agents[i], radius, &neighbours[found], neighbours.size() - found);
+		doNotOptimize(found);
+	});
+
+	runner.run("spatial hash/batched query", agents.size(), [&]() {
+		doNotOptimize(hash.queryRadius(&agents[0], agents.size(), radius, &neighbours[0], neighbours.size(), &agentOffsets[0]));
+	});
+
+	std::sort(agents.begin(), agents.end(), [&](const Vec3& a, const Vec3& b) {
+		const int rowA = (int)(a.z() / radius), rowB = (int)(b.z() / radius);
+		return rowA != rowB ? rowA < rowB : a.x() < b.x();
+	});
+
+	runner.run("spatial hash/batched query sorted", agents.size(), [&]() {
+		doNotOptimize(hash.queryRadius(&agents[0], agents.size(), radius, &neighbours[0], neighbours.size(), &agentOffsets[0]));
+	});
+
+	// Agents wandering a little each frame, which mostly keeps them in their cells.
+	std::vector<Vec3> homes(count);
+	for (size_t i = 0; i < count; i++)
+		if (i % 100 != 1)
+			homes[i] = worldPosition(scene.get(handles[i]));
+
+	size_t frame = 0;
+
+	runner.run("spatial hash/move", count, [&]() {
+		const Vec3 step(frame++ % 2 ? 0.5f : -0.5f, 0.0f, 0.0f);
+
+		for (size_t i = 0; i < count; i++)
+			hash.move(handles[i], homes[i] + step);
+	});
+}
\ No newline at end of file
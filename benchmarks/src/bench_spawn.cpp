@@ -0,0 +1,116 @@
+/*!
+ * @file bench_spawn.cpp
+ * @brief Benchmarks for creating and destroying SceneObjects.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <algorithm>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+
+// Local includes
+
+#include "graphics/scene_3d.h"
+#include "scene_object.h"
+#include "suites.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+using namespace engine::maths;
+
+
+namespace {
+
+	// The original SceneObject: allocated on its own, with each component allocated on its own and kept in a map keyed on its type.
+	class HeapSceneObject
+	{
+	public:
+		HeapSceneObject()
+		{
+			m_components[typeid(TransformComponent)] = new TransformComponent(Vec3(), Vec3(1.0f), Vec3());
+		}
+
+		~HeapSceneObject()
+		{
+			for (auto it = m_components.begin(); it != m_components.end(); it++)
+				delete it->second;
+		}
+
+	private:
+		std::unordered_map<std::type_index, Component*> m_components;
+	};
+
+}
+
+
+void engine::bench::benchSpawn(Runner& runner)
+{
+	// A wave of objects spawned and despawned each frame, as with projectiles or particles.
+	const size_t count = 1000;
+
+	graphics::Scene3D scene;
+	std::vector<SceneObjectHandle> handles(count);
+
+	SceneObjectHandle first = scene.create();
+	SceneObject* object = scene.get(first);
+	bool resolves = object && object->getHandle() == first && scene.getObjects().size() == 1;
+	bool destroys = scene.destroy(first) && !scene.get(first) && !scene.destroy(first) && scene.getObjects().empty();
+
+	// The next SceneObject reuses the slot, but the old handle mustn't resolve to it.
+	SceneObjectHandle second = scene.create();
+	runner.check("spawn/handles", resolves && destroys && second.index == first.index && !scene.get(first) && scene.get(second) && !scene.get(SceneObjectHandle()));
+	scene.destroy(second);
+
+	// Destroying a parent makes its children roots.
+	SceneObjectHandle parent = scene.create();
+	SceneObjectHandle child = scene.create();
+	scene.get(child)->setParent(scene.get(parent));
+	scene.destroy(parent);
+	runner.check("spawn/children of destroyed parents", scene.get(child) && !scene.get(child)->getParent());
+	scene.destroy(child);
+
+	std::vector<SceneObject*> spawned(count);
+
+	auto spawnWave = [&]() {
+		for (size_t i = 0; i < count; i++)
+		{
+			handles[i] = scene.create();
+			spawned[i] = scene.get(handles[i]);
+			spawned[i]->getComponent<TransformComponent>()->setPosition(Vec3((float)i, 0.0f, 0.0f));
+		}
+
+		// Despawn in a different order to the spawns, so the free list doesn't hand the slots back in order.
+		for (size_t i = 0; i < count; i += 2)
+			scene.destroy(handles[i]);
+		for (size_t i = 1; i < count; i += 2)
+			scene.destroy(handles[count - i]);
+	};
+
+	// After one wave the pool has room for the next, so the next wave should reuse exactly the same SceneObjects' memory.
+	spawnWave();
+	std::vector<SceneObject*> firstWave = spawned;
+	spawnWave();
+	std::vector<SceneObject*> secondWave = spawned;
+	std::sort(firstWave.begin(), firstWave.end());
+	std::sort(secondWave.begin(), secondWave.end());
+	runner.check("spawn/slots reused", firstWave == secondWave && scene.getObjects().empty());
+
+	std::vector<HeapSceneObject*> objects(count);
+
+	runner.run("spawn/new and delete", count, [&]() {
+		for (size_t i = 0; i < count; i++)
+			objects[i] = new HeapSceneObject();
+		for (size_t i = 0; i < count; i++)
+			delete objects[i];
+		doNotOptimize(objects[0]);
+	});
+
+	runner.run("spawn/create and destroy", count, spawnWave);
+}
\ No newline at end of file
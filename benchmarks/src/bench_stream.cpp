@@ -0,0 +1,227 @@
+/*!
+ * @file bench_stream.cpp
+ * @brief Benchmarks for the structure-of-arrays vector streams.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+
+// Local includes
+
+#include "maths/maths.h"
+#include "maths/simd.h"
+#include "suites.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+using namespace engine::maths;
+
+
+namespace {
+
+	// The random components are up to 100, so the products in dot() and cross() are up to 1e4. When those terms cancel, the FMA kernels' different
+	// ... rounding shows up relative to the terms rather than the result, hence a minimum scale.
+	const float productScale = 1e4f;
+
+	// Loose enough to allow for FMA kernels rounding differently.
+	const float tolerance = 1e-4f;
+
+	bool nearlyEqual(const Vec3Stream& a, const std::vector<Vec3>& b, float minScale = 1.0f)
+	{
+		if (a.size() != b.size())
+			return false;
+
+		for (size_t i = 0; i < b.size(); i++)
+			if (!bench::nearlyEqual(a.x()[i], b[i].x(), tolerance, minScale) || !bench::nearlyEqual(a.y()[i], b[i].y(), tolerance, minScale) || !bench::nearlyEqual(a.z()[i], b[i].z(), tolerance, minScale))
+				return false;
+
+		return true;
+	}
+
+	bool nearlyEqual(const Vec4Stream& a, const std::vector<Vec4>& b, float minScale = 1.0f)
+	{
+		if (a.size() != b.size())
+			return false;
+
+		for (size_t i = 0; i < b.size(); i++)
+			if (!bench::nearlyEqual(a.x()[i], b[i].x(), tolerance, minScale) || !bench::nearlyEqual(a.y()[i], b[i].y(), tolerance, minScale) || !bench::nearlyEqual(a.z()[i], b[i].z(), tolerance, minScale) || !bench::nearlyEqual(a.w()[i], b[i].w(), tolerance))
+				return false;
+
+		return true;
+	}
+
+	bool nearlyEqual(const std::vector<float>& a, const std::vector<float>& b, float minScale = 1.0f)
+	{
+		for (size_t i = 0; i < b.size(); i++)
+			if (!bench::nearlyEqual(a[i], b[i], tolerance, minScale))
+				return false;
+
+		return true;
+	}
+
+	void benchCount(Runner& runner, size_t count)
+	{
+		const std::string suffix = " (n=" + std::to_string(count) + ")";
+		const float dt = 1.0f / 60.0f;
+
+		std::vector<Vec3> a(count), b(count), out(count);
+		std::vector<Vec4> a4(count), b4(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			a[i] = randomVec3(100.0f);
+			b[i] = randomVec3(100.0f);
+			a4[i] = randomVec4(100.0f);
+			b4[i] = randomVec4(100.0f);
+		}
+
+		const Vec3Stream streamA(a), streamB(b);
+		const Vec4Stream streamA4(a4), streamB4(b4);
+		Vec3Stream streamOut;
+		Vec4Stream streamOut4;
+
+		bool roundTrips = streamA.size() == count && streamA4.size() == count;
+		const std::vector<Vec3> copyA = streamA.toVector();
+		const std::vector<Vec4> copyA4 = streamA4.toVector();
+		for (size_t i = 0; i < count; i++)
+			roundTrips = roundTrips && copyA[i] == a[i] && copyA4[i] == a4[i];
+		runner.check("stream/round trip" + suffix, roundTrips);
+
+		bool aligned = true;
+		for (int c = 0; c < 3; c++)
+			aligned = aligned && reinterpret_cast<size_t>(streamA.components()[c]) % ENGINE_SIMD_ALIGNMENT == 0;
+		for (int c = 0; c < 4; c++)
+			aligned = aligned && reinterpret_cast<size_t>(streamA4.components()[c]) % ENGINE_SIMD_ALIGNMENT == 0;
+		runner.check("stream/aligned" + suffix, aligned);
+
+		// The expected results, computed one Vec3/Vec4 at a time.
+
+		std::vector<Vec3> expectedAdd(count), expectedSubtract(count), expectedMultiply(count), expectedIntegrate(count), expectedNormalize(count), expectedCross(count);
+		std::vector<Vec4> expectedAdd4(count), expectedNormalize4(count);
+		std::vector<float> expectedDot(count), expectedLength(count), expectedDot4(count), results(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			expectedAdd[i] = a[i] + b[i];
+			expectedSubtract[i] = a[i] - b[i];
+			expectedMultiply[i] = Vec3(a[i].x() * b[i].x(), a[i].y() * b[i].y(), a[i].z() * b[i].z());
+			expectedIntegrate[i] = b[i] + a[i] * dt;
+			expectedNormalize[i] = normalize(a[i]);
+			expectedCross[i] = cross(a[i], b[i]);
+			expectedDot[i] = dot(a[i], b[i]);
+			expectedLength[i] = a[i].magnitude();
+			expectedAdd4[i] = a4[i] + b4[i];
+			expectedNormalize4[i] = normalize(a4[i]);
+			expectedDot4[i] = a4[i].x() * b4[i].x() + a4[i].y() * b4[i].y() + a4[i].z() * b4[i].z() + a4[i].w() * b4[i].w();
+		}
+
+		// The AoS baselines.
+
+		runner.run("stream/integrate Vec3 loop" + suffix, count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out[i] = b[i] + a[i] * dt;
+			doNotOptimize(out[0]);
+		});
+
+		runner.run("stream/normalize Vec3 loop" + suffix, count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out[i] = normalize(a[i]);
+			doNotOptimize(out[0]);
+		});
+
+		runner.run("stream/cross Vec3 loop" + suffix, count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out[i] = cross(a[i], b[i]);
+			doNotOptimize(out[0]);
+		});
+
+		runner.run("stream/dot Vec3 loop" + suffix, count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				results[i] = dot(a[i], b[i]);
+			doNotOptimize(results[0]);
+		});
+
+		for (int set = simd::SIMD_SCALAR; set <= simd::supportedInstructionSet(); set++)
+		{
+			simd::setInstructionSet((simd::InstructionSet)set);
+			const std::string isa = simd::instructionSetName((simd::InstructionSet)set);
+
+			// Check each kernel against the one-at-a-time results before timing it.
+
+			add(streamA, streamB, streamOut);
+			runner.check("stream/add/" + isa + suffix, nearlyEqual(streamOut, expectedAdd));
+
+			subtract(streamA, streamB, streamOut);
+			runner.check("stream/subtract/" + isa + suffix, nearlyEqual(streamOut, expectedSubtract));
+
+			multiply(streamA, streamB, streamOut);
+			runner.check("stream/multiply/" + isa + suffix, nearlyEqual(streamOut, expectedMultiply));
+
+			multiplyAdd(streamA, dt, streamB, streamOut);
+			bool integrates = nearlyEqual(streamOut, expectedIntegrate);
+			multiply(streamA, dt, streamOut);
+			multiplyAdd(streamOut, Vec3Stream(std::vector<Vec3>(count, Vec3(1.0f))), streamB, streamOut);
+			runner.check("stream/multiplyAdd/" + isa + suffix, integrates && nearlyEqual(streamOut, expectedIntegrate));
+
+			normalize(streamA, streamOut);
+			runner.check("stream/normalize/" + isa + suffix, nearlyEqual(streamOut, expectedNormalize));
+
+			cross(streamA, streamB, streamOut);
+			runner.check("stream/cross/" + isa + suffix, nearlyEqual(streamOut, expectedCross, productScale));
+
+			dot(streamA, streamB, &results[0]);
+			bool dots = nearlyEqual(results, expectedDot, productScale);
+			length(streamA, &results[0]);
+			runner.check("stream/dot and length/" + isa + suffix, dots && nearlyEqual(results, expectedLength));
+
+			add(streamA4, streamB4, streamOut4);
+			bool adds4 = nearlyEqual(streamOut4, expectedAdd4);
+			normalize(streamA4, streamOut4);
+			bool normalizes4 = nearlyEqual(streamOut4, expectedNormalize4);
+			dot(streamA4, streamB4, &results[0]);
+			runner.check("stream/Vec4Stream/" + isa + suffix, adds4 && normalizes4 && nearlyEqual(results, expectedDot4, productScale));
+
+			// Integrate in place, as a particle system would.
+			Vec3Stream positions(streamB);
+
+			runner.run("stream/integrate SoA/" + isa + suffix, count, [&]() {
+				multiplyAdd(streamA, dt, positions, positions);
+				doNotOptimize(positions.x()[0]);
+			});
+
+			runner.run("stream/normalize SoA/" + isa + suffix, count, [&]() {
+				normalize(streamA, streamOut);
+				doNotOptimize(streamOut.x()[0]);
+			});
+
+			runner.run("stream/cross SoA/" + isa + suffix, count, [&]() {
+				cross(streamA, streamB, streamOut);
+				doNotOptimize(streamOut.x()[0]);
+			});
+
+			runner.run("stream/dot SoA/" + isa + suffix, count, [&]() {
+				dot(streamA, streamB, &results[0]);
+				doNotOptimize(results[0]);
+			});
+		}
+
+		simd::setInstructionSet(simd::supportedInstructionSet());
+	}
+
+}
+
+
+void engine::bench::benchStream(Runner& runner)
+{
+	// One size that sits in cache and one that streams from memory. The odd count exercises the scalar tail.
+	benchCount(runner, 4099);
+	benchCount(runner, 1 << 20);
+}
\ No newline at end of file
@@ -0,0 +1,225 @@
+/*!
+ * @file bench_systems.cpp
+ * @brief Benchmarks for running a scene's Systems with the SystemScheduler.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// Local includes
+
+#include "graphics/scene_3d.h"
+#include "bounds_component.h"
+#include "scene_object.h"
+#include "suites.h"
+#include "system.h"
+#include "utils/thread_pool.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+using namespace engine::maths;
+
+
+namespace {
+
+	// Counts the Systems reading and writing each component type at once, to catch the scheduler running Systems which conflict together.
+	struct AccessMonitor
+	{
+		std::atomic<int> readers[COMPONENT_TYPES_COUNT];
+		std::atomic<int> writers[COMPONENT_TYPES_COUNT];
+		std::atomic<bool> clashed;
+
+		AccessMonitor()
+			: clashed(false)
+		{
+			for (int type = 0; type < COMPONENT_TYPES_COUNT; type++)
+			{
+				readers[type] = 0;
+				writers[type] = 0;
+			}
+		}
+	};
+
+	// A System which does a fixed amount of arithmetic of its own, standing in for a game system's work, while reporting the component
+	// ... types it declared to an AccessMonitor.
+	class WorkSystem : public System
+	{
+	public:
+		WorkSystem(ComponentMask reads, ComponentMask writes, size_t iterations, AccessMonitor& monitor)
+			: System("work", reads, writes), m_iterations(iterations), m_monitor(monitor), m_result(1.0f) { }
+
+		void update(graphics::Scene3D& scene, float deltaTime) override
+		{
+			for (int type = 0; type < COMPONENT_TYPES_COUNT; type++)
+			{
+				if (writes() & (ComponentMask(1) << type))
+				{
+					if (m_monitor.writers[type]++ != 0 || m_monitor.readers[type] != 0)
+						m_monitor.clashed = true;
+				}
+				else if (reads() & (ComponentMask(1) << type))
+				{
+					m_monitor.readers[type]++;
+					if (m_monitor.writers[type] != 0)
+						m_monitor.clashed = true;
+				}
+			}
+
+			float value = m_result;
+			for (size_t i = 0; i < m_iterations; i++)
+				value = std::sqrt(value * value + (float)i) * 0.5f;
+			m_result = value;
+
+			for (int type = 0; type < COMPONENT_TYPES_COUNT; type++)
+			{
+				if (writes() & (ComponentMask(1) << type))
+					m_monitor.writers[type]--;
+				else if (reads() & (ComponentMask(1) << type))
+					m_monitor.readers[type]--;
+			}
+		}
+
+		float result() const
+		{
+			return m_result;
+		}
+
+	private:
+		size_t m_iterations;
+		AccessMonitor& m_monitor;
+		float m_result;
+	};
+
+	// A System which appends a digit to the X position of every transform, so that the positions show the order the Systems ran in.
+	class DigitSystem : public System
+	{
+	public:
+		explicit DigitSystem(float digit)
+			: System("digit", 0, componentMask<TransformComponent>()), m_digit(digit) { }
+
+		void update(graphics::Scene3D& scene, float deltaTime) override
+		{
+			scene.each<TransformComponent>([this](TransformComponent& transform) {
+				transform.setPosition(Vec3(transform.position().x() * 10.0f + m_digit, 0.0f, 0.0f));
+			});
+		}
+
+	private:
+		float m_digit;
+	};
+
+}
+
+
+void engine::bench::benchSystems(Runner& runner)
+{
+	const ComponentMask transform = componentMask<TransformComponent>();
+	const ComponentMask bounds = componentMask<BoundsComponent>();
+	const ComponentMask mesh = ComponentMask(1) << COMPONENT_MESH;
+
+	const unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	// Conflicting Systems must run in the order they were added, and the scene's transforms must be updated after them.
+	{
+		graphics::Scene3D scene;
+		const SceneObjectHandle handle = scene.create();
+
+		scene.getSystems().add(new DigitSystem(1.0f));
+		scene.getSystems().add(new DigitSystem(2.0f));
+		scene.getSystems().add(new DigitSystem(3.0f));
+
+		utils::ThreadPool threadPool(std::max(4u, maxThreads));
+		scene.update(0.0f, &threadPool);
+
+		const TransformComponent* updated = scene.get(handle)->getComponent<TransformComponent>();
+		runner.check("systems/order", updated->position().x() == 123.0f && updated->getWorldMatrix()(3, 0) == 123.0f);
+	}
+
+	// A mix of Systems, some of which conflict, checked for running conflicting Systems together with more threads than there are cores.
+	{
+		graphics::Scene3D scene;
+		AccessMonitor monitor;
+		const ComponentMask masks[][2] = {
+			{ transform, 0 }, { transform, 0 }, { 0, transform }, { transform | bounds, mesh }, { 0, bounds },
+			{ mesh, 0 }, { transform, bounds }, { 0, 0 }, { 0, transform | mesh }, { bounds, 0 }
+		};
+
+		for (size_t i = 0; i < sizeof(masks) / sizeof(masks[0]); i++)
+			scene.getSystems().add(new WorkSystem(masks[i][0], masks[i][1], 2000, monitor));
+
+		utils::ThreadPool threadPool(std::max(4u, maxThreads));
+		for (int frame = 0; frame < 200; frame++)
+			scene.update(0.0f, &threadPool);
+
+		// Removing a System leaves the rest to run as before.
+		const bool removed = scene.getSystems().remove(scene.getSystems().get(3)) && !scene.getSystems().remove(nullptr) && scene.getSystems().size() == 9;
+		scene.update(0.0f, &threadPool);
+
+		runner.check("systems/conflicts", !monitor.clashed && removed);
+	}
+
+	// Sixteen independent Systems of a few tens of microseconds each, for each number of threads up to the hardware's. Only reading the same
+	// ... components doesn't make Systems conflict.
+	const size_t systemCount = 16;
+	graphics::Scene3D scene;
+	AccessMonitor monitor;
+
+	for (size_t i = 0; i < systemCount; i++)
+		scene.getSystems().add(new WorkSystem(transform, 0, 2000, monitor));
+
+	const double serialTime = runner.run("systems/independent/one after another", systemCount, [&]() {
+		scene.update();
+	}).nsPerOp();
+
+	std::vector<unsigned int> threadCounts;
+	for (unsigned int threads = 1; threads < maxThreads; threads *= 2)
+		threadCounts.push_back(threads);
+	threadCounts.push_back(maxThreads);
+
+	for (auto threads : threadCounts)
+	{
+		utils::ThreadPool threadPool(threads);
+
+		const std::string name = "systems/independent/threads=" + std::to_string(threads);
+		const double threadedTime = runner.run(name, systemCount, [&]() {
+			scene.update(0.0f, &threadPool);
+		}).nsPerOp();
+
+		// The speedup over running the Systems one after another, which is at most the number of threads while there are enough cores.
+		char speedup[32];
+		std::snprintf(speedup, sizeof(speedup), "%.2f", serialTime / threadedTime);
+		std::printf("%s speedup: %sx (%u hardware threads)\n", name.c_str(), speedup, maxThreads);
+		runner.addContext(name + "/speedup", speedup);
+	}
+
+	// The same Systems all writing transforms, which the scheduler has to run one after another however many threads there are.
+	graphics::Scene3D chainScene;
+
+	for (size_t i = 0; i < systemCount; i++)
+		chainScene.getSystems().add(new WorkSystem(0, transform, 2000, monitor));
+
+	utils::ThreadPool threadPool(maxThreads);
+
+	runner.run("systems/conflicting/threads=" + std::to_string(maxThreads), systemCount, [&]() {
+		chainScene.update(0.0f, &threadPool);
+	});
+
+	float results = 0.0f;
+	for (size_t i = 0; i < systemCount; i++)
+		results += static_cast<const WorkSystem*>(scene.getSystems().get(i))->result();
+	doNotOptimize(results);
+
+	runner.check("systems/independent", !monitor.clashed);
+}
\ No newline at end of file
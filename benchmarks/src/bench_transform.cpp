@@ -0,0 +1,117 @@
+/*!
+ * @file bench_transform.cpp
+ * @brief Benchmarks for the batched point and direction transforms.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+
+// Local includes
+
+#include "maths/maths.h"
+#include "maths/simd.h"
+#include "suites.h"
+
+
+// Namespaces
+
+using namespace engine;
+using namespace engine::bench;
+using namespace engine::maths;
+
+
+namespace {
+
+	// Loose enough to allow for FMA kernels rounding differently when terms cancel.
+	const float tolerance = 1e-4f;
+
+	bool nearlyEqual(const std::vector<maths::Vec3>& a, const std::vector<maths::Vec3>& b)
+	{
+		for (size_t i = 0; i < a.size(); i++)
+			if (!bench::nearlyEqual(a[i], b[i], tolerance))
+				return false;
+
+		return true;
+	}
+
+	void benchCount(Runner& runner, size_t count)
+	{
+		const maths::Mat4 m = maths::translation(maths::Vec3(1.0f, -2.0f, 3.0f)) * maths::rotation(maths::Vec3(30.0f, 45.0f, 60.0f)) * maths::scale(maths::Vec3(2.0f));
+		const std::string suffix = " (n=" + std::to_string(count) + ")";
+
+		std::vector<maths::Vec3> in(count);
+		std::vector<float> inX(count), inY(count), inZ(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			in[i] = maths::Vec3(randomFloat(-100.0f, 100.0f), randomFloat(-100.0f, 100.0f), randomFloat(-100.0f, 100.0f));
+			inX[i] = in[i].x();
+			inY[i] = in[i].y();
+			inZ[i] = in[i].z();
+		}
+
+		std::vector<maths::Vec3> out(count), expectedPoints(count), expectedDirections(count);
+		std::vector<float> outX(count), outY(count), outZ(count);
+
+		// The old way: one Mat4 * Vec4 at a time.
+		runner.run("transform/Mat4*Vec4 loop" + suffix, count, [&]() {
+			for (size_t i = 0; i < count; i++)
+				out[i] = maths::Vec3(m * maths::Vec4(in[i]));
+			doNotOptimize(out[0]);
+		});
+
+		simd::transformVec3_scalar(m.data_ptr(), &in[0].x(), &expectedPoints[0].x(), count, 1.0f);
+		simd::transformVec3_scalar(m.data_ptr(), &in[0].x(), &expectedDirections[0].x(), count, 0.0f);
+
+		for (int set = simd::SIMD_SCALAR; set <= simd::supportedInstructionSet(); set++)
+		{
+			simd::setInstructionSet((simd::InstructionSet)set);
+			const std::string isa = simd::instructionSetName((simd::InstructionSet)set);
+
+			// Check each kernel against the scalar reference before timing it.
+
+			maths::transformPoints(m, &in[0], &out[0], count);
+			runner.check("transformPoints/" + isa + suffix, nearlyEqual(out, expectedPoints));
+
+			maths::transformDirections(m, &in[0], &out[0], count);
+			runner.check("transformDirections/" + isa + suffix, nearlyEqual(out, expectedDirections));
+
+			maths::transformPoints(m, &inX[0], &inY[0], &inZ[0], &outX[0], &outY[0], &outZ[0], count);
+			bool soaMatches = true;
+			for (size_t i = 0; i < count; i++)
+				soaMatches = soaMatches && bench::nearlyEqual(maths::Vec3(outX[i], outY[i], outZ[i]), expectedPoints[i], tolerance);
+			runner.check("transformPoints SoA/" + isa + suffix, soaMatches);
+
+			runner.run("transformPoints/" + isa + suffix, count, [&]() {
+				maths::transformPoints(m, &in[0], &out[0], count);
+				doNotOptimize(out[0]);
+			});
+
+			runner.run("transformDirections/" + isa + suffix, count, [&]() {
+				maths::transformDirections(m, &in[0], &out[0], count);
+				doNotOptimize(out[0]);
+			});
+
+			runner.run("transformPoints SoA/" + isa + suffix, count, [&]() {
+				maths::transformPoints(m, &inX[0], &inY[0], &inZ[0], &outX[0], &outY[0], &outZ[0], count);
+				doNotOptimize(outX[0]);
+			});
+		}
+
+		simd::setInstructionSet(simd::supportedInstructionSet());
+	}
+
+}
+
+
+void engine::bench::benchTransform(Runner& runner)
+{
+	// One size that sits in cache and one that streams from memory. The odd count exercises the scalar tail.
+	benchCount(runner, 4099);
+	benchCount(runner, 1 << 20);
+}
\ No newline at end of file
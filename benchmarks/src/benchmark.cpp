@@ -0,0 +1,132 @@
+/*!
+ * @file benchmark.cpp
+ * @brief Implementation file for the Benchmark runner.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <cstdio>
+#include <fstream>
+
+
+// Local includes
+
+#include "benchmark.h"
+
+
+// Namespaces
+
+using namespace engine::bench;
+
+
+namespace {
+
+	// Quote a string for JSON. Benchmark names are plain ASCII, so only quotes, backslashes, and control characters need escaping.
+	std::string jsonString(const std::string& str)
+	{
+		std::string quoted = "\"";
+
+		for (size_t i = 0; i < str.size(); i++)
+		{
+			char c = str[i];
+
+			if (c == '"' || c == '\\')
+			{
+				quoted += '\\';
+				quoted += c;
+			}
+			else if ((unsigned char)c < 0x20)
+			{
+				char escaped[8];
+				std::snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char)c);
+				quoted += escaped;
+			}
+			else
+				quoted += c;
+		}
+
+		return quoted + "\"";
+	}
+
+}
+
+
+// Global variables
+
+const void* volatile engine::bench::g_sink = nullptr;
+
+
+double Result::nsPerOp() const
+{
+	return ops ? seconds * 1e9 / ops : 0.0;
+}
+
+double Result::opsPerSecond() const
+{
+	return seconds > 0.0 ? ops / seconds : 0.0;
+}
+
+Runner::Runner(double minSeconds)
+	: m_minSeconds(minSeconds), m_failures(0) { }
+
+bool Runner::check(const std::string& name, bool passed)
+{
+	if (!passed)
+	{
+		std::printf("CHECK FAILED: %s\n", name.c_str());
+		m_failures++;
+	}
+
+	return passed;
+}
+
+const std::vector<Result>& Runner::results() const
+{
+	return m_results;
+}
+
+int Runner::failures() const
+{
+	return m_failures;
+}
+
+void Runner::addContext(const std::string& key, const std::string& value)
+{
+	m_context.push_back(std::make_pair(key, value));
+}
+
+bool Runner::writeJson(const std::string& path) const
+{
+	std::ofstream file(path);
+	if (!file)
+		return false;
+
+	file << "{\n\t\"context\": {";
+
+	for (size_t i = 0; i < m_context.size(); i++)
+		file << (i ? ",\n\t\t" : "\n\t\t") << jsonString(m_context[i].first) << ": " << jsonString(m_context[i].second);
+
+	file << "\n\t},\n\t\"failures\": " << m_failures << ",\n\t\"results\": [";
+
+	char line[128];
+	for (size_t i = 0; i < m_results.size(); i++)
+	{
+		const Result& result = m_results[i];
+		std::snprintf(line, sizeof(line), ", \"ops\": %llu, \"seconds\": %.6f, \"nsPerOp\": %.3f, \"opsPerSecond\": %.0f }",
+			result.ops, result.seconds, result.nsPerOp(), result.opsPerSecond());
+
+		file << (i ? ",\n\t\t" : "\n\t\t") << "{ \"name\": " << jsonString(result.name) << line;
+	}
+
+	file << "\n\t]\n}\n";
+	return file.good();
+}
+
+const Result& Runner::record(const Result& result)
+{
+	std::printf("%-56s %12.3f ns/op %16.0f ops/s\n", result.name.c_str(), result.nsPerOp(), result.opsPerSecond());
+
+	m_results.push_back(result);
+	return m_results.back();
+}
\ No newline at end of file
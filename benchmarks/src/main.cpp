@@ -0,0 +1,89 @@
+/*!
+ * @file main.cpp
+ * @brief Entry point for the engine's microbenchmarks.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+
+// Local includes
+
+#include "maths/maths.h"
+#include "maths/simd.h"
+#include "suites.h"
+
+
+// Application entry point
+/*! Usage: benchmarks [--json <file>] [--min-time <seconds>]
+  * --json writes every result to @c file as well as printing it, so that runs before and after a change can be diffed.
+  * --min-time sets how long each benchmark is timed for; the default is 0.25 seconds. */
+int main(int argc, char** argv)
+{
+	using namespace engine;
+
+	const char* jsonPath = nullptr;
+	double minSeconds = 0.25;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+			jsonPath = argv[++i];
+		else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+			minSeconds = std::atof(argv[++i]);
+		else
+		{
+			std::printf("Usage: %s [--json <file>] [--min-time <seconds>]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	const char* isa = maths::simd::instructionSetName(maths::simd::supportedInstructionSet());
+#ifdef ENGINE_MATHS_OUT_OF_LINE
+	const char* build = "out-of-line";
+#else
+	const char* build = "inline";
+#endif
+
+	std::printf("Best supported instruction set: %s\n", isa);
+	std::printf("Maths build: %s\n\n", build);
+
+	bench::Runner runner(minSeconds);
+	runner.addContext("instructionSet", isa);
+	runner.addContext("mathsBuild", build);
+
+	bench::benchArithmetic(runner);
+	bench::benchInverse(runner);
+	bench::benchTransform(runner);
+	bench::benchCamera(runner);
+	bench::benchRotation(runner);
+	bench::benchStream(runner);
+	bench::benchFrustum(runner);
+	bench::benchRay(runner);
+	bench::benchComponents(runner);
+	bench::benchHierarchy(runner);
+	bench::benchSpawn(runner);
+	bench::benchBVH(runner);
+	bench::benchSpatialHash(runner);
+	bench::benchSystems(runner);
+	bench::benchPipeline(runner);
+
+	if (jsonPath && !runner.writeJson(jsonPath))
+	{
+		std::printf("\nCouldn't write %s.\n", jsonPath);
+		return 1;
+	}
+
+	if (runner.failures())
+	{
+		std::printf("\n%i check(s) failed.\n", runner.failures());
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
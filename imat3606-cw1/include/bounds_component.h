@@ -0,0 +1,41 @@
+#pragma once
+
+/*! @file bounds_component.h
+  * @brief Header file for BoundsComponent class.
+  * @author George McDonagh */
+
+
+// Internal includes
+
+#include "maths/maths.h"
+#include "component.h"
+
+
+// Namespaces
+
+namespace engine {
+
+	//! A SceneObject component holding a box around the SceneObject, for finding it with spatial queries.
+	/*! SceneObjects with both a BoundsComponent and a TransformComponent are put in their scene's SceneBVH, which transforms the box by the
+	  * world matrix. The SceneBVH reads the box when the SceneObject is added to it and whenever the SceneObject moves. */
+	class BoundsComponent : public Component
+	{
+	public:
+		static const ComponentType TYPE = COMPONENT_BOUNDS; /*!< The ComponentType of BoundsComponents. */
+
+		//! BoundsComponent constructor.
+		/*! @param bounds The box around the SceneObject, relative to its transform. */
+		explicit BoundsComponent(const maths::AABB& bounds);
+
+		//! BoundsComponent destructor.
+		~BoundsComponent() override;
+
+		//! Get the BoundsComponent's box.
+		/*! @return A reference to the immutable box around the SceneObject, relative to its transform. */
+		const maths::AABB& bounds() const;
+
+	private:
+		maths::AABB m_bounds; /*!< The box around the SceneObject, relative to its transform. */
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,229 @@
+#pragma once
+
+/*!
+  * @file cell_streamer.h
+  * @brief Header file for the CellStreamer class and the cell data it streams.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+// Internal includes
+
+#include "graphics/mesh.h"
+#include "maths/maths.h"
+#include "scene_object.h"
+
+
+// Namespaces
+
+namespace engine {
+
+	namespace graphics { class Scene3D; }
+
+	//! A SceneObject as stored in a cell's file.
+	struct CellObject
+	{
+		maths::Vec3 position; /*!< The TransformComponent's position. */
+		maths::Vec3 scale; /*!< The TransformComponent's scale. */
+		maths::Vec3 orientation; /*!< The TransformComponent's orientation, in Euler angles. */
+		std::string mesh; /*!< The filepath of the MeshComponent's mesh, or empty if the object has no MeshComponent. */
+		std::vector<std::pair<std::string, float>> lods; /*!< The filepath and screen size of each of the MeshComponent's coarser levels of detail. */
+		bool hasBounds; /*!< Whether the object has a BoundsComponent. */
+		maths::AABB bounds; /*!< The BoundsComponent's bounds. */
+		int parent; /*!< The index of the object's parent in the same cell, or -1 if it is a root. */
+	};
+
+	//! A cell in a CellIndex.
+	struct CellInfo
+	{
+		int x; /*!< The cell's column along the X axis. The cell covers X from @c x * cell size to (@c x + 1) * cell size. */
+		int z; /*!< The cell's row along the Z axis. */
+		std::string filepath; /*!< The filepath of the cell's file. */
+		size_t bytes; /*!< The number of bytes the cell's meshes are expected to take, counting meshes shared with other cells in full. */
+	};
+
+	//! The cells a scene has been partitioned in to.
+	/*! Cells are squares on the XZ plane, each of whose SceneObjects are stored in a file of its own. */
+	struct CellIndex
+	{
+		float cellSize; /*!< The length of each cell's sides. */
+		std::vector<CellInfo> cells; /*!< The cells. Cells with no SceneObjects needn't be listed. */
+	};
+
+	//! Streams the cells of a partitioned scene in and out of a Scene3D as the camera moves.
+	/*! Cells within the load radius of the camera are loaded, nearest first, and cells beyond the unload radius are evicted, destroying their
+	  * SceneObjects and releasing any meshes no other loaded cell uses. Nothing is loaded while the cells already loaded or loading are
+	  * expected to take more than the memory budget; loaded cells beyond the load radius are evicted, farthest first, to make room for nearer
+	  * ones.
+	  *
+	  * Loading never blocks a frame. A thread of the CellStreamer's own reads each cell's file and imports its new meshes, the render thread
+	  * creates the meshes' OpenGL objects one cell per uploadMeshes(), and the next update() adds the cell's SceneObjects to the scene. */
+	class CellStreamer
+	{
+	public:
+		//! CellStreamer constructor. Starts the loading thread.
+		/*! @param index The cells to stream. */
+		explicit CellStreamer(const CellIndex& index);
+
+		//! CellStreamer destructor. Stops the loading thread and destroys every mesh it has loaded.
+		~CellStreamer();
+
+		CellStreamer(const CellStreamer&) = delete;
+
+		CellStreamer& operator=(const CellStreamer&) = delete;
+
+		//! Set how far from the camera cells are loaded and evicted.
+		/*! Distances are from the camera to the nearest point of each cell, on the XZ plane.
+		  * @param loadRadius Cells nearer than this are loaded.
+		  * @param unloadRadius Cells farther than this are evicted. At least @p loadRadius, so that cells near the edge don't load and evict
+		  * over and over as the camera moves back and forth. */
+		void setRadii(float loadRadius, float unloadRadius);
+
+		//! Set how much memory loaded cells may take.
+		/*! @param bytes The most bytes the loaded and loading cells are expected to take, going by CellInfo::bytes, or 0 for no limit. */
+		void setMemoryBudget(size_t bytes);
+
+		//! Add loaded cells to the scene, evict cells out of range, and start loading cells in range.
+		/*! Call once a frame before updating the scene, on the thread updating it, which must be the only thread touching the scene.
+		  * @param scene The scene to stream the cells in to.
+		  * @param position The camera's position. */
+		void update(graphics::Scene3D& scene, const maths::Vec3& position);
+
+		//! Create the OpenGL objects of the next loading cell's meshes, and destroy the meshes of evicted cells.
+		/*! Must be called once a frame on the thread with the OpenGL context. With a separate update thread, call it after the frame has been
+		  * drawn, as the frame may have been prepared before the meshes' cells were evicted. */
+		void uploadMeshes();
+
+		//! Evict every loaded cell from the scene, and stop the rest loading.
+		/*! For when the scene stops being streamed. Cells the loading thread has already taken are never added to the scene, as long as
+		  * update() isn't called again. Their meshes, and those of the evicted cells, are destroyed by the destructor if not by uploadMeshes().
+		  * Only call on the thread updating the scene.
+		  * @param scene The scene the cells were streamed in to. */
+		void evictAll(graphics::Scene3D& scene);
+
+		//! Get the number of loaded cells.
+		/*! Only call on the thread updating the scene.
+		  * @return The number of cells whose SceneObjects are in the scene. */
+		size_t residentCells() const;
+
+		//! Get the number of cells being loaded.
+		/*! Only call on the thread updating the scene.
+		  * @return The number of cells which have been asked for and are yet to be added to the scene. */
+		size_t loadingCells() const;
+
+		//! Get the memory taken by the cells' meshes.
+		/*! @return The number of bytes of vertex and index data in every loaded mesh. */
+		size_t residentBytes() const;
+
+		//! List the meshes used by SceneObjects read from a cell or scene file.
+		/*! @param objects The SceneObjects.
+		  * @param filepaths The vector to fill with the filepath of every mesh and level of detail the objects use, each once, sorted. */
+		static void meshFilepaths(const std::vector<CellObject>& objects, std::vector<std::string>& filepaths);
+
+		//! Create SceneObjects read from a cell or scene file in a scene.
+		/*! @param scene The scene to create the SceneObjects in.
+		  * @param objects The SceneObjects.
+		  * @param filepaths The objects' meshes, as listed by meshFilepaths().
+		  * @param meshes The mesh for each of @p filepaths, or @p nullptr to leave the mesh out.
+		  * @param handles The vector to append the new SceneObjects' handles to, or @p nullptr. */
+		static void createObjects(graphics::Scene3D& scene, const std::vector<CellObject>& objects, const std::vector<std::string>& filepaths,
+			const std::vector<const graphics::Mesh*>& meshes, std::vector<SceneObjectHandle>* handles);
+
+	private:
+		//! Where a cell is, as far as the thread updating the scene is concerned.
+		enum CellStatus
+		{
+			CELL_UNLOADED, /*!< The cell isn't loaded. */
+			CELL_LOADING, /*!< The cell has been asked for, and isn't in the scene yet. */
+			CELL_RESIDENT /*!< The cell's SceneObjects are in the scene. */
+		};
+
+		//! A cell and its loading state.
+		struct Cell
+		{
+			CellInfo info; /*!< The cell's place and file. */
+			CellStatus status; /*!< Only touched by the thread updating the scene. */
+			std::vector<CellObject> objects; /*!< The cell's SceneObjects as read from its file. Written by the loading thread, then read by update(). */
+			std::vector<std::string> meshes; /*!< The filepaths of the meshes the cell uses, each once, sorted. Written by the loading thread. */
+			std::vector<graphics::Mesh*> uploads; /*!< The meshes the loading thread imported for the cell, for uploadMeshes() to upload. */
+			std::vector<SceneObjectHandle> handles; /*!< The handles of the cell's SceneObjects in the scene. Only touched by update(). */
+		};
+
+		//! A mesh used by one or more cells.
+		struct StreamedMesh
+		{
+			std::unique_ptr<graphics::Mesh> mesh; /*!< The mesh. */
+			unsigned int users; /*!< The number of loading or loaded cells which use the mesh. */
+		};
+
+		std::vector<Cell> m_cells; /*!< Every cell in the index. */
+		std::unordered_map<uint64_t, uint32_t> m_cellIndices; /*!< The index in m_cells of each cell, by its column and row. */
+		float m_cellSize; /*!< The length of each cell's sides. */
+		float m_loadRadius; /*!< Cells nearer than this are loaded. */
+		float m_unloadRadius; /*!< Cells farther than this are evicted. */
+		size_t m_memoryBudget; /*!< The most bytes the loaded and loading cells are expected to take, or 0 for no limit. */
+
+		// Only touched by the thread updating the scene.
+		std::vector<uint32_t> m_active; /*!< The indices of the loading and loaded cells. */
+		size_t m_committedBytes; /*!< The number of bytes the cells in m_active are expected to take. */
+		size_t m_residentCells; /*!< The number of loaded cells. */
+		std::vector<uint32_t> m_arrived; /*!< The indices of the cells being added to the scene in this update. */
+		std::vector<std::pair<float, uint32_t>> m_candidates; /*!< The distance and index of each cell in range but not loaded, in this update. */
+
+		mutable std::mutex m_mutex; /*!< Guards the members below it. */
+		std::condition_variable m_loadQueued; /*!< Signalled when a cell is added to m_loadQueue, or the loading thread should stop. */
+		std::deque<uint32_t> m_loadQueue; /*!< The indices of the cells for the loading thread to read. */
+		std::deque<uint32_t> m_uploadQueue; /*!< The indices of the cells whose meshes are waiting for uploadMeshes(). */
+		std::vector<uint32_t> m_readyQueue; /*!< The indices of the cells waiting for update() to add them to the scene. */
+		std::unordered_map<std::string, StreamedMesh> m_meshes; /*!< The meshes of the loading and loaded cells, by filepath. */
+		std::vector<std::unique_ptr<graphics::Mesh>> m_releases; /*!< Meshes no cell uses any more, waiting for uploadMeshes() to destroy them. */
+		size_t m_residentBytes; /*!< The number of bytes of vertex and index data in every uploaded mesh. */
+		bool m_stop; /*!< Set when the loading thread should exit. */
+
+		std::thread m_loader; /*!< The loading thread. */
+
+		//! The loading thread's main loop.
+		void loaderMain();
+
+		//! Add a cell's SceneObjects to the scene.
+		/*! @param scene The scene.
+		  * @param cell The cell, whose meshes have all been uploaded. */
+		void addToScene(graphics::Scene3D& scene, Cell& cell);
+
+		//! Destroy a loaded cell's SceneObjects, and release the meshes no other cell uses.
+		/*! @param scene The scene.
+		  * @param activeIndex The cell's index in m_active. */
+		void evict(graphics::Scene3D& scene, size_t activeIndex);
+
+		//! Drop a cell that the loading thread hasn't started on from the loading queue.
+		/*! @param activeIndex The cell's index in m_active.
+		  * @return False if the loading thread has already taken the cell, in which case it will be added to the scene as usual. */
+		bool cancel(size_t activeIndex);
+
+		//! Find how far a cell is from a point.
+		/*! @param cell The cell.
+		  * @param position The point.
+		  * @return The distance from the point to the nearest point of the cell, on the XZ plane. */
+		float distance(const Cell& cell, const maths::Vec3& position) const;
+
+		//! Combine a cell's column and row in to a key for m_cellIndices.
+		/*! @param x The cell's column.
+		  * @param z The cell's row.
+		  * @return The key. */
+		static uint64_t cellKey(int x, int z);
+	};
+
+}
\ No newline at end of file
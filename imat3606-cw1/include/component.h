@@ -5,10 +5,32 @@
   * @author George McDonagh */
 
 
+// External includes
+
+#include <stdint.h>
+
+
 // Namespaces
 
 namespace engine {
 
+	//! Component type IDs.
+	/*! Each Component class has its own ID, which it declares as a @c TYPE constant. The IDs index a SceneObject's component slots and
+	  * are the bit positions in a ComponentMask, so lookups by type are resolved at compile time. New Component classes must add an ID
+	  * here, before COMPONENT_TYPES_COUNT. */
+	enum ComponentType
+	{
+		COMPONENT_TRANSFORM = 0,
+		COMPONENT_MESH = 1,
+		COMPONENT_BOUNDS = 2,
+		COMPONENT_TYPES_COUNT
+	};
+
+	//! A set of component types, with bit @c n set for the ComponentType @c n.
+	typedef uint32_t ComponentMask;
+
+	static_assert(COMPONENT_TYPES_COUNT <= 32, "ComponentMask has one bit per ComponentType.");
+
 	//! Parent class for various SceneObject component's classes.
 	class Component
 	{
@@ -17,4 +39,20 @@ namespace engine {
 		virtual ~Component() = default;
 	};
 
+	//! Get the mask of a Component type.
+	/*! @return A ComponentMask with only @p T's bit set. */
+	template <typename T>
+	constexpr ComponentMask componentMask()
+	{
+		return ComponentMask(1) << T::TYPE;
+	}
+
+	//! Get the mask of a set of Component types.
+	/*! @return A ComponentMask with each of the types' bits set. */
+	template <typename T1, typename T2, typename... Rest>
+	constexpr ComponentMask componentMask()
+	{
+		return componentMask<T1>() | componentMask<T2, Rest...>();
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,275 @@
+#pragma once
+
+/*!
+  * @file component_store.h
+  * @brief Header file for the ComponentStore class and the archetypes it keeps components in.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <memory>
+#include <vector>
+
+
+// Internal includes
+
+#include "component.h"
+
+
+// Namespaces
+
+namespace engine {
+
+	class SceneObject;
+
+	//! A type-erased array of components, all of one type.
+	/*! Lets an Archetype move its rows around without knowing the types of its components. */
+	class ComponentColumn
+	{
+	public:
+		//! Virtual compiler-default destructor to enforce abstract class.
+		virtual ~ComponentColumn() = default;
+
+		//! Create an empty column of the same type.
+		/*! @return A pointer to the new column. The caller takes ownership. */
+		virtual ComponentColumn* createEmpty() const = 0;
+
+		//! Get a component.
+		/*! @param row The component's index.
+		  * @return A reference to the component. */
+		virtual Component& get(size_t row) = 0;
+
+		//! Add a copy of a component to the end of the column.
+		/*! @param component The component to copy. Must be of the column's type. */
+		virtual void pushBack(const Component& component) = 0;
+
+		//! Move a component from another column of the same type to the end of this one.
+		/*! @param other The column to move from. Its size doesn't change.
+		  * @param row The index in @p other of the component to move. */
+		virtual void pushBackFrom(ComponentColumn& other, size_t row) = 0;
+
+		//! Replace a component.
+		/*! @param row The component's index.
+		  * @param component The component to copy. Must be of the column's type. */
+		virtual void set(size_t row, const Component& component) = 0;
+
+		//! Remove a component by moving the last component in to its place.
+		/*! @param row The component's index. */
+		virtual void swapRemove(size_t row) = 0;
+	};
+
+	//! A column of components of type @p T, stored contiguously.
+	template <typename T>
+	class TypedColumn : public ComponentColumn
+	{
+	public:
+		//! Create an empty column of @p T.
+		/*! Used as a factory by ComponentStore, which only learns a component's type when one is added.
+		  * @return A pointer to the new column. The caller takes ownership. */
+		static ComponentColumn* create()
+		{
+			return new TypedColumn<T>();
+		}
+
+		ComponentColumn* createEmpty() const override
+		{
+			return create();
+		}
+
+		Component& get(size_t row) override
+		{
+			return m_components[row];
+		}
+
+		void pushBack(const Component& component) override
+		{
+			m_components.push_back(static_cast<const T&>(component));
+		}
+
+		void pushBackFrom(ComponentColumn& other, size_t row) override
+		{
+			m_components.push_back(std::move(static_cast<TypedColumn<T>&>(other).m_components[row]));
+		}
+
+		void set(size_t row, const Component& component) override
+		{
+			m_components[row] = static_cast<const T&>(component);
+		}
+
+		void swapRemove(size_t row) override
+		{
+			if (row + 1 != m_components.size())
+				m_components[row] = std::move(m_components.back());
+
+			m_components.pop_back();
+		}
+
+		//! Get the column's components.
+		/*! @return A pointer to the first of the column's components. */
+		T* data()
+		{
+			return m_components.data();
+		}
+
+		//! Get a component.
+		/*! @param row The component's index.
+		  * @return A reference to the component. */
+		T& operator[](size_t row)
+		{
+			return m_components[row];
+		}
+
+	private:
+		std::vector<T> m_components; /*!< The column's components. */
+	};
+
+	//! The SceneObjects with one particular set of component types, and their components.
+	/*! Each component type has its own column, and row @c i of every column belongs to the SceneObject at index @c i, so iterating a column
+	  * walks straight through memory. */
+	class Archetype
+	{
+	public:
+		//! Archetype constructor.
+		/*! @param mask The component types the archetype holds. */
+		explicit Archetype(ComponentMask mask);
+
+		//! Get the component types the archetype holds.
+		/*! @return A ComponentMask with the bit of each of the archetype's component types set. */
+		ComponentMask mask() const;
+
+		//! Get the number of SceneObjects in the archetype.
+		/*! @return The number of rows in each of the archetype's columns. */
+		size_t size() const;
+
+		//! Get the archetype's SceneObjects.
+		/*! @return A reference to an immutable vector of SceneObject pointers, in row order. */
+		const std::vector<SceneObject*>& objects() const;
+
+		//! Get the column of a component type.
+		/*! @param type The component type.
+		  * @return A pointer to the column. Returns @p nullptr if the archetype doesn't hold components of @p type. */
+		ComponentColumn* column(ComponentType type) const;
+
+		//! Get the column of a component type.
+		/*! @return A reference to the column of @p T components. The archetype must hold components of type @p T. */
+		template <typename T>
+		TypedColumn<T>& column() const
+		{
+			return static_cast<TypedColumn<T>&>(*m_columns[T::TYPE]);
+		}
+
+		//! Call a function with the components of each of the archetype's SceneObjects.
+		/*! @param func The function to call, as @c func(T&...) for each row. The archetype must hold every type in @p Ts. */
+		template <typename... Ts, typename Func>
+		void each(Func& func) const
+		{
+			eachRow(func, column<Ts>().data()...);
+		}
+
+	private:
+		friend class ComponentStore;
+
+		ComponentMask m_mask; /*!< The component types the archetype holds. */
+		std::vector<SceneObject*> m_objects; /*!< The SceneObject which owns each row. */
+		std::unique_ptr<ComponentColumn> m_columns[COMPONENT_TYPES_COUNT]; /*!< A column for each component type in m_mask, indexed by ComponentType. */
+
+		//! Call a function with one element of each array, for every row.
+		template <typename Func, typename... Ts>
+		void eachRow(Func& func, Ts*... columns) const
+		{
+			const size_t size = m_objects.size();
+
+			for (size_t i = 0; i < size; i++)
+				func(columns[i]...);
+		}
+	};
+
+	//! Stores the components of a set of SceneObjects, grouped by archetype.
+	/*! SceneObjects with the same component types share an Archetype, so the components a system wants can be iterated as packed arrays with
+	  * each() rather than by visiting each SceneObject. Adding or removing a component moves the SceneObject's components to another archetype.
+	  * @note Any change to which SceneObjects or components the store holds can move components in memory, invalidating pointers and
+	  * references to them. */
+	class ComponentStore
+	{
+	public:
+		//! ComponentStore constructor.
+		ComponentStore();
+
+		//! ComponentStore destructor. Destroys the components of any SceneObjects still in the store.
+		~ComponentStore();
+
+		ComponentStore(const ComponentStore&) = delete;
+
+		ComponentStore& operator=(const ComponentStore&) = delete;
+
+		//! Add a SceneObject to the store, with no components.
+		/*! @param object The SceneObject to add. Must not be in a store already. */
+		void insert(SceneObject* object);
+
+		//! Remove a SceneObject and its components from the store.
+		/*! @param object The SceneObject to remove. Must be in the store. */
+		void remove(SceneObject* object);
+
+		//! Give a SceneObject a component, or replace the one it has of the same type.
+		/*! @param object The SceneObject. Must be in the store.
+		  * @param type The component's type.
+		  * @param component The component to copy in to the store.
+		  * @param createColumn Creates an empty column for components of @p type, in case no archetype holds them yet. */
+		void setComponent(SceneObject* object, ComponentType type, const Component& component, ComponentColumn* (*createColumn)());
+
+		//! Destroy one of a SceneObject's components.
+		/*! @param object The SceneObject. Must be in the store.
+		  * @param type The type of the component to destroy. Nothing happens if @p object has no component of @p type. */
+		void removeComponent(SceneObject* object, ComponentType type);
+
+		//! Call a function with the components of each SceneObject which has a component of every type in @p Ts.
+		/*! Visits an archetype at a time, walking each of its columns in order.
+		  * @param func The function to call, as @c func(T&...). It must not add or remove SceneObjects or components. */
+		template <typename... Ts, typename Func>
+		void each(Func func)
+		{
+			const ComponentMask mask = componentMask<Ts...>();
+
+			for (auto it = m_archetypes.begin(); it != m_archetypes.end(); it++)
+				if (((*it)->m_mask & mask) == mask && (*it)->size() > 0)
+					(*it)->each<Ts...>(func);
+		}
+
+		//! Get the store's archetypes.
+		/*! @return A reference to an immutable vector of the store's archetypes, including any which are now empty. */
+		const std::vector<std::unique_ptr<Archetype>>& archetypes() const;
+
+		//! Get the store's structure version.
+		/*! Changes whenever a SceneObject or component is added or removed, which can move components, or a SceneObject in the store changes
+		  * parent. Anything which keeps pointers to components or depends on the hierarchy can compare it to tell whether it needs rebuilding.
+		  * @return The store's current structure version. */
+		unsigned long long structureVersion() const;
+
+	private:
+		friend class SceneObject;
+
+		std::vector<std::unique_ptr<Archetype>> m_archetypes; /*!< The store's archetypes. There are only ever a few, so they are searched linearly. */
+		unsigned long long m_structureVersion; /*!< The store's structure version. */
+
+		//! Find or create the archetype for a set of component types.
+		/*! @param mask The component types.
+		  * @param like An archetype whose columns can be copied for the types they share with @p mask.
+		  * @param createColumn Creates the column for any type in @p mask that @p like doesn't have.
+		  * @return A reference to the archetype. */
+		Archetype& findArchetype(ComponentMask mask, const Archetype* like, ComponentColumn* (*createColumn)());
+
+		//! Move a SceneObject's components to another archetype.
+		/*! Components of types that @p to doesn't hold are destroyed, and columns of @p to that the SceneObject has no component for are left
+		  * one row short, for the caller to fill.
+		  * @param object The SceneObject.
+		  * @param to The archetype to move to. */
+		void moveObject(SceneObject* object, Archetype& to);
+
+		//! Remove a row from an archetype, moving its last row in to the gap.
+		/*! @param archetype The archetype.
+		  * @param row The row to remove. */
+		static void removeRow(Archetype& archetype, size_t row);
+	};
+
+}
\ No newline at end of file
@@ -19,6 +19,11 @@
 
 #include <GL\glew.h>
 #include <GLFW\glfw3.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 #include <DearIMGUI\imgui.h>
 
@@ -30,6 +35,8 @@
 #include "graphics/renderer_3d.h"
 #include "graphics/window.h"
 #include "utils/logger.h"
+#include "utils/thread_pool.h"
+#include "utils/triple_buffer.h"
 
 
 // Verbose namespace commenting for doxygen documentation...
@@ -62,19 +69,68 @@ namespace engine {
 		bool init(int windowWidth, int windowHeight, const char* windowTitle) override;
 
 		//! Begin the engine's main loop.
-		/*! Kickstart the engine's main loop (update logic, input, rendering, etc.). */
+		/*! Kickstart the engine's main loop (update logic, input, rendering, etc.). The scene is updated at a fixed rate, set by
+		  * setTickRate(), however fast frames are drawn: each frame runs as many updates as the time since the last one covers, and draws
+		  * objects part of the way between the last two.
+		  *
+		  * Updating runs on a thread of its own, which finishes each frame with a RenderSnapshot. The calling thread, which has the OpenGL
+		  * context, handles input and draws the snapshots, so one frame is drawn while the next is updated, and a frame takes about as long as
+		  * the slower of the two rather than both together. Game::update() is called on the update thread at the start of each frame, before
+		  * the current scene is read, and updates the scene's CellStreamer if it is streamed. The CellStreamer uploads meshes on the calling
+		  * thread after each frame is drawn, as do scenes being preloaded by Game::preloadScene(). */
 		void run(Game& game) override;
 
+		//! Set how often the scene is updated.
+		/*! @param ticksPerSecond The number of scene updates per second, each of which steps the scene forward by 1 / @p ticksPerSecond seconds.
+		  * Must be greater than 0. Call before run(). */
+		void setTickRate(double ticksPerSecond);
+
+		//! Set the most scene updates a frame can run to catch up.
+		/*! Frames slower than this many updates give up on the time they couldn't cover, so the simulation slows down rather than falling
+		  * further behind with every frame.
+		  * @param maxTicks The most updates per frame. Must be at least 1. Call before run(). */
+		void setMaxTicksPerFrame(unsigned int maxTicks);
+
 		//! Terminate the engine.
 		/*! Terminates GLFW and reports any known errors. */
 		void terminate() override;
 
 	private:
+		//! A frame prepared by the update thread for the render thread.
+		struct Frame
+		{
+			graphics::RenderSnapshot snapshot; /*!< What to draw. */
+			unsigned int ticks; /*!< The number of scene updates run for the frame. */
+			double systemsTime; /*!< The time taken by the scene's Systems in the frame's last update, in milliseconds. */
+			std::vector<std::pair<const char*, double>> systemTimes; /*!< The name of each System and its time in the frame's last update. */
+			std::shared_ptr<CellStreamer> streamer; /*!< The scene's CellStreamer, for the render thread to upload meshes with, or @p nullptr. */
+			size_t residentCells; /*!< The number of cells the CellStreamer had loaded. */
+			size_t loadingCells; /*!< The number of cells the CellStreamer was loading. */
+			size_t residentBytes; /*!< The number of bytes the CellStreamer's meshes took. */
+		};
+
+		std::unique_ptr<utils::ThreadPool> m_threadPool; /*!< Worker threads for splitting each frame's work across cores. */
+		double m_tickRate = 60.0; /*!< The number of scene updates per second. */
+		unsigned int m_maxTicksPerFrame = 5; /*!< The most scene updates a frame can run. */
+		utils::TripleBuffer<Frame> m_frames; /*!< Hands frames from the update thread to the render thread. */
+		std::atomic<bool> m_running { false }; /*!< Cleared by the render thread to stop the update thread. */
+		std::mutex m_frameMutex; /*!< Paired with m_frameChanged. The frames themselves are handed over without it. */
+		std::condition_variable m_frameChanged; /*!< Signalled when a frame is published or consumed, or m_running is cleared. */
+
 		//! Initializes GLFW.
 		bool initGLFW();
 
+		//! The update thread's main loop.
+		/*! Updates the game's current scene and prepares a Frame from it, one frame ahead of the render thread, until m_running is cleared.
+		  * @param game The game being run. */
+		void updateMain(Game& game);
+
 		//! Initializes GLEW.
 		bool initGLEW();
+
+		//! Wake whichever thread is waiting on m_frameChanged.
+		/*! Call after publishing or consuming a frame, or clearing m_running. */
+		void signalFrames();
 	};
 
 }
\ No newline at end of file
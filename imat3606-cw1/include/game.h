@@ -8,13 +8,19 @@
 
 // External includes
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 
 // Internal includes
 
 #include "graphics\scene_3d.h"
 #include "utils\asset_manager.h"
+#include "cell_streamer.h"
 #include "mesh_component.h"
 
 
@@ -30,15 +36,101 @@ namespace engine {
 		Game();
 
 		//! Game destructor.
-		~Game();
+		virtual ~Game();
 
 		void load(const char* filepath);
 
 		std::shared_ptr<graphics::Scene3D>& currentScene();
 
+		//! Run the game's own logic for a frame.
+		/*! Called by the engine once a frame on the thread updating the scene, before it reads currentScene() and currentStreamer(), so a
+		  * switchTo() made here takes effect from the same frame. Streams the current scene's cells in and out around its camera. Games
+		  * override this to preloadScene() and switchTo(), and call Game::update() once they have, so the scene they switch to is streamed. */
+		virtual void update();
+
+		//! Stream the current scene's SceneObjects in from cells as its camera moves.
+		/*! If the scene is already streamed, its cells are evicted and the old CellStreamer is kept until releaseStreamers() finds no frame
+		  * still uses it. Call on the thread updating the scene.
+		  * @param indexFilepath The filepath of the cell index, written by utils::SerializerJSON::writeCells().
+		  * @param loadRadius Cells nearer the camera than this are loaded.
+		  * @param unloadRadius Cells farther from the camera than this are evicted.
+		  * @param memoryBudget The most bytes of meshes the loaded cells are expected to take, or 0 for no limit.
+		  * @return False if the index couldn't be read, in which case the scene carries on as it was. */
+		bool streamCurrentScene(const char* indexFilepath, float loadRadius, float unloadRadius, size_t memoryBudget = 0);
+
+		//! Get the current scene's CellStreamer.
+		/*! Frames hold on to the CellStreamer they were prepared with, so that it outlives them if the scene stops being streamed.
+		  * @return A shared pointer to the mutable CellStreamer, or @p nullptr if the current scene isn't streamed. */
+		const std::shared_ptr<CellStreamer>& currentStreamer();
+
+		//! Start loading a scene in the background.
+		/*! A thread of its own reads the scene's file, imports its meshes and creates its SceneObjects while the current scene carries on.
+		  * The meshes' OpenGL objects are then created by uploadPreloads(), a few each frame, after which the scene can be switched to.
+		  * Call on the thread updating the scene.
+		  * @param filepath The filepath of the scene, written by utils::SerializerJSON::write<graphics::Scene3D>().
+		  * @return The index of the scene, for switchTo(). */
+		int preloadScene(const char* filepath);
+
+		//! Check whether a scene has finished loading.
+		/*! @param sceneIndex The index of the scene.
+		  * @return True if switchTo() would switch to the scene. */
+		bool sceneReady(int sceneIndex) const;
+
+		//! Make a scene the current scene.
+		/*! The scene is already loaded, so this is only a change of index and the next frame draws the new scene. The old scene is kept, and
+		  * can be switched back to. Call on the thread updating the scene.
+		  * @param sceneIndex The index of the scene, as returned by preloadScene().
+		  * @return False if the scene hasn't finished loading, in which case the current scene is unchanged. */
+		bool switchTo(int sceneIndex);
+
+		//! Create the OpenGL objects of the meshes of the scenes being preloaded.
+		/*! Call once a frame on the thread with the OpenGL context. Meshes are uploaded until the frame's upload budget is spent, and at
+		  * least one is uploaded each frame while there are any left. */
+		void uploadPreloads();
+
+		//! Destroy the CellStreamers replaced by streamCurrentScene() that no frame uses any more.
+		/*! Call once a frame on the thread with the OpenGL context, after the frame has been drawn, as destroying a CellStreamer deletes the
+		  * OpenGL objects of its meshes. */
+		void releaseStreamers();
+
+		//! Set how much mesh data uploadPreloads() may upload a frame.
+		/*! @param bytes The most bytes of vertex and index data to upload a frame, or 0 for no limit. */
+		void setUploadBudget(size_t bytes);
+
 	private:
+		//! How far a scene loaded by preloadScene() has got.
+		enum PreloadStatus
+		{
+			PRELOAD_IMPORTING, /*!< The loading thread is reading the scene and importing its meshes. */
+			PRELOAD_UPLOADING, /*!< uploadPreloads() is uploading the scene's meshes. */
+			PRELOAD_READY /*!< The scene can be switched to. */
+		};
+
+		//! A scene loaded by preloadScene(), and the meshes it uses.
+		struct ScenePreload
+		{
+			std::string filepath; /*!< The filepath of the scene's file. */
+			std::vector<std::unique_ptr<graphics::Mesh>> meshes; /*!< The scene's meshes, kept for as long as the scene. Written by the loading thread. */
+			size_t uploaded; /*!< The number of meshes uploadPreloads() has uploaded. */
+			std::atomic<PreloadStatus> status; /*!< How far the scene has got. Each stage's writes are visible to whoever sees the next status. */
+			std::thread loader; /*!< The loading thread. */
+		};
+
 		 int m_currentSceneIndex;
+		 // The streamers and preloads own the meshes the scenes' SceneObjects point at, so they are declared first to be destroyed last.
+		 std::vector<std::shared_ptr<CellStreamer>> m_streamers; /*!< The CellStreamer of each scene in m_scenes, or @p nullptr. */
+		 std::vector<std::shared_ptr<CellStreamer>> m_retiredStreamers; /*!< CellStreamers replaced by streamCurrentScene(), until no frame uses them. */
+		 std::mutex m_streamerMutex; /*!< Guards m_retiredStreamers, which releaseStreamers() reads on the thread with the OpenGL context. */
+		 std::vector<std::unique_ptr<ScenePreload>> m_preloads; /*!< The ScenePreload of each scene in m_scenes, or @p nullptr if the scene wasn't preloaded. */
+		 mutable std::mutex m_preloadMutex; /*!< Guards m_preloads, which uploadPreloads() reads on the thread with the OpenGL context. */
 		 std::vector<std::shared_ptr<graphics::Scene3D>> m_scenes;
+		 std::vector<ScenePreload*> m_uploading; /*!< The scenes uploadPreloads() is uploading this frame. Only touched by uploadPreloads(). */
+		 size_t m_uploadBudget; /*!< The most bytes uploadPreloads() uploads a frame, or 0 for no limit. */
+
+		//! The main loop of a preloaded scene's loading thread.
+		/*! @param preload The scene's ScenePreload.
+		  * @param scene The scene to create the SceneObjects in. */
+		static void preloadMain(ScenePreload* preload, graphics::Scene3D* scene);
 	};
 	
 }
\ No newline at end of file
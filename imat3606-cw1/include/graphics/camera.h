@@ -8,7 +8,7 @@
 
 // Local includes
 
-#include "maths\maths.h"
+#include "maths/maths.h"
 
 
 // Namespaces
@@ -48,6 +48,10 @@ namespace engine { namespace graphics {
 		/*! @return A reference to an immutable 3-component vector; the Camera object's orientation containing its X, Y, and Z orientations. */
 		const maths::Vec3& orientation() const;
 
+		//! Camera orientation as a quaternion.
+		/*! @return A reference to an immutable quaternion; the same orientation as orientation(). */
+		const maths::Quat& rotation() const;
+
 		//! Gets a LookAt matrix constructed from the Camera's properties.
 		/*! @return A reference to an immutable 4x4 matrix; the Camera's cached view matrix. */
 		const maths::Mat4& getViewMatrix() const;
@@ -89,10 +93,13 @@ namespace engine { namespace graphics {
 		float& farClip();
 
 		//! Move the Camera object.
-		/*! Moves the position of the camera along its own axis.
-		  * @param offset The position offset. 
+		/*! Moves the position of the camera along its own axis, at the Camera's speed. Call it from the fixed timestep update with the tick
+		  * length, so that the camera moves at the same rate whatever the frame rate.
+		  * @param offset The direction to move in, relative to the Camera's axes. Each component is scaled by the speed, so a unit offset moves
+		  * the Camera by its speed each second.
+		  * @param deltaTime The time to move for, in seconds.
 		  * @note As this changes the position of the camera the View matrix is recalculated when calling @c move() */
-		void move(maths::Vec3 offset);
+		void move(maths::Vec3 offset, float deltaTime);
 
 		//! Rotate the Camera object.
 		/*! Rotates the orientation of the Camera.
@@ -100,6 +107,12 @@ namespace engine { namespace graphics {
 		  * @note As this changes the orientation of the camera the View matrix is recalculated when calling @c rotate() */
 		void rotate(maths::Vec3 offset);
 
+		//! Rotate the Camera object.
+		/*! Applies a rotation after the Camera's current orientation.
+		  * @param rotation A unit quaternion.
+		  * @note As this changes the orientation of the camera the View matrix is recalculated when calling @c rotate() */
+		void rotate(const maths::Quat& rotation);
+
 	private:
 		float m_fov; /*!< Field of View (in degrees). */
 		float m_aspect; /*!< Aspect ratio (width / height) */
@@ -111,12 +124,13 @@ namespace engine { namespace graphics {
 
 		maths::Vec3 m_position; /*< Camera position in 3D space. */
 		maths::Vec3 m_orientation; /*< Camera orientation in 3D space. */
+		maths::Quat m_rotation; /*!< Camera orientation as a quaternion, kept in sync with m_orientation. */
 
 		maths::Vec3 m_up; /*!< The up-direction vector of the camera. Equivalant to its local Y axis. */;
 		maths::Vec3 m_forward; /*!< The forward-direction vector representing where the camera is pointed. Equivalant to its local Z axis. */;
 		maths::Vec3 m_right; /*!< The vector casting off to the right hand side of the camera. Equivalant to its local X axis. */
 
-		float m_speed; /*! Camera movement speed modifier. */
+		float m_speed; /*! Camera movement speed, in units per second. */
 		float m_rotationSensitivity; /*! Sensitivity to rotations. */
 
 		//! Update the Camera's view matrix.
@@ -11,12 +11,14 @@
 #include <assimp\mesh.h>
 #include <assimp\scene.h>
 #include <GL\glew.h>
+#include <memory>
 #include <vector>
 
 
 // Local includes
 
 #include "asset.h"
+#include "maths\maths.h"
 
 
 // Namespaces
@@ -42,6 +44,8 @@ namespace engine { namespace graphics {
 			GLuint vao; /*!< OpenGL Vertex Array Buffer handle. */
 			GLuint vbo[4]; /*!< OpenGL Vertex Buffer Objects' handles - one for each of the MeshEntry's VBO type. */
 			unsigned int elementCount; /*!< Number of  */
+			maths::AABB bounds; /*!< The box around the MeshEntry's vertices, in model space. */
+			size_t byteSize; /*!< The number of bytes of vertex and index data in the MeshEntry's buffers. */
 
 			//! MeshEntry constructor.
 			/*! Constructs a MeshEntry given a pointer to an Assimp mesh object.
@@ -57,24 +61,52 @@ namespace engine { namespace graphics {
 
 		//! Mesh constructor.
 		/*! Construct a Mesh from file.
-		  * @param filepath The relative path to a mesh file. */
-		Mesh(const char* filepath);
+		  * @param filepath The relative path to a mesh file.
+		  * @param upload False to only import() the file, so that the Mesh can be constructed on a thread without the OpenGL context and
+		  * upload()ed later. */
+		Mesh(const char* filepath, bool upload = true);
 
 		//! Mesh destructor.
 		~Mesh();
 
 		//! Load the Mesh in to memory.
+		/*! The same as import() followed by upload(). */
 		bool load() override;
 
+		//! Read the Mesh's file, without creating any OpenGL objects.
+		/*! The slow half of load(), which may run on any thread. The imported data is kept until upload().
+		  * @return True if the file was read, or the Mesh is already loaded. On failure the error is stored for getLoadErrorString(). */
+		bool import();
+
+		//! Create the Mesh's MeshEntrys from the data import() read, and free it.
+		/*! Must be called on the thread with the OpenGL context.
+		  * @return True if the Mesh is now loaded, false if nothing has been imported. */
+		bool upload();
+
+		//! Get the size of the Mesh's buffers.
+		/*! @return The number of bytes of vertex and index data in every MeshEntry's buffers. 0 if the Mesh isn't loaded. */
+		size_t getByteSize() const;
+
 		//! Release all of the Mesh's memory.
 		void unload() override;
 
 		//! Render the Mesh.
 		void render() const;
 
+		//! Get the Mesh's bounds.
+		/*! @return A reference to the immutable box around every MeshEntry's vertices, in model space. */
+		const maths::AABB& getBounds() const;
+
+		//! Get the Mesh's MeshEntrys.
+		/*! @return A reference to an immutable vector of pointers to the Mesh's MeshEntrys. Empty if the Mesh isn't loaded. */
+		const std::vector<MeshEntry*>& getEntries() const;
+
 	private:
 
 		std::vector<MeshEntry*> m_entries; /*!< Collection of the Mesh's MeshEntrys. */
+		maths::AABB m_bounds; /*!< The box around every MeshEntry's vertices, in model space. */
+		size_t m_byteSize; /*!< The number of bytes of vertex and index data in every MeshEntry's buffers. */
+		std::unique_ptr<Assimp::Importer> m_importer; /*!< Holds the data read by import() until upload(). */
 	};
 
 } }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+/*!
+  * @file render_snapshot.h
+  * @brief Header file for the RenderSnapshot struct.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <vector>
+
+
+// Local includes
+
+#include "graphics\mesh.h"
+#include "maths\maths.h"
+#include "mesh_component.h"
+
+
+// Namespaces
+
+namespace engine { namespace graphics {
+
+	//! Everything needed to draw a frame of a scene, without the scene.
+	/*! Filled in by Renderer3D::prepare() and drawn by Renderer3D::submit(). A snapshot holds its own copies of the matrices and camera, and
+	  * points only at MeshEntrys, which don't change once loaded, so it can be drawn on one thread while the scene is updated on another. */
+	struct RenderSnapshot
+	{
+		//! An object to draw.
+		struct Draw
+		{
+			maths::Mat4 mvp; /*!< The object's model-view-projection matrix. */
+			maths::Mat4 model; /*!< The object's model matrix. */
+			maths::Mat3 normalMatrix; /*!< The object's normal matrix. */
+			size_t firstEntry; /*!< The index in @c entries of the object's first MeshEntry to draw. */
+			size_t entryCount; /*!< The number of the object's MeshEntrys to draw. */
+		};
+
+		maths::Vec3 eye; /*!< The camera's position. */
+		std::vector<Draw> draws; /*!< The visible objects, in the order they are drawn. */
+		std::vector<const Mesh::MeshEntry*> entries; /*!< The visible MeshEntrys of the objects in @c draws, each object's together. */
+		size_t visibleCount; /*!< The number of MeshEntrys to draw. */
+		size_t culledCount; /*!< The number of MeshEntrys outside the camera's frustum. */
+		size_t lodCounts[MeshComponent::MAX_LODS]; /*!< The number of objects to draw at each level of detail. */
+
+		//! RenderSnapshot constructor. Creates an empty snapshot.
+		RenderSnapshot()
+			: visibleCount(0), culledCount(0), lodCounts() { }
+	};
+
+} }
\ No newline at end of file
@@ -10,14 +10,18 @@
 
 #include <GL\glew.h>
 #include <GLFW\glfw3.h>
+#include <stdint.h>
+#include <vector>
 
 
 // Local includes
 
+#include "graphics\render_snapshot.h"
 #include "graphics\scene_3d.h"
 #include "graphics\shader_program.h"
 #include "maths\maths.h"
 #include "mesh_component.h"
+#include "transform_component.h"
 
 
 // Namespaces
@@ -33,12 +37,83 @@ namespace engine { namespace graphics {
 		//! Renderer3D destructor.
 		~Renderer3D();
 
-		//! Renders a given Scene3D.
-		/*! @param scene The 3D scene to be rendered by the renderer. */
-		void renderScene(graphics::Scene3D& scene);
+		//! The same as prepare() followed by submit().
+		/*! Draws a Scene3D straight away, on the thread with the OpenGL context. Use prepare() and submit() instead to work out the next
+		  * frame on another thread while the last is drawn.
+		  * @param scene The 3D scene to be rendered by the renderer.
+		  * @param interpolation How far the frame is from the update before the latest one to the latest, from 0 to 1. */
+		void renderScene(graphics::Scene3D& scene, float interpolation = 1.0f);
+
+		//! Work out what to draw for a Scene3D, without drawing it.
+		/*! Gathers every SceneObject with a TransformComponent and a MeshComponent, in the order they are packed in the scene's
+		  * ComponentStore. Each object's mesh bounds are moved in to world space and tested against the camera's frustum, many at a time, and
+		  * objects entirely outside it are skipped. The MeshEntrys of visible meshes with more than one are then tested on their own. World
+		  * bounds are cached, and only recalculated when an object's world matrix or mesh changes. Visible objects with more than one level of
+		  * detail then have the screen sizes of their bounding spheres found together, and pick a level with MeshComponent::selectLOD(). Each
+		  * object's model-view-projection matrix is calculated on the CPU from its world matrix and cached, and only recalculated when the
+		  * object's world matrix or the camera changes. The shaders receive it as the @c mvp uniform, along with @c model and @c normalMatrix
+		  * for lighting. Call Scene3D::update() first to bring the world matrices up to date.
+		  *
+		  * Between fixed timestep updates, objects which moved in the latest update are drawn @p interpolation of the way from their previous
+		  * world matrix to their current one (see TransformComponent::getInterpolatedWorldMatrix()), and their cached bounds cover both.
+		  *
+		  * The results are copied in to a RenderSnapshot for submit(). Doesn't need the OpenGL context, and touches none of the state submit()
+		  * does, so the next frame can be prepared on another thread while the last is submitted. Only one thread may prepare at a time, and it
+		  * must be the one updating the scene.
+		  * @param scene The 3D scene to be rendered.
+		  * @param snapshot The snapshot to fill in. Its vectors are reused, so a snapshot kept between frames stops allocating.
+		  * @param interpolation How far the frame is from the update before the latest one to the latest, from 0 to 1. */
+		void prepare(graphics::Scene3D& scene, RenderSnapshot& snapshot, float interpolation = 1.0f);
+
+		//! Draw a RenderSnapshot.
+		/*! Must be called on the thread with the OpenGL context. The counts returned by getVisibleCount(), getCulledCount() and getLODCount()
+		  * are the snapshot's from here on.
+		  * @param snapshot A snapshot filled in by prepare(). */
+		void submit(const RenderSnapshot& snapshot);
+
+		//! Get the number of MeshEntrys drawn by the last renderScene() or submit().
+		/*! @return The number of MeshEntrys which were at least partly inside the camera's frustum. */
+		size_t getVisibleCount() const;
+
+		//! Get the number of MeshEntrys skipped by the last renderScene() or submit().
+		/*! @return The number of MeshEntrys which were entirely outside the camera's frustum. */
+		size_t getCulledCount() const;
+
+		//! Get the number of objects drawn at a level of detail by the last renderScene() or submit().
+		/*! @param level The level, less than MeshComponent::MAX_LODS.
+		  * @return The number of visible objects drawn with their MeshComponent's @p level mesh. Objects with one level are drawn at level 0. */
+		size_t getLODCount(unsigned int level) const;
 
 	private:
+		//! An object gathered for drawing by the culling stage.
+		struct Draw
+		{
+			const TransformComponent* transform; /*!< The object's transform. */
+			const Mesh* mesh; /*!< The object's mesh. */
+			MeshComponent* component; /*!< The object's MeshComponent. */
+			unsigned int lod; /*!< The level of detail to draw the object at. */
+			unsigned long long boundsVersion; /*!< The world version of @c transform when the object's world bounds were calculated, or 0. */
+			unsigned long long mvpVersion; /*!< The world version of @c transform when @c mvp was calculated, or 0. */
+			unsigned long long mvpCamera; /*!< The value of m_cameraVersion when @c mvp was calculated. */
+			maths::Mat4 mvp; /*!< The object's cached model-view-projection matrix. */
+		};
+
+		maths::Mat4 m_viewProjection; /*!< The camera's view-projection matrix in the last prepare(). */
+		unsigned long long m_cameraVersion; /*!< Incremented whenever m_viewProjection changes. */
+		std::vector<Draw> m_draws; /*!< The objects to draw this frame, in the order the scene packs them. Kept between frames for their cached bounds. */
+		std::vector<maths::AABB> m_worldBounds; /*!< The world bounds of each object in m_draws' mesh, packed together for the frustum test. */
+		std::vector<uint8_t> m_visible; /*!< Whether each object in m_draws might be visible. */
+		std::vector<size_t> m_lodDraws; /*!< The indices in m_draws of the visible objects with more than one level of detail. */
+		maths::Vec3Stream m_sphereCentres; /*!< The centres of the bounding spheres of the objects in m_lodDraws. */
+		std::vector<float> m_sphereRadii; /*!< The radii of the bounding spheres of the objects in m_lodDraws. */
+		std::vector<float> m_screenSizes; /*!< The screen sizes of the bounding spheres of the objects in m_lodDraws. */
+		RenderSnapshot m_snapshot; /*!< The snapshot renderScene() prepares and submits. */
+
+		// Only touched by submit(), so that it can run alongside prepare().
 		ShaderProgram* m_shaderProgram; /*!< Pointer to the ShaderProgram which the renderer will use while rendering. */
+		size_t m_visibleCount; /*!< The number of MeshEntrys drawn by the last submit(). */
+		size_t m_culledCount; /*!< The number of MeshEntrys skipped by the last submit(). */
+		size_t m_lodCounts[MeshComponent::MAX_LODS]; /*!< The number of objects drawn at each level of detail by the last submit(). */
 	};
 
 } }
\ No newline at end of file
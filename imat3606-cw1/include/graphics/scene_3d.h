@@ -12,9 +12,15 @@
 
 // Internal includes
 
-#include "graphics\camera.h"
-#include "maths\maths.h"
+#include "graphics/camera.h"
+#include "maths/maths.h"
+#include "component_store.h"
+#include "scene_bvh.h"
 #include "scene_object.h"
+#include "system_scheduler.h"
+#include "transform_hierarchy.h"
+#include "utils/object_pool.h"
+#include "utils/thread_pool.h"
 
 
 // Namespaces
@@ -31,7 +37,20 @@ namespace engine { namespace graphics {
 		~Scene3D();
 
 		//! Update the scene's logic.
-		void update();
+		/*! Runs the scene's Systems, then brings the world matrices of every TransformComponent up to date, recalculating only those whose
+		  * transform or whose ancestors' transforms have changed, then moves the SceneObjects that moved within the scene's BVH.
+		  * @param deltaTime The time to step the scene forward by, in seconds.
+		  * @param threadPool The threads to run the Systems and split the world matrix updates across, or @p nullptr to update on the calling
+		  * thread. */
+		void update(float deltaTime = 0.0f, utils::ThreadPool* threadPool = nullptr);
+
+		//! Get the scene's Systems.
+		/*! @return A reference to the mutable SystemScheduler which update() runs the scene's Systems with. */
+		SystemScheduler& getSystems();
+
+		//! Get the scene's Systems.
+		/*! @return A reference to the immutable SystemScheduler which update() runs the scene's Systems with. */
+		const SystemScheduler& getSystems() const;
 
 		//! Get the scene's Camera.
 		/*! @return A reference to an immutable Camera object; the scene's Camera. */
@@ -42,20 +61,64 @@ namespace engine { namespace graphics {
 		Camera& getCamera();
 
 		//! Get the scene's collection of SceneObjects.
-		/*! @return A reference to an immutable vector of SceneObject pointers. */
+		/*! Destroying a SceneObject moves the last one in to its place, so the order changes as SceneObjects come and go.
+		  * @return A reference to an immutable vector of SceneObject pointers. */
 		const std::vector<engine::SceneObject*>& getObjects() const;
 
-		//! Get the scene's collection of SceneObjects.
-		/*! @return A reference to a mutable vector of SceneObject pointers. */
-		std::vector<engine::SceneObject*>& getObjects();
-
-		//! Add a SceneObject to the scene.
-		/*! @param sceneObject A pointer to a new SceneObject to be added to the scene. */
-		void add(engine::SceneObject* sceneObject);
+		//! Create a SceneObject in the scene.
+		/*! The SceneObject is constructed in the scene's pool, reusing the slot of a destroyed one if there is one, so once the scene has held
+		  * as many SceneObjects as it does at its busiest, creating them doesn't allocate.
+		  * @return The new SceneObject's handle. It starts with a TransformComponent at the origin. */
+		engine::SceneObjectHandle create();
+
+		//! Destroy a SceneObject and its components.
+		/*! The SceneObject's children become roots. Handles to it resolve to @p nullptr from then on, but pointers to it are left dangling.
+		  * @param handle The SceneObject's handle.
+		  * @return False if @p handle doesn't refer to a SceneObject in the scene, in which case nothing happens. */
+		bool destroy(engine::SceneObjectHandle handle);
+
+		//! Get a SceneObject.
+		/*! @param handle The SceneObject's handle.
+		  * @return A pointer to the mutable SceneObject. Returns @p nullptr if it has been destroyed. */
+		engine::SceneObject* get(engine::SceneObjectHandle handle);
+
+		//! Get a SceneObject.
+		/*! @param handle The SceneObject's handle.
+		  * @return A pointer to the immutable SceneObject. Returns @p nullptr if it has been destroyed. */
+		const engine::SceneObject* get(engine::SceneObjectHandle handle) const;
+
+		//! Call a function with the components of each SceneObject which has a component of every type in @p Ts.
+		/*! For example @c scene.each<TransformComponent, MeshComponent>([](TransformComponent& transform, MeshComponent& mesh) { ... }). Walks
+		  * the scene's packed component arrays instead of visiting each SceneObject, so prefer it to looping over getObjects().
+		  * @param func The function to call, as @c func(T&...). It must not add or remove SceneObjects or components. */
+		template <typename... Ts, typename Func>
+		void each(Func func)
+		{
+			m_components.each<Ts...>(func);
+		}
+
+		//! Get the scene's ComponentStore.
+		/*! @return A reference to the immutable store holding the components of the scene's SceneObjects. */
+		const ComponentStore& getComponents() const;
+
+		//! Get the scene's transform hierarchy.
+		/*! @return A reference to the immutable hierarchy that update() flattens the scene's transforms in to. */
+		const TransformHierarchy& getHierarchy() const;
+
+		//! Get the scene's spatial index.
+		/*! @return A reference to the immutable BVH over the world bounds of the scene's SceneObjects with a BoundsComponent, as of the
+		  * last update(). */
+		const SceneBVH& getBVH() const;
 
 	private:
 		Camera m_camera; /*!< The scene's Camera. */
+		ComponentStore m_components; /*!< The components of the scene's SceneObjects, grouped by archetype. */
+		TransformHierarchy m_hierarchy; /*!< The scene's transforms in hierarchy order, for updating their world matrices. */
+		SceneBVH m_bvh; /*!< The spatial index over the scene's SceneObjects with a BoundsComponent. */
+		SystemScheduler m_systems; /*!< Runs the scene's Systems. */
+		utils::ObjectPool<engine::SceneObject> m_objectPool; /*!< Owns the scene's SceneObjects. */
 		std::vector<engine::SceneObject*> m_objects; /*!< The scene's collection of SceneObjects. */
+		std::vector<size_t> m_objectIndices; /*!< The index in m_objects of the SceneObject in each slot of m_objectPool. */
 	};
 
 } }
\ No newline at end of file
@@ -80,6 +80,11 @@ namespace engine { namespace graphics {
 		  * @param f The value to pass to the uniform. */
 		void setUniform_4f(const char* uniformName, const GLfloat f[4]) const;
 
+		//! Sets a mat3 uniform's value.
+		/*! @param uniformName The name of the uniform to set.
+		  * @param m The value to pass to the uniform. */
+		void setUniform_mat3(const char* uniformName, const GLfloat m[9]) const;
+
 		//! Sets a mat4 uniform's value.
 		/*! @param uniformName The name of the uniform to set.
 		  * @param m The value to pass to the uniform. */
@@ -0,0 +1,82 @@
+#pragma once
+
+/*!
+  * @file aabb.h
+  * @brief Header file for the AABB class.
+  * @author George McDonagh */
+
+
+// Local includes
+
+#include "maths/maths.h"
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	//! An axis-aligned bounding box.
+	/*! Stored as its minimum and maximum corners, so an array of boxes is six tightly packed floats per box. */
+	class AABB
+	{
+	public:
+		//! Constructs an empty box at the origin.
+		ENGINE_MATHS_CONSTEXPR AABB();
+
+		//! Constructs a box from its corners.
+		/*! @param min The box's minimum corner.
+		  * @param max The box's maximum corner. Each component should be at least the matching component of @p min. */
+		ENGINE_MATHS_CONSTEXPR AABB(const Vec3& min, const Vec3& max);
+
+		//! Box's minimum corner.
+		/*! @return Read-only reference to the box's minimum corner. */
+		ENGINE_MATHS_CONSTEXPR const Vec3& min() const;
+
+		//! Box's maximum corner.
+		/*! @return Read-only reference to the box's maximum corner. */
+		ENGINE_MATHS_CONSTEXPR const Vec3& max() const;
+
+		//! Box's minimum corner.
+		/*! @return Modifiable reference to the box's minimum corner. */
+		Vec3& min();
+
+		//! Box's maximum corner.
+		/*! @return Modifiable reference to the box's maximum corner. */
+		Vec3& max();
+
+		//! Box's center.
+		/*! @return The point halfway between the box's corners. */
+		ENGINE_MATHS_CONSTEXPR Vec3 center() const;
+
+		//! Box's half-size.
+		/*! @return The distance from the box's center to its maximum corner along each axis. */
+		ENGINE_MATHS_CONSTEXPR Vec3 extents() const;
+
+		//! Box's size.
+		/*! @return The box's width, height, and depth. */
+		ENGINE_MATHS_CONSTEXPR Vec3 size() const;
+
+		//! Check whether a point is inside the box.
+		/*! @param point A point.
+		  * @return True if @p point is inside or on the surface of the box. */
+		ENGINE_MATHS_CONSTEXPR bool contains(const Vec3& point) const;
+
+		//! Check whether two boxes overlap.
+		/*! @param aabb Another box.
+		  * @return True if the boxes overlap or touch. */
+		ENGINE_MATHS_CONSTEXPR bool intersects(const AABB& aabb) const;
+
+		//! Grow the box to include a point.
+		/*! @param point The point to include. */
+		void expand(const Vec3& point);
+
+		//! Grow the box to include another box.
+		/*! @param aabb The box to include. */
+		void expand(const AABB& aabb);
+
+	private:
+		Vec3 m_min; /*!< The box's minimum corner. */
+		Vec3 m_max; /*!< The box's maximum corner. */
+	};
+
+} }
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+/*!
+  * @file aabb.inl
+  * @brief Inline definitions for the AABB class.
+  * @author George McDonagh */
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_CONSTEXPR AABB::AABB()
+		: m_min(0.0f), m_max(0.0f)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR AABB::AABB(const Vec3& min, const Vec3& max)
+		: m_min(min), m_max(max)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR const Vec3& AABB::min() const
+	{
+		return m_min;
+	}
+
+	ENGINE_MATHS_CONSTEXPR const Vec3& AABB::max() const
+	{
+		return m_max;
+	}
+
+	ENGINE_MATHS_INLINE Vec3& AABB::min()
+	{
+		return m_min;
+	}
+
+	ENGINE_MATHS_INLINE Vec3& AABB::max()
+	{
+		return m_max;
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec3 AABB::center() const
+	{
+		return (m_min + m_max) * 0.5f;
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec3 AABB::extents() const
+	{
+		return (m_max - m_min) * 0.5f;
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec3 AABB::size() const
+	{
+		return m_max - m_min;
+	}
+
+	ENGINE_MATHS_CONSTEXPR bool AABB::contains(const Vec3& point) const
+	{
+		return point.x() >= m_min.x() && point.x() <= m_max.x()
+			&& point.y() >= m_min.y() && point.y() <= m_max.y()
+			&& point.z() >= m_min.z() && point.z() <= m_max.z();
+	}
+
+	ENGINE_MATHS_CONSTEXPR bool AABB::intersects(const AABB& aabb) const
+	{
+		return m_min.x() <= aabb.m_max.x() && m_max.x() >= aabb.m_min.x()
+			&& m_min.y() <= aabb.m_max.y() && m_max.y() >= aabb.m_min.y()
+			&& m_min.z() <= aabb.m_max.z() && m_max.z() >= aabb.m_min.z();
+	}
+
+	ENGINE_MATHS_INLINE void AABB::expand(const Vec3& point)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			if (point(i) < m_min(i))
+				m_min(i) = point(i);
+			if (point(i) > m_max(i))
+				m_max(i) = point(i);
+		}
+	}
+
+	ENGINE_MATHS_INLINE void AABB::expand(const AABB& aabb)
+	{
+		expand(aabb.m_min);
+		expand(aabb.m_max);
+	}
+
+} }
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+
+/*!
+  * @file bvh.h
+  * @brief Header file for the BVH class.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <stdint.h>
+#include <vector>
+
+
+// Local includes
+
+#include "maths/maths.h"
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	//! A bounding volume hierarchy over a set of boxes, for finding the boxes in a region without testing every one.
+	/*! Each box is an item, identified by its index in the array passed to build(). The tree is built with the surface area heuristic, so
+	  * it suits boxes which rarely move. Moving boxes can be updated in place and the tree refitted around them, which is much cheaper than
+	  * a rebuild but lets the tree's quality drift as they move apart; compare cost() to its value after the last build() to decide when to
+	  * rebuild. */
+	class BVH
+	{
+	public:
+		//! BVH constructor. Creates an empty tree.
+		BVH();
+
+		//! Build the tree.
+		/*! @param boxes The items' boxes. Item @c i is @p boxes[i]. */
+		void build(const std::vector<AABB>& boxes);
+
+		//! Move an item.
+		/*! The tree isn't changed until the next refit().
+		  * @param item The item.
+		  * @param box The item's new box. */
+		void update(uint32_t item, const AABB& box);
+
+		//! Remove an item, so that queries no longer find it.
+		/*! Its index isn't reused until the next build(). The tree isn't changed until the next refit().
+		  * @param item The item. */
+		void remove(uint32_t item);
+
+		//! Grow and shrink the nodes above the items which have been updated or removed since the last build() or refit().
+		void refit();
+
+		//! Get the tree's surface area heuristic cost.
+		/*! The expected cost of a query, relative to testing a single box: lower is better. Refitting moved items tends to raise it. Worked
+		  * out from every node, so it costs about as much as a refit() of the whole tree.
+		  * @return The cost as of the last build() or refit(). */
+		float cost() const;
+
+		//! Get the number of items.
+		/*! @return The number of boxes passed to the last build(), including any since removed. */
+		size_t size() const;
+
+		//! Get the number of nodes.
+		/*! @return The number of nodes in the tree, including leaves. */
+		size_t nodeCount() const;
+
+		//! Get an item's box.
+		/*! @param item The item.
+		  * @return A reference to the item's box, as of the last build() or update(). */
+		const AABB& bounds(uint32_t item) const;
+
+		//! Find the items whose boxes overlap a box.
+		/*! @param box The box.
+		  * @param items The vector to append the items to, in no particular order. */
+		void query(const AABB& box, std::vector<uint32_t>& items) const;
+
+		//! Find the items whose boxes are at least partly inside a frustum.
+		/*! Gives the same items as Frustum::test(const AABB&) would, but skips whole subtrees which are outside the frustum, and doesn't test
+		  * the items in subtrees which are entirely inside it.
+		  * @param frustum The frustum.
+		  * @param items The vector to append the items to, in no particular order. */
+		void query(const Frustum& frustum, std::vector<uint32_t>& items) const;
+
+		//! Find the nearest item whose box a ray hits.
+		/*! @param ray The ray.
+		  * @param t Set to the distance along @p ray to the hit, as intersect(const Ray&, const AABB&, float&) would. Left unchanged if @p ray
+		  * misses every item.
+		  * @param item Set to the item hit. Left unchanged if @p ray misses every item.
+		  * @return True if @p ray hits an item. */
+		bool raycast(const Ray& ray, float& t, uint32_t& item) const;
+
+	private:
+		//! A node of the tree.
+		/*! Interior nodes have two children, stored next to each other. */
+		struct Node
+		{
+			AABB bounds; /*!< The box around every item below the node. */
+			uint32_t index; /*!< The index of a leaf's first item in m_order, or of an interior node's first child. */
+			uint32_t count; /*!< The number of a leaf's items, or 0 for an interior node. */
+		};
+
+		std::vector<Node> m_nodes; /*!< The nodes, root first. Children always come after their parents. */
+		std::vector<uint32_t> m_parents; /*!< The index of each node's parent. */
+		std::vector<uint32_t> m_order; /*!< The items, with each leaf's together. */
+		std::vector<uint32_t> m_leaves; /*!< The leaf holding each item. */
+		std::vector<AABB> m_boxes; /*!< Each item's box. Removed items' boxes are empty, with their minimum corner above their maximum. */
+		std::vector<uint8_t> m_dirty; /*!< Whether each leaf has items updated or removed since the last refit(). */
+		std::vector<uint32_t> m_dirtyLeaves; /*!< The leaves with items updated or removed since the last refit(). */
+
+		//! Make a node the box around its items or children.
+		/*! @param node The node's index.
+		  * @return True if the node's box changed. */
+		bool refitNode(uint32_t node);
+	};
+
+} }
\ No newline at end of file
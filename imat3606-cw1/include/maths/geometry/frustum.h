@@ -0,0 +1,82 @@
+#pragma once
+
+/*!
+  * @file frustum.h
+  * @brief Header file for the Frustum class.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <stdint.h>
+
+
+// Local includes
+
+#include "maths/maths.h"
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	//! Indices of a frustum's planes.
+	enum FrustumPlane
+	{
+		FRUSTUM_LEFT	= 0,
+		FRUSTUM_RIGHT	= 1,
+		FRUSTUM_BOTTOM	= 2,
+		FRUSTUM_TOP		= 3,
+		FRUSTUM_NEAR	= 4,
+		FRUSTUM_FAR		= 5
+	};
+
+	//! A view frustum, for rejecting bounds which can't be seen.
+	/*! Stored as six planes whose normals face in to the frustum. The tests are conservative: they never reject anything which is visible, but
+	  * boxes and spheres just outside a corner of the frustum may pass. */
+	class Frustum
+	{
+	public:
+		//! Constructs a frustum whose planes all pass through the origin facing +Y.
+		/*! Use Frustum(const Mat4&) to get a useful frustum. */
+		Frustum();
+
+		//! Constructs a frustum by extracting the planes from a view-projection matrix.
+		/*! @param viewProjection The projection matrix multiplied by the view matrix, for example @c camera.getPerspectiveMatrix() @c * @c camera.getViewMatrix().
+		  * Expects OpenGL clip space, where visible points have X, Y, and Z in [-W, W]. Pass a model-view-projection matrix instead to test bounds in
+		  * that model's space. */
+		explicit Frustum(const Mat4& viewProjection);
+
+		//! Frustum's plane.
+		/*! @param i The plane's index, a FrustumPlane value.
+		  * @return Read-only reference to the plane. Its normal is unit length and faces in to the frustum. */
+		const Plane& plane(int i) const;
+
+		//! Check whether a point is inside the frustum.
+		/*! @param point A point.
+		  * @return True if @p point is inside or on the surface of the frustum. */
+		bool test(const Vec3& point) const;
+
+		//! Check whether a sphere might be visible.
+		/*! @param sphere A sphere.
+		  * @return False if @p sphere is entirely outside one of the frustum's planes. */
+		bool test(const Sphere& sphere) const;
+
+		//! Check whether a box might be visible.
+		/*! @param aabb A box.
+		  * @return False if @p aabb is entirely outside one of the frustum's planes. */
+		bool test(const AABB& aabb) const;
+
+		//! Check whether each of an array of boxes might be visible.
+		/*! Tests four (SSE2) or eight (AVX) boxes at a time. Gives the same results as test(const AABB&), except that the AVX2 kernel's fused
+		  * multiply-adds may round differently for boxes which touch a plane.
+		  * @param boxes The boxes to test.
+		  * @param count The number of boxes.
+		  * @param result The array to write @p count results to: 1 if the box might be visible, 0 if it is outside the frustum. */
+		void test(const AABB* boxes, size_t count, uint8_t* result) const;
+
+	private:
+		Plane m_planes[6]; /*!< The frustum's planes, in FrustumPlane order. */
+	};
+
+} }
\ No newline at end of file
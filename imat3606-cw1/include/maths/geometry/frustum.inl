@@ -0,0 +1,54 @@
+#pragma once
+
+/*!
+  * @file frustum.inl
+  * @brief Inline definitions for the Frustum class.
+  * @author George McDonagh */
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_INLINE const Plane& Frustum::plane(int i) const
+	{
+		return m_planes[i];
+	}
+
+	ENGINE_MATHS_INLINE bool Frustum::test(const Vec3& point) const
+	{
+		for (int i = 0; i < 6; i++)
+			if (m_planes[i].signedDistance(point) < 0.0f)
+				return false;
+
+		return true;
+	}
+
+	ENGINE_MATHS_INLINE bool Frustum::test(const Sphere& sphere) const
+	{
+		for (int i = 0; i < 6; i++)
+			if (m_planes[i].signedDistance(sphere.center()) < -sphere.radius())
+				return false;
+
+		return true;
+	}
+
+	ENGINE_MATHS_INLINE bool Frustum::test(const AABB& aabb) const
+	{
+		for (int i = 0; i < 6; i++)
+		{
+			// Only the corner furthest along the plane's normal needs testing; if that's outside, the whole box is.
+			const Vec3& n = m_planes[i].normal();
+			Vec3 corner(
+				n.x() >= 0.0f ? aabb.max().x() : aabb.min().x(),
+				n.y() >= 0.0f ? aabb.max().y() : aabb.min().y(),
+				n.z() >= 0.0f ? aabb.max().z() : aabb.min().z());
+
+			if (m_planes[i].signedDistance(corner) < 0.0f)
+				return false;
+		}
+
+		return true;
+	}
+
+} }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+/*!
+  * @file plane.h
+  * @brief Header file for the Plane class.
+  * @author George McDonagh */
+
+
+// Local includes
+
+#include "maths/maths.h"
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	//! An infinite plane.
+	/*! Stored as a normal and a distance such that points on the plane satisfy @c dot(normal, point) @c + @c distance @c == @c 0.
+	  * Points on the side the normal faces have a positive signed distance. */
+	class Plane
+	{
+	public:
+		//! Constructs the plane through the origin facing +Y.
+		ENGINE_MATHS_CONSTEXPR Plane();
+
+		//! Constructs a plane from a normal and a distance.
+		/*! @param normal The plane's normal. Should be unit length for signedDistance() to return true distances.
+		  * @param distance The plane's distance term. The plane passes through @c -distance @c * @c normal when @p normal is unit length. */
+		ENGINE_MATHS_CONSTEXPR Plane(const Vec3& normal, float distance);
+
+		//! Constructs a plane from a normal and a point on the plane.
+		/*! @param normal The plane's normal.
+		  * @param point Any point on the plane. */
+		ENGINE_MATHS_CONSTEXPR Plane(const Vec3& normal, const Vec3& point);
+
+		//! Constructs a plane from the coefficients of its equation, @c ax @c + @c by @c + @c cz @c + @c d @c = @c 0.
+		ENGINE_MATHS_CONSTEXPR Plane(float a, float b, float c, float d);
+
+		//! Plane's normal.
+		/*! @return Read-only reference to the plane's normal. */
+		ENGINE_MATHS_CONSTEXPR const Vec3& normal() const;
+
+		//! Plane's distance term.
+		/*! @return Read-only reference to the plane's distance term. */
+		ENGINE_MATHS_CONSTEXPR const float& distance() const;
+
+		//! Plane's normal.
+		/*! @return Modifiable reference to the plane's normal. */
+		Vec3& normal();
+
+		//! Plane's distance term.
+		/*! @return Modifiable reference to the plane's distance term. */
+		float& distance();
+
+		//! Get the signed distance from the plane to a point.
+		/*! @param point A point.
+		  * @return The distance from the plane to @p point, scaled by the length of the plane's normal. Positive on the side the normal faces. */
+		ENGINE_MATHS_CONSTEXPR float signedDistance(const Vec3& point) const;
+
+		//! Normalizes the plane so that its normal is unit length.
+		void normalize();
+
+	private:
+		Vec3 m_normal; /*!< The plane's normal. */
+		float m_distance; /*!< The plane's distance term. */
+	};
+
+} }
\ No newline at end of file
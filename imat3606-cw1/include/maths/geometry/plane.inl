@@ -0,0 +1,61 @@
+#pragma once
+
+/*!
+  * @file plane.inl
+  * @brief Inline definitions for the Plane class.
+  * @author George McDonagh */
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_CONSTEXPR Plane::Plane()
+		: m_normal(0.0f, 1.0f, 0.0f), m_distance(0.0f)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Plane::Plane(const Vec3& normal, float distance)
+		: m_normal(normal), m_distance(distance)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Plane::Plane(const Vec3& normal, const Vec3& point)
+		: m_normal(normal), m_distance(-dot(normal, point))
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Plane::Plane(float a, float b, float c, float d)
+		: m_normal(a, b, c), m_distance(d)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR const Vec3& Plane::normal() const
+	{
+		return m_normal;
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Plane::distance() const
+	{
+		return m_distance;
+	}
+
+	ENGINE_MATHS_INLINE Vec3& Plane::normal()
+	{
+		return m_normal;
+	}
+
+	ENGINE_MATHS_INLINE float& Plane::distance()
+	{
+		return m_distance;
+	}
+
+	ENGINE_MATHS_CONSTEXPR float Plane::signedDistance(const Vec3& point) const
+	{
+		return dot(m_normal, point) + m_distance;
+	}
+
+	ENGINE_MATHS_INLINE void Plane::normalize()
+	{
+		float invLength = 1.0f / m_normal.magnitude();
+		m_normal = m_normal * invLength;
+		m_distance *= invLength;
+	}
+
+} }
\ No newline at end of file
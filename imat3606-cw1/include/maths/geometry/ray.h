@@ -0,0 +1,58 @@
+#pragma once
+
+/*!
+  * @file ray.h
+  * @brief Header file for the Ray class.
+  * @author George McDonagh */
+
+
+// Local includes
+
+#include "maths/maths.h"
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	//! A ray, starting at an origin and extending forever in one direction.
+	/*! The direction needn't be unit length. Hit distances from intersect() are in multiples of the direction, so with a unit direction they are
+	  * distances in world units. */
+	class Ray
+	{
+	public:
+		//! Constructs a ray at the origin pointing down -Z.
+		ENGINE_MATHS_CONSTEXPR Ray();
+
+		//! Constructs a ray with a specified origin and direction.
+		/*! @param origin The ray's origin.
+		  * @param direction The ray's direction. */
+		ENGINE_MATHS_CONSTEXPR Ray(const Vec3& origin, const Vec3& direction);
+
+		//! Ray's origin.
+		/*! @return Read-only reference to the ray's origin. */
+		ENGINE_MATHS_CONSTEXPR const Vec3& origin() const;
+
+		//! Ray's direction.
+		/*! @return Read-only reference to the ray's direction. */
+		ENGINE_MATHS_CONSTEXPR const Vec3& direction() const;
+
+		//! Ray's origin.
+		/*! @return Modifiable reference to the ray's origin. */
+		Vec3& origin();
+
+		//! Ray's direction.
+		/*! @return Modifiable reference to the ray's direction. */
+		Vec3& direction();
+
+		//! Get a point along the ray.
+		/*! @param t The distance along the ray, in multiples of its direction.
+		  * @return The origin plus @p t times the direction. */
+		ENGINE_MATHS_CONSTEXPR Vec3 point(float t) const;
+
+	private:
+		Vec3 m_origin; /*!< The ray's origin. */
+		Vec3 m_direction; /*!< The ray's direction. */
+	};
+
+} }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+/*!
+  * @file ray.inl
+  * @brief Inline definitions for the Ray class.
+  * @author George McDonagh */
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_CONSTEXPR Ray::Ray()
+		: m_origin(0.0f), m_direction(0.0f, 0.0f, -1.0f)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Ray::Ray(const Vec3& origin, const Vec3& direction)
+		: m_origin(origin), m_direction(direction)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR const Vec3& Ray::origin() const
+	{
+		return m_origin;
+	}
+
+	ENGINE_MATHS_CONSTEXPR const Vec3& Ray::direction() const
+	{
+		return m_direction;
+	}
+
+	ENGINE_MATHS_INLINE Vec3& Ray::origin()
+	{
+		return m_origin;
+	}
+
+	ENGINE_MATHS_INLINE Vec3& Ray::direction()
+	{
+		return m_direction;
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec3 Ray::point(float t) const
+	{
+		return m_origin + m_direction * t;
+	}
+
+} }
\ No newline at end of file
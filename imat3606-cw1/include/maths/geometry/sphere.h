@@ -0,0 +1,61 @@
+#pragma once
+
+/*!
+  * @file sphere.h
+  * @brief Header file for the Sphere class.
+  * @author George McDonagh */
+
+
+// Local includes
+
+#include "maths/maths.h"
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	//! A bounding sphere.
+	class Sphere
+	{
+	public:
+		//! Constructs a sphere at the origin with a radius of zero.
+		ENGINE_MATHS_CONSTEXPR Sphere();
+
+		//! Constructs a sphere with a specified center and radius.
+		/*! @param center The sphere's center.
+		  * @param radius The sphere's radius. */
+		ENGINE_MATHS_CONSTEXPR Sphere(const Vec3& center, float radius);
+
+		//! Sphere's center.
+		/*! @return Read-only reference to the sphere's center. */
+		ENGINE_MATHS_CONSTEXPR const Vec3& center() const;
+
+		//! Sphere's radius.
+		/*! @return Read-only reference to the sphere's radius. */
+		ENGINE_MATHS_CONSTEXPR const float& radius() const;
+
+		//! Sphere's center.
+		/*! @return Modifiable reference to the sphere's center. */
+		Vec3& center();
+
+		//! Sphere's radius.
+		/*! @return Modifiable reference to the sphere's radius. */
+		float& radius();
+
+		//! Check whether a point is inside the sphere.
+		/*! @param point A point.
+		  * @return True if @p point is inside or on the surface of the sphere. */
+		ENGINE_MATHS_CONSTEXPR bool contains(const Vec3& point) const;
+
+		//! Check whether two spheres overlap.
+		/*! @param sphere Another sphere.
+		  * @return True if the spheres overlap or touch. */
+		ENGINE_MATHS_CONSTEXPR bool intersects(const Sphere& sphere) const;
+
+	private:
+		Vec3 m_center; /*!< The sphere's center. */
+		float m_radius; /*!< The sphere's radius. */
+	};
+
+} }
\ No newline at end of file
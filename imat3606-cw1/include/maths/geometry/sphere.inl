@@ -0,0 +1,51 @@
+#pragma once
+
+/*!
+  * @file sphere.inl
+  * @brief Inline definitions for the Sphere class.
+  * @author George McDonagh */
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_CONSTEXPR Sphere::Sphere()
+		: m_center(0.0f), m_radius(0.0f)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Sphere::Sphere(const Vec3& center, float radius)
+		: m_center(center), m_radius(radius)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR const Vec3& Sphere::center() const
+	{
+		return m_center;
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Sphere::radius() const
+	{
+		return m_radius;
+	}
+
+	ENGINE_MATHS_INLINE Vec3& Sphere::center()
+	{
+		return m_center;
+	}
+
+	ENGINE_MATHS_INLINE float& Sphere::radius()
+	{
+		return m_radius;
+	}
+
+	ENGINE_MATHS_CONSTEXPR bool Sphere::contains(const Vec3& point) const
+	{
+		return dot(point - m_center, point - m_center) <= m_radius * m_radius;
+	}
+
+	ENGINE_MATHS_CONSTEXPR bool Sphere::intersects(const Sphere& sphere) const
+	{
+		return dot(sphere.m_center - m_center, sphere.m_center - m_center) <= (m_radius + sphere.m_radius) * (m_radius + sphere.m_radius);
+	}
+
+} }
\ No newline at end of file
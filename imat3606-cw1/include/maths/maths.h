@@ -9,6 +9,20 @@
 // External includes
 
 #include <math.h>
+#include <stddef.h>
+
+
+// Macros
+
+// The maths classes and the small nonmember functions are defined in .inl files which this header includes, so that they can be inlined into the code using them
+// ... and so that the constexpr ones can be evaluated at compile time. Define ENGINE_MATHS_OUT_OF_LINE to compile them in their .cpp files instead, as they used to be.
+#ifdef ENGINE_MATHS_OUT_OF_LINE
+#define ENGINE_MATHS_INLINE
+#define ENGINE_MATHS_CONSTEXPR
+#else
+#define ENGINE_MATHS_INLINE inline
+#define ENGINE_MATHS_CONSTEXPR constexpr
+#endif
 
 
 // Forward declare classes before including their header files.
@@ -23,18 +37,40 @@ namespace engine { namespace maths {
 	class Vec3;
 	class Vec4;
 
+	class Vec3Stream;
+	class Vec4Stream;
+
+	class Quat;
+
+	class Plane;
+	class AABB;
+	class Sphere;
+	class Frustum;
+	class Ray;
+
 } }
 
 
 // Local includes
 
-#include "matrix\mat2.h"
-#include "matrix\mat3.h"
-#include "matrix\mat4.h"
+#include "matrix/mat2.h"
+#include "matrix/mat3.h"
+#include "matrix/mat4.h"
 
-#include "vector\vec2.h"
-#include "vector\vec3.h"
-#include "vector\vec4.h"
+#include "vector/vec2.h"
+#include "vector/vec3.h"
+#include "vector/vec4.h"
+
+#include "vector/vec3_stream.h"
+#include "vector/vec4_stream.h"
+
+#include "quaternion/quat.h"
+
+#include "geometry/plane.h"
+#include "geometry/aabb.h"
+#include "geometry/sphere.h"
+#include "geometry/frustum.h"
+#include "geometry/ray.h"
 
 
 // Macros
@@ -49,12 +85,12 @@ namespace engine { namespace maths {
 	//! Convert radians to degrees.
 	/*! @param radians Value of radians to convert to degrees. 
 	  * @return Value of @p radians converted to degrees. */
-	float degrees(float radians);
+	ENGINE_MATHS_CONSTEXPR float degrees(float radians);
 
 	//! Convert degrees to radians.
 	/*! @param degrees Value of degrees to convert to radians.
 	  * @return Value of @p degrees converted to radians. */
-	float radians(float degrees);
+	ENGINE_MATHS_CONSTEXPR float radians(float degrees);
 
 	//! Get a vector's unit vector.
 	/*! Calculates and returns a vector's unit-length vector.
@@ -78,36 +114,36 @@ namespace engine { namespace maths {
 	/*! @param vec3a The first vector. 
 	  * @param vec3b The second vector.
 	  * @return The dot product of @p vec3a and @p vec3b. */
-	float dot(const Vec3& vec3a, const Vec3& vec3b);
+	ENGINE_MATHS_CONSTEXPR float dot(const Vec3& vec3a, const Vec3& vec3b);
 
 	//! Find the cross product of two three-component vectors.
 	/*! Calculates the cross product of two three-component vectors.
 	  * @param vec3a The first vector. 
 	  * @param vec3b The second vector.
 	  * @return A three-component vector perpendicular to both @p vec3a and @p vec3b. */
-	Vec3 cross(const Vec3& vec3a, const Vec3& vec3b);
+	ENGINE_MATHS_CONSTEXPR Vec3 cross(const Vec3& vec3a, const Vec3& vec3b);
 
 	//! A 2x2 identity matrix.
 	/*! @return A 2x2 matrix with a value of 1 assigned to its diagonal components. */
-	Mat2 identityMat2();
+	ENGINE_MATHS_CONSTEXPR Mat2 identityMat2();
 
 	//! A 3x3 identity matrix.
 	/*! @return A 3x3 matrix with a value of 1 assigned to its diagonal components. */
-	Mat3 identityMat3();
+	ENGINE_MATHS_CONSTEXPR Mat3 identityMat3();
 
 	//! A 4x4 identity matrix.
 	/*! @return A 4x4 matrix with a value of 1 assigned to its diagonal components. */
-	Mat4 identityMat4();
+	ENGINE_MATHS_CONSTEXPR Mat4 identityMat4();
 
 	//! Create a translation matrix from a three-component vector.
 	/*! @param t A three-component vector.
 	  * @return A 4x4 identity matrix with the first three components of its fourth column assigned the values of @p t. */
-	Mat4 translation(const Vec3& t);
+	ENGINE_MATHS_CONSTEXPR Mat4 translation(const Vec3& t);
 
 	//! Create a scale matrix from a three-component vector.
 	/*! @param s A three-component vector. 
 	  * @return A 4x4 matrix with the first three diagonal components assigned the values of @p s. */
-	Mat4 scale(const Vec3& s);
+	ENGINE_MATHS_CONSTEXPR Mat4 scale(const Vec3& s);
 
 	//! Create a rotation matrix which rotates around the X axis.
 	/*! @param Number of degrees to rotate around X.
@@ -125,10 +161,55 @@ namespace engine { namespace maths {
 	Mat4 rotationZ(float degrees);
 
 	//! Creates a rotation matrix which rotates around all three axis.
-	/*! @param r A three-component vector.
+	/*! Equivalent to rotationEuler().
+	  * @param r A three-component vector.
 	  * @return A 4x4 rotation matrix which combines rotations around X, Y, and Z. */
 	Mat4 rotation(const Vec3& r);
 
+	//! Create a rotation matrix from Euler angles.
+	/*! Builds @c rotationZ(r.z()) * @c rotationY(r.y()) * @c rotationX(r.x()) in closed form, with one sine and cosine per axis and no matrix products.
+	  * @param r The angles to rotate around X, then Y, then Z, in degrees.
+	  * @return A 4x4 rotation matrix. */
+	Mat4 rotationEuler(const Vec3& r);
+
+	//! Create a rotation matrix from a quaternion.
+	/*! @param quat A unit quaternion.
+	  * @return A 4x4 matrix which applies the same rotation as @p quat. */
+	ENGINE_MATHS_CONSTEXPR Mat4 rotation(const Quat& quat);
+
+	//! Create a 3x3 rotation matrix from a quaternion.
+	/*! @param quat A unit quaternion.
+	  * @return A 3x3 matrix which applies the same rotation as @p quat. */
+	ENGINE_MATHS_CONSTEXPR Mat3 rotationMat3(const Quat& quat);
+
+	//! Create a quaternion which rotates around an axis.
+	/*! @param axis The axis to rotate around. Must be unit length.
+	  * @param degrees Number of degrees to rotate around @p axis.
+	  * @return A unit quaternion. */
+	Quat rotationQuat(const Vec3& axis, float degrees);
+
+	//! Create a quaternion which rotates around all three axis.
+	/*! Uses the same convention as rotation(const Vec3&): rotates around X, then Y, then Z.
+	  * @param r A three-component vector of rotations in degrees.
+	  * @return A unit quaternion. */
+	Quat rotationQuat(const Vec3& r);
+
+	//! Create a quaternion from the rotation in a 3x3 matrix.
+	/*! @param mat3 A 3x3 rotation matrix. Must be orthonormal.
+	  * @return A unit quaternion. */
+	Quat rotationQuat(const Mat3& mat3);
+
+	//! Create a quaternion from the rotation in a 4x4 matrix.
+	/*! @param mat4 A 4x4 matrix whose upper 3x3 is a rotation matrix.
+	  * @return A unit quaternion. */
+	Quat rotationQuat(const Mat4& mat4);
+
+	//! Get a quaternion's rotation as Euler angles.
+	/*! The inverse of rotationQuat(const Vec3&). The Y angle is in the range [-90, 90]; the X and Z angles are in the range [-180, 180].
+	  * @param quat A unit quaternion.
+	  * @return The rotations around X, Y, and Z in degrees. */
+	Vec3 eulerAngles(const Quat& quat);
+
 	//! Calculate the inverse of a 2x2 matrix.
 	/*! @param mat2 A 2x2 matrix.
 	  * @return The inverse of @p mat2. */
@@ -143,21 +224,71 @@ namespace engine { namespace maths {
 	/*! @param mat4 A 4x4 matrix.
 	  * @return The inverse of @p mat4. */
 	Mat4 inverse(const Mat4& mat4);
+
+	//! Calculate the inverse of an affine 4x4 matrix.
+	/*! Faster than inverse(const Mat4&) but only valid for matrices whose bottom row is (0, 0, 0, 1), such as any combination of translations, rotations, and scales.
+	  * @param mat4 An affine 4x4 matrix.
+	  * @return The inverse of @p mat4. */
+	Mat4 inverseAffine(const Mat4& mat4);
+
+	//! Calculate the inverse of a rigid 4x4 matrix.
+	/*! Faster than inverseAffine() but only valid for matrices made up of only rotations and translations (no scale or shear), such as view matrices.
+	  * @param mat4 A 4x4 matrix with an orthonormal upper 3x3 and a bottom row of (0, 0, 0, 1).
+	  * @return The inverse of @p mat4. */
+	Mat4 inverseRigid(const Mat4& mat4);
+
+	//! Calculate the inverse of a quaternion.
+	/*! For a unit quaternion this is its conjugate, the opposite rotation.
+	  * @param quat A quaternion.
+	  * @return The inverse of @p quat. */
+	ENGINE_MATHS_CONSTEXPR Quat inverse(const Quat& quat);
+
+	//! Calculate the conjugate of a quaternion.
+	/*! @param quat A quaternion.
+	  * @return @p quat with its vector part negated. */
+	ENGINE_MATHS_CONSTEXPR Quat conjugate(const Quat& quat);
+
+	//! Find the dot product of two quaternions.
+	/*! @param quatA The first quaternion.
+	  * @param quatB The second quaternion.
+	  * @return The dot product of @p quatA and @p quatB. */
+	ENGINE_MATHS_CONSTEXPR float dot(const Quat& quatA, const Quat& quatB);
+
+	//! Get a quaternion's unit quaternion.
+	/*! @param quat A quaternion.
+	  * @return @p quat's normalized quaternion. */
+	Quat normalize(const Quat& quat);
+
+	//! Normalized linear interpolation between two rotations.
+	/*! Cheaper than slerp() but doesn't rotate at a constant speed as @p t changes. Always takes the shortest path.
+	  * @param quatA The rotation at @p t = 0.
+	  * @param quatB The rotation at @p t = 1.
+	  * @param t The interpolation factor.
+	  * @return A unit quaternion between @p quatA and @p quatB. */
+	Quat nlerp(const Quat& quatA, const Quat& quatB, float t);
+
+	//! Spherical linear interpolation between two rotations.
+	/*! Rotates at a constant speed as @p t changes. Always takes the shortest path.
+	  * @param quatA The rotation at @p t = 0.
+	  * @param quatB The rotation at @p t = 1.
+	  * @param t The interpolation factor.
+	  * @return A unit quaternion between @p quatA and @p quatB. */
+	Quat slerp(const Quat& quatA, const Quat& quatB, float t);
 	
 	//! Calculate the transpose of a 2x2 matrix.
 	/*! @param mat2 A 2x2 matrix.
 	  * @return The transpose of @p mat2. */
-	Mat2 transpose(const Mat2& mat2);
+	ENGINE_MATHS_CONSTEXPR Mat2 transpose(const Mat2& mat2);
 
 	//! Calculate the transpose of a 3x3 matrix.
 	/*! @param mat3 A 3x3 matrix.
 	  * @return The transpose of @p mat3. */
-	Mat3 transpose(const Mat3& mat3);
+	ENGINE_MATHS_CONSTEXPR Mat3 transpose(const Mat3& mat3);
 
 	//! Calculate the transpose of a 4x4 matrix.
 	/*! @param mat4 A 4x4 matrix.
 	  * @return The transpose of @p mat4. */
-	Mat4 transpose(const Mat4& mat4);
+	ENGINE_MATHS_CONSTEXPR Mat4 transpose(const Mat4& mat4);
 
 	//! Create a LookAt matrix.
 	/*! Creates a LookAt matrix given an eye (camera) position, a forwards direction vector, and a up-direction vector. 
@@ -176,10 +307,253 @@ namespace engine { namespace maths {
 	  * @return Returns a 4x4 perspective projection matrix. */
 	Mat4 perspective(float fov, float aspect, float nearClip, float farClip);
 
+	//! Find the sines and cosines of an array of angles.
+	/*! Evaluates four or eight angles at a time where the CPU supports it. See simd::SinCosKernel for the accuracy compared to std::sin() and std::cos().
+	  * @param angles The angles, in radians. Must be within [-8192, 8192].
+	  * @param sines The array to write the @p count sines to. May be the same array as @p angles.
+	  * @param cosines The array to write the @p count cosines to. May be the same array as @p angles, but not @p sines.
+	  * @param count The number of angles. */
+	void sinCos(const float* angles, float* sines, float* cosines, size_t count);
+
+	//! Transform an array of points by a 4x4 matrix.
+	/*! Each point is treated as having a W component of 1, so it is affected by the matrix's translation. The resulting W component is discarded.
+	  * @param m The transform matrix.
+	  * @param in The points to transform.
+	  * @param out The array to write the @p count transformed points to. May be the same array as @p in.
+	  * @param count The number of points to transform. */
+	void transformPoints(const Mat4& m, const Vec3* in, Vec3* out, size_t count);
+
+	//! Transform an array of directions by a 4x4 matrix.
+	/*! Each direction is treated as having a W component of 0, so it is unaffected by the matrix's translation. The directions are not re-normalized.
+	  * @param m The transform matrix.
+	  * @param in The directions to transform.
+	  * @param out The array to write the @p count transformed directions to. May be the same array as @p in.
+	  * @param count The number of directions to transform. */
+	void transformDirections(const Mat4& m, const Vec3* in, Vec3* out, size_t count);
+
+	//! Transform points stored as separate X, Y, and Z arrays by a 4x4 matrix.
+	/*! The structure-of-arrays equivalent of transformPoints(const Mat4&, const Vec3*, Vec3*, size_t). The output arrays may be the same arrays as the input arrays. */
+	void transformPoints(const Mat4& m, const float* inX, const float* inY, const float* inZ, float* outX, float* outY, float* outZ, size_t count);
+
+	//! Transform directions stored as separate X, Y, and Z arrays by a 4x4 matrix.
+	/*! The structure-of-arrays equivalent of transformDirections(const Mat4&, const Vec3*, Vec3*, size_t). The output arrays may be the same arrays as the input arrays. */
+	void transformDirections(const Mat4& m, const float* inX, const float* inY, const float* inZ, float* outX, float* outY, float* outZ, size_t count);
+
+	//! Add two streams of three-component vectors.
+	/*! @param a The first stream.
+	  * @param b The second stream. Must be the same size as @p a.
+	  * @param out The stream to write @c a[i] + @c b[i] to. Resized to match @p a, and may be @p a or @p b. */
+	void add(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out);
+
+	//! Subtract one stream of three-component vectors from another.
+	/*! @param a The first stream.
+	  * @param b The second stream. Must be the same size as @p a.
+	  * @param out The stream to write @c a[i] - @c b[i] to. Resized to match @p a, and may be @p a or @p b. */
+	void subtract(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out);
+
+	//! Multiply two streams of three-component vectors component-wise.
+	/*! @param a The first stream.
+	  * @param b The second stream. Must be the same size as @p a.
+	  * @param out The stream to write @c a[i] * @c b[i] to. Resized to match @p a, and may be @p a or @p b. */
+	void multiply(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out);
+
+	//! Scale a stream of three-component vectors.
+	/*! @param a The stream to scale.
+	  * @param s The scale factor.
+	  * @param out The stream to write @c a[i] * @p s to. Resized to match @p a, and may be @p a. */
+	void multiply(const Vec3Stream& a, float s, Vec3Stream& out);
+
+	//! Multiply two streams of three-component vectors component-wise and add a third.
+	/*! @param a The first stream.
+	  * @param b The second stream. Must be the same size as @p a.
+	  * @param c The stream to add. Must be the same size as @p a.
+	  * @param out The stream to write @c a[i] * @c b[i] + @c c[i] to. Resized to match @p a, and may be any of the inputs. */
+	void multiplyAdd(const Vec3Stream& a, const Vec3Stream& b, const Vec3Stream& c, Vec3Stream& out);
+
+	//! Scale a stream of three-component vectors and add another.
+	/*! For example, @c multiplyAdd(velocities, dt, positions, positions) integrates a stream of positions.
+	  * @param a The stream to scale.
+	  * @param s The scale factor.
+	  * @param c The stream to add. Must be the same size as @p a.
+	  * @param out The stream to write @c a[i] * @p s + @c c[i] to. Resized to match @p a, and may be @p a or @p c. */
+	void multiplyAdd(const Vec3Stream& a, float s, const Vec3Stream& c, Vec3Stream& out);
+
+	//! Find the dot products of two streams of three-component vectors.
+	/*! @param a The first stream.
+	  * @param b The second stream. Must be the same size as @p a.
+	  * @param out The array to write the dot products to. Must have room for @c a.size() floats. */
+	void dot(const Vec3Stream& a, const Vec3Stream& b, float* out);
+
+	//! Find the magnitudes of a stream of three-component vectors.
+	/*! @param vectors The stream.
+	  * @param out The array to write the magnitudes to. Must have room for @c vectors.size() floats. */
+	void length(const Vec3Stream& vectors, float* out);
+
+	//! Normalize a stream of three-component vectors.
+	/*! @param vectors The stream to normalize.
+	  * @param out The stream to write the unit vectors to. Resized to match @p vectors, and may be @p vectors. */
+	void normalize(const Vec3Stream& vectors, Vec3Stream& out);
+
+	//! Add two streams of four-component vectors.
+	/*! @param a The first stream.
+	  * @param b The second stream. Must be the same size as @p a.
+	  * @param out The stream to write @c a[i] + @c b[i] to. Resized to match @p a, and may be @p a or @p b. */
+	void add(const Vec4Stream& a, const Vec4Stream& b, Vec4Stream& out);
+
+	//! Subtract one stream of four-component vectors from another.
+	/*! @param a The first stream.
+	  * @param b The second stream. Must be the same size as @p a.
+	  * @param out The stream to write @c a[i] - @c b[i] to. Resized to match @p a, and may be @p a or @p b. */
+	void subtract(const Vec4Stream& a, const Vec4Stream& b, Vec4Stream& out);
+
+	//! Multiply two streams of four-component vectors component-wise.
+	/*! @param a The first stream.
+	  * @param b The second stream. Must be the same size as @p a.
+	  * @param out The stream to write @c a[i] * @c b[i] to. Resized to match @p a, and may be @p a or @p b. */
+	void multiply(const Vec4Stream& a, const Vec4Stream& b, Vec4Stream& out);
+
+	//! Scale a stream of four-component vectors.
+	/*! @param a The stream to scale.
+	  * @param s The scale factor.
+	  * @param out The stream to write @c a[i] * @p s to. Resized to match @p a, and may be @p a. */
+	void multiply(const Vec4Stream& a, float s, Vec4Stream& out);
+
+	//! Multiply two streams of four-component vectors component-wise and add a third.
+	/*! @param a The first stream.
+	  * @param b The second stream. Must be the same size as @p a.
+	  * @param c The stream to add. Must be the same size as @p a.
+	  * @param out The stream to write @c a[i] * @c b[i] + @c c[i] to. Resized to match @p a, and may be any of the inputs. */
+	void multiplyAdd(const Vec4Stream& a, const Vec4Stream& b, const Vec4Stream& c, Vec4Stream& out);
+
+	//! Scale a stream of four-component vectors and add another.
+	/*! For example, @c multiplyAdd(velocities, dt, positions, positions) integrates a stream of positions.
+	  * @param a The stream to scale.
+	  * @param s The scale factor.
+	  * @param c The stream to add. Must be the same size as @p a.
+	  * @param out The stream to write @c a[i] * @p s + @c c[i] to. Resized to match @p a, and may be @p a or @p c. */
+	void multiplyAdd(const Vec4Stream& a, float s, const Vec4Stream& c, Vec4Stream& out);
+
+	//! Find the dot products of two streams of four-component vectors.
+	/*! @param a The first stream.
+	  * @param b The second stream. Must be the same size as @p a.
+	  * @param out The array to write the dot products to. Must have room for @c a.size() floats. */
+	void dot(const Vec4Stream& a, const Vec4Stream& b, float* out);
+
+	//! Find the magnitudes of a stream of four-component vectors.
+	/*! @param vectors The stream.
+	  * @param out The array to write the magnitudes to. Must have room for @c vectors.size() floats. */
+	void length(const Vec4Stream& vectors, float* out);
+
+	//! Normalize a stream of four-component vectors.
+	/*! @param vectors The stream to normalize.
+	  * @param out The stream to write the unit vectors to. Resized to match @p vectors, and may be @p vectors. */
+	void normalize(const Vec4Stream& vectors, Vec4Stream& out);
+
+	//! Find the cross products of two streams of three-component vectors.
+	/*! @param a The first stream.
+	  * @param b The second stream. Must be the same size as @p a.
+	  * @param out The stream to write the cross products of @c a[i] and @c b[i] to. Resized to match @p a, and may be @p a or @p b. */
+	void cross(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out);
+
+	//! Transform a stream of points by a 4x4 matrix.
+	/*! The stream equivalent of transformPoints(const Mat4&, const Vec3*, Vec3*, size_t).
+	  * @param out The stream to write the transformed points to. Resized to match @p in, and may be @p in. */
+	void transformPoints(const Mat4& m, const Vec3Stream& in, Vec3Stream& out);
+
+	//! Transform a stream of directions by a 4x4 matrix.
+	/*! The stream equivalent of transformDirections(const Mat4&, const Vec3*, Vec3*, size_t).
+	  * @param out The stream to write the transformed directions to. Resized to match @p in, and may be @p in. */
+	void transformDirections(const Mat4& m, const Vec3Stream& in, Vec3Stream& out);
+
+	//! Transform an axis-aligned bounding box by a 4x4 matrix.
+	/*! @param m An affine transform matrix.
+	  * @param aabb A box.
+	  * @return The smallest axis-aligned box containing @p aabb's corners after transforming them by @p m. */
+	AABB transform(const Mat4& m, const AABB& aabb);
+
+	//! Intersect a ray with an axis-aligned bounding box.
+	/*! Uses the slab test. Gives the same results as the scalar simd::rayAABB kernel.
+	  * @param ray A ray.
+	  * @param aabb A box.
+	  * @param t Set to the distance along @p ray to the nearest hit, in multiples of its direction, or 0 if @p ray starts inside @p aabb. Left unchanged if @p ray misses.
+	  * @return True if @p ray hits @p aabb. */
+	bool intersect(const Ray& ray, const AABB& aabb, float& t);
+
+	//! Intersect a ray with a sphere.
+	/*! @param ray A ray.
+	  * @param sphere A sphere.
+	  * @param t Set to the distance along @p ray to the nearest hit, in multiples of its direction, or 0 if @p ray starts inside @p sphere. Left unchanged if @p ray misses.
+	  * @return True if @p ray hits @p sphere. */
+	bool intersect(const Ray& ray, const Sphere& sphere, float& t);
+
+	//! Intersect a ray with a triangle.
+	/*! Uses the Moller-Trumbore algorithm. Both sides of the triangle are hit.
+	  * @param ray A ray.
+	  * @param a The triangle's first corner.
+	  * @param b The triangle's second corner.
+	  * @param c The triangle's third corner.
+	  * @param t Set to the distance along @p ray to the hit, in multiples of its direction. Left unchanged if @p ray misses.
+	  * @return True if @p ray hits the triangle. */
+	bool intersect(const Ray& ray, const Vec3& a, const Vec3& b, const Vec3& c, float& t);
+
+	//! Intersect a stream of rays with an axis-aligned bounding box.
+	/*! Tests four (SSE2) or eight (AVX) rays at a time. Use this to test many rays against the same box, for example when picking or baking lights.
+	  * @param origins The rays' origins.
+	  * @param directions The rays' directions. Must be the same size as @p origins.
+	  * @param aabb A box.
+	  * @param t The array to write each ray's hit distance to, as intersect(const Ray&, const AABB&, float&) would, or infinity where the ray misses. */
+	void intersect(const Vec3Stream& origins, const Vec3Stream& directions, const AABB& aabb, float* t);
+
+	//! Intersect a stream of rays with a sphere.
+	/*! The stream equivalent of intersect(const Ray&, const Sphere&, float&).
+	  * @param t The array to write each ray's hit distance to, or infinity where the ray misses. */
+	void intersect(const Vec3Stream& origins, const Vec3Stream& directions, const Sphere& sphere, float* t);
+
+	//! Intersect a stream of rays with a triangle.
+	/*! The stream equivalent of intersect(const Ray&, const Vec3&, const Vec3&, const Vec3&, float&).
+	  * @param t The array to write each ray's hit distance to, or infinity where the ray misses. */
+	void intersect(const Vec3Stream& origins, const Vec3Stream& directions, const Vec3& a, const Vec3& b, const Vec3& c, float* t);
+
+	//! Find roughly how much of the screen each of a stream of bounding spheres covers.
+	/*! Tests four (SSE2) or eight (AVX) spheres at a time. Use this to pick a level of detail for each visible object.
+	  * @param centres The spheres' centres.
+	  * @param radii The spheres' radii. Must have room for @c centres.size() floats.
+	  * @param eye The camera's position.
+	  * @param scale The projection's Y scale, @c projection(1, 1) for a perspective projection matrix.
+	  * @param out The array to write each sphere's size to, as a fraction of the screen's height, found from its radius over its distance from
+	  * @p eye. Spheres around @p eye are given @p scale. Must have room for @c centres.size() floats. */
+	void screenSize(const Vec3Stream& centres, const float* radii, const Vec3& eye, float scale, float* out);
+
 	Mat2 operator*(float f, const Mat2& mat2);
 
 	Mat3 operator*(float f, const Mat3& mat3);
 
 	Mat4 operator*(float f, const Mat4& mat4);
 
-} }
\ No newline at end of file
+} }
+
+
+// Inline definitions
+
+#ifndef ENGINE_MATHS_OUT_OF_LINE
+#include "matrix/mat2.inl"
+#include "matrix/mat3.inl"
+#include "matrix/mat4.inl"
+
+#include "vector/vec2.inl"
+#include "vector/vec3.inl"
+#include "vector/vec4.inl"
+
+#include "vector/vec3_stream.inl"
+#include "vector/vec4_stream.inl"
+
+#include "quaternion/quat.inl"
+
+#include "geometry/plane.inl"
+#include "geometry/aabb.inl"
+#include "geometry/sphere.inl"
+#include "geometry/frustum.inl"
+#include "geometry/ray.inl"
+
+#include "maths.inl"
+#endif
\ No newline at end of file
@@ -0,0 +1,315 @@
+#pragma once
+
+/*!
+  * @file maths.inl
+  * @brief Inline definitions for the nonmember maths functions.
+  * @author George McDonagh */
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_CONSTEXPR float degrees(float radians)
+	{
+		return radians * 180.0f / MATH_PI;
+	}
+
+	ENGINE_MATHS_CONSTEXPR float radians(float degrees)
+	{
+		return degrees * MATH_PI / 180.0f;
+	}
+
+	ENGINE_MATHS_INLINE Vec2 normalize(const Vec2& vec2)
+	{
+		return vec2 / vec2.magnitude();
+	}
+
+	ENGINE_MATHS_INLINE Vec3 normalize(const Vec3& vec3)
+	{
+		return vec3 / vec3.magnitude();
+	}
+
+	ENGINE_MATHS_INLINE Vec4 normalize(const Vec4& vec4)
+	{
+		return vec4 / vec4.magnitude();
+	}
+
+	ENGINE_MATHS_CONSTEXPR float dot(const Vec3& vec3a, const Vec3& vec3b)
+	{
+		return vec3a.x() * vec3b.x() + vec3a.y() * vec3b.y() + vec3a.z() * vec3b.z();
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec3 cross(const Vec3& vec3a, const Vec3& vec3b)
+	{
+		return Vec3(
+			vec3a.y() * vec3b.z() - vec3a.z() * vec3b.y(),
+			vec3a.z() * vec3b.x() - vec3a.x() * vec3b.z(),
+			vec3a.x() * vec3b.y() - vec3a.y() * vec3b.x());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat2 identityMat2()
+	{
+		return Mat2();
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat3 identityMat3()
+	{
+		return Mat3();
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat4 identityMat4()
+	{
+		return Mat4();
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat4 translation(const Vec3& t)
+	{
+		return Mat4(
+			1.0f,  0.0f,  0.0f,  0.0f,
+			0.0f,  1.0f,  0.0f,  0.0f,
+			0.0f,  0.0f,  1.0f,  0.0f,
+			t.x(), t.y(), t.z(), 1.0f);
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat4 scale(const Vec3& s)
+	{
+		return Mat4(
+			s.x(), 0.0f,  0.0f,  0.0f,
+			0.0f,  s.y(), 0.0f,  0.0f,
+			0.0f,  0.0f,  s.z(), 0.0f,
+			0.0f,  0.0f,  0.0f,  1.0f);
+	}
+
+	ENGINE_MATHS_INLINE Mat4 rotationX(float x)
+	{
+		x = radians(x);
+		float s = sin(x), c = cos(x);
+
+		return Mat4(
+			1.0f,  0.0f, 0.0f, 0.0f,
+			0.0f,  c,    s,    0.0f,
+			0.0f, -s,    c,    0.0f,
+			0.0f,  0.0f, 0.0f, 1.0f);
+	}
+
+	ENGINE_MATHS_INLINE Mat4 rotationY(float y)
+	{
+		y = radians(y);
+		float s = sin(y), c = cos(y);
+
+		return Mat4(
+			c,    0.0f, -s,    0.0f,
+			0.0f, 1.0f,  0.0f, 0.0f,
+			s,    0.0f,  c,    0.0f,
+			0.0f, 0.0f,  0.0f, 1.0f);
+	}
+
+	ENGINE_MATHS_INLINE Mat4 rotationZ(float z)
+	{
+		z = radians(z);
+		float s = sin(z), c = cos(z);
+
+		return Mat4(
+			 c,    s,    0.0f, 0.0f,
+			-s,    c,    0.0f, 0.0f,
+			 0.0f, 0.0f, 1.0f, 0.0f,
+			 0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	ENGINE_MATHS_INLINE Mat4 rotation(const Vec3& r)
+	{
+		return rotationEuler(r);
+	}
+
+	ENGINE_MATHS_INLINE Mat4 rotationEuler(const Vec3& r)
+	{
+		// Expands rotationZ(r.z()) * rotationY(r.y()) * rotationX(r.x()).
+		float x = radians(r.x()), y = radians(r.y()), z = radians(r.z());
+
+		float sx = sin(x), cx = cos(x);
+		float sy = sin(y), cy = cos(y);
+		float sz = sin(z), cz = cos(z);
+
+		return Mat4(
+			cz * cy,
+			sz * cy,
+			-sy,
+			0.0f,
+
+			cz * sy * sx - sz * cx,
+			sz * sy * sx + cz * cx,
+			cy * sx,
+			0.0f,
+
+			cz * sy * cx + sz * sx,
+			sz * sy * cx - cz * sx,
+			cy * cx,
+			0.0f,
+
+			0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat4 rotation(const Quat& quat)
+	{
+		return Mat4(rotationMat3(quat));
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat3 rotationMat3(const Quat& quat)
+	{
+		return Mat3(
+			1.0f - 2.0f * (quat.y() * quat.y() + quat.z() * quat.z()),
+			2.0f * (quat.x() * quat.y() + quat.w() * quat.z()),
+			2.0f * (quat.x() * quat.z() - quat.w() * quat.y()),
+
+			2.0f * (quat.x() * quat.y() - quat.w() * quat.z()),
+			1.0f - 2.0f * (quat.x() * quat.x() + quat.z() * quat.z()),
+			2.0f * (quat.y() * quat.z() + quat.w() * quat.x()),
+
+			2.0f * (quat.x() * quat.z() + quat.w() * quat.y()),
+			2.0f * (quat.y() * quat.z() - quat.w() * quat.x()),
+			1.0f - 2.0f * (quat.x() * quat.x() + quat.y() * quat.y()));
+	}
+
+	ENGINE_MATHS_INLINE Quat rotationQuat(const Vec3& axis, float degrees)
+	{
+		float halfAngle = 0.5f * radians(degrees);
+		return Quat(axis * sin(halfAngle), cos(halfAngle));
+	}
+
+	ENGINE_MATHS_INLINE Quat rotationQuat(const Vec3& r)
+	{
+		// Expands rotationQuat(Z) * rotationQuat(Y) * rotationQuat(X).
+		float hx = 0.5f * radians(r.x());
+		float hy = 0.5f * radians(r.y());
+		float hz = 0.5f * radians(r.z());
+
+		float sx = sin(hx), cx = cos(hx);
+		float sy = sin(hy), cy = cos(hy);
+		float sz = sin(hz), cz = cos(hz);
+
+		return Quat(
+			cz * cy * sx - sz * sy * cx,
+			cz * sy * cx + sz * cy * sx,
+			sz * cy * cx - cz * sy * sx,
+			cz * cy * cx + sz * sy * sx);
+	}
+
+	ENGINE_MATHS_INLINE Quat rotationQuat(const Mat4& mat4)
+	{
+		return rotationQuat(Mat3(mat4));
+	}
+
+	ENGINE_MATHS_INLINE Mat2 inverse(const Mat2& mat2)
+	{
+		return (1.0f / mat2.determinant()) * Mat2(mat2(1, 1), -mat2(0, 1), -mat2(1, 0), mat2(0, 0));
+	}
+
+	ENGINE_MATHS_CONSTEXPR Quat inverse(const Quat& quat)
+	{
+		return conjugate(quat) * (1.0f / dot(quat, quat));
+	}
+
+	ENGINE_MATHS_CONSTEXPR Quat conjugate(const Quat& quat)
+	{
+		return Quat(-quat.x(), -quat.y(), -quat.z(), quat.w());
+	}
+
+	ENGINE_MATHS_CONSTEXPR float dot(const Quat& quatA, const Quat& quatB)
+	{
+		return quatA.x() * quatB.x() + quatA.y() * quatB.y() + quatA.z() * quatB.z() + quatA.w() * quatB.w();
+	}
+
+	ENGINE_MATHS_INLINE Quat normalize(const Quat& quat)
+	{
+		return quat * (1.0f / quat.magnitude());
+	}
+
+	ENGINE_MATHS_INLINE Quat nlerp(const Quat& quatA, const Quat& quatB, float t)
+	{
+		// q and -q are the same rotation; pick whichever of them is closest to quatA.
+		float b = dot(quatA, quatB) < 0.0f ? -t : t;
+		return normalize(quatA * (1.0f - t) + quatB * b);
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat2 transpose(const Mat2& mat2)
+	{
+		return Mat2(
+			mat2(0, 0), mat2(1, 0),
+			mat2(0, 1), mat2(1, 1));
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat3 transpose(const Mat3& mat3)
+	{
+		return Mat3(
+			mat3(0, 0), mat3(1, 0), mat3(2, 0),
+			mat3(0, 1), mat3(1, 1), mat3(2, 1),
+			mat3(0, 2), mat3(1, 2), mat3(2, 2));
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat4 transpose(const Mat4& mat4)
+	{
+		return Mat4(
+			mat4(0, 0), mat4(1, 0), mat4(2, 0), mat4(3, 0),
+			mat4(0, 1), mat4(1, 1), mat4(2, 1), mat4(3, 1),
+			mat4(0, 2), mat4(1, 2), mat4(2, 2), mat4(3, 2),
+			mat4(0, 3), mat4(1, 3), mat4(2, 3), mat4(3, 3));
+	}
+
+	ENGINE_MATHS_INLINE Mat4 lookAt(const Vec3& eye, const Vec3& at, const Vec3& up)
+	{
+		Vec3 zAxis = normalize(at - eye);
+		Vec3 xAxis = normalize(cross(up, zAxis));
+		Vec3 yAxis = cross(zAxis, xAxis);
+
+		return Mat4(
+			xAxis.x(),		yAxis.x(),		zAxis.x(),		0.0f,
+			xAxis.y(),		yAxis.y(),		zAxis.y(),		0.0f,
+			xAxis.z(),		yAxis.z(),		zAxis.z(),		0.0f,
+			dot(xAxis, eye), dot(yAxis, eye), dot(zAxis, eye), 1.0f);
+	}
+
+	ENGINE_MATHS_INLINE Mat4 perspective(float fov, float aspect, float nearClip, float farClip)
+	{
+		float yScale = 1.0f / tan(0.5f * fov);
+		float xScale = yScale / aspect;
+		float nearmfar = nearClip - farClip;
+
+		return Mat4(
+			xScale, 0,		0,								   0,
+			0,		yScale, 0,								   0,
+			0,		0,		(farClip + nearClip) / nearmfar,  -1,
+			0,		0,		2 * farClip * nearClip / nearmfar, 0);
+	}
+
+	ENGINE_MATHS_INLINE Mat2 operator*(float f, const Mat2& mat2)
+	{
+		Mat2 m(mat2);
+		for (int i = 0; i < 2; i++)
+			for (int j = 0; j < 2; j++)
+				m(i, j) *= f;
+
+		return m;
+	}
+
+	ENGINE_MATHS_INLINE Mat3 operator*(float f, const Mat3& mat3)
+	{
+		Mat3 m(mat3);
+		for (int i = 0; i < 3; i++)
+			for (int j = 0; j < 3; j++)
+				m(i, j) *= f;
+
+		return m;
+	}
+
+	ENGINE_MATHS_INLINE Mat4 operator*(float f, const Mat4& mat4)
+	{
+		Mat4 m(mat4);
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				m(i, j) *= f;
+
+		return m;
+	}
+
+} }
\ No newline at end of file
@@ -25,11 +25,11 @@ namespace engine { namespace maths {
 	public:
 		//! Construct a 2x2 Matrix.
 		/*! Constructs a 2x2 identity matrix. */
-		Mat2();
+		ENGINE_MATHS_CONSTEXPR Mat2();
 
 		//! Construct a 2x2 Matrix with a specific diagonal value.
 		/*! @param diagonal The value of the components on the diagonal. */
-		Mat2(float diagonal);
+		ENGINE_MATHS_CONSTEXPR Mat2(float diagonal);
 
 		//! Construct a 2x2 Matrix with specific components.
 		/*! @param values The values of the matrix in column-major order. */
@@ -40,20 +40,20 @@ namespace engine { namespace maths {
 		  * @param c1y Left-most column's Y component.
 		  * @param c2x Right-most column's X component.
 		  * @param c2y Right-most column's Y component. */
-		Mat2(float c1x, float c1y,
+		ENGINE_MATHS_CONSTEXPR Mat2(float c1x, float c1y,
 			float c2x, float c2y);
 
 		//! Construct a 2x2 Matrix with specific column data.
 		/*! @param col1 Left-most column.
 		  * @param col2 Right-most column. */
-		Mat2(const Vec2& col1, const Vec2& col2);
+		ENGINE_MATHS_CONSTEXPR Mat2(const Vec2& col1, const Vec2& col2);
 
 		//! Destructor.
-		~Mat2();
+		~Mat2() = default;
 
 		//! Get the determinant of the Mat2.
 		/*! @return The determinant of the Mat2. */
-		float determinant() const;
+		ENGINE_MATHS_CONSTEXPR float determinant() const;
 
 		//! Transpose the matrix.
 		/*! Flips the matrix components on the diagonal; the columns of the Mat2 become the rows and vice versa. */
@@ -61,7 +61,7 @@ namespace engine { namespace maths {
 
 		//! Get a pointer to the matrices elements.
 		/*! @return A pointer to the first component of the element. */
-		const float* const data_ptr() const;
+		ENGINE_MATHS_CONSTEXPR const float* const data_ptr() const;
 
 		//! Add two 2x2 matrix objects together.
 		/*! @param mat2 A 2x2 matrix object. */
@@ -73,11 +73,11 @@ namespace engine { namespace maths {
 
 		//! Multiply two 2x2 matrix objects together.
 		/*! @param mat2 A 2x2 matrix object. */
-		Mat2 operator*(const Mat2& mat2) const;
+		ENGINE_MATHS_CONSTEXPR Mat2 operator*(const Mat2& mat2) const;
 
 		//! Multiply a two-component vector by a 2x2 matrix.
 		/*! @param vec2 A two-component vector object. */
-		Vec2 operator*(const Vec2& vec2) const;
+		ENGINE_MATHS_CONSTEXPR Vec2 operator*(const Vec2& vec2) const;
 
 		//! Increment one matrix object's components by another's.
 		/*! @param mat2 A 2x2 matrix object. */
@@ -102,7 +102,7 @@ namespace engine { namespace maths {
 		//! Get a non-mutable reference of the matrix element at @c (col,row)
 		/*! @param col The component's column.
 		  * @param row The component's row. */
-		const float& operator()(int col, int row) const;
+		ENGINE_MATHS_CONSTEXPR const float& operator()(int col, int row) const;
 
 		//! Get a mutable reference of the matrix element at @c (col,row)
 		/*! @param col The component's column.
@@ -0,0 +1,141 @@
+#pragma once
+
+/*!
+  * @file mat2.inl
+  * @brief Inline definitions for the Mat2 class.
+  * @author George McDonagh */
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_CONSTEXPR Mat2::Mat2()
+		: Mat2(1.0f)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Mat2::Mat2(float diagonal)
+		: m_values{
+			diagonal, 0.0f,
+			0.0f, diagonal }
+	{ }
+
+	ENGINE_MATHS_INLINE Mat2::Mat2(float values[4])
+	{
+		for (int i = 0; i < 4; i++)
+			m_values[i] = values[i];
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat2::Mat2(float c1x, float c1y,
+		float c2x, float c2y)
+		: m_values{
+			c1x, c1y,
+			c2x, c2y }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Mat2::Mat2(const Vec2& col1, const Vec2& col2)
+		: m_values{
+			col1.x(), col1.y(),
+			col2.x(), col2.y() }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR float Mat2::determinant() const
+	{
+		return (m_values[0] * m_values[3]) - (m_values[2] * m_values[1]);
+	}
+
+	ENGINE_MATHS_INLINE void Mat2::transpose()
+	{
+		*this = maths::transpose(*this);
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float* const Mat2::data_ptr() const
+	{
+		return m_values;
+	}
+
+	ENGINE_MATHS_INLINE Mat2 Mat2::operator+(const Mat2& mat2) const
+	{
+		float m[4];
+
+		for (int i = 0; i < 4; i++)
+			m[i] = m_values[i] + mat2.m_values[i];
+
+		return Mat2(m);
+	}
+
+	ENGINE_MATHS_INLINE Mat2 Mat2::operator-(const Mat2& mat2) const
+	{
+		float m[4];
+
+		for (int i = 0; i < 4; i++)
+			m[i] = m_values[i] - mat2.m_values[i];
+
+		return Mat2(m);
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat2 Mat2::operator*(const Mat2& mat2) const
+	{
+		return Mat2(
+			m_values[0] * mat2.m_values[0] + m_values[2] * mat2.m_values[1],
+			m_values[1] * mat2.m_values[0] + m_values[3] * mat2.m_values[1],
+
+			m_values[0] * mat2.m_values[2] + m_values[2] * mat2.m_values[3],
+			m_values[1] * mat2.m_values[2] + m_values[3] * mat2.m_values[3]);
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec2 Mat2::operator*(const Vec2& vec2) const
+	{
+		return Vec2(
+			m_values[0] * vec2.x() + m_values[2] * vec2.y(),
+			m_values[1] * vec2.x() + m_values[3] * vec2.y());
+	}
+
+	ENGINE_MATHS_INLINE Mat2& Mat2::operator+=(const Mat2& mat2)
+	{
+		for (int i = 0; i < 4; i++)
+			m_values[i] += mat2.m_values[i];
+
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Mat2& Mat2::operator-=(const Mat2& mat2)
+	{
+		for (int i = 0; i < 4; i++)
+			m_values[i] -= mat2.m_values[i];
+
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Mat2& Mat2::operator*=(const Mat2& mat2)
+	{
+		*this = *this * mat2;
+
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE bool Mat2::operator==(const Mat2& mat2) const
+	{
+		for (int i = 0; i < 4; i++)
+			if (m_values[i] != mat2.m_values[i])
+				return false;
+
+		return true;
+	}
+
+	ENGINE_MATHS_INLINE bool Mat2::operator!=(const Mat2& mat2) const
+	{
+		return !(*this == mat2);
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Mat2::operator()(int col, int row) const
+	{
+		return m_values[2 * col + row];
+	}
+
+	ENGINE_MATHS_INLINE float& Mat2::operator()(int col, int row)
+	{
+		return m_values[2 * col + row];
+	}
+
+} }
\ No newline at end of file
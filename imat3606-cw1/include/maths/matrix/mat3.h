@@ -26,11 +26,11 @@ namespace engine { namespace maths {
 	public:
 		//! Default constructor.
 		/*! Constructs a 3x3 identity matrix. */
-		Mat3();
+		ENGINE_MATHS_CONSTEXPR Mat3();
 
 		//! Constructs a 3x3 matrix with a specified diagonal value.
 		/*! @param diagonal The value of the components on the diagonal. */
-		Mat3(float diagonal);
+		ENGINE_MATHS_CONSTEXPR Mat3(float diagonal);
 
 		//! Constructs a 3x3 matrix with specified components.
 		/*! @param values The values of the matrix in column-major order. */
@@ -46,7 +46,7 @@ namespace engine { namespace maths {
 		  * @param c3x Right-most column's X component.
 		  * @param c3y Right-most column's Y component.
 		  * @param c3z Right-most column's Z component. */
-		Mat3(float c1x, float c1y, float c1z,
+		ENGINE_MATHS_CONSTEXPR Mat3(float c1x, float c1y, float c1z,
 			float c2x, float c2y, float c2z,
 			float c3x, float c3y, float c3z);
 
@@ -54,18 +54,18 @@ namespace engine { namespace maths {
 		/*! @param col1 Left-most column.
 		  * @param col2 Middle column. 
 		  * @param col3 Right-most column. */
-		Mat3(const Vec3& col1, const Vec3& col2, const Vec3& col3);
+		ENGINE_MATHS_CONSTEXPR Mat3(const Vec3& col1, const Vec3& col2, const Vec3& col3);
 
 		//! Constructs a 3x3 matrix using the top left components of a 4x4.
 		/*! @param mat4 A 4x4 matrix. */
-		Mat3(const Mat4& mat4);
+		ENGINE_MATHS_CONSTEXPR Mat3(const Mat4& mat4);
 
 		//! Destructor.
-		~Mat3();
+		~Mat3() = default;
 
 		//! Get the determinant of the Mat3.
 		/*! @return The determinant of the Mat3. */
-		float determinant() const;
+		ENGINE_MATHS_CONSTEXPR float determinant() const;
 
 		//! Transpose the matrix.
 		/*! Flips the matrix components on the diagonal; makes the columns of the matrix become the rows of the matrix and vice versa. */
@@ -73,7 +73,7 @@ namespace engine { namespace maths {
 
 		//! Get a pointer to the matrices elements.
 		/*! @return A pointer to the first component of the element. */
-		const float* const data_ptr() const;
+		ENGINE_MATHS_CONSTEXPR const float* const data_ptr() const;
 
 		//! Add two 3x3 matrix objects together.
 		/*! @param mat3 A 3x3 matrix object. */
@@ -85,11 +85,11 @@ namespace engine { namespace maths {
 
 		//! Multiply two 3x3 matrix objects together.
 		/*! @param mat3 A 3x3 matrix object. */
-		Mat3 operator*(const Mat3& mat3) const;
+		ENGINE_MATHS_CONSTEXPR Mat3 operator*(const Mat3& mat3) const;
 
 		//! Multiply a three-component vector by a 3x3 matrix.
 		/*! @param vec3 A three-component vector object. */
-		Vec3 operator*(const maths::Vec3& vec3) const;
+		ENGINE_MATHS_CONSTEXPR Vec3 operator*(const maths::Vec3& vec3) const;
 
 		//! Increment one matrix object's components by another's.
 		/*! @param mat3 A 3x3 matrix object. */
@@ -114,7 +114,7 @@ namespace engine { namespace maths {
 		//! Get a non-mutable reference of the matrix element at @c (col,row)
 		/*! @param col The component's column.
 		  * @param row The component's row. */
-		const float& operator()(int col, int row) const;
+		ENGINE_MATHS_CONSTEXPR const float& operator()(int col, int row) const;
 
 		//! Get a mutable reference of the matrix element at @c (col,row)
 		/*! @param col The component's column.
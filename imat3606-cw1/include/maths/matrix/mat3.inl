@@ -0,0 +1,162 @@
+#pragma once
+
+/*!
+  * @file mat3.inl
+  * @brief Inline definitions for the Mat3 class.
+  * @author George McDonagh */
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_CONSTEXPR Mat3::Mat3()
+		: Mat3(1.0f)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Mat3::Mat3(float diagonal)
+		: m_values{
+			diagonal, 0.0f, 0.0f,
+			0.0f, diagonal, 0.0f,
+			0.0f, 0.0f, diagonal }
+	{ }
+
+	ENGINE_MATHS_INLINE Mat3::Mat3(float values[9])
+	{
+		for (int i = 0; i < 9; i++)
+			m_values[i] = values[i];
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat3::Mat3(float c1x, float c1y, float c1z,
+		float c2x, float c2y, float c2z,
+		float c3x, float c3y, float c3z)
+		: m_values{
+			c1x, c1y, c1z,
+			c2x, c2y, c2z,
+			c3x, c3y, c3z }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Mat3::Mat3(const Vec3& col1, const Vec3& col2, const Vec3& col3)
+		: m_values{
+			col1.x(), col1.y(), col1.z(),
+			col2.x(), col2.y(), col2.z(),
+			col3.x(), col3.y(), col3.z() }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Mat3::Mat3(const Mat4& mat4)
+		: m_values{
+			mat4(0, 0), mat4(0, 1), mat4(0, 2),
+			mat4(1, 0), mat4(1, 1), mat4(1, 2),
+			mat4(2, 0), mat4(2, 1), mat4(2, 2) }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR float Mat3::determinant() const
+	{
+		return (
+			(m_values[0] * ((m_values[4] * m_values[8]) - (m_values[7] * m_values[5]))) -
+			(m_values[3] * ((m_values[1] * m_values[8]) - (m_values[7] * m_values[2]))) +
+			(m_values[6] * ((m_values[1] * m_values[5]) - (m_values[4] * m_values[2]))));
+	}
+
+	ENGINE_MATHS_INLINE void Mat3::transpose()
+	{
+		*this = maths::transpose(*this);
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float* const Mat3::data_ptr() const
+	{
+		return m_values;
+	}
+
+	ENGINE_MATHS_INLINE Mat3 Mat3::operator+(const Mat3& mat3) const
+	{
+		float m[9];
+
+		for (int i = 0; i < 9; i++)
+			m[i] = m_values[i] + mat3.m_values[i];
+
+		return Mat3(m);
+	}
+
+	ENGINE_MATHS_INLINE Mat3 Mat3::operator-(const Mat3& mat3) const
+	{
+		float m[9];
+
+		for (int i = 0; i < 9; i++)
+			m[i] = m_values[i] - mat3.m_values[i];
+
+		return Mat3(m);
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat3 Mat3::operator*(const Mat3& mat3) const
+	{
+		return Mat3(
+			m_values[0] * mat3.m_values[0] + m_values[3] * mat3.m_values[1] + m_values[6] * mat3.m_values[2],
+			m_values[1] * mat3.m_values[0] + m_values[4] * mat3.m_values[1] + m_values[7] * mat3.m_values[2],
+			m_values[2] * mat3.m_values[0] + m_values[5] * mat3.m_values[1] + m_values[8] * mat3.m_values[2],
+
+			m_values[0] * mat3.m_values[3] + m_values[3] * mat3.m_values[4] + m_values[6] * mat3.m_values[5],
+			m_values[1] * mat3.m_values[3] + m_values[4] * mat3.m_values[4] + m_values[7] * mat3.m_values[5],
+			m_values[2] * mat3.m_values[3] + m_values[5] * mat3.m_values[4] + m_values[8] * mat3.m_values[5],
+
+			m_values[0] * mat3.m_values[6] + m_values[3] * mat3.m_values[7] + m_values[6] * mat3.m_values[8],
+			m_values[1] * mat3.m_values[6] + m_values[4] * mat3.m_values[7] + m_values[7] * mat3.m_values[8],
+			m_values[2] * mat3.m_values[6] + m_values[5] * mat3.m_values[7] + m_values[8] * mat3.m_values[8]);
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec3 Mat3::operator*(const Vec3& vec3) const
+	{
+		return Vec3(
+			m_values[0] * vec3.x() + m_values[3] * vec3.y() + m_values[6] * vec3.z(),
+			m_values[1] * vec3.x() + m_values[4] * vec3.y() + m_values[7] * vec3.z(),
+			m_values[2] * vec3.x() + m_values[5] * vec3.y() + m_values[8] * vec3.z());
+	}
+
+	ENGINE_MATHS_INLINE Mat3& Mat3::operator+=(const Mat3& mat3)
+	{
+		for (int i = 0; i < 9; i++)
+			m_values[i] += mat3.m_values[i];
+
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Mat3& Mat3::operator-=(const Mat3& mat3)
+	{
+		for (int i = 0; i < 9; i++)
+			m_values[i] -= mat3.m_values[i];
+
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Mat3& Mat3::operator*=(const Mat3& mat3)
+	{
+		*this = *this * mat3;
+
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE bool Mat3::operator==(const Mat3& mat3) const
+	{
+		for (int i = 0; i < 9; i++)
+			if (m_values[i] != mat3.m_values[i])
+				return false;
+
+		return true;
+	}
+
+	ENGINE_MATHS_INLINE bool Mat3::operator!=(const Mat3& mat3) const
+	{
+		return !(*this == mat3);
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Mat3::operator()(int col, int row) const
+	{
+		return m_values[3 * col + row];
+	}
+
+	ENGINE_MATHS_INLINE float& Mat3::operator()(int col, int row)
+	{
+		return m_values[3 * col + row];
+	}
+
+} }
\ No newline at end of file
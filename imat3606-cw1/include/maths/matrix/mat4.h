@@ -8,7 +8,7 @@
 
 // Local includes
 
-#include "maths\maths.h"
+#include "maths/maths.h"
 
 
 // Namespaces
@@ -27,11 +27,11 @@ namespace engine { namespace maths {
 	public:
 		//! Default constructor.
 		/*! Constructs a 4x4 identity matrix. */
-		Mat4();
+		ENGINE_MATHS_CONSTEXPR Mat4();
 
 		//! Constructs a 4x4 matrix with a specified diagonal value.
 		/*! @param diagonal The value of the components on the diagonal. */
-		Mat4(float diagonal);
+		ENGINE_MATHS_CONSTEXPR Mat4(float diagonal);
 
 		//! Constructs a 4x4 matrix with specified components.
 		/*! @param values The values of the matrix in column-major order. */
@@ -54,7 +54,7 @@ namespace engine { namespace maths {
 		  * @param c4y Right-most column's Y component.
 		  * @param c4z Right-most column's Z component.
 		  * @param c4w Right-most column's W component. */
-		Mat4(float c1x, float c1y, float c1z, float c1w,
+		ENGINE_MATHS_CONSTEXPR Mat4(float c1x, float c1y, float c1z, float c1w,
 			float c2x, float c2y, float c2z, float c2w,
 			float c3x, float c3y, float c3z, float c3w,
 			float c4x, float c4y, float c4z, float c4w);
@@ -64,18 +64,18 @@ namespace engine { namespace maths {
 		  * @param col2 Second column. 
 		  * @param col3 Third column.
 		  * @param col4 Right-most column. */
-		Mat4(const maths::Vec4& col1, const maths::Vec4& col2, const maths::Vec4& col3, const maths::Vec4& col4);
+		ENGINE_MATHS_CONSTEXPR Mat4(const maths::Vec4& col1, const maths::Vec4& col2, const maths::Vec4& col3, const maths::Vec4& col4);
 
 		//! Cosntruct a 4x4 matrix using a 3x3 matrice's elements.
 		/*! @param mat3 A 3x3 matrix. */
-		Mat4(const maths::Mat3& mat3);
+		ENGINE_MATHS_CONSTEXPR Mat4(const maths::Mat3& mat3);
 
 		//! Default destructor.
-		~Mat4();
+		~Mat4() = default;
 
 		//! Get the determinant of the Mat4.
 		/*! @return The determinant of the Mat4. */
-		float determinant() const;
+		ENGINE_MATHS_CONSTEXPR float determinant() const;
 
 		//! Transpose the matrix.
 		/*! Flips the matrix components on the diagonal; makes the columns of the matrix become the rows of the matrix and vice versa. */
@@ -83,7 +83,7 @@ namespace engine { namespace maths {
 
 		//! Get a pointer to the matrices elements.
 		/*! @return A pointer to the first component of the element. */
-		const float* const data_ptr() const;
+		ENGINE_MATHS_CONSTEXPR const float* const data_ptr() const;
 
 		//! Add two 4x4 matrix objects together.
 		/*! @param mat4 A 4x4 matrix object. */
@@ -124,7 +124,7 @@ namespace engine { namespace maths {
 		//! Get a non-mutable reference of the matrix element at @c (col,row)
 		/*! @param col The component's column.
 		  * @param row The component's row. */
-		const float& operator()(int col, int row) const;
+		ENGINE_MATHS_CONSTEXPR const float& operator()(int col, int row) const;
 
 		//! Get a mutable reference of the matrix element at @c (col,row)
 		/*! @param col The component's column.
@@ -0,0 +1,166 @@
+#pragma once
+
+/*!
+  * @file mat4.inl
+  * @brief Inline definitions for the Mat4 class.
+  * @author George McDonagh */
+
+
+// Local includes
+
+#include "maths/simd.h"
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_CONSTEXPR Mat4::Mat4()
+		: Mat4(1.0f)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Mat4::Mat4(float diagonal)
+		: m_values{
+			diagonal, 0.0f, 0.0f, 0.0f,
+			0.0f, diagonal, 0.0f, 0.0f,
+			0.0f, 0.0f, diagonal, 0.0f,
+			0.0f, 0.0f, 0.0f, diagonal }
+	{ }
+
+	ENGINE_MATHS_INLINE Mat4::Mat4(float values[16])
+	{
+		for (int i = 0; i < 16; i++)
+			m_values[i] = values[i];
+	}
+
+	ENGINE_MATHS_CONSTEXPR Mat4::Mat4(float c1x, float c1y, float c1z, float c1w,
+		float c2x, float c2y, float c2z, float c2w,
+		float c3x, float c3y, float c3z, float c3w,
+		float c4x, float c4y, float c4z, float c4w)
+		: m_values{
+			c1x, c1y, c1z, c1w,
+			c2x, c2y, c2z, c2w,
+			c3x, c3y, c3z, c3w,
+			c4x, c4y, c4z, c4w }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Mat4::Mat4(const Vec4& col1, const Vec4& col2, const Vec4& col3, const Vec4& col4)
+		: m_values{
+			col1.x(), col1.y(), col1.z(), col1.w(),
+			col2.x(), col2.y(), col2.z(), col2.w(),
+			col3.x(), col3.y(), col3.z(), col3.w(),
+			col4.x(), col4.y(), col4.z(), col4.w() }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Mat4::Mat4(const Mat3& mat3)
+		: m_values{
+			mat3(0, 0), mat3(0, 1), mat3(0, 2), 0.0f,
+			mat3(1, 0), mat3(1, 1), mat3(1, 2), 0.0f,
+			mat3(2, 0), mat3(2, 1), mat3(2, 2), 0.0f,
+			0.0f,       0.0f,       0.0f,       1.0f }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR float Mat4::determinant() const
+	{
+		return (
+			(m_values[0 ] * (maths::Mat3(m_values[5], m_values[6], m_values[7], m_values[9], m_values[10], m_values[11], m_values[13], m_values[14], m_values[15]).determinant())) -
+			(m_values[4 ] * (maths::Mat3(m_values[1], m_values[2], m_values[3], m_values[9], m_values[10], m_values[11], m_values[13], m_values[14], m_values[15]).determinant())) +
+			(m_values[8 ] * (maths::Mat3(m_values[1], m_values[2], m_values[3], m_values[5], m_values[6 ], m_values[7 ], m_values[13], m_values[14], m_values[15]).determinant())) -
+			(m_values[12] * (maths::Mat3(m_values[1], m_values[2], m_values[3], m_values[5], m_values[6 ], m_values[7 ], m_values[9 ], m_values[10], m_values[11]).determinant())));
+	}
+
+	ENGINE_MATHS_INLINE void Mat4::transpose()
+	{
+		*this = maths::transpose(*this);
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float* const Mat4::data_ptr() const
+	{
+		return m_values;
+	}
+
+	ENGINE_MATHS_INLINE Mat4 Mat4::operator+(const Mat4& mat4) const
+	{
+		float m[16];
+
+		for (int i = 0; i < 16; i++)
+			m[i] = m_values[i] + mat4.m_values[i];
+
+		return Mat4(m);
+	}
+
+	ENGINE_MATHS_INLINE Mat4 Mat4::operator-(const Mat4& mat4) const
+	{
+		float m[16];
+
+		for (int i = 0; i < 16; i++)
+			m[i] = m_values[i] - mat4.m_values[i];
+
+		return Mat4(m);
+	}
+
+	ENGINE_MATHS_INLINE Mat4 Mat4::operator*(const Mat4& mat4) const
+	{
+		Mat4 m;
+		simd::mat4Mul(m_values, mat4.m_values, m.m_values);
+
+		return m;
+	}
+
+	ENGINE_MATHS_INLINE Vec4 Mat4::operator*(const Vec4& vec4) const
+	{
+		Vec4 v;
+		simd::mat4MulVec4(m_values, &vec4.x(), &v.x());
+
+		return v;
+	}
+
+	ENGINE_MATHS_INLINE Mat4& Mat4::operator+=(const Mat4& mat4)
+	{
+		for (int i = 0; i < 16; i++)
+			m_values[i] += mat4.m_values[i];
+
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Mat4& Mat4::operator-=(const Mat4& mat4)
+	{
+		for (int i = 0; i < 16; i++)
+			m_values[i] -= mat4.m_values[i];
+
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Mat4& Mat4::operator*=(const Mat4& mat4)
+	{
+		// The kernels allow the output to alias an input, so the product can be written straight back.
+		simd::mat4Mul(m_values, mat4.m_values, m_values);
+
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE bool Mat4::operator==(const Mat4& mat4) const
+	{
+		for (int i = 0; i < 16; i++)
+			if (m_values[i] != mat4.m_values[i])
+				return false;
+
+		return true;
+	}
+
+	ENGINE_MATHS_INLINE bool Mat4::operator!=(const Mat4& mat4) const
+	{
+		return !(*this == mat4);
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Mat4::operator()(int col, int row) const
+	{
+		return m_values[4 * col + row];
+	}
+
+	ENGINE_MATHS_INLINE float& Mat4::operator()(int col, int row)
+	{
+		return m_values[4 * col + row];
+	}
+
+} }
\ No newline at end of file
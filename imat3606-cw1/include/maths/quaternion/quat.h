@@ -0,0 +1,116 @@
+#pragma once
+
+/*!
+  * @file quat.h
+  * @brief Header file for the Quat class.
+  * @author George McDonagh */
+
+
+// Local includes
+
+#include "maths/maths.h"
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	//! A quaternion, for representing rotations.
+	/*! Stored as (X, Y, Z, W) where W is the scalar part. Rotation quaternions are expected to be unit length.
+	  * @note Multiplying two quaternions composes their rotations in the same order as multiplying their matrices: @c (a * b) rotates by @c b and then by @c a. */
+	class Quat
+	{
+	public:
+		//! Constructs an identity quaternion.
+		/*! The identity quaternion represents no rotation. */
+		ENGINE_MATHS_CONSTEXPR Quat();
+
+		//! Constructs a quaternion with specified components.
+		/*! @param x The X component of the vector part.
+		  * @param y The Y component of the vector part.
+		  * @param z The Z component of the vector part.
+		  * @param w The scalar part. */
+		ENGINE_MATHS_CONSTEXPR Quat(float x, float y, float z, float w);
+
+		//! Constructs a quaternion with a vector part and a scalar part.
+		/*! @param v The vector part.
+		  * @param w The scalar part. */
+		ENGINE_MATHS_CONSTEXPR Quat(const Vec3& v, float w);
+
+		//! Quaternion's X component.
+		/*! @return Read-only reference to the X component of the quaternion's vector part. */
+		ENGINE_MATHS_CONSTEXPR const float& x() const;
+
+		//! Quaternion's Y component.
+		/*! @return Read-only reference to the Y component of the quaternion's vector part. */
+		ENGINE_MATHS_CONSTEXPR const float& y() const;
+
+		//! Quaternion's Z component.
+		/*! @return Read-only reference to the Z component of the quaternion's vector part. */
+		ENGINE_MATHS_CONSTEXPR const float& z() const;
+
+		//! Quaternion's W component.
+		/*! @return Read-only reference to the quaternion's scalar part. */
+		ENGINE_MATHS_CONSTEXPR const float& w() const;
+
+		//! Quaternion's X component.
+		/*! @return Modifiable reference to the X component of the quaternion's vector part. */
+		float& x();
+
+		//! Quaternion's Y component.
+		/*! @return Modifiable reference to the Y component of the quaternion's vector part. */
+		float& y();
+
+		//! Quaternion's Z component.
+		/*! @return Modifiable reference to the Z component of the quaternion's vector part. */
+		float& z();
+
+		//! Quaternion's W component.
+		/*! @return Modifiable reference to the quaternion's scalar part. */
+		float& w();
+
+		//! Quaternion's vector part.
+		/*! @return The quaternion's X, Y, and Z components. */
+		ENGINE_MATHS_CONSTEXPR Vec3 xyz() const;
+
+		//! Quaternion's magnitude.
+		/*! @return The quaternion's magnitude/length/norm. */
+		float magnitude() const;
+
+		//! Normalizes the quaternion.
+		void normalize();
+
+		//! Compose two rotations.
+		/*! @param quat A quaternion object.
+		  * @return A quaternion which rotates by @p quat and then by this quaternion. */
+		ENGINE_MATHS_CONSTEXPR Quat operator*(const Quat& quat) const;
+
+		//! Rotate a three-component vector by the quaternion.
+		/*! @param vec3 A three-component vector object. */
+		Vec3 operator*(const Vec3& vec3) const;
+
+		ENGINE_MATHS_CONSTEXPR Quat operator*(float f) const;
+
+		ENGINE_MATHS_CONSTEXPR Quat operator+(const Quat& quat) const;
+
+		ENGINE_MATHS_CONSTEXPR Quat operator-(const Quat& quat) const;
+
+		ENGINE_MATHS_CONSTEXPR Quat operator-() const;
+
+		Quat& operator*=(const Quat& quat);
+
+		Quat& operator*=(float f);
+
+		ENGINE_MATHS_CONSTEXPR bool operator==(const Quat& quat) const;
+
+		ENGINE_MATHS_CONSTEXPR bool operator!=(const Quat& quat) const;
+
+		ENGINE_MATHS_CONSTEXPR const float& operator()(int i) const;
+
+		float& operator()(int i);
+
+	private:
+		float m_values[4]; /*!< The quaternion object's components, in X, Y, Z, W order. */
+	};
+
+} }
\ No newline at end of file
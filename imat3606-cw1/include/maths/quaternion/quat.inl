@@ -0,0 +1,153 @@
+#pragma once
+
+/*!
+  * @file quat.inl
+  * @brief Inline definitions for the Quat class.
+  * @author George McDonagh */
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_CONSTEXPR Quat::Quat()
+		: Quat(0.0f, 0.0f, 0.0f, 1.0f)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Quat::Quat(float x, float y, float z, float w)
+		: m_values{ x, y, z, w }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Quat::Quat(const Vec3& v, float w)
+		: Quat(v.x(), v.y(), v.z(), w)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR const float& Quat::x() const
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Quat::y() const
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Quat::z() const
+	{
+		return m_values[2];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Quat::w() const
+	{
+		return m_values[3];
+	}
+
+	ENGINE_MATHS_INLINE float& Quat::x()
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_INLINE float& Quat::y()
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_INLINE float& Quat::z()
+	{
+		return m_values[2];
+	}
+
+	ENGINE_MATHS_INLINE float& Quat::w()
+	{
+		return m_values[3];
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec3 Quat::xyz() const
+	{
+		return Vec3(x(), y(), z());
+	}
+
+	ENGINE_MATHS_INLINE float Quat::magnitude() const
+	{
+		return sqrt(x() * x() + y() * y() + z() * z() + w() * w());
+	}
+
+	ENGINE_MATHS_INLINE void Quat::normalize()
+	{
+		*this *= 1.0f / magnitude();
+	}
+
+	ENGINE_MATHS_CONSTEXPR Quat Quat::operator*(const Quat& quat) const
+	{
+		return Quat(
+			w() * quat.x() + x() * quat.w() + y() * quat.z() - z() * quat.y(),
+			w() * quat.y() - x() * quat.z() + y() * quat.w() + z() * quat.x(),
+			w() * quat.z() + x() * quat.y() - y() * quat.x() + z() * quat.w(),
+			w() * quat.w() - x() * quat.x() - y() * quat.y() - z() * quat.z());
+	}
+
+	ENGINE_MATHS_INLINE Vec3 Quat::operator*(const Vec3& vec3) const
+	{
+		// v' = v + 2w(u x v) + 2u x (u x v), which avoids building the full rotation matrix.
+		Vec3 u = xyz();
+		Vec3 t = cross(u, vec3) * 2.0f;
+
+		return vec3 + t * w() + cross(u, t);
+	}
+
+	ENGINE_MATHS_CONSTEXPR Quat Quat::operator*(float f) const
+	{
+		return Quat(x() * f, y() * f, z() * f, w() * f);
+	}
+
+	ENGINE_MATHS_CONSTEXPR Quat Quat::operator+(const Quat& quat) const
+	{
+		return Quat(x() + quat.x(), y() + quat.y(), z() + quat.z(), w() + quat.w());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Quat Quat::operator-(const Quat& quat) const
+	{
+		return Quat(x() - quat.x(), y() - quat.y(), z() - quat.z(), w() - quat.w());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Quat Quat::operator-() const
+	{
+		return Quat(-x(), -y(), -z(), -w());
+	}
+
+	ENGINE_MATHS_INLINE Quat& Quat::operator*=(const Quat& quat)
+	{
+		*this = *this * quat;
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Quat& Quat::operator*=(float f)
+	{
+		x() *= f;
+		y() *= f;
+		z() *= f;
+		w() *= f;
+		return *this;
+	}
+
+	ENGINE_MATHS_CONSTEXPR bool Quat::operator==(const Quat& quat) const
+	{
+		return x() == quat.x() && y() == quat.y() && z() == quat.z() && w() == quat.w();
+	}
+
+	ENGINE_MATHS_CONSTEXPR bool Quat::operator!=(const Quat& quat) const
+	{
+		return !(*this == quat);
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Quat::operator()(int i) const
+	{
+		return m_values[i];
+	}
+
+	ENGINE_MATHS_INLINE float& Quat::operator()(int i)
+	{
+		return m_values[i];
+	}
+
+} }
\ No newline at end of file
@@ -0,0 +1,335 @@
+#pragma once
+
+/*!
+  * @file simd.h
+  * @brief Header file for the SIMD maths kernels and their runtime dispatch.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+// Macros
+
+// Only x86/x64 targets get SSE/AVX kernels; every other target falls back to the scalar reference kernels.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define ENGINE_SIMD_X86
+#endif
+
+// GCC and Clang need to be told a function may use instructions beyond the translation unit's baseline; MSVC does not.
+#if defined(__GNUC__) || defined(__clang__)
+#define ENGINE_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define ENGINE_SIMD_TARGET(isa)
+#endif
+
+// The alignment, in bytes, of arrays allocated with alignedAlloc(). Enough for a 256-bit AVX register.
+#define ENGINE_SIMD_ALIGNMENT 32
+
+
+// Namespaces
+
+namespace engine { namespace maths { namespace simd {
+
+	//! The instruction sets the maths kernels have implementations for.
+	/*! Ordered from least to most capable so that they can be compared. */
+	enum InstructionSet
+	{
+		SIMD_SCALAR	= 0,
+		SIMD_SSE2	= 1,
+		SIMD_AVX	= 2,
+		SIMD_AVX2	= 3 // AVX2 with FMA3.
+	};
+
+	//! Kernel signature for multiplying two column-major 4x4 matrices.
+	/*! @param a The left-hand matrix's 16 components.
+	  * @param b The right-hand matrix's 16 components.
+	  * @param out The 16 components to write the product to. May alias @p a or @p b. */
+	typedef void (*Mat4MulKernel)(const float* a, const float* b, float* out);
+
+	//! Kernel signature for multiplying a four-component vector by a column-major 4x4 matrix.
+	/*! @param m The matrix's 16 components.
+	  * @param v The vector's 4 components.
+	  * @param out The 4 components to write the product to. May alias @p v. */
+	typedef void (*Mat4MulVec4Kernel)(const float* m, const float* v, float* out);
+
+	//! Kernel signature for transforming packed three-component vectors by a column-major 4x4 matrix.
+	/*! @param m The matrix's 16 components.
+	  * @param in @p count tightly packed XYZ triples.
+	  * @param out @p count tightly packed XYZ triples to write to. May be the same array as @p in.
+	  * @param count The number of vectors to transform.
+	  * @param w The implied fourth component of every input vector; 1 for points, 0 for directions. */
+	typedef void (*TransformVec3Kernel)(const float* m, const float* in, float* out, size_t count, float w);
+
+	//! Kernel signature for transforming three-component vectors stored as separate X, Y, and Z arrays.
+	/*! Parameters match TransformVec3Kernel, except that each component has its own array. The output arrays may be the same arrays as the input arrays. */
+	typedef void (*TransformSoAKernel)(const float* m, const float* inX, const float* inY, const float* inZ, float* outX, float* outY, float* outZ, size_t count, float w);
+
+	//! Kernel signature for inverting a column-major 4x4 matrix.
+	/*! @param m The matrix's 16 components.
+	  * @param out The 16 components to write the inverse to. May alias @p m.
+	  * @note A singular matrix produces infinite or NaN components, as dividing by its zero determinant would. */
+	typedef void (*Mat4InverseKernel)(const float* m, float* out);
+
+	//! Kernel signature for inverting a column-major 4x4 matrix whose bottom row is (0, 0, 0, 1).
+	/*! Only reads the upper 3x3 and the translation, and always writes a bottom row of (0, 0, 0, 1).
+	  * @param m The matrix's 16 components.
+	  * @param out The 16 components to write the inverse to. May alias @p m. */
+	typedef void (*Mat4InverseAffineKernel)(const float* m, float* out);
+
+	//! Kernel signature for an element-wise operation on two arrays, such as @c out[i] = a[i] + b[i].
+	/*! @param a The first @p count operands.
+	  * @param b The second @p count operands.
+	  * @param out The @p count results. May be the same array as @p a or @p b.
+	  * @param count The number of elements. */
+	typedef void (*StreamBinaryKernel)(const float* a, const float* b, float* out, size_t count);
+
+	//! Kernel signature for scaling an array: @c out[i] = a[i] * s.
+	/*! @param out May be the same array as @p a. */
+	typedef void (*StreamScaleKernel)(const float* a, float s, float* out, size_t count);
+
+	//! Kernel signature for an element-wise multiply-add: @c out[i] = a[i] * b[i] + c[i].
+	/*! @param out May be the same array as any of the inputs. */
+	typedef void (*StreamMultiplyAddKernel)(const float* a, const float* b, const float* c, float* out, size_t count);
+
+	//! Kernel signature for a scaled add: @c out[i] = a[i] * s + c[i].
+	/*! @param out May be the same array as either of the inputs. */
+	typedef void (*StreamScaleAddKernel)(const float* a, float s, const float* c, float* out, size_t count);
+
+	//! Kernel signature for the dot products of vectors stored as one array per component.
+	/*! @param a @p components arrays of @p count elements; the first vectors' components.
+	  * @param b @p components arrays of @p count elements; the second vectors' components.
+	  * @param components The number of components in each vector, from 1 to 4.
+	  * @param out The @p count dot products.
+	  * @param count The number of vectors. */
+	typedef void (*StreamDotKernel)(const float* const* a, const float* const* b, int components, float* out, size_t count);
+
+	//! Kernel signature for the magnitudes of vectors stored as one array per component.
+	/*! Parameters match StreamDotKernel. */
+	typedef void (*StreamLengthKernel)(const float* const* v, int components, float* out, size_t count);
+
+	//! Kernel signature for normalizing vectors stored as one array per component.
+	/*! @param in @p components arrays of @p count elements.
+	  * @param out @p components arrays of @p count elements to write the unit vectors to. May be the same arrays as @p in.
+	  * @note Zero-length vectors produce NaN components, as normalize() does. */
+	typedef void (*StreamNormalizeKernel)(const float* const* in, float* const* out, int components, size_t count);
+
+	//! Kernel signature for the cross products of three-component vectors stored as one array per component.
+	/*! @param a 3 arrays (X, Y, Z) of @p count elements.
+	  * @param b 3 arrays (X, Y, Z) of @p count elements.
+	  * @param out 3 arrays (X, Y, Z) of @p count elements to write the cross products to. May be the same arrays as @p a or @p b. */
+	typedef void (*StreamCrossKernel)(const float* const* a, const float* const* b, float* const* out, size_t count);
+
+	//! Kernel signature for the sines and cosines of an array of angles.
+	/*! @param angles @p count angles, in radians.
+	  * @param sines The array to write the @p count sines to. May be the same array as @p angles.
+	  * @param cosines The array to write the @p count cosines to. May be the same array as @p angles, but not @p sines.
+	  * @param count The number of angles.
+	  * @note The SSE2, AVX, and AVX2 kernels evaluate the Cephes single precision minimax polynomials after reducing the angles by pi/4 in three
+	  * ... parts. For angles within [-8192, 8192] radians they are within 1e-7 (absolute) of sin() and cos() evaluated in double precision, or about
+	  * ... 1 ULP of 1.0; std::sin() and std::cos() on floats are within 3.3e-8 by the same measure. Outside that range the reduction runs out of
+	  * ... precision and the results shouldn't be used. The scalar kernel calls std::sin() and std::cos(). */
+	typedef void (*SinCosKernel)(const float* angles, float* sines, float* cosines, size_t count);
+
+	//! Kernel signature for testing axis-aligned boxes against a frustum.
+	/*! @param planes 6 planes of 4 floats each: the normal's X, Y, and Z, then the distance term. The normals face in to the frustum.
+	  * @param boxes @p count boxes of 6 floats each: the minimum corner's X, Y, and Z, then the maximum corner's.
+	  * @param count The number of boxes.
+	  * @param result The array to write @p count results to: 1 if the box is inside or straddles every plane, 0 if it is entirely outside any of them. */
+	typedef void (*FrustumCullKernel)(const float* planes, const float* boxes, size_t count, uint8_t* result);
+
+	//! Kernel signature for intersecting rays stored as one array per component with a single shape.
+	/*! @param origins 3 arrays (X, Y, Z) of @p count elements; the rays' origins.
+	  * @param directions 3 arrays (X, Y, Z) of @p count elements; the rays' directions. They needn't be unit length.
+	  * @param shape For rayAABB, 6 floats: the minimum corner's X, Y, and Z, then the maximum corner's. For raySphere, 4 floats: the center's X, Y,
+	  * ... and Z, then the radius. For rayTriangle, 9 floats: the X, Y, and Z of each corner in turn.
+	  * @param t The array to write the @p count hit distances to, in multiples of each ray's direction, or infinity where the ray misses. Rays starting
+	  * ... inside a box or sphere hit it at 0.
+	  * @param count The number of rays.
+	  * @note The SSE2 and AVX kernels give exactly the scalar kernels' results. The AVX2 kernels use fused multiply-adds, so may round differently
+	  * ... for rays which graze an edge. */
+	typedef void (*RayIntersectKernel)(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count);
+
+	//! Kernel signature for the screen sizes of bounding spheres stored as one array per component.
+	/*! @param centres 3 arrays (X, Y, Z) of @p count elements; the spheres' centres.
+	  * @param radii @p count radii.
+	  * @param camera 4 floats: the eye's X, Y, and Z, then the projection's scale, which is the Y scale of a perspective projection matrix.
+	  * @param out The array to write the @p count sizes to: each radius times the scale over the distance from the eye to the centre, or over
+	  * ... the radius if the eye is inside the sphere. This is about the fraction of the screen's height the sphere covers.
+	  * @param count The number of spheres.
+	  * @note The SSE2 and AVX kernels give exactly the scalar kernel's results. The AVX2 kernel uses fused multiply-adds, so may round differently. */
+	typedef void (*SphereScreenSizeKernel)(const float* const* centres, const float* radii, const float* camera, float* out, size_t count);
+
+	//! Triangles whose Moller-Trumbore determinant is smaller than this are treated as parallel to the ray.
+	const float RAY_TRIANGLE_EPSILON = 1e-12f;
+
+	//! Allocate memory aligned to ENGINE_SIMD_ALIGNMENT bytes.
+	/*! @param bytes The number of bytes to allocate.
+	  * @return The allocated memory, or a null pointer if it couldn't be allocated. Must be released with alignedFree(). */
+	void* alignedAlloc(size_t bytes);
+
+	//! Release memory allocated with alignedAlloc().
+	/*! @param ptr The memory to release. May be a null pointer. */
+	void alignedFree(void* ptr);
+
+	//! Get the most capable instruction set supported by the CPU and operating system.
+	/*! The CPU is only queried (with CPUID) the first time this is called. */
+	InstructionSet supportedInstructionSet();
+
+	//! Get the instruction set that the dispatched kernels are currently using.
+	InstructionSet activeInstructionSet();
+
+	//! Select the kernels that the dispatched kernel pointers use.
+	/*! Useful for comparing the kernels against eachother. The kernels are resolved before main() runs, so this is only needed to change
+	  * them, which mustn't be done while other threads may be calling them.
+	  * @param set The instruction set to use.
+	  * @return False if @p set isn't supported, in which case the active kernels are left unchanged. */
+	bool setInstructionSet(InstructionSet set);
+
+	//! Get a readable name for an instruction set.
+	const char* instructionSetName(InstructionSet set);
+
+	extern Mat4MulKernel mat4Mul; /*!< Dispatched Mat4 x Mat4 kernel. Set to the best supported kernel at start-up. */
+	extern Mat4MulVec4Kernel mat4MulVec4; /*!< Dispatched Mat4 x Vec4 kernel. Set to the best supported kernel at start-up. */
+	extern TransformVec3Kernel transformVec3; /*!< Dispatched packed XYZ transform kernel. Set to the best supported kernel at start-up. */
+	extern Mat4InverseKernel mat4Inverse; /*!< Dispatched Mat4 inverse kernel. Set to the best supported kernel at start-up. */
+	extern Mat4InverseAffineKernel mat4InverseAffine; /*!< Dispatched affine Mat4 inverse kernel. Set to the best supported kernel at start-up. */
+	extern Mat4InverseAffineKernel mat4InverseRigid; /*!< Dispatched rigid Mat4 inverse kernel, for an orthonormal upper 3x3. Set to the best supported kernel at start-up. */
+	extern TransformSoAKernel transformSoA; /*!< Dispatched X/Y/Z array transform kernel. Set to the best supported kernel at start-up. */
+	extern StreamBinaryKernel streamAdd; /*!< Dispatched array add kernel. */
+	extern StreamBinaryKernel streamSubtract; /*!< Dispatched array subtract kernel. */
+	extern StreamBinaryKernel streamMultiply; /*!< Dispatched array multiply kernel. */
+	extern StreamScaleKernel streamScale; /*!< Dispatched array scale kernel. */
+	extern StreamMultiplyAddKernel streamMultiplyAdd; /*!< Dispatched array multiply-add kernel. */
+	extern StreamScaleAddKernel streamScaleAdd; /*!< Dispatched array scaled add kernel. */
+	extern StreamDotKernel streamDot; /*!< Dispatched per-component array dot product kernel. */
+	extern StreamLengthKernel streamLength; /*!< Dispatched per-component array magnitude kernel. */
+	extern StreamNormalizeKernel streamNormalize; /*!< Dispatched per-component array normalize kernel. */
+	extern StreamCrossKernel streamCross; /*!< Dispatched per-component array cross product kernel. */
+	extern SinCosKernel sinCos; /*!< Dispatched array sine and cosine kernel. */
+	extern FrustumCullKernel frustumCullAABB; /*!< Dispatched frustum and box culling kernel. */
+	extern RayIntersectKernel rayAABB; /*!< Dispatched ray and box intersection kernel. */
+	extern RayIntersectKernel raySphere; /*!< Dispatched ray and sphere intersection kernel. */
+	extern RayIntersectKernel rayTriangle; /*!< Dispatched ray and triangle intersection kernel. */
+	extern SphereScreenSizeKernel sphereScreenSize; /*!< Dispatched bounding sphere screen size kernel. */
+
+	// Reference implementations, always available.
+
+	void mat4Mul_scalar(const float* a, const float* b, float* out);
+	void mat4MulVec4_scalar(const float* m, const float* v, float* out);
+	void transformVec3_scalar(const float* m, const float* in, float* out, size_t count, float w);
+	void mat4Inverse_scalar(const float* m, float* out);
+	void mat4InverseAffine_scalar(const float* m, float* out);
+	void mat4InverseRigid_scalar(const float* m, float* out);
+	void transformSoA_scalar(const float* m, const float* inX, const float* inY, const float* inZ, float* outX, float* outY, float* outZ, size_t count, float w);
+	void streamAdd_scalar(const float* a, const float* b, float* out, size_t count);
+	void streamSubtract_scalar(const float* a, const float* b, float* out, size_t count);
+	void streamMultiply_scalar(const float* a, const float* b, float* out, size_t count);
+	void streamScale_scalar(const float* a, float s, float* out, size_t count);
+	void streamMultiplyAdd_scalar(const float* a, const float* b, const float* c, float* out, size_t count);
+	void streamScaleAdd_scalar(const float* a, float s, const float* c, float* out, size_t count);
+	void streamDot_scalar(const float* const* a, const float* const* b, int components, float* out, size_t count);
+	void streamLength_scalar(const float* const* v, int components, float* out, size_t count);
+	void streamNormalize_scalar(const float* const* in, float* const* out, int components, size_t count);
+	void streamCross_scalar(const float* const* a, const float* const* b, float* const* out, size_t count);
+	void sinCos_scalar(const float* angles, float* sines, float* cosines, size_t count);
+	void frustumCullAABB_scalar(const float* planes, const float* boxes, size_t count, uint8_t* result);
+	void rayAABB_scalar(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count);
+	void raySphere_scalar(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count);
+	void rayTriangle_scalar(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count);
+	void sphereScreenSize_scalar(const float* const* centres, const float* radii, const float* camera, float* out, size_t count);
+
+#ifdef ENGINE_SIMD_X86
+	// Instruction set specific implementations. Only call these when supportedInstructionSet() allows it.
+
+	void mat4Mul_sse2(const float* a, const float* b, float* out);
+	void mat4MulVec4_sse2(const float* m, const float* v, float* out);
+	void transformVec3_sse2(const float* m, const float* in, float* out, size_t count, float w);
+	void mat4Inverse_sse2(const float* m, float* out); // A single 4x4 inverse doesn't benefit from 256-bit registers, so the AVX sets use this too.
+	void mat4InverseAffine_sse2(const float* m, float* out); // As with mat4Inverse_sse2, the AVX sets use this and the next too.
+	void mat4InverseRigid_sse2(const float* m, float* out);
+	void transformSoA_sse2(const float* m, const float* inX, const float* inY, const float* inZ, float* outX, float* outY, float* outZ, size_t count, float w);
+	void streamAdd_sse2(const float* a, const float* b, float* out, size_t count);
+	void streamSubtract_sse2(const float* a, const float* b, float* out, size_t count);
+	void streamMultiply_sse2(const float* a, const float* b, float* out, size_t count);
+	void streamScale_sse2(const float* a, float s, float* out, size_t count);
+	void streamMultiplyAdd_sse2(const float* a, const float* b, const float* c, float* out, size_t count);
+	void streamScaleAdd_sse2(const float* a, float s, const float* c, float* out, size_t count);
+	void streamDot_sse2(const float* const* a, const float* const* b, int components, float* out, size_t count);
+	void streamLength_sse2(const float* const* v, int components, float* out, size_t count);
+	void streamNormalize_sse2(const float* const* in, float* const* out, int components, size_t count);
+	void streamCross_sse2(const float* const* a, const float* const* b, float* const* out, size_t count);
+	void sinCos_sse2(const float* angles, float* sines, float* cosines, size_t count);
+	void frustumCullAABB_sse2(const float* planes, const float* boxes, size_t count, uint8_t* result);
+	void rayAABB_sse2(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count);
+	void raySphere_sse2(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count);
+	void rayTriangle_sse2(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count);
+	void sphereScreenSize_sse2(const float* const* centres, const float* radii, const float* camera, float* out, size_t count);
+
+	void mat4Mul_avx(const float* a, const float* b, float* out);
+	void mat4MulVec4_avx(const float* m, const float* v, float* out);
+	void transformVec3_avx(const float* m, const float* in, float* out, size_t count, float w);
+	void transformSoA_avx(const float* m, const float* inX, const float* inY, const float* inZ, float* outX, float* outY, float* outZ, size_t count, float w);
+	void streamAdd_avx(const float* a, const float* b, float* out, size_t count);
+	void streamSubtract_avx(const float* a, const float* b, float* out, size_t count);
+	void streamMultiply_avx(const float* a, const float* b, float* out, size_t count);
+	void streamScale_avx(const float* a, float s, float* out, size_t count);
+	void streamMultiplyAdd_avx(const float* a, const float* b, const float* c, float* out, size_t count);
+	void streamScaleAdd_avx(const float* a, float s, const float* c, float* out, size_t count);
+	void streamDot_avx(const float* const* a, const float* const* b, int components, float* out, size_t count);
+	void streamLength_avx(const float* const* v, int components, float* out, size_t count);
+	void streamNormalize_avx(const float* const* in, float* const* out, int components, size_t count);
+	void streamCross_avx(const float* const* a, const float* const* b, float* const* out, size_t count);
+	void sinCos_avx(const float* angles, float* sines, float* cosines, size_t count);
+	void frustumCullAABB_avx(const float* planes, const float* boxes, size_t count, uint8_t* result);
+	void rayAABB_avx(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count);
+	void raySphere_avx(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count);
+	void rayTriangle_avx(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count);
+	void sphereScreenSize_avx(const float* const* centres, const float* radii, const float* camera, float* out, size_t count);
+
+	void mat4Mul_avx2(const float* a, const float* b, float* out);
+	void mat4MulVec4_avx2(const float* m, const float* v, float* out);
+	void transformVec3_avx2(const float* m, const float* in, float* out, size_t count, float w);
+	void transformSoA_avx2(const float* m, const float* inX, const float* inY, const float* inZ, float* outX, float* outY, float* outZ, size_t count, float w);
+	// The element-wise add, subtract, multiply, and scale kernels have nothing to gain from FMA, so the AVX2 set uses the AVX ones.
+	void streamMultiplyAdd_avx2(const float* a, const float* b, const float* c, float* out, size_t count);
+	void streamScaleAdd_avx2(const float* a, float s, const float* c, float* out, size_t count);
+	void streamDot_avx2(const float* const* a, const float* const* b, int components, float* out, size_t count);
+	void streamLength_avx2(const float* const* v, int components, float* out, size_t count);
+	void streamNormalize_avx2(const float* const* in, float* const* out, int components, size_t count);
+	void streamCross_avx2(const float* const* a, const float* const* b, float* const* out, size_t count);
+	void sinCos_avx2(const float* angles, float* sines, float* cosines, size_t count);
+	void frustumCullAABB_avx2(const float* planes, const float* boxes, size_t count, uint8_t* result);
+	void rayAABB_avx2(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count);
+	void raySphere_avx2(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count);
+	void rayTriangle_avx2(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count);
+	void sphereScreenSize_avx2(const float* const* centres, const float* radii, const float* camera, float* out, size_t count);
+
+	// Constants for the vectorised sinCos kernels, from the Cephes maths library's sinf() and cosf().
+	namespace sinCosConstants {
+
+		const float FOUR_OVER_PI = 1.27323954473516f;
+
+		// pi/4 split in to three parts, the first two of which have few enough significant bits that multiplying them by the octant is exact.
+		const float PI_OVER_4_A = 0.78515625f;
+		const float PI_OVER_4_B = 2.4187564849853515625e-4f;
+		const float PI_OVER_4_C = 3.77489497744594108e-8f;
+
+		// sin(x) ~= x + x^3 * (S2 + x^2 * (S1 + x^2 * S0)) for |x| <= pi/4.
+		const float SIN_S0 = -1.9515295891e-4f;
+		const float SIN_S1 = 8.3321608736e-3f;
+		const float SIN_S2 = -1.6666654611e-1f;
+
+		// cos(x) ~= 1 - x^2 / 2 + x^4 * (C2 + x^2 * (C1 + x^2 * C0)) for |x| <= pi/4.
+		const float COS_C0 = 2.443315711809948e-5f;
+		const float COS_C1 = -1.388731625493765e-3f;
+		const float COS_C2 = 4.166664568298827e-2f;
+
+	}
+
+#endif
+
+} } }
\ No newline at end of file
@@ -8,7 +8,7 @@
 
 // Local includes
 
-#include "maths\maths.h"
+#include "maths/maths.h"
 
 
 // Namespaces
@@ -20,47 +20,47 @@ namespace engine { namespace maths {
 	{
 	public:
 		//! Constructs an empty two-component vector.
-		Vec2();
+		ENGINE_MATHS_CONSTEXPR Vec2();
 
 		//! Constructs a two-component vector filled with a specified value.
 		/*! @param f Value to fill the vector with. */
-		Vec2(float f);
+		ENGINE_MATHS_CONSTEXPR Vec2(float f);
 
 		//! Constructs a two-component vector with specified values.
 		/*! @param v1 Vector's first component. (X, R, or S value)
 		  * @param v2 Vector's second component. (Y, G, or T value) */
-		Vec2(float v1, float v2);
+		ENGINE_MATHS_CONSTEXPR Vec2(float v1, float v2);
 
 		//! Constructs a two-component vector using another.
 		/*! @param vec2 A two-component vector. */
-		Vec2(const Vec2& vec2);
+		Vec2(const Vec2& vec2) = default;
 
 		//! Default destructor.
-		~Vec2();
+		~Vec2() = default;
 
 		//! Vector's X component.
 		/*! @return Read-only reference to the vector's first component. */
-		const float& x() const;
+		ENGINE_MATHS_CONSTEXPR const float& x() const;
 
 		//! Vector's Y component.
 		/*! @return Read-only reference to the vector's second component. */
-		const float& y() const;
+		ENGINE_MATHS_CONSTEXPR const float& y() const;
 
 		//! Vector's R component.
 		/*! @return Read-only reference to the vector's first component. */
-		const float& r() const;
+		ENGINE_MATHS_CONSTEXPR const float& r() const;
 
 		//! Vector's G component.
 		/*! @return Read-only reference to the vector's second component. */
-		const float& g() const;
+		ENGINE_MATHS_CONSTEXPR const float& g() const;
 
 		//! Vector's S component.
 		/*! @return Read-only reference to the vector's first component. */
-		const float& s() const;
+		ENGINE_MATHS_CONSTEXPR const float& s() const;
 
 		//! Vector's T component.
 		/*! @return Read-only reference to the vector's second component. */
-		const float& t() const;
+		ENGINE_MATHS_CONSTEXPR const float& t() const;
 
 		//! Vector's X component.
 		/*! @return Modifiable reference to the vector's first component. */
@@ -93,19 +93,19 @@ namespace engine { namespace maths {
 		//! Normalizes the vector.
 		void normalize();
 
-		Vec2 operator+(const Vec2& vec2) const;
+		ENGINE_MATHS_CONSTEXPR Vec2 operator+(const Vec2& vec2) const;
 
-		Vec2 operator-(const Vec2& vec2) const;
+		ENGINE_MATHS_CONSTEXPR Vec2 operator-(const Vec2& vec2) const;
 
-		Vec2 operator-() const;
+		ENGINE_MATHS_CONSTEXPR Vec2 operator-() const;
 
-		Vec2 operator*(const Vec2& vec2) const;
+		ENGINE_MATHS_CONSTEXPR Vec2 operator*(const Vec2& vec2) const;
 
-		Vec2 operator*(float f) const;
+		ENGINE_MATHS_CONSTEXPR Vec2 operator*(float f) const;
 
-		Vec2 operator/(const Vec2& vec2) const;
+		ENGINE_MATHS_CONSTEXPR Vec2 operator/(const Vec2& vec2) const;
 
-		Vec2 operator/(float f) const;
+		ENGINE_MATHS_CONSTEXPR Vec2 operator/(float f) const;
 
 		Vec2& operator+=(const Vec2& vec2);
 
@@ -119,11 +119,11 @@ namespace engine { namespace maths {
 
 		Vec2& operator/=(float f);
 
-		bool operator==(const Vec2& vec2) const;
+		ENGINE_MATHS_CONSTEXPR bool operator==(const Vec2& vec2) const;
 
-		bool operator!=(const Vec2& vec2) const;
+		ENGINE_MATHS_CONSTEXPR bool operator!=(const Vec2& vec2) const;
 
-		const float& operator()(int i) const;
+		ENGINE_MATHS_CONSTEXPR const float& operator()(int i) const;
 
 		float& operator()(int i);
 
@@ -0,0 +1,192 @@
+#pragma once
+
+/*!
+  * @file vec2.inl
+  * @brief Inline definitions for the Vec2 class.
+  * @author George McDonagh */
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_CONSTEXPR Vec2::Vec2()
+		: Vec2(0.0f, 0.0f)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Vec2::Vec2(float f)
+		: m_values{ f, f }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Vec2::Vec2(float v1, float v2)
+		: m_values{ v1, v2 }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec2::x() const
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec2::y() const
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec2::r() const
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec2::g() const
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec2::s() const
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec2::t() const
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec2::x()
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec2::y()
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec2::r()
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec2::g()
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec2::s()
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec2::t()
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_INLINE float Vec2::magnitude() const
+	{
+		return sqrt(x() * x() + y() * y());
+	}
+
+	ENGINE_MATHS_INLINE void Vec2::normalize()
+	{
+		*this /= magnitude();
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec2 Vec2::operator+(const Vec2& vec2) const
+	{
+		return Vec2(x() + vec2.x(), y() + vec2.y());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec2 Vec2::operator-(const Vec2& vec2) const
+	{
+		return Vec2(x() - vec2.x(), y() - vec2.y());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec2 Vec2::operator-() const
+	{
+		return Vec2(-x(), -y());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec2 Vec2::operator*(const Vec2& vec2) const
+	{
+		return Vec2(x() * vec2.x(), y() * vec2.y());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec2 Vec2::operator*(float f) const
+	{
+		return Vec2(x() * f, y() * f);
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec2 Vec2::operator/(const Vec2& vec2) const
+	{
+		return Vec2(x() / vec2.x(), y() / vec2.y());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec2 Vec2::operator/(float f) const
+	{
+		return Vec2(x() / f, y() / f);
+	}
+
+	ENGINE_MATHS_INLINE Vec2& Vec2::operator+=(const Vec2& vec2)
+	{
+		x() += vec2.x();
+		y() += vec2.y();
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec2& Vec2::operator-=(const Vec2& vec2)
+	{
+		x() -= vec2.x();
+		y() -= vec2.y();
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec2& Vec2::operator*=(const Vec2& vec2)
+	{
+		x() *= vec2.x();
+		y() *= vec2.y();
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec2& Vec2::operator*=(float f)
+	{
+		x() *= f;
+		y() *= f;
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec2& Vec2::operator/=(const Vec2& vec2)
+	{
+		x() /= vec2.x();
+		y() /= vec2.y();
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec2& Vec2::operator/=(float f)
+	{
+		x() /= f;
+		y() /= f;
+		return *this;
+	}
+
+	ENGINE_MATHS_CONSTEXPR bool Vec2::operator==(const Vec2& vec2) const
+	{
+		return x() == vec2.x() && y() == vec2.y();
+	}
+
+	ENGINE_MATHS_CONSTEXPR bool Vec2::operator!=(const Vec2& vec2) const
+	{
+		return !(*this == vec2);
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec2::operator()(int i) const
+	{
+		return m_values[i];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec2::operator()(int i)
+	{
+		return m_values[i];
+	}
+
+} }
\ No newline at end of file
@@ -8,7 +8,7 @@
 
 // Local includes
 
-#include "maths\maths.h"
+#include "maths/maths.h"
 
 
 // Namespaces
@@ -20,70 +20,70 @@ namespace engine { namespace maths {
 	{
 	public:
 		//! Constructs an empty three-component vector.
-		Vec3();
+		ENGINE_MATHS_CONSTEXPR Vec3();
 
 		//! Constructs a three-component vector filled with a specified value.
 		/*! @param f Value to fill the vector with. */
-		Vec3(float f);
+		ENGINE_MATHS_CONSTEXPR Vec3(float f);
 
 		//! Constructs a three-component vector with specified values.
 		/*! @param v1 Vector's first component. (X, R, or S value)
 		  * @param v2 Vector's second component. (Y, G, or T value)
 		  * @param v3 Vector's third component. (Z, B, or P value) */
-		Vec3(float v1, float v2, float v3);
+		ENGINE_MATHS_CONSTEXPR Vec3(float v1, float v2, float v3);
 
 		//! Constructs a three-component vector using another.
 		/*! @param vec3 A three-component vector. */
-		Vec3(const Vec3& vec3);
+		Vec3(const Vec3& vec3) = default;
 
 		//! Constructs a three-component vector using a four-component vector.
 		/*! Uses the first three components of a four-component vector and throws away the last.
 		  * @param vec4 A four-component vector. */
-		Vec3(const Vec4& vec4);
+		ENGINE_MATHS_CONSTEXPR Vec3(const Vec4& vec4);
 
 		//! Constructs a three component vector using a two-component vector and a specified third value.
 		/*! @param vec2 A two-component vector to use for the first and second components.
 		  * @param z The value of the vector's third component. */
-		Vec3(const Vec2& vec2, float z);
+		ENGINE_MATHS_CONSTEXPR Vec3(const Vec2& vec2, float z);
 
 		//! Default destructor.
-		~Vec3();
+		~Vec3() = default;
 
 		//! Vector's X component.
 		/*! @return Read-only reference to the vector's first component. */
-		const float& x() const;
+		ENGINE_MATHS_CONSTEXPR const float& x() const;
 
 		//! Vector's Y component.
 		/*! @return Read-only reference to the vector's second component. */
-		const float& y() const;
+		ENGINE_MATHS_CONSTEXPR const float& y() const;
 
 		//! Vector's Z component.
 		/*! @return Read-only reference to the vector's third component. */
-		const float& z() const;
+		ENGINE_MATHS_CONSTEXPR const float& z() const;
 
 		//! Vector's R component.
 		/*! @return Read-only reference to the vector's first component. */
-		const float& r() const;
+		ENGINE_MATHS_CONSTEXPR const float& r() const;
 
 		//! Vector's G component.
 		/*! @return Read-only reference to the vector's second component. */
-		const float& g() const;
+		ENGINE_MATHS_CONSTEXPR const float& g() const;
 
 		//! Vector's B component.
 		/*! @return Read-only reference to the vector's third component. */
-		const float& b() const;
+		ENGINE_MATHS_CONSTEXPR const float& b() const;
 
 		//! Vector's S component.
 		/*! @return Read-only reference to the vector's first component. */
-		const float& s() const;
+		ENGINE_MATHS_CONSTEXPR const float& s() const;
 
 		//! Vector's T component.
 		/*! @return Read-only reference to the vector's second component. */
-		const float& t() const;
+		ENGINE_MATHS_CONSTEXPR const float& t() const;
 
 		//! Vector's P component.
 		/*! @return Read-only reference to the vector's third component. */
-		const float& p() const;
+		ENGINE_MATHS_CONSTEXPR const float& p() const;
 
 		//! Vector's X component.
 		/*! @return Modifiable reference to the vector's first component. */
@@ -128,19 +128,19 @@ namespace engine { namespace maths {
 		//! Normalizes the vector.
 		void normalize();
 
-		Vec3 operator+(const Vec3& vec3) const;
+		ENGINE_MATHS_CONSTEXPR Vec3 operator+(const Vec3& vec3) const;
 
-		Vec3 operator-(const Vec3& vec3) const;
+		ENGINE_MATHS_CONSTEXPR Vec3 operator-(const Vec3& vec3) const;
 
-		Vec3 operator-() const;
+		ENGINE_MATHS_CONSTEXPR Vec3 operator-() const;
 
-		Vec3 operator*(const Vec3& vec3) const;
+		ENGINE_MATHS_CONSTEXPR Vec3 operator*(const Vec3& vec3) const;
 
-		Vec3 operator*(float f) const;
+		ENGINE_MATHS_CONSTEXPR Vec3 operator*(float f) const;
 
-		Vec3 operator/(const Vec3& vec3) const;
+		ENGINE_MATHS_CONSTEXPR Vec3 operator/(const Vec3& vec3) const;
 
-		Vec3 operator/(float f) const;
+		ENGINE_MATHS_CONSTEXPR Vec3 operator/(float f) const;
 
 		Vec3& operator+=(const Vec3& vec3);
 
@@ -154,11 +154,11 @@ namespace engine { namespace maths {
 
 		Vec3& operator/=(float f);
 
-		bool operator==(const Vec3& vec3) const;
+		ENGINE_MATHS_CONSTEXPR bool operator==(const Vec3& vec3) const;
 
-		bool operator!=(const Vec3& vec3) const;
+		ENGINE_MATHS_CONSTEXPR bool operator!=(const Vec3& vec3) const;
 
-		const float& operator()(int i) const;
+		ENGINE_MATHS_CONSTEXPR const float& operator()(int i) const;
 
 		float& operator()(int i);
 
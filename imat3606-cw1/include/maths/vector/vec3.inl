@@ -0,0 +1,236 @@
+#pragma once
+
+/*!
+  * @file vec3.inl
+  * @brief Inline definitions for the Vec3 class.
+  * @author George McDonagh */
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_CONSTEXPR Vec3::Vec3()
+		: Vec3(0.0f, 0.0f, 0.0f)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Vec3::Vec3(float f)
+		: m_values{ f, f, f }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Vec3::Vec3(float v1, float v2, float v3)
+		: m_values{ v1, v2, v3 }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Vec3::Vec3(const Vec4& vec4)
+		: Vec3(vec4.x(), vec4.y(), vec4.z())
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Vec3::Vec3(const Vec2& vec2, float z)
+		: Vec3(vec2.x(), vec2.y(), z)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec3::x() const
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec3::y() const
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec3::z() const
+	{
+		return m_values[2];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec3::r() const
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec3::g() const
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec3::b() const
+	{
+		return m_values[2];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec3::s() const
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec3::t() const
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec3::p() const
+	{
+		return m_values[2];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec3::x()
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec3::y()
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec3::z()
+	{
+		return m_values[2];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec3::r()
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec3::g()
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec3::b()
+	{
+		return m_values[2];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec3::s()
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec3::t()
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec3::p()
+	{
+		return m_values[2];
+	}
+
+	ENGINE_MATHS_INLINE float Vec3::magnitude() const
+	{
+		return sqrt(x() * x() + y() * y() + z() * z());
+	}
+
+	ENGINE_MATHS_INLINE void Vec3::normalize()
+	{
+		*this /= magnitude();
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec3 Vec3::operator+(const Vec3& vec3) const
+	{
+		return Vec3(x() + vec3.x(), y() + vec3.y(), z() + vec3.z());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec3 Vec3::operator-(const Vec3& vec3) const
+	{
+		return Vec3(x() - vec3.x(), y() - vec3.y(), z() - vec3.z());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec3 Vec3::operator-() const
+	{
+		return Vec3(-x(), -y(), -z());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec3 Vec3::operator*(const Vec3& vec3) const
+	{
+		return Vec3(x() * vec3.x(), y() * vec3.y(), z() * vec3.z());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec3 Vec3::operator*(float f) const
+	{
+		return Vec3(x() * f, y() * f, z() * f);
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec3 Vec3::operator/(const Vec3& vec3) const
+	{
+		return Vec3(x() / vec3.x(), y() / vec3.y(), z() / vec3.z());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec3 Vec3::operator/(float f) const
+	{
+		return Vec3(x() / f, y() / f, z() / f);
+	}
+
+	ENGINE_MATHS_INLINE Vec3& Vec3::operator+=(const Vec3& vec3)
+	{
+		x() += vec3.x();
+		y() += vec3.y();
+		z() += vec3.z();
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec3& Vec3::operator-=(const Vec3& vec3)
+	{
+		x() -= vec3.x();
+		y() -= vec3.y();
+		z() -= vec3.z();
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec3& Vec3::operator*=(const Vec3& vec3)
+	{
+		x() *= vec3.x();
+		y() *= vec3.y();
+		z() *= vec3.z();
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec3& Vec3::operator*=(float f)
+	{
+		x() *= f;
+		y() *= f;
+		z() *= f;
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec3& Vec3::operator/=(const Vec3& vec3)
+	{
+		x() /= vec3.x();
+		y() /= vec3.y();
+		z() /= vec3.z();
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec3& Vec3::operator/=(float f)
+	{
+		x() /= f;
+		y() /= f;
+		z() /= f;
+		return *this;
+	}
+
+	ENGINE_MATHS_CONSTEXPR bool Vec3::operator==(const Vec3& vec3) const
+	{
+		return x() == vec3.x() && y() == vec3.y() && z() == vec3.z();
+	}
+
+	ENGINE_MATHS_CONSTEXPR bool Vec3::operator!=(const Vec3& vec3) const
+	{
+		return !(*this == vec3);
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec3::operator()(int i) const
+	{
+		return m_values[i];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec3::operator()(int i)
+	{
+		return m_values[i];
+	}
+
+} }
\ No newline at end of file
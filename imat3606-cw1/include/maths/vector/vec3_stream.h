@@ -0,0 +1,143 @@
+#pragma once
+
+/*!
+  * @file vec3_stream.h
+  * @brief Header file for the Vec3Stream class.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <vector>
+
+
+// Local includes
+
+#include "maths/maths.h"
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	//! A structure-of-arrays container of three-component vectors.
+	/*! Stores the X, Y, and Z components of its vectors in three separate arrays, each aligned to ENGINE_SIMD_ALIGNMENT bytes, so that whole streams can be
+	  * processed several vectors per instruction with the nonmember functions such as add(), dot(), and normalize(). Prefer those over looping with get() and set().
+	  * @note Pointers returned by x(), y(), and z() are invalidated by anything which changes the stream's capacity. */
+	class Vec3Stream
+	{
+	public:
+		//! Constructs an empty stream.
+		Vec3Stream();
+
+		//! Constructs a stream of zero vectors.
+		/*! @param size The number of vectors in the stream. */
+		explicit Vec3Stream(size_t size);
+
+		//! Constructs a stream from an array of three-component vectors.
+		/*! @param vectors The vectors to copy in to the stream. */
+		Vec3Stream(const std::vector<Vec3>& vectors);
+
+		//! Constructs a stream using another.
+		/*! @param other The stream to copy. */
+		Vec3Stream(const Vec3Stream& other);
+
+		//! Constructs a stream by taking another's arrays.
+		/*! @param other The stream to move from. Left empty. */
+		Vec3Stream(Vec3Stream&& other);
+
+		//! Destructor. Releases the stream's arrays.
+		~Vec3Stream();
+
+		Vec3Stream& operator=(const Vec3Stream& other);
+
+		Vec3Stream& operator=(Vec3Stream&& other);
+
+		//! Stream's size.
+		/*! @return The number of vectors in the stream. */
+		size_t size() const;
+
+		//! Stream's capacity.
+		/*! @return The number of vectors the stream can hold before it has to reallocate its arrays. */
+		size_t capacity() const;
+
+		//! Check whether the stream is empty.
+		/*! @return True if the stream holds no vectors. */
+		bool empty() const;
+
+		//! Change the number of vectors in the stream.
+		/*! New vectors are zero vectors.
+		  * @param size The stream's new size. */
+		void resize(size_t size);
+
+		//! Make sure the stream can hold a number of vectors without reallocating.
+		/*! @param capacity The minimum number of vectors to make room for. */
+		void reserve(size_t capacity);
+
+		//! Remove every vector from the stream. Keeps the stream's capacity.
+		void clear();
+
+		//! Add a vector to the end of the stream.
+		/*! @param vec3 The vector to add. */
+		void pushBack(const Vec3& vec3);
+
+		//! Get a vector from the stream.
+		/*! @param i The index of the vector.
+		  * @return A copy of the vector at @p i. */
+		Vec3 get(size_t i) const;
+
+		//! Set a vector in the stream.
+		/*! @param i The index of the vector.
+		  * @param vec3 The vector's new value. */
+		void set(size_t i, const Vec3& vec3);
+
+		//! Stream's X components.
+		/*! @return Read-only pointer to the array of X components. */
+		const float* x() const;
+
+		//! Stream's Y components.
+		/*! @return Read-only pointer to the array of Y components. */
+		const float* y() const;
+
+		//! Stream's Z components.
+		/*! @return Read-only pointer to the array of Z components. */
+		const float* z() const;
+
+		//! Stream's X components.
+		/*! @return Modifiable pointer to the array of X components. */
+		float* x();
+
+		//! Stream's Y components.
+		/*! @return Modifiable pointer to the array of Y components. */
+		float* y();
+
+		//! Stream's Z components.
+		/*! @return Modifiable pointer to the array of Z components. */
+		float* z();
+
+		//! Stream's component arrays.
+		/*! For passing to the per-component kernels in engine::maths::simd.
+		  * @return Read-only pointer to the X, Y, and Z array pointers. */
+		const float* const* components() const;
+
+		//! Stream's component arrays.
+		/*! For passing to the per-component kernels in engine::maths::simd.
+		  * @return Pointer to the X, Y, and Z array pointers. */
+		float* const* components();
+
+		//! Copy the stream's vectors out in to an array of three-component vectors.
+		/*! @return The stream's vectors. */
+		std::vector<Vec3> toVector() const;
+
+	private:
+		//! Move the stream's vectors in to new arrays.
+		/*! @param capacity The new capacity. Must be at least the stream's size. */
+		void reallocate(size_t capacity);
+
+		float* m_data; /*!< The single allocation holding the X, Y, and Z arrays one after the other. */
+		float* m_components[3]; /*!< Pointers to the X, Y, and Z arrays inside m_data. */
+		size_t m_size; /*!< The number of vectors in the stream. */
+		size_t m_capacity; /*!< The number of vectors each array has room for. Always a multiple of 8, so every array stays aligned. */
+	};
+
+} }
\ No newline at end of file
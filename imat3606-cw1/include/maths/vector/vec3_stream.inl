@@ -0,0 +1,85 @@
+#pragma once
+
+/*!
+  * @file vec3_stream.inl
+  * @brief Inline definitions for the Vec3Stream class.
+  * @author George McDonagh */
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_INLINE size_t Vec3Stream::size() const
+	{
+		return m_size;
+	}
+
+	ENGINE_MATHS_INLINE size_t Vec3Stream::capacity() const
+	{
+		return m_capacity;
+	}
+
+	ENGINE_MATHS_INLINE bool Vec3Stream::empty() const
+	{
+		return m_size == 0;
+	}
+
+	ENGINE_MATHS_INLINE void Vec3Stream::clear()
+	{
+		m_size = 0;
+	}
+
+	ENGINE_MATHS_INLINE Vec3 Vec3Stream::get(size_t i) const
+	{
+		return Vec3(m_components[0][i], m_components[1][i], m_components[2][i]);
+	}
+
+	ENGINE_MATHS_INLINE void Vec3Stream::set(size_t i, const Vec3& vec3)
+	{
+		m_components[0][i] = vec3.x();
+		m_components[1][i] = vec3.y();
+		m_components[2][i] = vec3.z();
+	}
+
+	ENGINE_MATHS_INLINE const float* Vec3Stream::x() const
+	{
+		return m_components[0];
+	}
+
+	ENGINE_MATHS_INLINE const float* Vec3Stream::y() const
+	{
+		return m_components[1];
+	}
+
+	ENGINE_MATHS_INLINE const float* Vec3Stream::z() const
+	{
+		return m_components[2];
+	}
+
+	ENGINE_MATHS_INLINE float* Vec3Stream::x()
+	{
+		return m_components[0];
+	}
+
+	ENGINE_MATHS_INLINE float* Vec3Stream::y()
+	{
+		return m_components[1];
+	}
+
+	ENGINE_MATHS_INLINE float* Vec3Stream::z()
+	{
+		return m_components[2];
+	}
+
+	ENGINE_MATHS_INLINE const float* const* Vec3Stream::components() const
+	{
+		return m_components;
+	}
+
+	ENGINE_MATHS_INLINE float* const* Vec3Stream::components()
+	{
+		return m_components;
+	}
+
+} }
\ No newline at end of file
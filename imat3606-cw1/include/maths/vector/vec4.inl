@@ -0,0 +1,268 @@
+#pragma once
+
+/*!
+  * @file vec4.inl
+  * @brief Inline definitions for the Vec4 class.
+  * @author George McDonagh */
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_CONSTEXPR Vec4::Vec4()
+		: Vec4(0.0f, 0.0f, 0.0f, 0.0f)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Vec4::Vec4(float f)
+		: m_values{ f, f, f, f }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Vec4::Vec4(float v1, float v2, float v3, float v4)
+		: m_values{ v1, v2, v3, v4 }
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR Vec4::Vec4(const Vec3& vec3)
+		: Vec4(vec3.x(), vec3.y(), vec3.z(), 1.0f)
+	{ }
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec4::x() const
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec4::y() const
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec4::z() const
+	{
+		return m_values[2];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec4::w() const
+	{
+		return m_values[3];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec4::r() const
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec4::g() const
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec4::b() const
+	{
+		return m_values[2];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec4::a() const
+	{
+		return m_values[3];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec4::s() const
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec4::t() const
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec4::p() const
+	{
+		return m_values[2];
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec4::q() const
+	{
+		return m_values[3];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec4::x()
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec4::y()
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec4::z()
+	{
+		return m_values[2];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec4::w()
+	{
+		return m_values[3];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec4::r()
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec4::g()
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec4::b()
+	{
+		return m_values[2];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec4::a()
+	{
+		return m_values[3];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec4::s()
+	{
+		return m_values[0];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec4::t()
+	{
+		return m_values[1];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec4::p()
+	{
+		return m_values[2];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec4::q()
+	{
+		return m_values[3];
+	}
+
+	ENGINE_MATHS_INLINE float Vec4::magnitude() const
+	{
+		return sqrt(x() * x() + y() * y() + z() * z() + w() * w());
+	}
+
+	ENGINE_MATHS_INLINE void Vec4::normalize()
+	{
+		*this /= magnitude();
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec4 Vec4::operator+(const Vec4& vec4) const
+	{
+		return Vec4(x() + vec4.x(), y() + vec4.y(), z() + vec4.z(), w() + vec4.w());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec4 Vec4::operator-(const Vec4& vec4) const
+	{
+		return Vec4(x() - vec4.x(), y() - vec4.y(), z() - vec4.z(), w() - vec4.w());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec4 Vec4::operator-() const
+	{
+		return Vec4(-x(), -y(), -z(), -w());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec4 Vec4::operator*(const Vec4& vec4) const
+	{
+		return Vec4(x() * vec4.x(), y() * vec4.y(), z() * vec4.z(), w() * vec4.w());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec4 Vec4::operator*(float f) const
+	{
+		return Vec4(x() * f, y() * f, z() * f, w() * f);
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec4 Vec4::operator/(const Vec4& vec4) const
+	{
+		return Vec4(x() / vec4.x(), y() / vec4.y(), z() / vec4.z(), w() / vec4.w());
+	}
+
+	ENGINE_MATHS_CONSTEXPR Vec4 Vec4::operator/(float f) const
+	{
+		return Vec4(x() / f, y() / f, z() / f, w() / f);
+	}
+
+	ENGINE_MATHS_INLINE Vec4& Vec4::operator+=(const Vec4& vec4)
+	{
+		x() += vec4.x();
+		y() += vec4.y();
+		z() += vec4.z();
+		w() += vec4.w();
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec4& Vec4::operator-=(const Vec4& vec4)
+	{
+		x() -= vec4.x();
+		y() -= vec4.y();
+		z() -= vec4.z();
+		w() -= vec4.w();
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec4& Vec4::operator*=(const Vec4& vec4)
+	{
+		x() *= vec4.x();
+		y() *= vec4.y();
+		z() *= vec4.z();
+		w() *= vec4.w();
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec4& Vec4::operator*=(float f)
+	{
+		x() *= f;
+		y() *= f;
+		z() *= f;
+		w() *= f;
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec4& Vec4::operator/=(const Vec4& vec4)
+	{
+		x() /= vec4.x();
+		y() /= vec4.y();
+		z() /= vec4.z();
+		w() /= vec4.w();
+		return *this;
+	}
+
+	ENGINE_MATHS_INLINE Vec4& Vec4::operator/=(float f)
+	{
+		x() /= f;
+		y() /= f;
+		z() /= f;
+		w() /= f;
+		return *this;
+	}
+
+	ENGINE_MATHS_CONSTEXPR bool Vec4::operator==(const Vec4& vec4) const
+	{
+		return x() == vec4.x() && y() == vec4.y() && z() == vec4.z() && w() == vec4.w();
+	}
+
+	ENGINE_MATHS_CONSTEXPR bool Vec4::operator!=(const Vec4& vec4) const
+	{
+		return !(*this == vec4);
+	}
+
+	ENGINE_MATHS_CONSTEXPR const float& Vec4::operator()(int i) const
+	{
+		return m_values[i];
+	}
+
+	ENGINE_MATHS_INLINE float& Vec4::operator()(int i)
+	{
+		return m_values[i];
+	}
+
+} }
\ No newline at end of file
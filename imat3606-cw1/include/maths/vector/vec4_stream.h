@@ -0,0 +1,151 @@
+#pragma once
+
+/*!
+  * @file vec4_stream.h
+  * @brief Header file for the Vec4Stream class.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <vector>
+
+
+// Local includes
+
+#include "maths/maths.h"
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	//! A structure-of-arrays container of four-component vectors.
+	/*! Stores the X, Y, Z, and W components of its vectors in three separate arrays, each aligned to ENGINE_SIMD_ALIGNMENT bytes, so that whole streams can be
+	  * processed several vectors per instruction with the nonmember functions such as add(), dot(), and normalize(). Prefer those over looping with get() and set().
+	  * @note Pointers returned by x(), y(), z(), and w() are invalidated by anything which changes the stream's capacity. */
+	class Vec4Stream
+	{
+	public:
+		//! Constructs an empty stream.
+		Vec4Stream();
+
+		//! Constructs a stream of zero vectors.
+		/*! @param size The number of vectors in the stream. */
+		explicit Vec4Stream(size_t size);
+
+		//! Constructs a stream from an array of four-component vectors.
+		/*! @param vectors The vectors to copy in to the stream. */
+		Vec4Stream(const std::vector<Vec4>& vectors);
+
+		//! Constructs a stream using another.
+		/*! @param other The stream to copy. */
+		Vec4Stream(const Vec4Stream& other);
+
+		//! Constructs a stream by taking another's arrays.
+		/*! @param other The stream to move from. Left empty. */
+		Vec4Stream(Vec4Stream&& other);
+
+		//! Destructor. Releases the stream's arrays.
+		~Vec4Stream();
+
+		Vec4Stream& operator=(const Vec4Stream& other);
+
+		Vec4Stream& operator=(Vec4Stream&& other);
+
+		//! Stream's size.
+		/*! @return The number of vectors in the stream. */
+		size_t size() const;
+
+		//! Stream's capacity.
+		/*! @return The number of vectors the stream can hold before it has to reallocate its arrays. */
+		size_t capacity() const;
+
+		//! Check whether the stream is empty.
+		/*! @return True if the stream holds no vectors. */
+		bool empty() const;
+
+		//! Change the number of vectors in the stream.
+		/*! New vectors are zero vectors.
+		  * @param size The stream's new size. */
+		void resize(size_t size);
+
+		//! Make sure the stream can hold a number of vectors without reallocating.
+		/*! @param capacity The minimum number of vectors to make room for. */
+		void reserve(size_t capacity);
+
+		//! Remove every vector from the stream. Keeps the stream's capacity.
+		void clear();
+
+		//! Add a vector to the end of the stream.
+		/*! @param vec4 The vector to add. */
+		void pushBack(const Vec4& vec4);
+
+		//! Get a vector from the stream.
+		/*! @param i The index of the vector.
+		  * @return A copy of the vector at @p i. */
+		Vec4 get(size_t i) const;
+
+		//! Set a vector in the stream.
+		/*! @param i The index of the vector.
+		  * @param vec4 The vector's new value. */
+		void set(size_t i, const Vec4& vec4);
+
+		//! Stream's X components.
+		/*! @return Read-only pointer to the array of X components. */
+		const float* x() const;
+
+		//! Stream's Y components.
+		/*! @return Read-only pointer to the array of Y components. */
+		const float* y() const;
+
+		//! Stream's Z components.
+		/*! @return Read-only pointer to the array of Z components. */
+		const float* z() const;
+
+		//! Stream's W components.
+		/*! @return Read-only pointer to the array of W components. */
+		const float* w() const;
+
+		//! Stream's X components.
+		/*! @return Modifiable pointer to the array of X components. */
+		float* x();
+
+		//! Stream's Y components.
+		/*! @return Modifiable pointer to the array of Y components. */
+		float* y();
+
+		//! Stream's Z components.
+		/*! @return Modifiable pointer to the array of Z components. */
+		float* z();
+
+		//! Stream's W components.
+		/*! @return Modifiable pointer to the array of W components. */
+		float* w();
+
+		//! Stream's component arrays.
+		/*! For passing to the per-component kernels in engine::maths::simd.
+		  * @return Read-only pointer to the X, Y, Z, and W array pointers. */
+		const float* const* components() const;
+
+		//! Stream's component arrays.
+		/*! For passing to the per-component kernels in engine::maths::simd.
+		  * @return Pointer to the X, Y, Z, and W array pointers. */
+		float* const* components();
+
+		//! Copy the stream's vectors out in to an array of four-component vectors.
+		/*! @return The stream's vectors. */
+		std::vector<Vec4> toVector() const;
+
+	private:
+		//! Move the stream's vectors in to new arrays.
+		/*! @param capacity The new capacity. Must be at least the stream's size. */
+		void reallocate(size_t capacity);
+
+		float* m_data; /*!< The single allocation holding the X, Y, Z, and W arrays one after the other. */
+		float* m_components[4]; /*!< Pointers to the X, Y, Z, and W arrays inside m_data. */
+		size_t m_size; /*!< The number of vectors in the stream. */
+		size_t m_capacity; /*!< The number of vectors each array has room for. Always a multiple of 8, so every array stays aligned. */
+	};
+
+} }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+/*!
+  * @file vec4_stream.inl
+  * @brief Inline definitions for the Vec4Stream class.
+  * @author George McDonagh */
+
+
+// Namespaces
+
+namespace engine { namespace maths {
+
+	ENGINE_MATHS_INLINE size_t Vec4Stream::size() const
+	{
+		return m_size;
+	}
+
+	ENGINE_MATHS_INLINE size_t Vec4Stream::capacity() const
+	{
+		return m_capacity;
+	}
+
+	ENGINE_MATHS_INLINE bool Vec4Stream::empty() const
+	{
+		return m_size == 0;
+	}
+
+	ENGINE_MATHS_INLINE void Vec4Stream::clear()
+	{
+		m_size = 0;
+	}
+
+	ENGINE_MATHS_INLINE Vec4 Vec4Stream::get(size_t i) const
+	{
+		return Vec4(m_components[0][i], m_components[1][i], m_components[2][i], m_components[3][i]);
+	}
+
+	ENGINE_MATHS_INLINE void Vec4Stream::set(size_t i, const Vec4& vec4)
+	{
+		m_components[0][i] = vec4.x();
+		m_components[1][i] = vec4.y();
+		m_components[2][i] = vec4.z();
+		m_components[3][i] = vec4.w();
+	}
+
+	ENGINE_MATHS_INLINE const float* Vec4Stream::x() const
+	{
+		return m_components[0];
+	}
+
+	ENGINE_MATHS_INLINE const float* Vec4Stream::y() const
+	{
+		return m_components[1];
+	}
+
+	ENGINE_MATHS_INLINE const float* Vec4Stream::z() const
+	{
+		return m_components[2];
+	}
+
+	ENGINE_MATHS_INLINE const float* Vec4Stream::w() const
+	{
+		return m_components[3];
+	}
+
+	ENGINE_MATHS_INLINE float* Vec4Stream::x()
+	{
+		return m_components[0];
+	}
+
+	ENGINE_MATHS_INLINE float* Vec4Stream::y()
+	{
+		return m_components[1];
+	}
+
+	ENGINE_MATHS_INLINE float* Vec4Stream::z()
+	{
+		return m_components[2];
+	}
+
+	ENGINE_MATHS_INLINE float* Vec4Stream::w()
+	{
+		return m_components[3];
+	}
+
+	ENGINE_MATHS_INLINE const float* const* Vec4Stream::components() const
+	{
+		return m_components;
+	}
+
+	ENGINE_MATHS_INLINE float* const* Vec4Stream::components()
+	{
+		return m_components;
+	}
+
+} }
\ No newline at end of file
@@ -17,9 +17,15 @@
 namespace engine {
 
 	//! A SceneObject component representing its 3D mesh.
+	/*! The mesh may have coarser levels of detail (LODs) for when the SceneObject is small on screen. Level 0 is mesh(); each level added with
+	  * addLOD() is drawn once the SceneObject's bounding sphere covers less of the screen than that level's screen size. The renderer picks
+	  * the level each frame with selectLOD(). */
 	class MeshComponent : public Component
 	{
 	public:
+		static const ComponentType TYPE = COMPONENT_MESH; /*!< The ComponentType of MeshComponents. */
+		static const unsigned int MAX_LODS = 4; /*!< The most levels of detail a MeshComponent can have, including mesh(). */
+
 		//! Mesh constructor.
 		/*! @param mesh A pointer to a constant Mesh. The mesh to initialize the MeshComponent with. */
 		MeshComponent(const graphics::Mesh* mesh);
@@ -28,11 +34,56 @@ namespace engine {
 		~MeshComponent() override;
 
 		//! Get the MeshComponent's Mesh.
-		/*! @return A reference to a mutable pointer to a constant Mesh. */
+		/*! @return A reference to a mutable pointer to a constant Mesh. This is the most detailed level, level 0. */
 		const graphics::Mesh*& mesh();
 
+		//! Add a coarser level of detail.
+		/*! @param mesh A pointer to a constant Mesh. Should have about the same bounds as mesh(), as only mesh()'s bounds are used for culling
+		  * and for measuring the SceneObject's size on screen.
+		  * @param screenSize The fraction of the screen's height that the SceneObject's bounding sphere must cover less of for @p mesh to be
+		  * drawn. Must be smaller than the previous level's.
+		  * @return False if the MeshComponent already has MAX_LODS levels or @p screenSize isn't smaller than the previous level's, in which
+		  * case nothing happens. */
+		bool addLOD(const graphics::Mesh* mesh, float screenSize);
+
+		//! Get the number of levels of detail.
+		/*! @return The number of levels, including mesh(). */
+		unsigned int lodCount() const;
+
+		//! Get a level of detail's mesh.
+		/*! @param level The level, less than lodCount().
+		  * @return A pointer to the level's constant Mesh. */
+		const graphics::Mesh* lodMesh(unsigned int level) const;
+
+		//! Get a level of detail's screen size.
+		/*! @param level The level, less than lodCount().
+		  * @return The fraction of the screen's height below which the level is drawn. Level 0 has no limit, so returns infinity. */
+		float lodScreenSize(unsigned int level) const;
+
+		//! Get the level of detail selectLOD() last picked.
+		/*! @return The level, or 0 if selectLOD() hasn't been called. */
+		unsigned int currentLOD() const;
+
+		//! Pick the level of detail to draw.
+		/*! The level only changes once @p screenSize is clearly past a threshold, so that a SceneObject sat near one doesn't flicker between
+		  * levels.
+		  * @param screenSize The fraction of the screen's height the SceneObject's bounding sphere covers. See maths::screenSize().
+		  * @param hysteresis How far past a threshold @p screenSize must be, as a fraction of the threshold.
+		  * @return The level to draw. */
+		unsigned int selectLOD(float screenSize, float hysteresis);
+
 	private:
+		//! A coarser level of detail.
+		struct LOD
+		{
+			const graphics::Mesh* mesh; /*!< The level's mesh. */
+			float screenSize; /*!< The screen size below which the level is drawn. */
+		};
+
 		const graphics::Mesh* m_mesh; /*!< A pointer to the Mesh Asset which the MeshComponent currently has. */
+		LOD m_lods[MAX_LODS - 1]; /*!< Levels 1 and up, from most to least detailed. */
+		unsigned int m_lodCount; /*!< The number of levels, including m_mesh. */
+		unsigned int m_currentLOD; /*!< The level selectLOD() last picked. */
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+/*!
+  * @file scene_bvh.h
+  * @brief Header file for the SceneBVH class.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <stdint.h>
+#include <vector>
+
+
+// Internal includes
+
+#include "maths/geometry/bvh.h"
+#include "component_store.h"
+#include "scene_object.h"
+
+
+// Namespaces
+
+namespace engine {
+
+	//! A spatial index over the world bounds of a scene's SceneObjects, for culling, picking, and proximity queries.
+	/*! Indexes every SceneObject with a BoundsComponent and a TransformComponent. The SceneObjects are split between two BVHs: a static one,
+	  * built once with the surface area heuristic and only rebuilt when it has gone stale, and a small dynamic one, which is refitted as its
+	  * SceneObjects move and rebuilt when SceneObjects join or leave it or refitting has worn down its quality. A static SceneObject which moves
+	  * is taken out of the static BVH and put in the dynamic one. Once enough SceneObjects in the dynamic BVH have stopped moving, the static
+	  * BVH is rebuilt with them in it. */
+	class SceneBVH
+	{
+	public:
+		//! SceneBVH constructor.
+		SceneBVH();
+
+		//! Bring the index up to date with a scene.
+		/*! Costs time in proportion to the number of SceneObjects that moved, unless the scene's structure changed, when every indexed
+		  * SceneObject is checked for having been added or removed.
+		  * @param store The scene's ComponentStore.
+		  * @param moved The SceneObjects whose world matrices have changed since the last update(). See TransformHierarchy::moved().
+		  * @param structureVersion The store's structure version. See ComponentStore::structureVersion(). */
+		void update(const ComponentStore& store, const std::vector<SceneObject*>& moved, unsigned long long structureVersion);
+
+		//! Find the SceneObjects whose world bounds overlap a box.
+		/*! @param box The box, in world space.
+		  * @param objects The vector to append the SceneObjects' handles to, in no particular order. */
+		void query(const maths::AABB& box, std::vector<SceneObjectHandle>& objects) const;
+
+		//! Find the SceneObjects whose world bounds are at least partly inside a frustum.
+		/*! @param frustum The frustum, in world space.
+		  * @param objects The vector to append the SceneObjects' handles to, in no particular order. */
+		void query(const maths::Frustum& frustum, std::vector<SceneObjectHandle>& objects) const;
+
+		//! Find the nearest SceneObject whose world bounds a ray hits.
+		/*! @param ray The ray, in world space.
+		  * @param t Set to the distance along @p ray to the hit, as maths::intersect(const Ray&, const AABB&, float&) would. Left unchanged
+		  * if @p ray misses.
+		  * @return The handle of the SceneObject hit, or a null handle if @p ray misses. */
+		SceneObjectHandle raycast(const maths::Ray& ray, float& t) const;
+
+		//! Get the number of SceneObjects in the index.
+		/*! @return The number of SceneObjects indexed as of the last update(). */
+		size_t size() const;
+
+		//! Get the number of SceneObjects in the dynamic BVH.
+		/*! @return The number of SceneObjects in the dynamic BVH as of the last update(). */
+		size_t dynamicSize() const;
+
+	private:
+		//! Which BVH a SceneObject is in.
+		enum Tree
+		{
+			TREE_NONE,
+			TREE_STATIC,
+			TREE_DYNAMIC
+		};
+
+		//! A SceneObject's place in the index.
+		struct Proxy
+		{
+			SceneObjectHandle handle; /*!< The SceneObject's handle. */
+			Tree tree; /*!< The BVH the SceneObject is in. */
+			uint32_t item; /*!< The SceneObject's item in the BVH. */
+			uint32_t lastMoved; /*!< The update() in which the SceneObject last moved or was added. */
+			uint32_t seen; /*!< The last update() that found the SceneObject in the scene's ComponentStore. */
+		};
+
+		maths::BVH m_static; /*!< The BVH of SceneObjects which haven't moved recently. */
+		std::vector<SceneObjectHandle> m_staticObjects; /*!< The SceneObject of each item in m_static, or a null handle for removed items. */
+		size_t m_staticRemoved; /*!< The number of items removed from m_static since it was built. */
+
+		maths::BVH m_dynamic; /*!< The BVH of SceneObjects which have moved recently. */
+		std::vector<SceneObjectHandle> m_dynamicObjects; /*!< The SceneObject of each item in m_dynamic. */
+		std::vector<maths::AABB> m_dynamicBoxes; /*!< The world bounds of each item in m_dynamic. */
+		bool m_dynamicChanged; /*!< Whether SceneObjects have joined or left m_dynamic since it was built. */
+		float m_dynamicBuildCost; /*!< The cost of m_dynamic when it was built. */
+
+		std::vector<Proxy> m_proxies; /*!< Each SceneObject's place in the index, indexed by its handle's index. */
+		uint32_t m_updates; /*!< The number of calls to update(). */
+		unsigned long long m_structureVersion; /*!< The structure version as of the last update(). */
+		bool m_built; /*!< Whether m_static has been built yet. */
+
+		//! Add SceneObjects which have gained bounds and remove those which have lost them or been destroyed.
+		/*! @param store The scene's ComponentStore. */
+		void reconcile(const ComponentStore& store);
+
+		//! Put a SceneObject in the dynamic BVH.
+		/*! @param proxy The SceneObject's proxy, which must not be in a BVH.
+		  * @param box The SceneObject's world bounds. */
+		void addDynamic(Proxy& proxy, const maths::AABB& box);
+
+		//! Take a SceneObject out of whichever BVH it's in.
+		/*! @param proxy The SceneObject's proxy. */
+		void remove(Proxy& proxy);
+
+		//! Rebuild the static BVH from the SceneObjects which haven't moved recently, and the dynamic BVH from the rest.
+		/*! @param settledBefore SceneObjects which last moved before this update() go in the static BVH. */
+		void rebuildStatic(uint32_t settledBefore);
+
+		//! Rebuild the dynamic BVH from m_dynamicBoxes.
+		void rebuildDynamic();
+	};
+
+}
\ No newline at end of file
@@ -8,39 +8,71 @@
 
 // External includes
 
-#include <typeindex>
-#include <unordered_map>
+#include <type_traits>
 #include <vector>
 
 
 // Internal includes
 
 #include "component.h"
+#include "component_store.h"
 #include "transform_component.h"
+#include "utils/object_pool.h"
 
 
 // Namespaces
 
 namespace engine {
 
+	namespace graphics { class Scene3D; }
+
+	//! A reference to a SceneObject which can tell when the SceneObject has been destroyed. See Scene3D::get().
+	typedef utils::PoolHandle SceneObjectHandle;
+
 	//! An object within a scene.
+	/*! A handle to a set of components. The components themselves are kept in the scene's ComponentStore along with those of other
+	  * SceneObjects with the same component types. SceneObjects are created and destroyed by Scene3D::create() and Scene3D::destroy().
+	  * @note Pointers returned by getComponent() and getComponents() are invalidated when a SceneObject or component is added to or removed
+	  * from the same scene, as that can move components in memory. */
 	class SceneObject
 	{
 	public:
-		//! SceneObject constructor.
-		SceneObject();
+		//! SceneObject constructor. Gives the SceneObject a TransformComponent at the origin.
+		/*! @param store The ComponentStore to keep the SceneObject's components in. */
+		explicit SceneObject(ComponentStore& store);
 
-		//! SceneObject destructor.
+		//! SceneObject destructor. Destroys the SceneObject's components, and makes its children roots.
 		~SceneObject();
 
+		SceneObject(const SceneObject&) = delete;
+
+		SceneObject& operator=(const SceneObject&) = delete;
+
 		//! Add a component to the SceneObject.
-		/*! @param component A pointer to the new Component object to give to the SceneObject. */
+		/*! @param component A pointer to the new Component object to give to the SceneObject. Replaces any existing component of type @p T.
+		  * The component is copied in to the SceneObject's ComponentStore and then deleted, so it must have been allocated with @c new. Passing
+		  * @p nullptr removes the SceneObject's component of type @p T. */
 		template <typename T>
 		void addComponent(T* component)
 		{
-			// Using the Component type as the component's key in the map of the SceneObject's components.
-			// ... this limits the SceneObject to have only one component of each Component type.
-			m_components[typeid(T)] = component;
+			if (component)
+			{
+				addComponent(*component);
+				delete component;
+			}
+			else
+				m_store->removeComponent(this, T::TYPE);
+		}
+
+		//! Add a component to the SceneObject, without allocating it on the heap first.
+		/*! @param component The component to copy in to the SceneObject's ComponentStore. Replaces any existing component of type @p T. */
+		template <typename T>
+		void addComponent(const T& component)
+		{
+			static_assert(std::is_base_of<Component, T>::value, "SceneObject components must derive from Component.");
+
+			// Each Component type has its own column, which limits the SceneObject to having only one component of each type.
+			m_store->setComponent(this, T::TYPE, component, &TypedColumn<T>::create);
 		}
 
 		//! Get the component of of type @p T.
@@ -48,32 +80,72 @@ namespace engine {
 		template <typename T>
 		T* getComponent()
 		{
-			// Only bother to attempt to find the component if it is a valid Component type.
-			if (std::is_base_of<Component, T>())
-			{
-				if (!m_components.empty() && m_components.find(typeid(T)) != m_components.end())
-					return dynamic_cast<T*>(m_components[typeid(T)]);
-			}
-			else
-				utils::Logger::log("WARNING::SCENE_OBJECT::GET_COMPONENT - Type argument \"%s\" is not a valid Component type.", typeid(T).name());
+			static_assert(std::is_base_of<Component, T>::value, "SceneObject components must derive from Component.");
+
+			// The column can only hold T, so there's no need for a dynamic_cast.
+			return hasComponent<T>() ? &m_archetype->column<T>()[m_row] : nullptr;
+		}
+
+		//! Get the component of of type @p T.
+		/*! @return A pointer to the retrieved immutable component. Returns @p nullptr if no component of type @p T exists. */
+		template <typename T>
+		const T* getComponent() const
+		{
+			static_assert(std::is_base_of<Component, T>::value, "SceneObject components must derive from Component.");
 
-			return nullptr;
+			return hasComponent<T>() ? &m_archetype->column<T>()[m_row] : nullptr;
 		}
 
 		//! Check if the SceneObject has a Component of a certain type.
 		/*! @return True if the SceneObject owns a Component of type @p T. */
 		template <typename T>
-		bool hasComponent()
+		bool hasComponent() const
 		{
-			return !m_components.empty() && m_components.find(typeid(T)) != m_components.end();
+			return (m_archetype->mask() & componentMask<T>()) != 0;
 		}
 
+		//! Check if the SceneObject has a Component of each of a set of types.
+		/*! @param mask The types to check for, for example @c componentMask<TransformComponent, MeshComponent>().
+		  * @return True if the SceneObject owns a Component of every type in @p mask. */
+		bool hasComponents(ComponentMask mask) const;
+
+		//! Get the set of Component types the SceneObject has.
+		/*! @return A ComponentMask with the bits of the SceneObject's component types set. */
+		ComponentMask getComponentMask() const;
+
 		//! Get the collection of SceneObject components.
-		/*! @return A vector of pointers to Components. */
+		/*! @return A vector of pointers to Components, in ComponentType order. */
 		std::vector<Component*> getComponents();
 
+		//! Set the SceneObject's parent.
+		/*! The SceneObject's TransformComponent becomes relative to the parent's, from the next Scene3D::update(). The parent should be in the
+		  * same scene.
+		  * @param parent A pointer to the new parent, or @p nullptr to make the SceneObject a root.
+		  * @return False if @p parent is the SceneObject or one of its descendants, in which case the parent isn't changed. */
+		bool setParent(SceneObject* parent);
+
+		//! Get the SceneObject's parent.
+		/*! @return A pointer to the parent. Returns @p nullptr if the SceneObject is a root. */
+		SceneObject* getParent() const;
+
+		//! Get the SceneObject's children.
+		/*! @return A reference to an immutable vector of pointers to the SceneObjects whose parent this is. */
+		const std::vector<SceneObject*>& getChildren() const;
+
+		//! Get the SceneObject's handle.
+		/*! @return The handle Scene3D::create() returned for the SceneObject. */
+		SceneObjectHandle getHandle() const;
+
 	private:
-		std::unordered_map<std::type_index, Component*> m_components; /*!< An unordered map of pointers to Components. The Component type is used as the key. */
+		friend class ComponentStore;
+		friend class graphics::Scene3D;
+
+		ComponentStore* m_store; /*!< The ComponentStore holding the SceneObject's components. */
+		Archetype* m_archetype; /*!< The archetype in m_store holding the SceneObject's components. */
+		size_t m_row; /*!< The SceneObject's row in m_archetype. */
+		SceneObject* m_parent; /*!< The SceneObject's parent, or @p nullptr. */
+		std::vector<SceneObject*> m_children; /*!< The SceneObjects whose parent this is. */
+		SceneObjectHandle m_handle; /*!< The SceneObject's handle in its scene. */
 	};
 
 }
\ No newline at end of file
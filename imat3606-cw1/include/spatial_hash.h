@@ -0,0 +1,211 @@
+#pragma once
+
+/*!
+  * @file spatial_hash.h
+  * @brief Header file for the SpatialHash class.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <stdint.h>
+#include <vector>
+
+
+// Internal includes
+
+#include "maths/maths.h"
+#include "scene_object.h"
+
+
+// Namespaces
+
+namespace engine {
+
+	//! A uniform grid of cubic cells over SceneObject positions, for gameplay proximity queries such as AI sensing and triggers.
+	/*! Only the cells which hold SceneObjects exist, found by hashing their coordinates, so the grid can cover an unbounded world. Each cell keeps
+	  * its SceneObjects' positions together, so a query reads a handful of short arrays. Inserting, moving and removing a SceneObject are O(1),
+	  * and moving one within its cell only writes its position.
+	  *
+	  * Queries write to a buffer the caller provides rather than allocating. Queries are fastest when their radius is about the cell size; much
+	  * larger radii visit many cells, and much smaller ones test many SceneObjects which are too far away.
+	  *
+	  * SceneObjects are tracked by handle, and aren't moved automatically. Either move() them as gameplay moves them, or pass the scene's
+	  * TransformHierarchy::moved() list to update() once a frame. */
+	class SpatialHash
+	{
+	public:
+		//! SpatialHash constructor.
+		/*! @param cellSize The length of each cell's sides. Should be about the radius of a typical query. */
+		explicit SpatialHash(float cellSize);
+
+		//! Add a SceneObject.
+		/*! @param handle The SceneObject's handle. Adding a SceneObject which is already in the hash moves it instead.
+		  * @param position The SceneObject's position. */
+		void insert(SceneObjectHandle handle, const maths::Vec3& position);
+
+		//! Move a SceneObject.
+		/*! @param handle The SceneObject's handle.
+		  * @param position The SceneObject's new position.
+		  * @return False if the SceneObject isn't in the hash, in which case nothing happens. */
+		bool move(SceneObjectHandle handle, const maths::Vec3& position);
+
+		//! Remove a SceneObject.
+		/*! @param handle The SceneObject's handle.
+		  * @return False if the SceneObject isn't in the hash, in which case nothing happens. */
+		bool remove(SceneObjectHandle handle);
+
+		//! Move the SceneObjects in the hash which have moved in the scene to the positions in their world matrices.
+		/*! @param moved The SceneObjects whose world matrices have changed. See TransformHierarchy::moved(). SceneObjects which aren't in the
+		  * hash are skipped. */
+		void update(const std::vector<SceneObject*>& moved);
+
+		//! Check whether a SceneObject is in the hash.
+		/*! @param handle The SceneObject's handle.
+		  * @return True if the SceneObject has been inserted and not since removed. */
+		bool contains(SceneObjectHandle handle) const;
+
+		//! Remove every SceneObject. Keeps the memory the cells were using, for reuse.
+		void clear();
+
+		//! Get the number of SceneObjects in the hash.
+		/*! @return The number of SceneObjects. */
+		size_t size() const;
+
+		//! Find the SceneObjects within a radius of a point.
+		/*! @param centre The point.
+		  * @param radius The radius. SceneObjects exactly @p radius away are included.
+		  * @param results The buffer to write the SceneObjects' handles to, in no particular order.
+		  * @param capacity The number of handles @p results has room for. Any SceneObjects found beyond that aren't written.
+		  * @return The number of SceneObjects found, which may be more than @p capacity. */
+		size_t queryRadius(const maths::Vec3& centre, float radius, SceneObjectHandle* results, size_t capacity) const;
+
+		//! Find the SceneObjects within a radius of each of many points.
+		/*! Quicker than querying each point on its own, as points which share a cell share the cell lookups. Ordering the points so that those
+		  * near each other are next to each other, as when each point is a SceneObject in the hash, makes that happen more often.
+		  * @param centres The points.
+		  * @param count The number of points.
+		  * @param radius The radius. SceneObjects exactly @p radius away are included.
+		  * @param results The buffer to write the SceneObjects' handles to. Each point's SceneObjects come after the previous point's.
+		  * @param capacity The number of handles @p results has room for. Any SceneObjects found beyond that aren't written.
+		  * @param offsets The buffer to write where each point's SceneObjects are in @p results to. Must have room for @p count + 1 offsets.
+		  * The SceneObjects near point @c i are @p results[offsets[i]] up to but not including @p results[offsets[i + 1]], and are cut short
+		  * if @p capacity ran out.
+		  * @return The number of SceneObjects found, counting those near more than one point once for each, which may be more than
+		  * @p capacity. */
+		size_t queryRadius(const maths::Vec3* centres, size_t count, float radius, SceneObjectHandle* results, size_t capacity, size_t* offsets) const;
+
+		//! Find the SceneObjects inside a box.
+		/*! @param box The box. SceneObjects on its surface are included.
+		  * @param results The buffer to write the SceneObjects' handles to, in no particular order.
+		  * @param capacity The number of handles @p results has room for. Any SceneObjects found beyond that aren't written.
+		  * @return The number of SceneObjects found, which may be more than @p capacity. */
+		size_t queryBox(const maths::AABB& box, SceneObjectHandle* results, size_t capacity) const;
+
+	private:
+		static const uint32_t NO_CELL = 0xFFFFFFFF; //!< Marks an empty slot in m_table.
+
+		//! A cell of the grid.
+		struct Cell
+		{
+			uint64_t key; /*!< The cell's packed coordinates. */
+			std::vector<maths::Vec3> positions; /*!< The positions of the SceneObjects in the cell. */
+			std::vector<SceneObjectHandle> handles; /*!< The handles of the SceneObjects in the cell, in the same order as positions. */
+		};
+
+		//! Where a SceneObject is in the grid.
+		struct Entry
+		{
+			uint32_t generation; /*!< The SceneObject's handle's generation, or 0 if no SceneObject in this slot is in the hash. */
+			uint32_t cell; /*!< The index of the SceneObject's cell in m_cells. */
+			uint32_t slot; /*!< The SceneObject's index in its cell. */
+		};
+
+		//! The cells overlapping a box, as a range of cell coordinates.
+		struct CellRange
+		{
+			int min[3]; /*!< The coordinates of the lowest cell. */
+			int max[3]; /*!< The coordinates of the highest cell. */
+		};
+
+		float m_inverseCellSize; /*!< 1 / the length of each cell's sides. */
+		std::vector<Cell> m_cells; /*!< Every cell which has ever held a SceneObject. Cells are kept when they empty, for reuse. */
+		std::vector<uint32_t> m_table; /*!< An open addressing hash table of indices in to m_cells, or NO_CELL. Its size is a power of two. */
+		std::vector<Entry> m_entries; /*!< Where each SceneObject is, indexed by its handle's index. */
+		size_t m_size; /*!< The number of SceneObjects. */
+
+		//! Find a cell.
+		/*! @param key The cell's packed coordinates.
+		  * @return The cell's index in m_cells, or NO_CELL if it doesn't exist. */
+		uint32_t findCell(uint64_t key) const;
+
+		//! Find a cell, creating it if it doesn't exist.
+		/*! @param key The cell's packed coordinates.
+		  * @return The cell's index in m_cells. */
+		uint32_t findOrCreateCell(uint64_t key);
+
+		//! Get the packed coordinates of the cell holding a point.
+		/*! @param position The point.
+		  * @return The cell's packed coordinates. */
+		uint64_t cellKey(const maths::Vec3& position) const;
+
+		//! Get the cells overlapping a box.
+		/*! @param min The box's minimum corner.
+		  * @param max The box's maximum corner.
+		  * @return The range of cells. */
+		CellRange cellRange(const maths::Vec3& min, const maths::Vec3& max) const;
+
+		//! Pack a cell's coordinates in to a key.
+		/*! @param x The cell's X coordinate.
+		  * @param y The cell's Y coordinate.
+		  * @param z The cell's Z coordinate.
+		  * @return The cell's packed coordinates. */
+		static uint64_t packKey(int x, int y, int z);
+
+		//! Check whether a cell is in a range.
+		/*! @param key The cell's packed coordinates.
+		  * @param range The range.
+		  * @return True if the cell is in @p range. */
+		static bool inRange(uint64_t key, const CellRange& range);
+
+		//! Take a SceneObject out of its cell, moving the cell's last SceneObject in to its place.
+		/*! @param entry The SceneObject's entry. */
+		void detach(const Entry& entry);
+
+		//! Put a SceneObject in a cell.
+		/*! @param handle The SceneObject's handle.
+		  * @param position The SceneObject's position.
+		  * @param cell The index in m_cells of the cell holding @p position. */
+		void attach(SceneObjectHandle handle, const maths::Vec3& position, uint32_t cell);
+
+		//! Call a function with each cell in a range which holds SceneObjects.
+		/*! @param range The range of cells.
+		  * @param func The function to call, as @c func(const Cell&). */
+		template <typename Func>
+		void eachCell(const CellRange& range, Func func) const
+		{
+			const uint64_t volume = (uint64_t)(range.max[0] - range.min[0] + 1) * (range.max[1] - range.min[1] + 1) * (range.max[2] - range.min[2] + 1);
+
+			// A big enough range has more cells than exist, so it is quicker to check every cell that does than to look up every one in range.
+			if (volume > m_cells.size())
+			{
+				for (auto it = m_cells.begin(); it != m_cells.end(); it++)
+					if (!it->handles.empty() && inRange(it->key, range))
+						func(*it);
+
+				return;
+			}
+
+			for (int z = range.min[2]; z <= range.max[2]; z++)
+				for (int y = range.min[1]; y <= range.max[1]; y++)
+					for (int x = range.min[0]; x <= range.max[0]; x++)
+					{
+						const uint32_t cell = findCell(packKey(x, y, z));
+
+						if (cell != NO_CELL && !m_cells[cell].handles.empty())
+							func(m_cells[cell]);
+					}
+		}
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+/*!
+  * @file system.h
+  * @brief Header file for the System class.
+  * @author George McDonagh */
+
+
+// Internal includes
+
+#include "component.h"
+
+
+// Namespaces
+
+namespace engine {
+
+	namespace graphics { class Scene3D; }
+
+	//! Parent class for game systems, which update a scene's components each frame.
+	/*! Each System declares the component types it reads and writes, so that a SystemScheduler can run Systems which don't touch the same
+	  * components at the same time. A System must not touch components of types it hasn't declared. */
+	class System
+	{
+	public:
+		//! System constructor.
+		/*! @param name The System's name, for reporting its timings. Must outlive the System.
+		  * @param reads The component types the System only reads.
+		  * @param writes The component types the System writes, and may also read. */
+		System(const char* name, ComponentMask reads, ComponentMask writes);
+
+		//! Virtual compiler-default destructor to enforce abstract class.
+		virtual ~System() = default;
+
+		//! Update the System's components.
+		/*! May be called on any thread, at the same time as other Systems whose component types don't conflict with this one's. It must not
+		  * create or destroy SceneObjects, add or remove components, or use the ThreadPool the scene is being updated with.
+		  * @param scene The scene being updated.
+		  * @param deltaTime The time to step the scene forward by, in seconds. */
+		virtual void update(graphics::Scene3D& scene, float deltaTime) = 0;
+
+		//! Get the System's name.
+		/*! @return The name the System was constructed with. */
+		const char* name() const;
+
+		//! Get the component types the System only reads.
+		/*! @return The ComponentMask of the types. */
+		ComponentMask reads() const;
+
+		//! Get the component types the System writes.
+		/*! @return The ComponentMask of the types. */
+		ComponentMask writes() const;
+
+		//! Check whether the System and another can't run at the same time.
+		/*! @param other Another System.
+		  * @return True if either System writes a component type the other reads or writes. */
+		bool conflicts(const System& other) const;
+
+		//! Get how long the System's last update took.
+		/*! @return The time in milliseconds, or 0 if it hasn't been updated. */
+		double lastUpdateTime() const;
+
+	private:
+		friend class SystemScheduler;
+
+		const char* m_name; /*!< The System's name. */
+		ComponentMask m_reads; /*!< The component types the System only reads. */
+		ComponentMask m_writes; /*!< The component types the System writes. */
+		double m_lastUpdateTime; /*!< How long the last update took, in milliseconds. Set by the SystemScheduler. */
+	};
+
+}
\ No newline at end of file
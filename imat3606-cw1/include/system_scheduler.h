@@ -0,0 +1,102 @@
+#pragma once
+
+/*!
+  * @file system_scheduler.h
+  * @brief Header file for the SystemScheduler class.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+
+// Internal includes
+
+#include "system.h"
+#include "utils/thread_pool.h"
+
+
+// Namespaces
+
+namespace engine {
+
+	//! Runs a scene's Systems each frame, as many at once as their component types allow.
+	/*! Each update, the Systems are arranged in to a graph in which each System waits for the Systems added before it that it conflicts with
+	  * (see System::conflicts()). The ThreadPool's threads then take Systems as soon as everything they wait for has finished, so Systems
+	  * which touch different components, or only read the same ones, run side by side. Systems which conflict always run in the order they
+	  * were added. */
+	class SystemScheduler
+	{
+	public:
+		//! SystemScheduler constructor.
+		SystemScheduler();
+
+		SystemScheduler(const SystemScheduler&) = delete;
+
+		SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+		//! Add a System.
+		/*! @param system A pointer to the System, which the SystemScheduler takes ownership of.
+		  * @return @p system. */
+		System* add(System* system);
+
+		//! Remove and destroy a System.
+		/*! @param system A pointer to the System.
+		  * @return False if @p system wasn't added to this SystemScheduler, in which case nothing happens. */
+		bool remove(System* system);
+
+		//! Get the number of Systems.
+		/*! @return The number of Systems which have been added and not removed. */
+		size_t size() const;
+
+		//! Get a System.
+		/*! @param index The System's index, in the order the Systems were added, less than size().
+		  * @return A pointer to the mutable System. */
+		System* get(size_t index) const;
+
+		//! Update every System once.
+		/*! Returns once every System has finished. Each System's time is recorded for System::lastUpdateTime().
+		  * @param scene The scene to pass to the Systems.
+		  * @param deltaTime The time to step the scene forward by, in seconds.
+		  * @param threadPool The threads to run the Systems across, or @p nullptr to run them one after another on the calling thread. */
+		void update(graphics::Scene3D& scene, float deltaTime, utils::ThreadPool* threadPool);
+
+		//! Get how long the last update() took.
+		/*! @return The time in milliseconds from the first System starting to the last finishing. Less than the sum of the Systems' times when
+		  * some of them ran at once. */
+		double lastUpdateTime() const;
+
+	private:
+		std::vector<std::unique_ptr<System>> m_systems; /*!< The Systems, in the order they were added. */
+		double m_lastUpdateTime; /*!< How long the last update took, in milliseconds. */
+
+		// The graph for the current update, rebuilt each update so that it is always up to date with the Systems and their component types.
+		std::vector<std::vector<uint32_t>> m_dependents; /*!< The indices of the Systems waiting for each System. */
+		std::vector<uint32_t> m_waitingFor; /*!< The number of Systems each System is still waiting for. */
+
+		std::mutex m_mutex; /*!< Guards the members below it while the Systems are running. */
+		std::condition_variable m_readyChanged; /*!< Signalled when Systems become ready, or the last System finishes. */
+		std::vector<uint32_t> m_ready; /*!< The indices of the Systems which have been ready to run, in the order they became ready. */
+		size_t m_nextReady; /*!< The index in m_ready of the next System to run. */
+		size_t m_finished; /*!< The number of Systems which have finished. */
+
+		graphics::Scene3D* m_scene; /*!< The scene being updated. */
+		float m_deltaTime; /*!< The time the scene is being stepped forward by. */
+
+		//! Arrange the Systems in to a graph, and mark those which wait for nothing as ready.
+		void buildGraph();
+
+		//! Take and run ready Systems until every System has finished.
+		void runReady();
+
+		//! Run a System and time it.
+		/*! @param system The System. */
+		void runSystem(System& system);
+	};
+
+}
\ No newline at end of file
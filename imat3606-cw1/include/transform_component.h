@@ -5,9 +5,15 @@
   * @author George McDonagh */
 
 
+// External includes
+
+#include <atomic>
+#include <stdint.h>
+
+
 // Internal includes
 
-#include "maths\maths.h"
+#include "maths/maths.h"
 #include "component.h"
 
 
@@ -15,16 +21,29 @@
 
 namespace engine {
 
+	class TransformHierarchy;
+
 	//! 3D transform component.
+	/*! Holds a position, scale, and rotation relative to the SceneObject's parent, or to the world for SceneObjects without one. The local
+	  * matrix is only recalculated after one of those changes, and the world matrix only after the local matrix or the parent's world
+	  * matrix changes, so transforms which don't move cost no matrix maths. */
 	class TransformComponent : public Component
 	{
 	public:
+		static const ComponentType TYPE = COMPONENT_TRANSFORM; /*!< The ComponentType of TransformComponents. */
+
 		//! Transform constructor.
 		/*! @param position A 3-component vector representing a position in 3D space relative to the X, Y, and Z axes.
 		  * @param scale A 3-component vector representing a 3D scale.
 		  * @param orientation A 3-component vector representing a rotation in 3D space around the X, Y, and Z axis. */
 		TransformComponent(maths::Vec3 position, maths::Vec3 scale, maths::Vec3 orientation);
 
+		//! Transform constructor.
+		/*! @param position A 3-component vector representing a position in 3D space relative to the X, Y, and Z axes.
+		  * @param scale A 3-component vector representing a 3D scale.
+		  * @param rotation A unit quaternion representing a rotation in 3D space. */
+		TransformComponent(maths::Vec3 position, maths::Vec3 scale, maths::Quat rotation);
+
 		//! Transform destructor.
 		~TransformComponent() override;
 
@@ -37,30 +56,162 @@ namespace engine {
 		const maths::Vec3& scale() const;
 
 		//! Get the Transform's orientation.
-		/*! @return A reference to an immutable 3-component vector. The transforms orientation in 3D space. */
-		const maths::Vec3& orientation() const;
+		/*! @return A 3-component vector. The transforms orientation in 3D space as rotations around the X, Y, and Z axis, calculated from its rotation. */
+		maths::Vec3 orientation() const;
+
+		//! Get the Transform's rotation.
+		/*! @return A reference to an immutable quaternion. The transforms orientation in 3D space. */
+		const maths::Quat& rotation() const;
+
+		//! Set the Transform's position.
+		/*! Only marks the Transform as changed if @p position differs from the current position.
+		  * @param position The Transform's new position. */
+		void setPosition(const maths::Vec3& position);
+
+		//! Set the Transform's scale.
+		/*! Only marks the Transform as changed if @p scale differs from the current scale.
+		  * @param scale The Transform's new scale. */
+		void setScale(const maths::Vec3& scale);
+
+		//! Set the Transform's rotation.
+		/*! Only marks the Transform as changed if @p rotation differs from the current rotation.
+		  * @param rotation A unit quaternion. The Transform's new orientation. */
+		void setRotation(const maths::Quat& rotation);
+
+		//! Set the Transform's orientation.
+		/*! @param orientation Rotations around the X, Y, and Z axis. The Transform's new orientation. */
+		void setOrientation(const maths::Vec3& orientation);
 
 		//! Get the Transform's position.
-		/*! @return A reference to a mutable 3-component vector. The Transforms 3D position. */
+		/*! @return A reference to a mutable 3-component vector. The Transforms 3D position.
+		  * @note Marks the Transform as changed, whether or not the position is then modified. Use the const overload to only read it, and
+		  * setPosition() to only mark it as changed when it actually changes. */
 		maths::Vec3& position();
 
 		//! Get the Transform's scale.
-		/*! @return A reference to a mutable 3-component vector. The Transform scale components. */
+		/*! @return A reference to a mutable 3-component vector. The Transform scale components.
+		  * @note Marks the Transform as changed, whether or not the scale is then modified. */
 		maths::Vec3& scale();
 
-		//! Get the Transform's orientation.
-		/*! @return A reference to a mutable 3-component vector. The transforms orientation in 3D space. */
-		maths::Vec3& orientation();
+		//! Get the Transform's rotation.
+		/*! @return A reference to a mutable quaternion. The transforms orientation in 3D space.
+		  * @note Marks the Transform as changed, whether or not the rotation is then modified. */
+		maths::Quat& rotation();
 
-		//! Get the Transform's transform matrix.
-		/*! Calculates and returns the matrix calculated by combining the transforms three components together.
+		//! Get the Transform's local transform matrix.
+		/*! The matrix combining the transforms three components together, relative to the parent. It is cached by updateWorldMatrix(). From
+		  * a change until then, it is calculated on each call and not cached, so that this never writes to the Transform and can be called on
+		  * several threads at once, as Systems which only read Transforms are.
 		  * @return A 4x4 matrix. The Transform's transform matrix. */
 		maths::Mat4 getMatrix() const;
 
+		//! Get the Transform's normal matrix.
+		/*! The inverse transpose of the transform matrix's upper 3x3, for transforming normals so that they stay perpendicular to non-uniformly
+		  * scaled surfaces. Cached along with the transform matrix.
+		  * @return A 3x3 matrix. The Transform's normal matrix. */
+		maths::Mat3 getNormalMatrix() const;
+
+		//! Get the Transform's version.
+		/*! Changes whenever the Transform might have changed, and is only ever shared with copies of the Transform, so caches of values
+		  * derived from the Transform can store it and compare it to tell whether they are stale, or use it as a key.
+		  * @return The Transform's current version. */
+		unsigned long long version() const;
+
+		//! Get the Transform's world matrix.
+		/*! The parent's world matrix multiplied by the local transform matrix, or just the local transform matrix if there is no parent.
+		  * @return A reference to an immutable 4x4 matrix. The world matrix as of the last updateWorldMatrix(); the identity matrix before then. */
+		const maths::Mat4& getWorldMatrix() const;
+
+		//! Get the Transform's world normal matrix.
+		/*! The inverse transpose of the world matrix's upper 3x3.
+		  * @return A reference to an immutable 3x3 matrix. The world normal matrix as of the last updateWorldMatrix(). */
+		const maths::Mat3& getWorldNormalMatrix() const;
+
+		//! Get the Transform's world version.
+		/*! Like version(), but changes whenever the world matrix is recalculated.
+		  * @return The version of the Transform's world matrix. 0 before the first updateWorldMatrix(). */
+		unsigned long long worldVersion() const;
+
+		//! Get the Transform's previous world matrix.
+		/*! @return A reference to an immutable 4x4 matrix. The world matrix before the last updateWorldMatrix() that recalculated it, or the
+		  * current world matrix if it has only been calculated once. */
+		const maths::Mat4& getPreviousWorldMatrix() const;
+
+		//! Get the update in which the Transform's world matrix was last recalculated.
+		/*! @return The @p update passed to the last updateWorldMatrix() that recalculated the world matrix. 0 before the first. */
+		unsigned long long worldUpdate() const;
+
+		//! Get the Transform's world matrix part of the way from its previous world matrix.
+		/*! For drawing between two updates of a fixed timestep simulation. Blends the matrices element by element, which is close enough to
+		  * blending the positions, rotations, and scales for the small changes of a single update.
+		  * @param update The latest update. Transforms whose world matrix wasn't recalculated in it have stayed still since the update before.
+		  * @param t How far to blend from the previous world matrix to the current one, from 0 to 1.
+		  * @return The blended world matrix, or the world matrix itself if it wasn't recalculated in @p update. */
+		maths::Mat4 getInterpolatedWorldMatrix(unsigned long long update, float t) const;
+
+		//! Recalculate the Transform's world matrix if it is stale.
+		/*! The world matrix is stale if the Transform has changed, or if @p parent isn't the Transform it was calculated from or has a
+		  * different world version. Called for every Transform by Scene3D::update(), parents before their children. Safe to call for
+		  * different Transforms on different threads.
+		  * @param parent A pointer to the parent's Transform, which must already be up to date, or @p nullptr if there is no parent.
+		  * @param update A number identifying the scene update, which increases with each one. See TransformHierarchy::updates().
+		  * @return True if the world matrix was recalculated. */
+		bool updateWorldMatrix(const TransformComponent* parent, unsigned long long update);
+
 	private:
 		maths::Vec3 m_position; /*!< The Transform's position. */
 		maths::Vec3 m_scale; /*!< The Transform's scale. */
-		maths::Vec3 m_orientation; /*! The Transform's orientation. */
+		maths::Quat m_rotation; /*!< The Transform's orientation. */
+
+		maths::Mat4 m_matrix; /*!< The cached transform matrix. */
+		maths::Mat3 m_normalMatrix; /*!< The cached normal matrix. */
+		bool m_dirty; /*!< True if the cached matrices need recalculating. */
+		unsigned long long m_version; /*!< The Transform's current version. */
+
+		maths::Mat4 m_worldMatrix; /*!< The world matrix. */
+		maths::Mat3 m_worldNormalMatrix; /*!< The world normal matrix. */
+		unsigned long long m_worldVersion; /*!< The version of the world matrix. */
+		unsigned long long m_worldSourceVersion; /*!< The Transform's version when the world matrix was last calculated. */
+		unsigned long long m_parentWorldVersion; /*!< The parent's world version when the world matrix was last calculated, or 0 if there was no parent. */
+		maths::Mat4 m_previousWorldMatrix; /*!< The world matrix before it was last recalculated. */
+		unsigned long long m_worldUpdate; /*!< The update in which the world matrix was last recalculated. */
+
+		//! The TransformHierarchy the Transform is in, and its index there.
+		/*! Copies start outside any hierarchy, as only the original is in one. Assigning to a Transform keeps its place in the hierarchy, as
+		  * replacing an object's TransformComponent in place doesn't rebuild it, and tells the hierarchy the Transform has changed, as it has. */
+		struct HierarchySlot
+		{
+			TransformHierarchy* hierarchy; /*!< The hierarchy, or @p nullptr if the Transform isn't in one. */
+			uint32_t index; /*!< The Transform's index in the hierarchy. */
+
+			HierarchySlot() : hierarchy(nullptr), index(0) { }
+
+			HierarchySlot(const HierarchySlot&) : hierarchy(nullptr), index(0) { }
+
+			HierarchySlot& operator=(const HierarchySlot&);
+		};
+
+		HierarchySlot m_hierarchySlot; /*!< Used by changed() to tell the hierarchy, so that it only visits the Transforms which have changed. */
+
+		static std::atomic<unsigned long long> s_nextVersion; /*!< The next block of versions to give out, shared by every Transform so that versions are unique. */
+
+		//! Get a version which no Transform has had before.
+		/*! Versions are taken from s_nextVersion in blocks, so that threads updating Transforms in parallel don't all contend for it.
+		  * @return A new version. Never 0. */
+		static unsigned long long newVersion();
+
+		//! Mark the cached matrices as stale, give the Transform a new version, and tell its hierarchy.
+		void changed();
+
+		//! Calculate the transform and normal matrices from the position, scale, and rotation.
+		/*! @param matrix The matrix to write the transform matrix to.
+		  * @param normalMatrix The matrix to write the normal matrix to. */
+		void calculateMatrices(maths::Mat4& matrix, maths::Mat3& normalMatrix) const;
+
+		//! Recalculate the cached matrices if they are stale.
+		void updateMatrices();
+
+		friend class TransformHierarchy;
 	};
 
 }
\ No newline at end of file
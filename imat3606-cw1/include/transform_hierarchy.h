@@ -0,0 +1,101 @@
+#pragma once
+
+/*!
+  * @file transform_hierarchy.h
+  * @brief Header file for the TransformHierarchy class.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <atomic>
+#include <stdint.h>
+#include <vector>
+
+
+// Internal includes
+
+#include "transform_component.h"
+#include "utils/thread_pool.h"
+
+
+// Namespaces
+
+namespace engine {
+
+	class SceneObject;
+
+	//! A scene's transforms flattened in to arrays in order of their depth in the hierarchy, for updating world matrices.
+	/*! Transforms tell the hierarchy when they change, and it lists them, so an update only visits the subtrees under the transforms which
+	  * changed rather than every transform. The subtrees don't overlap, so they are split across threads. The world matrices are written in
+	  * place in to the TransformComponents, which sit in the packed component columns that the renderer walks. */
+	class TransformHierarchy
+	{
+	public:
+		//! TransformHierarchy constructor.
+		TransformHierarchy();
+
+		//! Bring the world matrices of a set of SceneObjects up to date.
+		/*! Only transforms which have changed, or whose ancestors' have, are recalculated. Each transform adds itself to a list of the
+		  * hierarchy's when it changes, so the transforms which haven't, and aren't under one which has, aren't visited at all.
+		  * @param objects The SceneObjects. Their parents must be among them.
+		  * @param structureVersion A value which changes whenever a SceneObject or component is added or removed, or a parent changes, as the
+		  * arrays are only rebuilt when it does. See ComponentStore::structureVersion().
+		  * @param threadPool The threads to split each depth across, or @p nullptr to update on the calling thread. */
+		void update(const std::vector<SceneObject*>& objects, unsigned long long structureVersion, utils::ThreadPool* threadPool);
+
+		//! Get the number of transforms in the hierarchy.
+		/*! @return The number of transforms as of the last update(). */
+		size_t size() const;
+
+		//! Get the depth of the hierarchy.
+		/*! @return The number of levels of transforms as of the last update(). 1 if no transform has a parent. */
+		size_t depth() const;
+
+		//! Get the number of times update() has been called.
+		/*! TransformComponents record the number of the update which last recalculated their world matrices, as
+		  * TransformComponent::worldUpdate(), so comparing the two tells whether one moved in the last update().
+		  * @return The number of updates, which is also the number of the last one. */
+		unsigned long long updates() const;
+
+		//! Get the SceneObjects which moved in the last update().
+		/*! @return A reference to an immutable vector of the SceneObjects whose world matrices the last update() recalculated, each after its
+		  * ancestors. */
+		const std::vector<SceneObject*>& moved() const;
+
+	private:
+		std::vector<TransformComponent*> m_transforms; /*!< The transforms, with each depth's together, roots first. */
+		std::vector<SceneObject*> m_objects; /*!< The SceneObject each transform belongs to. */
+		std::vector<uint8_t> m_changed; /*!< Whether each transform has changed since the last update(), so that it is only listed once. */
+		std::vector<uint32_t> m_dirty; /*!< The indices of the transforms which have changed since the last update(). Room for every transform. */
+		std::atomic<size_t> m_dirtyCount; /*!< The number of indices in m_dirty. Transforms on different threads can change at once. */
+		std::vector<uint32_t> m_subtrees; /*!< The changed transforms with no changed ancestors, whose subtrees the current update() visits. */
+		std::vector<std::vector<SceneObject*>> m_chunkMoved; /*!< The SceneObjects moved by each chunk of m_subtrees, when split across threads. */
+		std::vector<SceneObject*> m_moved; /*!< The SceneObjects whose world matrices were recalculated by the last update(). */
+		std::vector<int> m_parents; /*!< The index in m_transforms of each transform's parent, or -1 for roots. */
+		std::vector<uint32_t> m_childStarts; /*!< Where each transform's children start in m_children, followed by the size of m_children. */
+		std::vector<uint32_t> m_children; /*!< The indices in m_transforms of each transform's children, one transform's after another. */
+		std::vector<size_t> m_levels; /*!< The index in m_transforms where each depth starts, followed by the number of transforms. */
+		unsigned long long m_structureVersion; /*!< The structure version the arrays were built for. */
+		unsigned long long m_updates; /*!< The number of times update() has been called. */
+		bool m_built; /*!< Whether the arrays have been built yet. */
+
+		//! Rebuild the arrays from the SceneObjects' parents and children.
+		/*! @param objects The SceneObjects. */
+		void rebuild(const std::vector<SceneObject*>& objects);
+
+		//! Add a transform to the list of those which have changed.
+		/*! Called by the transform itself. Safe to call for different transforms on different threads.
+		  * @param index The transform's index in m_transforms. */
+		void changed(uint32_t index);
+
+		//! Recalculate the world matrices of a transform and its descendants which are stale.
+		/*! @param index The transform's index in m_transforms.
+		  * @param parentRecalculated Whether the parent's world matrix has just been recalculated.
+		  * @param moved The vector to append the SceneObjects whose world matrices are recalculated to. */
+		void updateSubtree(uint32_t index, bool parentRecalculated, std::vector<SceneObject*>& moved);
+
+		friend class TransformComponent;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,209 @@
+#pragma once
+
+/*!
+  * @file object_pool.h
+  * @brief Header file for the ObjectPool class and the handles it gives out.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+// Namespaces
+
+namespace engine { namespace utils {
+
+	//! A reference to an object in an ObjectPool.
+	/*! Unlike a pointer, a handle can tell when the object it refers to has been destroyed, even if its slot has since been reused. */
+	struct PoolHandle
+	{
+		uint32_t index; /*!< The index of the object's slot in the pool. */
+		uint32_t generation; /*!< The generation of the slot when the object was created. Never 0 for a live object. */
+
+		//! PoolHandle constructor. Creates a null handle, which never refers to an object.
+		PoolHandle()
+			: index(0), generation(0) { }
+
+		//! Check whether the handle is null.
+		/*! @return True if the handle was default constructed, rather than given out by an ObjectPool. */
+		bool isNull() const
+		{
+			return generation == 0;
+		}
+
+		bool operator==(const PoolHandle& other) const
+		{
+			return index == other.index && generation == other.generation;
+		}
+
+		bool operator!=(const PoolHandle& other) const
+		{
+			return !(*this == other);
+		}
+	};
+
+	//! Stores objects of type @p T in fixed-size blocks, reusing the slots of destroyed objects.
+	/*! Creating and destroying an object is O(1), and once the pool has grown to its peak size neither touches the heap. Objects never move,
+	  * so pointers to them stay valid until they are destroyed. Each slot counts the objects that have lived in it, so a PoolHandle to a
+	  * destroyed object resolves to @p nullptr instead of to whatever has taken its slot. */
+	template <typename T>
+	class ObjectPool
+	{
+	public:
+		static const uint32_t BLOCK_SIZE = 256; //!< The number of slots allocated at a time.
+
+		//! ObjectPool constructor.
+		ObjectPool()
+			: m_freeHead(NO_SLOT), m_size(0) { }
+
+		//! ObjectPool destructor. Destroys any objects still in the pool.
+		~ObjectPool()
+		{
+			clear();
+		}
+
+		ObjectPool(const ObjectPool&) = delete;
+
+		ObjectPool& operator=(const ObjectPool&) = delete;
+
+		//! Create an object in the pool.
+		/*! @param args The arguments to pass to @p T's constructor.
+		  * @return A handle to the new object. */
+		template <typename... Args>
+		PoolHandle create(Args&&... args)
+		{
+			if (m_freeHead == NO_SLOT)
+				grow();
+
+			const uint32_t index = m_freeHead;
+			Slot& slot = this->slot(index);
+
+			new (&slot.storage) T(std::forward<Args>(args)...);
+
+			m_freeHead = slot.nextFree;
+			slot.nextFree = LIVE;
+			m_size++;
+
+			PoolHandle handle;
+			handle.index = index;
+			handle.generation = slot.generation;
+			return handle;
+		}
+
+		//! Destroy an object in the pool, freeing its slot for reuse.
+		/*! @param handle A handle to the object.
+		  * @return False if @p handle doesn't refer to a live object, in which case nothing happens. */
+		bool destroy(PoolHandle handle)
+		{
+			T* object = get(handle);
+
+			if (!object)
+				return false;
+
+			Slot& slot = this->slot(handle.index);
+
+			// Let go of the slot before destroying the object, in case its destructor looks itself up.
+			slot.nextFree = m_freeHead;
+			m_freeHead = handle.index;
+			m_size--;
+
+			// Skip 0 when the generation wraps around, so a null handle never matches.
+			if (++slot.generation == 0)
+				slot.generation = 1;
+
+			object->~T();
+			return true;
+		}
+
+		//! Get an object in the pool.
+		/*! @param handle A handle to the object.
+		  * @return A pointer to the object. Returns @p nullptr if @p handle is null, or its object has been destroyed. */
+		T* get(PoolHandle handle) const
+		{
+			if (handle.index >= capacity())
+				return nullptr;
+
+			Slot& slot = this->slot(handle.index);
+
+			if (slot.nextFree != LIVE || slot.generation != handle.generation)
+				return nullptr;
+
+			return reinterpret_cast<T*>(&slot.storage);
+		}
+
+		//! Destroy every object in the pool. The pool keeps its blocks for reuse.
+		void clear()
+		{
+			for (uint32_t index = 0; index < capacity(); index++)
+			{
+				PoolHandle handle;
+				handle.index = index;
+				handle.generation = slot(index).generation;
+				destroy(handle);
+			}
+		}
+
+		//! Get the number of objects in the pool.
+		/*! @return The number of live objects. */
+		size_t size() const
+		{
+			return m_size;
+		}
+
+		//! Get the number of slots in the pool.
+		/*! @return The number of objects the pool can hold before it next allocates a block. */
+		uint32_t capacity() const
+		{
+			return (uint32_t)m_blocks.size() * BLOCK_SIZE;
+		}
+
+	private:
+		static const uint32_t NO_SLOT = 0xFFFFFFFF; //!< Ends the free list.
+		static const uint32_t LIVE = 0xFFFFFFFE; //!< Marks a slot with a live object in place of a free list link.
+
+		//! Space for one object.
+		struct Slot
+		{
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type storage; /*!< The object, when the slot is live. */
+			uint32_t generation; /*!< The generation of the slot's current or next object. */
+			uint32_t nextFree; /*!< The next free slot's index if this one is free, or LIVE. */
+		};
+
+		std::vector<std::unique_ptr<Slot[]>> m_blocks; /*!< The pool's blocks, which are never freed or moved until the pool is destroyed. */
+		uint32_t m_freeHead; /*!< The index of the first free slot, or NO_SLOT. */
+		size_t m_size; /*!< The number of live objects. */
+
+		//! Get a slot.
+		/*! @param index The slot's index. Must be less than capacity().
+		  * @return A reference to the slot. */
+		Slot& slot(uint32_t index) const
+		{
+			return m_blocks[index / BLOCK_SIZE][index % BLOCK_SIZE];
+		}
+
+		//! Allocate another block, and put its slots on the free list.
+		void grow()
+		{
+			const uint32_t first = capacity();
+			m_blocks.push_back(std::unique_ptr<Slot[]>(new Slot[BLOCK_SIZE]));
+
+			// Link the slots in order, so objects created together sit together.
+			for (uint32_t i = 0; i < BLOCK_SIZE; i++)
+			{
+				Slot& slot = m_blocks.back()[i];
+				slot.generation = 1;
+				slot.nextFree = i + 1 < BLOCK_SIZE ? first + i + 1 : m_freeHead;
+			}
+
+			m_freeHead = first;
+		}
+	};
+
+} }
\ No newline at end of file
@@ -10,11 +10,15 @@
 
 #include <fstream>
 #include <json\json.h>
+#include <unordered_map>
+#include <vector>
 
 
 // Internal includes
 
 #include "utils\i_serializer.h"
+#include "bounds_component.h"
+#include "cell_streamer.h"
 #include "mesh_component.h"
 #include "transform_component.h"
 
@@ -79,9 +83,12 @@ namespace engine { namespace utils {
 
 				graphics::Camera camera(camPosition, camDirection, camFOV, camAspect, camFar, camNear);
 
+				std::vector<SceneObject*> sceneObjects;
+
 				for (int i = 0; i < root["objects"].size(); i++)
 				{
-					SceneObject* sceneObject = new SceneObject();
+					SceneObject* sceneObject = scene->get(scene->create());
+					sceneObjects.push_back(sceneObject);
 
 					for (int j = 0; j < root["objects"][i]["components"].size(); j++)
 					{
@@ -105,11 +112,38 @@ namespace engine { namespace utils {
 						else if (root["objects"][i]["components"][j]["type"] == typeid(MeshComponent).name())
 						{
 							std::string meshFilepath = root["objects"][i]["components"][j]["filepath"].asCString();
-							sceneObject->addComponent<MeshComponent>(new MeshComponent(AssetManager::loadAsset<graphics::Mesh>(meshFilepath.c_str())));
+							MeshComponent* meshComponent = new MeshComponent(AssetManager::loadAsset<graphics::Mesh>(meshFilepath.c_str()));
+
+							// Coarser levels of detail are optional, and listed from most to least detailed.
+							const Json::Value& lods = root["objects"][i]["components"][j]["lods"];
+							for (int k = 0; k < lods.size(); k++)
+								meshComponent->addLOD(AssetManager::loadAsset<graphics::Mesh>(lods[k]["filepath"].asCString()), lods[k]["screenSize"].asFloat());
+
+							sceneObject->addComponent<MeshComponent>(meshComponent);
+						}
+						else if (root["objects"][i]["components"][j]["type"] == typeid(BoundsComponent).name())
+						{
+							maths::Vec3 bMin(
+								root["objects"][i]["components"][j]["min"][0].asFloat(),
+								root["objects"][i]["components"][j]["min"][1].asFloat(),
+								root["objects"][i]["components"][j]["min"][2].asFloat());
+							maths::Vec3 bMax(
+								root["objects"][i]["components"][j]["max"][0].asFloat(),
+								root["objects"][i]["components"][j]["max"][1].asFloat(),
+								root["objects"][i]["components"][j]["max"][2].asFloat());
+
+							sceneObject->addComponent<BoundsComponent>(new BoundsComponent(maths::AABB(bMin, bMax)));
 						}
 					}
+				}
+
+				// Parents are stored as indices in to the array of objects, so they can only be linked up once every object exists.
+				for (int i = 0; i < root["objects"].size(); i++)
+				{
+					int parent = root["objects"][i].get("parent", -1).asInt();
 
-					scene->add(sceneObject);
+					if (parent >= 0 && parent < (int)sceneObjects.size())
+						sceneObjects[i]->setParent(sceneObjects[parent]);
 				}
 			}
 
@@ -155,51 +189,14 @@ namespace engine { namespace utils {
 			// Start an array of objects
 			root["objects"] = Json::Value(Json::arrayValue);
 
-			// For each SceneObject the scene current has
+			// Each object's parent is written as its index in the array of objects.
+			std::unordered_map<const SceneObject*, int> objectIndices;
 			for (int i = 0; i < sceneObjects.size(); i++)
-			{
-				std::vector<Component*> components = sceneObjects[i]->getComponents();
-
-				// Add an array to the array of objects that we will represent a single scene object (and contain its components)
-				root["objects"].append(Json::Value());
+				objectIndices[sceneObjects[i]] = i;
 
-				root["objects"][i]["components"] = Json::Value(Json::arrayValue);
-
-				for (int j = 0; j < components.size(); j++)
-				{
-					root["objects"][i]["components"].append(Json::Value());
-
-					if (dynamic_cast<TransformComponent*>(components[j]))
-					{
-						TransformComponent* transform = dynamic_cast<TransformComponent*>(components[j]);
-
-						root["objects"][i]["components"][j]["type"] = typeid(TransformComponent).name();
-
-						root["objects"][i]["components"][j]["position"] = Json::Value(Json::arrayValue);
-						root["objects"][i]["components"][j]["position"].append(transform->position().x());
-						root["objects"][i]["components"][j]["position"].append(transform->position().y());
-						root["objects"][i]["components"][j]["position"].append(transform->position().z());
-
-						root["objects"][i]["components"][j]["scale"] = Json::Value(Json::arrayValue);
-						root["objects"][i]["components"][j]["scale"].append(transform->scale().x());
-						root["objects"][i]["components"][j]["scale"].append(transform->scale().y());
-						root["objects"][i]["components"][j]["scale"].append(transform->scale().z());
-
-						root["objects"][i]["components"][j]["orientation"] = Json::Value(Json::arrayValue);
-						root["objects"][i]["components"][j]["orientation"].append(transform->orientation().x());
-						root["objects"][i]["components"][j]["orientation"].append(transform->orientation().y());
-						root["objects"][i]["components"][j]["orientation"].append(transform->orientation().z());
-					}
-					else if (dynamic_cast<MeshComponent*>(components[j]))
-					{
-						MeshComponent* meshComponent = dynamic_cast<MeshComponent*>(components[j]);
-
-						root["objects"][i]["components"][j]["type"] = typeid(MeshComponent).name();
-
-						root["objects"][i]["components"][j]["filepath"] = Json::Value(meshComponent->mesh()->getFilepath());
-					}
-				}
-			}
+			// For each SceneObject the scene current has
+			for (int i = 0; i < sceneObjects.size(); i++)
+				root["objects"].append(writeObject(*sceneObjects[i], sceneObjects[i]->getParent() ? objectIndices[sceneObjects[i]->getParent()] : -1));
 
 			std::ofstream file_id("res/data/scene.json");
 
@@ -209,8 +206,36 @@ namespace engine { namespace utils {
 			file_id.close();
 		}
 
+		//! Read the SceneObjects of a cell written by writeCells(), or of a scene written by write<graphics::Scene3D>().
+		/*! Only reads the file, so it may be called on any thread. Meshes are left for the caller to load.
+		  * @param filepath The filepath of the cell's file.
+		  * @param objects The vector to append the cell's SceneObjects to.
+		  * @return False if the file couldn't be opened or parsed. */
+		static bool readCell(const char* filepath, std::vector<CellObject>& objects);
+
+		//! Read a cell index written by writeCells().
+		/*! @param filepath The filepath of the index.
+		  * @param index The CellIndex to fill in.
+		  * @return False if the file couldn't be opened or parsed. */
+		static bool readCellIndex(const char* filepath, CellIndex& index);
+
+		//! Partition a scene in to cells for a CellStreamer, and write each cell to a file of its own.
+		/*! Each SceneObject goes in to the cell its root ancestor's position is in, so hierarchies are never split between cells. Cells are
+		  * written to @p directory as @c x_z.json, and listed in @c index.json along with the bytes of their meshes' buffers.
+		  * @param scene The scene, whose meshes must be loaded.
+		  * @param directory The directory to write the files to, which must exist.
+		  * @param cellSize The length of each cell's sides.
+		  * @return False if a file couldn't be written. */
+		static bool writeCells(const graphics::Scene3D& scene, const char* directory, float cellSize);
+
 	private:
 		static bool openFile(const char* filepath);
+
+		//! Write a SceneObject and its components in the format read<graphics::Scene3D>() reads.
+		/*! @param object The SceneObject.
+		  * @param parent The index of the object's parent in the array of objects it is written to, or -1 for none.
+		  * @return The JSON object. */
+		static Json::Value writeObject(SceneObject& object, int parent);
 	};
 
 } }
\ No newline at end of file
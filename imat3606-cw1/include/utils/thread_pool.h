@@ -0,0 +1,72 @@
+#pragma once
+
+/*!
+  * @file thread_pool.h
+  * @brief Header file for the ThreadPool class.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Namespaces
+
+namespace engine { namespace utils {
+
+	//! A set of worker threads for splitting loops across cores.
+	/*! The thread which calls parallelFor() works alongside the workers, so a pool of @c n threads has @c n-1 workers. */
+	class ThreadPool
+	{
+	public:
+		//! ThreadPool constructor.
+		/*! @param threads The number of threads to split loops across, including the calling thread. 0 uses one per hardware thread. */
+		explicit ThreadPool(unsigned int threads = 0);
+
+		//! ThreadPool destructor. Waits for the workers to finish and joins them.
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		//! Get the number of threads loops are split across.
+		/*! @return The number of workers plus one for the calling thread. */
+		unsigned int threadCount() const;
+
+		//! Split a loop in to chunks and run them across the pool's threads.
+		/*! Returns once every chunk has run. Loops of no more than @p grain iterations run on the calling thread without waking the workers.
+		  * @param count The number of iterations.
+		  * @param grain The number of iterations in each chunk. Large enough that a chunk takes a few microseconds.
+		  * @param func The loop body, called as @c func(begin, end) for each chunk. Called from several threads at once. */
+		void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& func);
+
+	private:
+		std::vector<std::thread> m_workers; /*!< The worker threads. */
+
+		std::mutex m_mutex; /*!< Guards the members below it. */
+		std::condition_variable m_wake; /*!< Signalled when there is a new loop for the workers, or they should stop. */
+		std::condition_variable m_done; /*!< Signalled when the last worker finishes the current loop. */
+		unsigned long long m_generation; /*!< Incremented for each loop given to the workers, so they can tell a new loop from a spurious wake up. */
+		unsigned int m_busy; /*!< The number of workers yet to finish the current loop. */
+		bool m_stop; /*!< Set when the workers should exit. */
+
+		const std::function<void(size_t, size_t)>* m_func; /*!< The current loop body. */
+		size_t m_count; /*!< The current loop's number of iterations. */
+		size_t m_grain; /*!< The current loop's chunk size. */
+		std::atomic<size_t> m_next; /*!< The first iteration of the next chunk to be taken. */
+
+		//! Take and run chunks of the current loop until there are none left.
+		void runChunks();
+
+		//! The workers' main loop.
+		void workerMain();
+	};
+
+} }
\ No newline at end of file
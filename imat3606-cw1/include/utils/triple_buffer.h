@@ -0,0 +1,88 @@
+#pragma once
+
+/*!
+  * @file triple_buffer.h
+  * @brief Header file for the TripleBuffer class.
+  * @author George McDonagh */
+
+
+// External includes
+
+#include <atomic>
+#include <stdint.h>
+
+
+// Namespaces
+
+namespace engine { namespace utils {
+
+	//! Hands values of type @p T from one thread to another without locks.
+	/*! One thread, the producer, fills in back() and publish()es it. Another, the consumer, consume()s the latest published value and reads
+	  * it from front(). Each thread has a buffer of its own, and the third is swapped between them with a single atomic exchange, so neither
+	  * ever waits for the other or sees a half-written value. If the producer publishes twice before the consumer takes one, the older value
+	  * is skipped. The buffers are reused rather than reconstructed, so any memory they hold is kept from one value to the next. */
+	template <typename T>
+	class TripleBuffer
+	{
+	public:
+		//! TripleBuffer constructor.
+		TripleBuffer()
+			: m_back(0), m_middle(1), m_front(2) { }
+
+		TripleBuffer(const TripleBuffer&) = delete;
+
+		TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+		//! Get the producer's buffer.
+		/*! Only the producer may call this. The buffer still holds whatever was in it when it was last handed back.
+		  * @return A reference to the mutable buffer. */
+		T& back()
+		{
+			return m_buffers[m_back];
+		}
+
+		//! Publish the producer's buffer to the consumer, and take an unused buffer in its place.
+		/*! Only the producer may call this. */
+		void publish()
+		{
+			m_back = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel) & INDEX;
+		}
+
+		//! Check whether the last published buffer has yet to be consumed.
+		/*! @return True if the consumer has not taken the last published buffer. */
+		bool pending() const
+		{
+			return (m_middle.load(std::memory_order_acquire) & FRESH) != 0;
+		}
+
+		//! Take the last published buffer, if the consumer hasn't already.
+		/*! Only the consumer may call this.
+		  * @return True if front() is now a newly published buffer, false if nothing has been published since the last consume(). */
+		bool consume()
+		{
+			if (!pending())
+				return false;
+
+			m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX;
+			return true;
+		}
+
+		//! Get the consumer's buffer.
+		/*! Only the consumer may call this.
+		  * @return A reference to the buffer taken by the last consume(). */
+		const T& front() const
+		{
+			return m_buffers[m_front];
+		}
+
+	private:
+		static const uint8_t INDEX = 3; //!< The bits of m_middle holding the index of the buffer.
+		static const uint8_t FRESH = 4; //!< The bit of m_middle set when its buffer has been published and not consumed.
+
+		T m_buffers[3]; /*!< The buffers. */
+		uint8_t m_back; /*!< The index of the producer's buffer. */
+		std::atomic<uint8_t> m_middle; /*!< The index of the buffer between the threads, and the FRESH bit. */
+		uint8_t m_front; /*!< The index of the consumer's buffer. */
+	};
+
+} }
\ No newline at end of file
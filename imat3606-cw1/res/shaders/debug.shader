@@ -4,19 +4,17 @@
 layout(location = 0) in vec3 vertex_position;
 layout(location = 1) in vec3 vertex_normal;
 
+uniform mat4 mvp;
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform mat3 normalMatrix;
 
 out vec3 fragPos;
 out vec3 normal;
 
 void main()
 {
-	mat4 mvp = projection * view * model;
-
 	fragPos = vec3(model * vec4(vertex_position, 1.0));
-	normal = normalize(mat3(transpose(inverse(model))) * vertex_normal);
+	normal = normalize(normalMatrix * vertex_normal);
 	gl_Position = mvp * vec4(vertex_position, 1.0);
 }
 
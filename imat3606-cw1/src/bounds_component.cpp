@@ -0,0 +1,25 @@
+/*!
+ * @file bounds_component.cpp
+ * @brief Implementation file for the BoundsComponent class.
+ * @author George McDonagh */
+
+
+// Local includes
+
+#include "bounds_component.h"
+
+
+// Namespaces
+
+using namespace engine;
+
+
+BoundsComponent::BoundsComponent(const maths::AABB& bounds)
+	: Component(), m_bounds(bounds) { }
+
+BoundsComponent::~BoundsComponent() { }
+
+const maths::AABB& BoundsComponent::bounds() const
+{
+	return m_bounds;
+}
\ No newline at end of file
@@ -0,0 +1,432 @@
+/*!
+ * @file cell_streamer.cpp
+ * @brief Implementation file for the CellStreamer class.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <algorithm>
+#include <cmath>
+
+
+// Local includes
+
+#include "cell_streamer.h"
+#include "graphics/scene_3d.h"
+#include "utils/serializer_json.h"
+
+
+// Namespaces
+
+using namespace engine;
+
+
+CellStreamer::CellStreamer(const CellIndex& index)
+	: m_cellSize(index.cellSize), m_loadRadius(index.cellSize), m_unloadRadius(index.cellSize * 1.5f), m_memoryBudget(0), m_committedBytes(0),
+	m_residentCells(0), m_residentBytes(0), m_stop(false)
+{
+	m_cells.resize(index.cells.size());
+
+	for (uint32_t i = 0; i < index.cells.size(); i++)
+	{
+		m_cells[i].info = index.cells[i];
+		m_cells[i].status = CELL_UNLOADED;
+		m_cellIndices[cellKey(index.cells[i].x, index.cells[i].z)] = i;
+	}
+
+	m_loader = std::thread(&CellStreamer::loaderMain, this);
+}
+
+CellStreamer::~CellStreamer()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+
+	m_loadQueued.notify_all();
+	m_loader.join();
+}
+
+void CellStreamer::setRadii(float loadRadius, float unloadRadius)
+{
+	m_loadRadius = loadRadius;
+	m_unloadRadius = std::max(loadRadius, unloadRadius);
+}
+
+void CellStreamer::setMemoryBudget(size_t bytes)
+{
+	m_memoryBudget = bytes;
+}
+
+void CellStreamer::update(graphics::Scene3D& scene, const maths::Vec3& position)
+{
+	// Take the cells whose meshes have all been uploaded since the last update.
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_arrived.swap(m_readyQueue);
+	}
+
+	for (auto index : m_arrived)
+		addToScene(scene, m_cells[index]);
+
+	m_arrived.clear();
+
+	// Evict the cells out of range, or stop them loading if the loading thread hasn't started on them.
+	for (size_t i = 0; i < m_active.size();)
+	{
+		const Cell& cell = m_cells[m_active[i]];
+
+		if (distance(cell, position) <= m_unloadRadius)
+			i++;
+		else if (cell.status == CELL_RESIDENT)
+			evict(scene, i);
+		else if (!cancel(i))
+			i++;
+	}
+
+	// Only the cells in the square around the load radius can be in range, so there is no need to look at every cell in the index.
+	const int reach = (int)std::ceil(m_loadRadius / m_cellSize);
+	const int centreX = (int)std::floor(position.x() / m_cellSize);
+	const int centreZ = (int)std::floor(position.z() / m_cellSize);
+
+	m_candidates.clear();
+
+	for (int x = centreX - reach; x <= centreX + reach; x++)
+	{
+		for (int z = centreZ - reach; z <= centreZ + reach; z++)
+		{
+			auto found = m_cellIndices.find(cellKey(x, z));
+
+			if (found == m_cellIndices.end() || m_cells[found->second].status != CELL_UNLOADED)
+				continue;
+
+			const float cellDistance = distance(m_cells[found->second], position);
+
+			if (cellDistance <= m_loadRadius)
+				m_candidates.push_back(std::make_pair(cellDistance, found->second));
+		}
+	}
+
+	std::sort(m_candidates.begin(), m_candidates.end());
+
+	for (const auto& candidate : m_candidates)
+	{
+		Cell& cell = m_cells[candidate.second];
+
+		// Make room by evicting loaded cells outside the load radius, farthest first. Cells inside it are never evicted for nearer ones, so
+		// ... two cells can't take turns evicting each other.
+		while (m_memoryBudget != 0 && m_committedBytes + cell.info.bytes > m_memoryBudget)
+		{
+			size_t farthest = m_active.size();
+			float farthestDistance = m_loadRadius;
+
+			for (size_t i = 0; i < m_active.size(); i++)
+			{
+				const float activeDistance = distance(m_cells[m_active[i]], position);
+
+				if (m_cells[m_active[i]].status == CELL_RESIDENT && activeDistance > farthestDistance)
+				{
+					farthest = i;
+					farthestDistance = activeDistance;
+				}
+			}
+
+			if (farthest == m_active.size())
+				break;
+
+			evict(scene, farthest);
+		}
+
+		if (m_memoryBudget != 0 && m_committedBytes + cell.info.bytes > m_memoryBudget)
+			break;
+
+		cell.status = CELL_LOADING;
+		m_active.push_back(candidate.second);
+		m_committedBytes += cell.info.bytes;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_loadQueue.push_back(candidate.second);
+		}
+
+		m_loadQueued.notify_one();
+	}
+}
+
+void CellStreamer::uploadMeshes()
+{
+	std::vector<std::unique_ptr<graphics::Mesh>> releases;
+	uint32_t index = 0;
+	bool uploading = false;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		releases.swap(m_releases);
+
+		if (!m_uploadQueue.empty())
+		{
+			index = m_uploadQueue.front();
+			m_uploadQueue.pop_front();
+			uploading = true;
+		}
+	}
+
+	// Destroying the meshes deletes their OpenGL objects.
+	releases.clear();
+
+	if (!uploading)
+		return;
+
+	size_t bytes = 0;
+
+	for (auto mesh : m_cells[index].uploads)
+	{
+		mesh->upload();
+		bytes += mesh->getByteSize();
+	}
+
+	m_cells[index].uploads.clear();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_residentBytes += bytes;
+	m_readyQueue.push_back(index);
+}
+
+void CellStreamer::evictAll(graphics::Scene3D& scene)
+{
+	for (size_t i = 0; i < m_active.size();)
+	{
+		if (m_cells[m_active[i]].status == CELL_RESIDENT)
+			evict(scene, i);
+		else if (!cancel(i))
+			i++;
+	}
+}
+
+size_t CellStreamer::residentCells() const
+{
+	return m_residentCells;
+}
+
+size_t CellStreamer::loadingCells() const
+{
+	return m_active.size() - m_residentCells;
+}
+
+size_t CellStreamer::residentBytes() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_residentBytes;
+}
+
+void CellStreamer::meshFilepaths(const std::vector<CellObject>& objects, std::vector<std::string>& filepaths)
+{
+	filepaths.clear();
+
+	for (const auto& object : objects)
+	{
+		if (!object.mesh.empty())
+			filepaths.push_back(object.mesh);
+
+		for (const auto& lod : object.lods)
+			filepaths.push_back(lod.first);
+	}
+
+	std::sort(filepaths.begin(), filepaths.end());
+	filepaths.erase(std::unique(filepaths.begin(), filepaths.end()), filepaths.end());
+}
+
+void CellStreamer::createObjects(graphics::Scene3D& scene, const std::vector<CellObject>& objects, const std::vector<std::string>& filepaths,
+	const std::vector<const graphics::Mesh*>& meshes, std::vector<SceneObjectHandle>* handles)
+{
+	auto findMesh = [&filepaths, &meshes](const std::string& filepath) {
+		return meshes[std::lower_bound(filepaths.begin(), filepaths.end(), filepath) - filepaths.begin()];
+	};
+
+	std::vector<SceneObject*> sceneObjects;
+
+	for (const auto& object : objects)
+	{
+		SceneObject* sceneObject = scene.get(scene.create());
+		sceneObjects.push_back(sceneObject);
+
+		if (handles)
+			handles->push_back(sceneObject->getHandle());
+
+		sceneObject->addComponent<TransformComponent>(new TransformComponent(object.position, object.scale, object.orientation));
+
+		const graphics::Mesh* mesh = object.mesh.empty() ? nullptr : findMesh(object.mesh);
+
+		if (mesh)
+		{
+			MeshComponent* meshComponent = new MeshComponent(mesh);
+
+			for (const auto& lod : object.lods)
+				if (const graphics::Mesh* lodMesh = findMesh(lod.first))
+					meshComponent->addLOD(lodMesh, lod.second);
+
+			sceneObject->addComponent<MeshComponent>(meshComponent);
+		}
+
+		if (object.hasBounds)
+			sceneObject->addComponent<BoundsComponent>(new BoundsComponent(object.bounds));
+	}
+
+	for (size_t i = 0; i < objects.size(); i++)
+		if (objects[i].parent >= 0 && objects[i].parent < (int)sceneObjects.size())
+			sceneObjects[i]->setParent(sceneObjects[objects[i].parent]);
+}
+
+void CellStreamer::loaderMain()
+{
+	for (;;)
+	{
+		uint32_t index;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_loadQueued.wait(lock, [this]() { return m_stop || !m_loadQueue.empty(); });
+
+			if (m_stop)
+				return;
+
+			index = m_loadQueue.front();
+			m_loadQueue.pop_front();
+		}
+
+		Cell& cell = m_cells[index];
+		cell.objects.clear();
+
+		if (!utils::SerializerJSON::readCell(cell.info.filepath.c_str(), cell.objects))
+			utils::Logger::log("ERROR::CELL_STREAMER::LOAD - Failed to read cell: \"%s\".\n", cell.info.filepath.c_str());
+
+		meshFilepaths(cell.objects, cell.meshes);
+
+		// Meshes other cells already use are shared. This is the only thread which adds meshes, so one missing now is still missing once
+		// ... imported, and cells reach uploadMeshes() in the order they are read, so a shared mesh is always uploaded before the cells
+		// ... sharing it are added to the scene.
+		for (const auto& filepath : cell.meshes)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				auto found = m_meshes.find(filepath);
+
+				if (found != m_meshes.end())
+				{
+					found->second.users++;
+					continue;
+				}
+			}
+
+			std::unique_ptr<graphics::Mesh> mesh(new graphics::Mesh(filepath.c_str(), false));
+
+			if (!mesh->getLoadErrorString().empty())
+				utils::Logger::log("ERROR::CELL_STREAMER::LOAD - Unable to load mesh: \"%s\".\n\tError message: \"%s\"\n", filepath.c_str(), mesh->getLoadErrorString().c_str());
+
+			cell.uploads.push_back(mesh.get());
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			StreamedMesh& streamed = m_meshes[filepath];
+			streamed.mesh = std::move(mesh);
+			streamed.users = 1;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_uploadQueue.push_back(index);
+	}
+}
+
+void CellStreamer::addToScene(graphics::Scene3D& scene, Cell& cell)
+{
+	cell.status = CELL_RESIDENT;
+	cell.handles.clear();
+	m_residentCells++;
+
+	// Look the meshes up first, so that the lock isn't held while the objects are created. Meshes which failed to load are left out, as
+	// ... they would be drawn as nothing anyway.
+	std::vector<const graphics::Mesh*> meshes;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (const auto& filepath : cell.meshes)
+		{
+			const graphics::Mesh* mesh = m_meshes[filepath].mesh.get();
+			meshes.push_back(mesh->getEntries().empty() ? nullptr : mesh);
+		}
+	}
+
+	createObjects(scene, cell.objects, cell.meshes, meshes, &cell.handles);
+
+	// The objects' descriptions aren't needed again until the cell is next loaded.
+	cell.objects.clear();
+	cell.objects.shrink_to_fit();
+}
+
+void CellStreamer::evict(graphics::Scene3D& scene, size_t activeIndex)
+{
+	Cell& cell = m_cells[m_active[activeIndex]];
+
+	for (auto handle : cell.handles)
+		scene.destroy(handle);
+
+	cell.handles.clear();
+	cell.status = CELL_UNLOADED;
+	m_residentCells--;
+	m_committedBytes -= cell.info.bytes;
+	m_active[activeIndex] = m_active.back();
+	m_active.pop_back();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for (const auto& filepath : cell.meshes)
+	{
+		auto found = m_meshes.find(filepath);
+
+		if (--found->second.users == 0)
+		{
+			m_residentBytes -= found->second.mesh->getByteSize();
+			m_releases.push_back(std::move(found->second.mesh));
+			m_meshes.erase(found);
+		}
+	}
+}
+
+bool CellStreamer::cancel(size_t activeIndex)
+{
+	const uint32_t index = m_active[activeIndex];
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto queued = std::find(m_loadQueue.begin(), m_loadQueue.end(), index);
+
+		if (queued == m_loadQueue.end())
+			return false;
+
+		m_loadQueue.erase(queued);
+	}
+
+	m_cells[index].status = CELL_UNLOADED;
+	m_committedBytes -= m_cells[index].info.bytes;
+	m_active[activeIndex] = m_active.back();
+	m_active.pop_back();
+	return true;
+}
+
+float CellStreamer::distance(const Cell& cell, const maths::Vec3& position) const
+{
+	const float minX = cell.info.x * m_cellSize;
+	const float minZ = cell.info.z * m_cellSize;
+	const float dx = std::max(0.0f, std::max(minX - position.x(), position.x() - (minX + m_cellSize)));
+	const float dz = std::max(0.0f, std::max(minZ - position.z(), position.z() - (minZ + m_cellSize)));
+
+	return std::sqrt(dx * dx + dz * dz);
+}
+
+uint64_t CellStreamer::cellKey(int x, int z)
+{
+	return ((uint64_t)(uint32_t)x << 32) | (uint32_t)z;
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+/*!
+ * @file component_store.cpp
+ * @brief Implementation file for the ComponentStore and Archetype classes.
+ * @author George McDonagh */
+
+
+// Local includes
+
+#include "component_store.h"
+#include "scene_object.h"
+
+
+// Namespaces
+
+using namespace engine;
+
+
+Archetype::Archetype(ComponentMask mask)
+	: m_mask(mask) { }
+
+ComponentMask Archetype::mask() const
+{
+	return m_mask;
+}
+
+size_t Archetype::size() const
+{
+	return m_objects.size();
+}
+
+const std::vector<SceneObject*>& Archetype::objects() const
+{
+	return m_objects;
+}
+
+ComponentColumn* Archetype::column(ComponentType type) const
+{
+	return m_columns[type].get();
+}
+
+ComponentStore::ComponentStore()
+	: m_structureVersion(0) { }
+
+ComponentStore::~ComponentStore()
+{
+	// Any SceneObjects still in the store lose their components with it.
+	for (auto it = m_archetypes.begin(); it != m_archetypes.end(); it++)
+		for (auto object : (*it)->m_objects)
+		{
+			object->m_store = nullptr;
+			object->m_archetype = nullptr;
+		}
+}
+
+void ComponentStore::insert(SceneObject* object)
+{
+	Archetype& archetype = findArchetype(0, nullptr, nullptr);
+	archetype.m_objects.push_back(object);
+
+	object->m_store = this;
+	object->m_archetype = &archetype;
+	object->m_row = archetype.m_objects.size() - 1;
+
+	m_structureVersion++;
+}
+
+void ComponentStore::remove(SceneObject* object)
+{
+	removeRow(*object->m_archetype, object->m_row);
+	m_structureVersion++;
+
+	object->m_store = nullptr;
+	object->m_archetype = nullptr;
+}
+
+void ComponentStore::setComponent(SceneObject* object, ComponentType type, const Component& component, ComponentColumn* (*createColumn)())
+{
+	Archetype* archetype = object->m_archetype;
+
+	if (archetype->m_columns[type])
+	{
+		archetype->m_columns[type]->set(object->m_row, component);
+		return;
+	}
+
+	Archetype& to = findArchetype(archetype->m_mask | (ComponentMask(1) << type), archetype, createColumn);
+	moveObject(object, to);
+	m_structureVersion++;
+
+	// moveObject() left the new component's column one row short.
+	to.m_columns[type]->pushBack(component);
+}
+
+void ComponentStore::removeComponent(SceneObject* object, ComponentType type)
+{
+	Archetype* archetype = object->m_archetype;
+
+	if (archetype->m_columns[type])
+	{
+		moveObject(object, findArchetype(archetype->m_mask & ~(ComponentMask(1) << type), archetype, nullptr));
+		m_structureVersion++;
+	}
+}
+
+const std::vector<std::unique_ptr<Archetype>>& ComponentStore::archetypes() const
+{
+	return m_archetypes;
+}
+
+unsigned long long ComponentStore::structureVersion() const
+{
+	return m_structureVersion;
+}
+
+Archetype& ComponentStore::findArchetype(ComponentMask mask, const Archetype* like, ComponentColumn* (*createColumn)())
+{
+	for (auto it = m_archetypes.begin(); it != m_archetypes.end(); it++)
+		if ((*it)->m_mask == mask)
+			return **it;
+
+	Archetype* archetype = new Archetype(mask);
+	m_archetypes.push_back(std::unique_ptr<Archetype>(archetype));
+
+	for (int type = 0; type < COMPONENT_TYPES_COUNT; type++)
+		if (mask & (ComponentMask(1) << type))
+		{
+			if (like && like->m_columns[type])
+				archetype->m_columns[type].reset(like->m_columns[type]->createEmpty());
+			else
+				archetype->m_columns[type].reset(createColumn());
+		}
+
+	return *archetype;
+}
+
+void ComponentStore::moveObject(SceneObject* object, Archetype& to)
+{
+	Archetype& from = *object->m_archetype;
+	const size_t row = object->m_row;
+
+	for (int type = 0; type < COMPONENT_TYPES_COUNT; type++)
+		if (from.m_columns[type] && to.m_columns[type])
+			to.m_columns[type]->pushBackFrom(*from.m_columns[type], row);
+
+	to.m_objects.push_back(object);
+
+	// Clear the emptied row out of the old archetype.
+	removeRow(from, row);
+
+	object->m_archetype = &to;
+	object->m_row = to.m_objects.size() - 1;
+}
+
+void ComponentStore::removeRow(Archetype& archetype, size_t row)
+{
+	for (int type = 0; type < COMPONENT_TYPES_COUNT; type++)
+		if (archetype.m_columns[type])
+			archetype.m_columns[type]->swapRemove(row);
+
+	// The last row has moved in to the gap, so its SceneObject's row has changed.
+	SceneObject* moved = archetype.m_objects.back();
+	archetype.m_objects[row] = moved;
+	archetype.m_objects.pop_back();
+
+	moved->m_row = row;
+}
\ No newline at end of file
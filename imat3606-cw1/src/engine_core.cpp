@@ -9,6 +9,13 @@
 #define CLEAR_COLOUR 0.5f, 0.5f, 0.5f, 1.0f
 
 
+// External includes
+
+#include <cmath>
+#include <functional>
+#include <thread>
+
+
 // Local includes
 
 #include "engine_core.h"
@@ -66,6 +73,10 @@ bool EngineCore::init(int windowWidth, int windowHeight, const char* windowTitle
 
 	m_renderer3D = std::unique_ptr<graphics::Renderer3D>(new graphics::Renderer3D());
 
+	// The update thread splits its work across the pool, so leave one hardware thread for the render thread.
+	const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+	m_threadPool = std::unique_ptr<utils::ThreadPool>(new utils::ThreadPool(hardwareThreads > 1 ? hardwareThreads - 1 : 1));
+
 	return true;
 }
 
@@ -109,7 +120,10 @@ bool EngineCore::initGLEW()
 
 void EngineCore::run(Game& game)
 {
-	// The engine's main loop.
+	m_running = true;
+	std::thread updateThread(&EngineCore::updateMain, this, std::ref(game));
+
+	// The engine's main loop, which draws the frames the update thread prepares.
 	while (!m_mainWindow->shouldClose())
 	{
 		glfwPollEvents();
@@ -117,16 +131,141 @@ void EngineCore::run(Game& game)
 		if (m_mainWindow->isKeyStroked(GLFW_KEY_ESCAPE))
 			m_mainWindow->close();
 
+		// The update thread is at most one frame ahead, so this is never a long wait.
+		{
+			std::unique_lock<std::mutex> lock(m_frameMutex);
+			m_frameChanged.wait(lock, [this]() { return m_frames.pending(); });
+		}
+
+		m_frames.consume();
+		signalFrames();
+
+		const Frame& frame = m_frames.front();
+
 		m_mainWindow->clear();
 
-		m_renderer3D->renderScene(*game.currentScene());
+		m_renderer3D->submit(frame.snapshot);
+
+		// Only once the frame is drawn, as it may still use the meshes of cells evicted since it was prepared.
+		if (frame.streamer)
+			frame.streamer->uploadMeshes();
+
+		game.uploadPreloads();
+		game.releaseStreamers();
 
 		ImGui::TextColored(ImVec4(1, 0, 0, 1), "%.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+		ImGui::Text("%u updates at %.0f Hz", frame.ticks, m_tickRate);
+		ImGui::Text("%u meshes drawn, %u culled", (unsigned int)m_renderer3D->getVisibleCount(), (unsigned int)m_renderer3D->getCulledCount());
+		ImGui::Text("Objects at LOD 0/1/2/3: %u/%u/%u/%u", (unsigned int)m_renderer3D->getLODCount(0), (unsigned int)m_renderer3D->getLODCount(1),
+			(unsigned int)m_renderer3D->getLODCount(2), (unsigned int)m_renderer3D->getLODCount(3));
+
+		ImGui::Text("Systems: %.3f ms", frame.systemsTime);
+		for (const auto& system : frame.systemTimes)
+			ImGui::Text("\t%s: %.3f ms", system.first, system.second);
+
+		if (frame.streamer)
+			ImGui::Text("Cells: %u loaded, %u loading, %.1f MB", (unsigned int)frame.residentCells, (unsigned int)frame.loadingCells, frame.residentBytes / (1024.0 * 1024.0));
+
 		ImGui::TextColored(ImVec4(0, 1, 0, 1), "\nInput controls");
 		ImGui::Text("\tCamera:\n\t[W]: Forwards.\n\t[S]: Backwards.\n\t[A]: Left.\n\t[D]: Right.\n\t[Space]: Up.\n\t[L-Ctrl]: Down.\n\t[Q]: Roll left.\n\t[E]: Roll right.\n\n\tOther:\n\t[M]: Disable/enable mouse input.\n\t[Esc]Exit.");
 
 		m_mainWindow->swapBuffers();
 	}
+
+	m_running = false;
+	signalFrames();
+	updateThread.join();
+
+	// The frames' CellStreamers must be destroyed while there is still an OpenGL context. With the update thread gone, this thread can cycle
+	// ... each buffer through back() to drop them.
+	for (int i = 0; i < 3; i++)
+	{
+		m_frames.back().streamer.reset();
+		m_frames.publish();
+		m_frames.consume();
+	}
+}
+
+void EngineCore::updateMain(Game& game)
+{
+	double lastFrameTime = glfwGetTime();
+
+	// Start a whole tick behind, so the scene is updated before it is first drawn.
+	double accumulator = 1.0 / m_tickRate;
+
+	while (m_running)
+	{
+		// Wait for the render thread to take the last frame, so that this thread works on the next frame while the render thread draws it
+		// ... rather than racing ahead with frames that will never be drawn.
+		{
+			std::unique_lock<std::mutex> lock(m_frameMutex);
+			m_frameChanged.wait(lock, [this]() { return !m_frames.pending() || !m_running; });
+		}
+
+		if (!m_running)
+			break;
+
+		const double frameTime = glfwGetTime();
+		const double tickLength = 1.0 / m_tickRate;
+		accumulator += frameTime - lastFrameTime;
+		lastFrameTime = frameTime;
+
+		// First, as the game may switch scenes, and streams the current scene's cells in to it before it is updated.
+		game.update();
+
+		graphics::Scene3D& scene = *game.currentScene();
+		Frame& frame = m_frames.back();
+
+		frame.streamer = game.currentStreamer();
+		if (frame.streamer)
+		{
+			frame.residentCells = frame.streamer->residentCells();
+			frame.loadingCells = frame.streamer->loadingCells();
+			frame.residentBytes = frame.streamer->residentBytes();
+		}
+
+		frame.ticks = 0;
+		for (; accumulator >= tickLength && frame.ticks < m_maxTicksPerFrame; frame.ticks++)
+		{
+			scene.update((float)tickLength, m_threadPool.get());
+			accumulator -= tickLength;
+		}
+
+		// Past the cap, drop whatever time is left over beyond a part of a tick.
+		if (accumulator >= tickLength)
+			accumulator = std::fmod(accumulator, tickLength);
+
+		m_renderer3D->prepare(scene, frame.snapshot, (float)(accumulator / tickLength));
+
+		const SystemScheduler& systems = scene.getSystems();
+		frame.systemsTime = systems.lastUpdateTime();
+		frame.systemTimes.clear();
+		for (size_t i = 0; i < systems.size(); i++)
+			frame.systemTimes.push_back(std::make_pair(systems.get(i)->name(), systems.get(i)->lastUpdateTime()));
+
+		m_frames.publish();
+		signalFrames();
+	}
+}
+
+void EngineCore::signalFrames()
+{
+	// Taking the mutex, even briefly, stops the signal landing between the waiting thread checking its condition and going to sleep.
+	{
+		std::lock_guard<std::mutex> lock(m_frameMutex);
+	}
+
+	m_frameChanged.notify_all();
+}
+
+void EngineCore::setTickRate(double ticksPerSecond)
+{
+	m_tickRate = ticksPerSecond;
+}
+
+void EngineCore::setMaxTicksPerFrame(unsigned int maxTicks)
+{
+	m_maxTicksPerFrame = maxTicks;
 }
 
 void EngineCore::terminate()
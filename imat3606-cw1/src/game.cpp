@@ -16,19 +16,28 @@ using namespace engine;
 
 
 Game::Game()
+	: m_currentSceneIndex(0), m_uploadBudget(4 * 1024 * 1024)
 {
 	m_scenes.push_back(std::shared_ptr<graphics::Scene3D>(new graphics::Scene3D()));
+	m_streamers.push_back(nullptr);
+	m_preloads.push_back(nullptr);
 
-	currentScene()->add(new SceneObject());
+	SceneObject* sceneObject = currentScene()->get(currentScene()->create());
 
-	currentScene()->getObjects()[0]->addComponent<MeshComponent>(new MeshComponent(utils::AssetManager::loadAsset<graphics::Mesh>("res/meshes/sphere.dae")));
+	sceneObject->addComponent<MeshComponent>(new MeshComponent(utils::AssetManager::loadAsset<graphics::Mesh>("res/meshes/sphere.dae")));
 
 	utils::SerializerJSON::write<graphics::Scene3D>(*currentScene());
 
 	currentScene() = std::shared_ptr<graphics::Scene3D>(utils::SerializerJSON::read<graphics::Scene3D>("res/data/scene.json"));
 }
 
-Game::~Game() { }
+Game::~Game()
+{
+	// The loading threads write to their scenes, so they must finish before the scenes are destroyed.
+	for (const auto& preload : m_preloads)
+		if (preload && preload->loader.joinable())
+			preload->loader.join();
+}
 
 void load(const char* filepath)
 {
@@ -38,4 +47,171 @@ void load(const char* filepath)
 std::shared_ptr<graphics::Scene3D>& Game::currentScene()
 {
 	return m_scenes[m_currentSceneIndex];
+}
+
+void Game::update()
+{
+	const std::shared_ptr<CellStreamer>& streamer = currentStreamer();
+
+	if (streamer)
+		streamer->update(*currentScene(), currentScene()->getCamera().position());
+}
+
+bool Game::streamCurrentScene(const char* indexFilepath, float loadRadius, float unloadRadius, size_t memoryBudget)
+{
+	CellIndex index;
+
+	if (!utils::SerializerJSON::readCellIndex(indexFilepath, index))
+		return false;
+
+	std::shared_ptr<CellStreamer> streamer(new CellStreamer(index));
+	streamer->setRadii(loadRadius, unloadRadius);
+	streamer->setMemoryBudget(memoryBudget);
+
+	std::shared_ptr<CellStreamer>& current = m_streamers[m_currentSceneIndex];
+
+	// The frame being drawn may still use the old CellStreamer's meshes, so it is only destroyed once the render thread has let go of it.
+	if (current)
+	{
+		current->evictAll(*currentScene());
+
+		std::lock_guard<std::mutex> lock(m_streamerMutex);
+		m_retiredStreamers.push_back(std::move(current));
+	}
+
+	current = std::move(streamer);
+	return true;
+}
+
+const std::shared_ptr<CellStreamer>& Game::currentStreamer()
+{
+	return m_streamers[m_currentSceneIndex];
+}
+
+int Game::preloadScene(const char* filepath)
+{
+	ScenePreload* preload = new ScenePreload();
+	preload->filepath = filepath;
+	preload->uploaded = 0;
+	preload->status = PRELOAD_IMPORTING;
+
+	graphics::Scene3D* scene = new graphics::Scene3D();
+
+	m_scenes.push_back(std::shared_ptr<graphics::Scene3D>(scene));
+	m_streamers.push_back(nullptr);
+
+	{
+		std::lock_guard<std::mutex> lock(m_preloadMutex);
+		m_preloads.push_back(std::unique_ptr<ScenePreload>(preload));
+	}
+
+	preload->loader = std::thread(&Game::preloadMain, preload, scene);
+
+	return (int)m_scenes.size() - 1;
+}
+
+bool Game::sceneReady(int sceneIndex) const
+{
+	// Only the thread updating the scene adds to m_preloads, so it can read them without the lock.
+	if (sceneIndex < 0 || sceneIndex >= (int)m_scenes.size())
+		return false;
+
+	return !m_preloads[sceneIndex] || m_preloads[sceneIndex]->status == PRELOAD_READY;
+}
+
+bool Game::switchTo(int sceneIndex)
+{
+	if (!sceneReady(sceneIndex))
+		return false;
+
+	m_currentSceneIndex = sceneIndex;
+	return true;
+}
+
+void Game::uploadPreloads()
+{
+	// The lock only guards m_preloads itself, which the update thread may be adding to. The ScenePreloads stay where they are, and only this
+	// ... thread touches the meshes of those being uploaded, so the uploads are done without it.
+	m_uploading.clear();
+
+	{
+		std::lock_guard<std::mutex> lock(m_preloadMutex);
+
+		for (const auto& preload : m_preloads)
+			if (preload && preload->status == PRELOAD_UPLOADING)
+				m_uploading.push_back(preload.get());
+	}
+
+	size_t bytes = 0;
+
+	for (auto preload : m_uploading)
+	{
+		for (; preload->uploaded < preload->meshes.size(); preload->uploaded++)
+		{
+			if (m_uploadBudget != 0 && bytes >= m_uploadBudget)
+				return;
+
+			graphics::Mesh* mesh = preload->meshes[preload->uploaded].get();
+			mesh->upload();
+			bytes += mesh->getByteSize();
+		}
+
+		preload->status = PRELOAD_READY;
+	}
+}
+
+void Game::releaseStreamers()
+{
+	std::lock_guard<std::mutex> lock(m_streamerMutex);
+
+	// Once only m_retiredStreamers holds a CellStreamer, no frame can take it again, so its count can't go back up.
+	for (size_t i = 0; i < m_retiredStreamers.size();)
+	{
+		if (m_retiredStreamers[i].use_count() == 1)
+		{
+			m_retiredStreamers[i] = std::move(m_retiredStreamers.back());
+			m_retiredStreamers.pop_back();
+		}
+		else
+			i++;
+	}
+}
+
+void Game::setUploadBudget(size_t bytes)
+{
+	m_uploadBudget = bytes;
+}
+
+void Game::preloadMain(ScenePreload* preload, graphics::Scene3D* scene)
+{
+	std::vector<CellObject> objects;
+
+	if (!utils::SerializerJSON::readCell(preload->filepath.c_str(), objects))
+		utils::Logger::log("ERROR::GAME::PRELOAD_SCENE - Failed to read scene: \"%s\".\n", preload->filepath.c_str());
+
+	std::vector<std::string> filepaths;
+	CellStreamer::meshFilepaths(objects, filepaths);
+
+	// Meshes which fail to import are left out of the scene. Mesh::upload() does nothing for them, so uploadPreloads() needn't skip them.
+	std::vector<const graphics::Mesh*> meshes;
+
+	for (const auto& filepath : filepaths)
+	{
+		graphics::Mesh* mesh = new graphics::Mesh(filepath.c_str(), false);
+		preload->meshes.push_back(std::unique_ptr<graphics::Mesh>(mesh));
+
+		if (mesh->getLoadErrorString().empty())
+			meshes.push_back(mesh);
+		else
+		{
+			utils::Logger::log("ERROR::GAME::PRELOAD_SCENE - Unable to load mesh: \"%s\".\n\tError message: \"%s\"\n", filepath.c_str(), mesh->getLoadErrorString().c_str());
+			meshes.push_back(nullptr);
+		}
+	}
+
+	// The SceneObjects only point at the meshes, so they can be created before the meshes are uploaded. Nothing reads the scene until it is
+	// ... switched to, by which time they have been.
+	CellStreamer::createObjects(*scene, objects, filepaths, meshes, nullptr);
+
+	preload->status = PRELOAD_UPLOADING;
 }
\ No newline at end of file
@@ -23,12 +23,13 @@ Camera::Camera()
 
 	m_position = maths::Vec3();
 	m_orientation = maths::Vec3();
+	m_rotation = maths::Quat();
 
 	m_up = maths::Vec3(0.0f, 1.0f, 0.0f);
 	m_forward = maths::Vec3(0.0f, 0.0f, -1.0f);
 	m_right = cross(m_up, m_forward);
 
-	m_speed = 0.1f;
+	m_speed = 6.0f;
 	m_rotationSensitivity = 0.5f;
 
 	updateView();
@@ -44,12 +45,13 @@ Camera::Camera(engine::maths::Vec3 position, engine::maths::Vec3 direction, floa
 
 	m_position = position;
 	m_orientation = maths::Vec3();
+	m_rotation = maths::Quat();
 
 	m_up = maths::Vec3(0.0f, 1.0f, 0.0f);
 	m_forward = direction;
 	m_right = cross(m_up, m_forward);
 
-	m_speed = 0.1f;
+	m_speed = 6.0f;
 	m_rotationSensitivity = 0.5f;
 
 	updateView();
@@ -73,6 +75,11 @@ const engine::maths::Vec3& Camera::orientation() const
 	return m_orientation;
 }
 
+const engine::maths::Quat& Camera::rotation() const
+{
+	return m_rotation;
+}
+
 const engine::maths::Mat4& Camera::getViewMatrix() const
 {
 	return m_matView;
@@ -123,10 +130,10 @@ float& Camera::farClip()
 	return m_farClip;
 }
 
-void Camera::move(engine::maths::Vec3 offset)
+void Camera::move(engine::maths::Vec3 offset, float deltaTime)
 {
 	offset = (m_forward * offset.z()) + (m_right * offset.x()) + (m_up * offset.y());
-	m_position += offset * m_speed;
+	m_position += offset * (m_speed * deltaTime);
 
 	updateView();
 }
@@ -134,15 +141,29 @@ void Camera::move(engine::maths::Vec3 offset)
 void Camera::rotate(engine::maths::Vec3 offset)
 {
 	m_orientation += offset * m_rotationSensitivity;
+	m_rotation = maths::rotationQuat(m_orientation);
+
+	updateView();
+}
+
+void Camera::rotate(const maths::Quat& rotation)
+{
+	m_rotation = maths::normalize(rotation * m_rotation);
+	m_orientation = maths::eulerAngles(m_rotation);
 
 	updateView();
 }
 
 void Camera::updateView()
 {
-	maths::Mat4 r = maths::rotation(m_orientation);
-	maths::Mat4 t = maths::translation(-m_position);
-	m_matView = r * t;
+	// The view matrix is the rotation followed by a translation to the camera. Build it directly rather than multiplying the two.
+	maths::Mat3 r = maths::rotationMat3(m_rotation);
+	maths::Vec3 t = r * -m_position;
+
+	m_matView = maths::Mat4(r);
+	m_matView(3, 0) = t.x();
+	m_matView(3, 1) = t.y();
+	m_matView(3, 2) = t.z();
 
 	m_forward = maths::Vec3(m_matView(0, 2), m_matView(1, 2), m_matView(2, 2));
 	m_up = maths::Vec3(m_matView(0, 1), m_matView(1, 1), m_matView(2, 1));
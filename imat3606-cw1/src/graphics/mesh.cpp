@@ -27,24 +27,33 @@ engine::graphics::Mesh::MeshEntry::MeshEntry(aiMesh* mesh)
 	glBindVertexArray(vao);
 
 	elementCount = mesh->mNumFaces * 3;
+	byteSize = 0;
 
 	// Vertex position data.
 	if (mesh->HasPositions()) 
 	{
 		float *vertices = new float[mesh->mNumVertices * 3];
 
-		// Get the raw data from the Assimp mesh.
+		// Get the raw data from the Assimp mesh, and the box around it for culling while we're at it.
 		for (int i = 0; i < mesh->mNumVertices; ++i) 
 		{
 			vertices[i * 3] = mesh->mVertices[i].x;
 			vertices[i * 3 + 1] = mesh->mVertices[i].y;
 			vertices[i * 3 + 2] = mesh->mVertices[i].z;
+
+			const maths::Vec3 vertex(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+
+			if (i == 0)
+				bounds = maths::AABB(vertex, vertex);
+			else
+				bounds.expand(vertex);
 		}
 
 		// Generate, bind, and fill VBO for vertex positions.
 		glGenBuffers(1, &vbo[VERTEX_BUFFER]);
 		glBindBuffer(GL_ARRAY_BUFFER, vbo[VERTEX_BUFFER]);
 		glBufferData(GL_ARRAY_BUFFER, 3 * mesh->mNumVertices * sizeof(GLfloat), vertices, GL_STATIC_DRAW);
+		byteSize += 3 * mesh->mNumVertices * sizeof(GLfloat);
 
 		// Set vertex attribute [0] for currently bound buffer: 3 x GL_FLOATs
 		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, NULL);
@@ -69,6 +78,7 @@ engine::graphics::Mesh::MeshEntry::MeshEntry(aiMesh* mesh)
 		glGenBuffers(1, &vbo[TEXCOORD_BUFFER]);
 		glBindBuffer(GL_ARRAY_BUFFER, vbo[TEXCOORD_BUFFER]);
 		glBufferData(GL_ARRAY_BUFFER, 2 * mesh->mNumVertices * sizeof(GLfloat), texCoords, GL_STATIC_DRAW);
+		byteSize += 2 * mesh->mNumVertices * sizeof(GLfloat);
 
 		// Set vertex attribute [1] for currently bound buffer: 2 x GL_FLOATs.
 		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, NULL);
@@ -94,6 +104,7 @@ engine::graphics::Mesh::MeshEntry::MeshEntry(aiMesh* mesh)
 		glGenBuffers(1, &vbo[NORMAL_BUFFER]);
 		glBindBuffer(GL_ARRAY_BUFFER, vbo[NORMAL_BUFFER]);
 		glBufferData(GL_ARRAY_BUFFER, 3 * mesh->mNumVertices * sizeof(GLfloat), normals, GL_STATIC_DRAW);
+		byteSize += 3 * mesh->mNumVertices * sizeof(GLfloat);
 
 		// Set vertex attribute [2] for currently bound buffer: 3 x GL_FLOATs.
 		glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 0, NULL);
@@ -119,6 +130,7 @@ engine::graphics::Mesh::MeshEntry::MeshEntry(aiMesh* mesh)
 		glGenBuffers(1, &vbo[INDEX_BUFFER]);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vbo[INDEX_BUFFER]);
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, 3 * mesh->mNumFaces * sizeof(GLuint), indices, GL_STATIC_DRAW);
+		byteSize += 3 * mesh->mNumFaces * sizeof(GLuint);
 
 		// Set vertex attribute [3] for currently bound buffer: 3 x GL_FLOAT.
 		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 0, NULL);
@@ -158,10 +170,13 @@ void engine::graphics::Mesh::MeshEntry::render() const
 	glBindVertexArray(0);
 }
 
-engine::graphics::Mesh::Mesh(const char* filepath)
-	: Asset(filepath)
+engine::graphics::Mesh::Mesh(const char* filepath, bool upload)
+	: Asset(filepath), m_byteSize(0)
 {
-	load();
+	if (upload)
+		load();
+	else
+		import();
 }
 
 engine::graphics::Mesh::~Mesh() 
@@ -171,23 +186,49 @@ engine::graphics::Mesh::~Mesh()
 
 bool engine::graphics::Mesh::load()
 {
-	if (!m_isLoaded)
+	return import() && upload();
+}
+
+bool engine::graphics::Mesh::import()
+{
+	if (m_isLoaded || m_importer)
+		return true;
+
+	// Make sure load error string is reset.
+	m_loadErrorString = "";
+
+	std::unique_ptr<Assimp::Importer> importer(new Assimp::Importer());
+
+	if (!importer->ReadFile(m_filepath, NULL))
 	{
-		// Make sure load error string is reset.
-		m_loadErrorString = "";
+		m_loadErrorString = importer->GetErrorString();
+		return false;
+	}
 
-		Assimp::Importer importer;
-		const aiScene* scene = importer.ReadFile(m_filepath, NULL);
+	m_importer = std::move(importer);
+	return true;
+}
 
-		if (!scene)
-			m_loadErrorString = importer.GetErrorString();
-		else
+bool engine::graphics::Mesh::upload()
+{
+	if (!m_isLoaded && m_importer)
+	{
+		const aiScene* scene = m_importer->GetScene();
+
+		for (int i = 0; i < scene->mNumMeshes; ++i)
 		{
-			for (int i = 0; i < scene->mNumMeshes; ++i)
-				m_entries.push_back(new Mesh::MeshEntry(scene->mMeshes[i]));
+			m_entries.push_back(new Mesh::MeshEntry(scene->mMeshes[i]));
+			m_byteSize += m_entries.back()->byteSize;
 
-			m_isLoaded = true;
+			if (i == 0)
+				m_bounds = m_entries.back()->bounds;
+			else
+				m_bounds.expand(m_entries.back()->bounds);
 		}
+
+		// The importer owns the imported data, so this frees it.
+		m_importer.reset();
+		m_isLoaded = true;
 	}
 
 	return m_isLoaded;
@@ -195,6 +236,8 @@ bool engine::graphics::Mesh::load()
 
 void engine::graphics::Mesh::unload()
 {
+	m_importer.reset();
+
 	if (m_isLoaded)
 	{
 		// Destroy all mesh entries so to release all their memory.
@@ -203,6 +246,8 @@ void engine::graphics::Mesh::unload()
 			delete m_entries.at(i);
 
 		m_entries.clear();
+		m_bounds = maths::AABB();
+		m_byteSize = 0;
 
 		m_isLoaded = false;
 	}
@@ -212,4 +257,19 @@ void engine::graphics::Mesh::render() const
 {
 	for (int i = 0; i < m_entries.size(); ++i)
 		m_entries.at(i)->render();
+}
+
+size_t engine::graphics::Mesh::getByteSize() const
+{
+	return m_byteSize;
+}
+
+const engine::maths::AABB& engine::graphics::Mesh::getBounds() const
+{
+	return m_bounds;
+}
+
+const std::vector<engine::graphics::Mesh::MeshEntry*>& engine::graphics::Mesh::getEntries() const
+{
+	return m_entries;
 }
\ No newline at end of file
@@ -4,6 +4,11 @@
  * @author George McDonagh */
 
 
+// External includes
+
+#include <algorithm>
+
+
 // Local includes
 
 #include "graphics/renderer_3d.h"
@@ -14,27 +19,211 @@
 using namespace engine::graphics;
 
 
+namespace {
+
+	// How far past a level of detail's screen size an object must be before it changes level, as a fraction of the screen size.
+	const float LOD_HYSTERESIS = 0.1f;
+
+}
+
+
 Renderer3D::Renderer3D()
+	: m_cameraVersion(0), m_visibleCount(0), m_culledCount(0)
 {
+	std::fill(m_lodCounts, m_lodCounts + MeshComponent::MAX_LODS, 0);
+
 	m_shaderProgram = new ShaderProgram("res/shaders/debug.shader");
 }
 
 Renderer3D::~Renderer3D() { delete m_shaderProgram; }
 
-void Renderer3D::renderScene(engine::graphics::Scene3D& scene)
+void Renderer3D::renderScene(engine::graphics::Scene3D& scene, float interpolation)
 {
-	m_shaderProgram->enable();
-	m_shaderProgram->setUniform_mat4("view", scene.getCamera().getViewMatrix().data_ptr());
-	m_shaderProgram->setUniform_mat4("projection", scene.getCamera().getPerspectiveMatrix().data_ptr());
-	m_shaderProgram->setUniform_3f("eye", &(scene.getCamera().position().x()));
+	prepare(scene, m_snapshot, interpolation);
+	submit(m_snapshot);
+}
+
+void Renderer3D::prepare(engine::graphics::Scene3D& scene, RenderSnapshot& snapshot, float interpolation)
+{
+	const Camera& camera = scene.getCamera();
+	const maths::Mat4 viewProjection = camera.getPerspectiveMatrix() * camera.getViewMatrix();
 
-	std::vector<engine::SceneObject*>& objects = scene.getObjects();
-	for (auto it = objects.begin(); it != objects.end(); it++)
+	// A transform's world version changes along with its world matrix, so a cached MVP can only go stale when the camera moves.
+	if (viewProjection != m_viewProjection)
 	{
-		if ((*it)->hasComponent<MeshComponent>())
+		m_viewProjection = viewProjection;
+		m_cameraVersion++;
+	}
+
+	// Objects which moved in the latest update are drawn part of the way between their last two world matrices.
+	const unsigned long long latestUpdate = scene.getHierarchy().updates();
+	const bool interpolate = interpolation < 1.0f;
+
+	// Culling stage: gather what there is to draw and work out what the camera can see, before touching any GL state.
+	const maths::Frustum frustum(viewProjection);
+	size_t count = 0;
+
+	scene.each<TransformComponent, MeshComponent>([this, &count, latestUpdate](const TransformComponent& transform, MeshComponent& meshComponent) {
+		if (count == m_draws.size())
 		{
-			m_shaderProgram->setUniform_mat4("model", maths::Mat4(1.0f).data_ptr());
-			(*it)->getComponent<MeshComponent>()->mesh()->render();
+			Draw draw = { nullptr, nullptr, nullptr, 0, 0, 0, 0, maths::Mat4() };
+			m_draws.push_back(draw);
+			m_worldBounds.push_back(maths::AABB());
 		}
+
+		// The scene packs objects in the same order each frame, so each slot usually holds the same object as last frame. World versions are
+		// ... unique to each world matrix, so a matching version means the cached bounds belong to this object and are up to date.
+		Draw& draw = m_draws[count];
+
+		// ... Bounds of objects which moved in the latest update also cover where they were, so they hold wherever the object is drawn in
+		// ... between.
+		if (draw.boundsVersion == 0 || draw.boundsVersion != transform.worldVersion() || draw.mesh != meshComponent.mesh())
+		{
+			m_worldBounds[count] = maths::transform(transform.getWorldMatrix(), meshComponent.mesh()->getBounds());
+
+			if (transform.worldUpdate() == latestUpdate)
+				m_worldBounds[count].expand(maths::transform(transform.getPreviousWorldMatrix(), meshComponent.mesh()->getBounds()));
+		}
+
+		draw.transform = &transform;
+		draw.mesh = meshComponent.mesh();
+		draw.component = &meshComponent;
+		draw.lod = 0;
+		draw.boundsVersion = transform.worldVersion();
+		count++;
+	});
+
+	m_visible.resize(count);
+	frustum.test(m_worldBounds.data(), count, m_visible.data());
+
+	// Level of detail stage: find how much of the screen each visible object with a choice of levels covers, all together, then let each
+	// ... pick its level. The bounding spheres are the spheres around the world bounds.
+	m_lodDraws.clear();
+	for (size_t i = 0; i < count; i++)
+		if (m_visible[i] && m_draws[i].component->lodCount() > 1)
+			m_lodDraws.push_back(i);
+
+	m_sphereCentres.resize(m_lodDraws.size());
+	m_sphereRadii.resize(m_lodDraws.size());
+	m_screenSizes.resize(m_lodDraws.size());
+
+	for (size_t i = 0; i < m_lodDraws.size(); i++)
+	{
+		const maths::AABB& bounds = m_worldBounds[m_lodDraws[i]];
+		m_sphereCentres.set(i, bounds.center());
+		m_sphereRadii[i] = bounds.extents().magnitude();
 	}
+
+	maths::screenSize(m_sphereCentres, m_sphereRadii.data(), camera.position(), camera.getPerspectiveMatrix()(1, 1), m_screenSizes.data());
+
+	for (size_t i = 0; i < m_lodDraws.size(); i++)
+	{
+		Draw& draw = m_draws[m_lodDraws[i]];
+		draw.lod = draw.component->selectLOD(m_screenSizes[i], LOD_HYSTERESIS);
+	}
+
+	// Snapshot stage: copy out everything the draw calls need, so that the scene is free to change while they are made.
+	snapshot.eye = camera.position();
+	snapshot.draws.clear();
+	snapshot.entries.clear();
+	snapshot.visibleCount = 0;
+	snapshot.culledCount = 0;
+	std::fill(snapshot.lodCounts, snapshot.lodCounts + MeshComponent::MAX_LODS, 0);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const TransformComponent& transform = *m_draws[i].transform;
+
+		if (!m_visible[i])
+		{
+			snapshot.culledCount += m_draws[i].mesh->getEntries().size();
+			continue;
+		}
+
+		const std::vector<Mesh::MeshEntry*>& entries = m_draws[i].component->lodMesh(m_draws[i].lod)->getEntries();
+		snapshot.lodCounts[m_draws[i].lod]++;
+
+		// Blended matrices change every frame, so their MVPs aren't worth caching. The normal matrix isn't blended, as the rotation
+		// ... changes too little in one update for the lighting to show it.
+		const bool blended = interpolate && transform.worldUpdate() == latestUpdate;
+		const maths::Mat4 model = blended ? transform.getInterpolatedWorldMatrix(latestUpdate, interpolation) : transform.getWorldMatrix();
+
+		RenderSnapshot::Draw draw;
+		draw.model = model;
+		draw.normalMatrix = transform.getWorldNormalMatrix();
+		draw.firstEntry = snapshot.entries.size();
+
+		if (blended)
+		{
+			draw.mvp = m_viewProjection * model;
+		}
+		else
+		{
+			// Like the bounds, each slot's MVP is kept for as long as it holds the same world version and the camera stays put.
+			Draw& cached = m_draws[i];
+
+			if (cached.mvpVersion == 0 || cached.mvpVersion != transform.worldVersion() || cached.mvpCamera != m_cameraVersion)
+			{
+				cached.mvp = m_viewProjection * model;
+				cached.mvpVersion = transform.worldVersion();
+				cached.mvpCamera = m_cameraVersion;
+			}
+
+			draw.mvp = cached.mvp;
+		}
+
+		// A mesh's only MeshEntry has the same bounds as the mesh, which have already passed. Coarser levels of detail are assumed to have
+		// ... about the same bounds as the most detailed level.
+		for (auto entry : entries)
+		{
+			if (entries.size() > 1 && !frustum.test(maths::transform(model, entry->bounds)))
+			{
+				snapshot.culledCount++;
+				continue;
+			}
+
+			snapshot.entries.push_back(entry);
+		}
+
+		draw.entryCount = snapshot.entries.size() - draw.firstEntry;
+		snapshot.visibleCount += draw.entryCount;
+
+		if (draw.entryCount > 0)
+			snapshot.draws.push_back(draw);
+	}
+}
+
+void Renderer3D::submit(const RenderSnapshot& snapshot)
+{
+	m_shaderProgram->enable();
+	m_shaderProgram->setUniform_3f("eye", &(snapshot.eye.x()));
+
+	for (const auto& draw : snapshot.draws)
+	{
+		m_shaderProgram->setUniform_mat4("mvp", draw.mvp.data_ptr());
+		m_shaderProgram->setUniform_mat4("model", draw.model.data_ptr());
+		m_shaderProgram->setUniform_mat3("normalMatrix", draw.normalMatrix.data_ptr());
+
+		for (size_t i = draw.firstEntry; i < draw.firstEntry + draw.entryCount; i++)
+			snapshot.entries[i]->render();
+	}
+
+	m_visibleCount = snapshot.visibleCount;
+	m_culledCount = snapshot.culledCount;
+	std::copy(snapshot.lodCounts, snapshot.lodCounts + MeshComponent::MAX_LODS, m_lodCounts);
+}
+
+size_t Renderer3D::getVisibleCount() const
+{
+	return m_visibleCount;
+}
+
+size_t Renderer3D::getCulledCount() const
+{
+	return m_culledCount;
+}
+
+size_t Renderer3D::getLODCount(unsigned int level) const
+{
+	return m_lodCounts[level];
 }
\ No newline at end of file
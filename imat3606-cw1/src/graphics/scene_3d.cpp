@@ -21,15 +21,25 @@ Scene3D::Scene3D()
 
 Scene3D::~Scene3D()
 {
-	for (auto it : m_objects)
-		delete it;
-
+	m_objectPool.clear();
 	m_objects.clear();
 }
 
-void Scene3D::update()
+void Scene3D::update(float deltaTime, engine::utils::ThreadPool* threadPool)
+{
+	m_systems.update(*this, deltaTime, threadPool);
+	m_hierarchy.update(m_objects, m_components.structureVersion(), threadPool);
+	m_bvh.update(m_components, m_hierarchy.moved(), m_components.structureVersion());
+}
+
+engine::SystemScheduler& Scene3D::getSystems()
 {
+	return m_systems;
+}
 
+const engine::SystemScheduler& Scene3D::getSystems() const
+{
+	return m_systems;
 }
 
 const Camera& Scene3D::getCamera() const
@@ -47,12 +57,59 @@ const std::vector<engine::SceneObject*>& Scene3D::getObjects() const
 	return m_objects;
 }
 
-std::vector<engine::SceneObject*>& Scene3D::getObjects()
+engine::SceneObjectHandle Scene3D::create()
 {
-	return m_objects;
+	const SceneObjectHandle handle = m_objectPool.create(m_components);
+
+	SceneObject* object = m_objectPool.get(handle);
+	object->m_handle = handle;
+
+	if (m_objectIndices.size() < m_objectPool.capacity())
+		m_objectIndices.resize(m_objectPool.capacity());
+
+	m_objectIndices[handle.index] = m_objects.size();
+	m_objects.push_back(object);
+
+	return handle;
+}
+
+bool Scene3D::destroy(engine::SceneObjectHandle handle)
+{
+	SceneObject* object = m_objectPool.get(handle);
+
+	if (!object)
+		return false;
+
+	// Move the last SceneObject in to the gap, so removing one doesn't shift the rest.
+	const size_t index = m_objectIndices[handle.index];
+	m_objects[index] = m_objects.back();
+	m_objectIndices[m_objects[index]->m_handle.index] = index;
+	m_objects.pop_back();
+
+	return m_objectPool.destroy(handle);
+}
+
+engine::SceneObject* Scene3D::get(engine::SceneObjectHandle handle)
+{
+	return m_objectPool.get(handle);
+}
+
+const engine::SceneObject* Scene3D::get(engine::SceneObjectHandle handle) const
+{
+	return m_objectPool.get(handle);
+}
+
+const engine::ComponentStore& Scene3D::getComponents() const
+{
+	return m_components;
+}
+
+const engine::TransformHierarchy& Scene3D::getHierarchy() const
+{
+	return m_hierarchy;
 }
 
-void Scene3D::add(engine::SceneObject* sceneObject)
+const engine::SceneBVH& Scene3D::getBVH() const
 {
-	m_objects.push_back(sceneObject);
+	return m_bvh;
 }
\ No newline at end of file
@@ -153,6 +153,11 @@ void ShaderProgram::setUniform_4f(const char* uniformName, const GLfloat f[4]) c
 	GL_CALL(glUniform4f(getUniformLoc(uniformName), f[0], f[1], f[2], f[3]));
 }
 
+void ShaderProgram::setUniform_mat3(const char* uniformName, const GLfloat f[9]) const
+{
+	GL_CALL(glUniformMatrix3fv(getUniformLoc(uniformName), 1, GL_FALSE, f));
+}
+
 void ShaderProgram::setUniform_mat4(const char* uniformName, const GLfloat f[16]) const
 {
 	GL_CALL(glUniformMatrix4fv(getUniformLoc(uniformName), 1, GL_FALSE, f));
@@ -0,0 +1,14 @@
+/*!
+ * @file aabb.cpp
+ * @brief Implimentation file for the AABB class.
+ * @author George McDonagh */
+
+
+// Local includes
+
+#include "maths/maths.h"
+
+// The AABB definitions are inlined from the header unless the out-of-line build is requested.
+#ifdef ENGINE_MATHS_OUT_OF_LINE
+#include "maths/geometry/aabb.inl"
+#endif
\ No newline at end of file
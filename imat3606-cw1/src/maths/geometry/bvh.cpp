@@ -0,0 +1,560 @@
+/*!
+ * @file bvh.cpp
+ * @brief Implementation file for the BVH class.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <algorithm>
+#include <limits>
+
+
+// Local includes
+
+#include "maths/geometry/bvh.h"
+
+
+// Namespaces
+
+using namespace engine::maths;
+
+
+namespace {
+
+	// Nodes with more items than this are always split, even where the surface area heuristic says a leaf would be cheaper.
+	const uint32_t MAX_LEAF_SIZE = 8;
+
+	// The number of buckets each axis is divided in to when looking for the cheapest split.
+	const int BIN_COUNT = 16;
+
+	// The cost of visiting a node, relative to testing an item's box.
+	const float TRAVERSAL_COST = 1.0f;
+
+	// Nodes and items which are entirely inside, partly inside, or outside a frustum.
+	enum Containment { OUTSIDE, INTERSECTING, INSIDE };
+
+	AABB emptyBox()
+	{
+		const float infinity = std::numeric_limits<float>::infinity();
+		return AABB(Vec3(infinity), Vec3(-infinity));
+	}
+
+	bool isEmpty(const AABB& box)
+	{
+		return box.min().x() > box.max().x();
+	}
+
+	// AABB::expand() grows a box to fit both of the other box's corners, which goes wrong for an empty box, so merge them one axis at a time.
+	void merge(AABB& box, const AABB& other)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			box.min()(i) = std::min(box.min()(i), other.min()(i));
+			box.max()(i) = std::max(box.max()(i), other.max()(i));
+		}
+	}
+
+	// Half of a box's surface area, which is all the surface area heuristic needs, as it only compares areas.
+	float halfArea(const AABB& box)
+	{
+		if (isEmpty(box))
+			return 0.0f;
+
+		const Vec3 size = box.size();
+		return size.x() * size.y() + size.y() * size.z() + size.z() * size.x();
+	}
+
+	Containment classify(const Frustum& frustum, const AABB& box)
+	{
+		if (isEmpty(box))
+			return OUTSIDE;
+
+		Containment containment = INSIDE;
+
+		for (int i = 0; i < 6; i++)
+		{
+			// The corner furthest along the plane's normal is the last to leave the plane's inside, and the opposite corner is the first.
+			const Plane& plane = frustum.plane(i);
+			const Vec3& n = plane.normal();
+
+			const Vec3 furthest(
+				n.x() >= 0.0f ? box.max().x() : box.min().x(),
+				n.y() >= 0.0f ? box.max().y() : box.min().y(),
+				n.z() >= 0.0f ? box.max().z() : box.min().z());
+
+			if (plane.signedDistance(furthest) < 0.0f)
+				return OUTSIDE;
+
+			const Vec3 nearest(
+				n.x() >= 0.0f ? box.min().x() : box.max().x(),
+				n.y() >= 0.0f ? box.min().y() : box.max().y(),
+				n.z() >= 0.0f ? box.min().z() : box.max().z());
+
+			if (plane.signedDistance(nearest) < 0.0f)
+				containment = INTERSECTING;
+		}
+
+		return containment;
+	}
+
+	// The slab test, with the reciprocal of the ray's direction worked out once per ray rather than once per node.
+	bool hitNode(const AABB& box, const Vec3& origin, const Vec3& inverseDirection, float& t)
+	{
+		if (isEmpty(box))
+			return false;
+
+		float tNear = 0.0f;
+		float tFar = std::numeric_limits<float>::infinity();
+
+		for (int i = 0; i < 3; i++)
+		{
+			const float t1 = (box.min()(i) - origin(i)) * inverseDirection(i);
+			const float t2 = (box.max()(i) - origin(i)) * inverseDirection(i);
+
+			tNear = std::max(tNear, std::min(t1, t2));
+			tFar = std::min(tFar, std::max(t1, t2));
+		}
+
+		t = tNear;
+		return tNear <= tFar;
+	}
+
+	// An axis-aligned bucket of items, and the box around them.
+	struct Bin
+	{
+		AABB bounds;
+		uint32_t count;
+	};
+
+	// A node still to be built, and the range of m_order holding its items.
+	struct BuildTask
+	{
+		uint32_t node;
+		uint32_t begin;
+		uint32_t end;
+	};
+
+}
+
+
+BVH::BVH() { }
+
+void BVH::build(const std::vector<AABB>& boxes)
+{
+	const uint32_t count = (uint32_t)boxes.size();
+
+	m_boxes = boxes;
+	m_order.resize(count);
+	m_leaves.assign(count, 0);
+	m_nodes.clear();
+	m_parents.clear();
+	m_dirtyLeaves.clear();
+
+	for (uint32_t i = 0; i < count; i++)
+		m_order[i] = i;
+
+	if (count == 0)
+	{
+		m_dirty.clear();
+		return;
+	}
+
+	std::vector<Vec3> centroids(count);
+	for (uint32_t i = 0; i < count; i++)
+		centroids[i] = isEmpty(boxes[i]) ? Vec3(0.0f) : boxes[i].center();
+
+	// A binary tree with one item per leaf has 2n - 1 nodes, and leaves usually hold more.
+	m_nodes.reserve(2 * count);
+	m_parents.reserve(2 * count);
+
+	m_nodes.push_back(Node());
+	m_parents.push_back(0);
+
+	// Built from an explicit stack, as badly distributed items can make the tree much deeper than log n.
+	std::vector<BuildTask> tasks;
+	BuildTask root = { 0, 0, count };
+	tasks.push_back(root);
+
+	while (!tasks.empty())
+	{
+		const BuildTask task = tasks.back();
+		tasks.pop_back();
+
+		const uint32_t itemCount = task.end - task.begin;
+
+		AABB bounds = emptyBox();
+		AABB centroidBounds = emptyBox();
+
+		for (uint32_t i = task.begin; i < task.end; i++)
+		{
+			merge(bounds, m_boxes[m_order[i]]);
+			centroidBounds.expand(centroids[m_order[i]]);
+		}
+
+		m_nodes[task.node].bounds = bounds;
+
+		// Bin the items' centroids along the axis they are most spread out on, and find the boundary between bins which gives the cheapest
+		// ... pair of children. Trying the other axes as well makes the build three times slower for a barely better tree.
+		int axis = 0;
+		const Vec3 spread = centroidBounds.size();
+
+		if (spread.y() > spread(axis))
+			axis = 1;
+		if (spread.z() > spread(axis))
+			axis = 2;
+
+		int bestAxis = -1;
+		int bestBin = 0;
+		float bestCost = std::numeric_limits<float>::infinity();
+
+		if (itemCount > 1 && spread(axis) > 0.0f)
+		{
+			const float lowest = centroidBounds.min()(axis);
+			const float extent = spread(axis);
+
+			const float scale = BIN_COUNT / extent;
+
+			Bin bins[BIN_COUNT];
+			for (int b = 0; b < BIN_COUNT; b++)
+			{
+				bins[b].bounds = emptyBox();
+				bins[b].count = 0;
+			}
+
+			for (uint32_t i = task.begin; i < task.end; i++)
+			{
+				const int b = std::min(BIN_COUNT - 1, (int)((centroids[m_order[i]](axis) - lowest) * scale));
+				merge(bins[b].bounds, m_boxes[m_order[i]]);
+				bins[b].count++;
+			}
+
+			// Sweep from the right to find the area and count of everything above each boundary, then from the left to price each split.
+			float rightArea[BIN_COUNT];
+			uint32_t rightCount[BIN_COUNT];
+
+			AABB right = emptyBox();
+			uint32_t rightItems = 0;
+
+			for (int b = BIN_COUNT - 1; b > 0; b--)
+			{
+				merge(right, bins[b].bounds);
+				rightItems += bins[b].count;
+				rightArea[b] = halfArea(right);
+				rightCount[b] = rightItems;
+			}
+
+			AABB left = emptyBox();
+			uint32_t leftItems = 0;
+
+			for (int b = 0; b < BIN_COUNT - 1; b++)
+			{
+				merge(left, bins[b].bounds);
+				leftItems += bins[b].count;
+
+				if (leftItems == 0 || rightCount[b + 1] == 0)
+					continue;
+
+				const float cost = halfArea(left) * leftItems + rightArea[b + 1] * rightCount[b + 1];
+
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestBin = b;
+				}
+			}
+		}
+
+		const bool worthSplitting = bestAxis >= 0 && TRAVERSAL_COST * halfArea(bounds) + bestCost < halfArea(bounds) * itemCount;
+
+		if (!worthSplitting && itemCount <= MAX_LEAF_SIZE)
+		{
+			m_nodes[task.node].index = task.begin;
+			m_nodes[task.node].count = itemCount;
+
+			for (uint32_t i = task.begin; i < task.end; i++)
+				m_leaves[m_order[i]] = task.node;
+
+			continue;
+		}
+
+		uint32_t middle;
+
+		if (bestAxis >= 0)
+		{
+			// Bin the items the same way as above, so that both sides are guaranteed to get some.
+			const float lowest = centroidBounds.min()(bestAxis);
+			const float scale = BIN_COUNT / (centroidBounds.max()(bestAxis) - lowest);
+
+			middle = (uint32_t)(std::partition(m_order.begin() + task.begin, m_order.begin() + task.end, [&](uint32_t item) {
+				return std::min(BIN_COUNT - 1, (int)((centroids[item](bestAxis) - lowest) * scale)) <= bestBin;
+			}) - m_order.begin());
+		}
+		else
+		{
+			// Every centroid is in the same place, so no split is any better than another.
+			middle = task.begin + itemCount / 2;
+		}
+
+		const uint32_t child = (uint32_t)m_nodes.size();
+		m_nodes.push_back(Node());
+		m_nodes.push_back(Node());
+		m_parents.push_back(task.node);
+		m_parents.push_back(task.node);
+
+		m_nodes[task.node].index = child;
+		m_nodes[task.node].count = 0;
+
+		BuildTask leftTask = { child, task.begin, middle };
+		BuildTask rightTask = { child + 1, middle, task.end };
+		tasks.push_back(rightTask);
+		tasks.push_back(leftTask);
+	}
+
+	m_dirty.assign(m_nodes.size(), 0);
+}
+
+void BVH::update(uint32_t item, const AABB& box)
+{
+	m_boxes[item] = box;
+
+	const uint32_t leaf = m_leaves[item];
+
+	if (!m_dirty[leaf])
+	{
+		m_dirty[leaf] = 1;
+		m_dirtyLeaves.push_back(leaf);
+	}
+}
+
+void BVH::remove(uint32_t item)
+{
+	update(item, emptyBox());
+}
+
+void BVH::refit()
+{
+	if (m_dirtyLeaves.empty())
+		return;
+
+	// If much of the tree has changed, refitting every node is cheaper than walking up from each changed leaf. Children come after their
+	// ... parents, so going backwards refits each node after its children.
+	if (m_dirtyLeaves.size() * 4 > m_nodes.size())
+	{
+		for (uint32_t node = (uint32_t)m_nodes.size(); node-- > 0;)
+			refitNode(node);
+	}
+	else
+	{
+		// Refit each changed leaf's ancestors in turn, stopping at the first one whose box doesn't change, as nothing above it will either.
+		// Small movements rarely reach far up the tree.
+		for (auto leaf : m_dirtyLeaves)
+			for (uint32_t node = leaf; refitNode(node) && node != 0;)
+				node = m_parents[node];
+	}
+
+	for (auto leaf : m_dirtyLeaves)
+		m_dirty[leaf] = 0;
+
+	m_dirtyLeaves.clear();
+}
+
+size_t BVH::size() const
+{
+	return m_boxes.size();
+}
+
+size_t BVH::nodeCount() const
+{
+	return m_nodes.size();
+}
+
+const AABB& BVH::bounds(uint32_t item) const
+{
+	return m_boxes[item];
+}
+
+void BVH::query(const AABB& box, std::vector<uint32_t>& items) const
+{
+	if (m_nodes.empty())
+		return;
+
+	// Empty boxes have their minimum corner above their maximum, so they never intersect anything.
+	std::vector<uint32_t> stack(1, 0);
+
+	while (!stack.empty())
+	{
+		const Node& node = m_nodes[stack.back()];
+		stack.pop_back();
+
+		if (!node.bounds.intersects(box))
+			continue;
+
+		if (node.count > 0)
+		{
+			for (uint32_t i = node.index; i < node.index + node.count; i++)
+				if (m_boxes[m_order[i]].intersects(box))
+					items.push_back(m_order[i]);
+		}
+		else
+		{
+			stack.push_back(node.index + 1);
+			stack.push_back(node.index);
+		}
+	}
+}
+
+void BVH::query(const Frustum& frustum, std::vector<uint32_t>& items) const
+{
+	if (m_nodes.empty())
+		return;
+
+	// Each node is paired with whether it's already known to be entirely inside the frustum.
+	std::vector<std::pair<uint32_t, bool>> stack(1, std::make_pair(0u, false));
+
+	while (!stack.empty())
+	{
+		const Node& node = m_nodes[stack.back().first];
+		bool inside = stack.back().second;
+		stack.pop_back();
+
+		if (!inside)
+		{
+			const Containment containment = classify(frustum, node.bounds);
+
+			if (containment == OUTSIDE)
+				continue;
+
+			inside = containment == INSIDE;
+		}
+
+		if (node.count > 0)
+		{
+			for (uint32_t i = node.index; i < node.index + node.count; i++)
+			{
+				const AABB& box = m_boxes[m_order[i]];
+
+				if (!isEmpty(box) && (inside || frustum.test(box)))
+					items.push_back(m_order[i]);
+			}
+		}
+		else
+		{
+			stack.push_back(std::make_pair(node.index + 1, inside));
+			stack.push_back(std::make_pair(node.index, inside));
+		}
+	}
+}
+
+bool BVH::raycast(const Ray& ray, float& t, uint32_t& item) const
+{
+	if (m_nodes.empty())
+		return false;
+
+	const Vec3& origin = ray.origin();
+	const Vec3 inverseDirection(1.0f / ray.direction().x(), 1.0f / ray.direction().y(), 1.0f / ray.direction().z());
+
+	float nearest = std::numeric_limits<float>::infinity();
+	bool hit = false;
+
+	// Each node is paired with the distance at which the ray enters it, so nodes beyond the nearest hit so far can be skipped.
+	std::vector<std::pair<uint32_t, float>> stack;
+	float rootT;
+
+	if (hitNode(m_nodes[0].bounds, origin, inverseDirection, rootT))
+		stack.push_back(std::make_pair(0u, rootT));
+
+	while (!stack.empty())
+	{
+		const Node& node = m_nodes[stack.back().first];
+		const float entry = stack.back().second;
+		stack.pop_back();
+
+		if (entry >= nearest)
+			continue;
+
+		if (node.count > 0)
+		{
+			for (uint32_t i = node.index; i < node.index + node.count; i++)
+			{
+				const AABB& box = m_boxes[m_order[i]];
+				float itemT;
+
+				if (!isEmpty(box) && intersect(ray, box, itemT) && itemT < nearest)
+				{
+					nearest = itemT;
+					item = m_order[i];
+					hit = true;
+				}
+			}
+		}
+		else
+		{
+			// Visit the nearer child first, so that the further one is more likely to be skipped.
+			float leftT, rightT;
+			const bool hitLeft = hitNode(m_nodes[node.index].bounds, origin, inverseDirection, leftT);
+			const bool hitRight = hitNode(m_nodes[node.index + 1].bounds, origin, inverseDirection, rightT);
+
+			if (hitLeft && hitRight)
+			{
+				if (leftT <= rightT)
+				{
+					stack.push_back(std::make_pair(node.index + 1, rightT));
+					stack.push_back(std::make_pair(node.index, leftT));
+				}
+				else
+				{
+					stack.push_back(std::make_pair(node.index, leftT));
+					stack.push_back(std::make_pair(node.index + 1, rightT));
+				}
+			}
+			else if (hitLeft)
+				stack.push_back(std::make_pair(node.index, leftT));
+			else if (hitRight)
+				stack.push_back(std::make_pair(node.index + 1, rightT));
+		}
+	}
+
+	if (hit)
+		t = nearest;
+
+	return hit;
+}
+
+bool BVH::refitNode(uint32_t index)
+{
+	Node& node = m_nodes[index];
+	AABB bounds = emptyBox();
+
+	if (node.count > 0)
+	{
+		for (uint32_t i = node.index; i < node.index + node.count; i++)
+			merge(bounds, m_boxes[m_order[i]]);
+	}
+	else
+	{
+		merge(bounds, m_nodes[node.index].bounds);
+		merge(bounds, m_nodes[node.index + 1].bounds);
+	}
+
+	if (bounds.min() == node.bounds.min() && bounds.max() == node.bounds.max())
+		return false;
+
+	node.bounds = bounds;
+	return true;
+}
+
+float BVH::cost() const
+{
+	if (m_nodes.empty() || halfArea(m_nodes[0].bounds) == 0.0f)
+		return 0.0f;
+
+	// The chance of a query visiting a node is roughly its area over the root's.
+	float cost = 0.0f;
+
+	for (auto it = m_nodes.begin(); it != m_nodes.end(); it++)
+		cost += halfArea(it->bounds) * (it->count > 0 ? (float)it->count : TRAVERSAL_COST);
+
+	return cost / halfArea(m_nodes[0].bounds);
+}
\ No newline at end of file
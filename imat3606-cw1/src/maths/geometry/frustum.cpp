@@ -0,0 +1,62 @@
+/*!
+ * @file frustum.cpp
+ * @brief Implementation file for the Frustum class.
+ * @author George McDonagh */
+
+
+// Local includes
+
+#include "maths/maths.h"
+#include "maths/simd.h"
+
+// The Frustum's single bound tests are inlined from the header unless the out-of-line build is requested.
+#ifdef ENGINE_MATHS_OUT_OF_LINE
+#include "maths/geometry/frustum.inl"
+#endif
+
+
+// Namespaces
+
+using namespace engine::maths;
+
+
+// The culling kernels read the planes as four floats each and the boxes as six floats each.
+static_assert(sizeof(Plane) == 4 * sizeof(float), "Plane must be four tightly packed floats.");
+static_assert(sizeof(AABB) == 6 * sizeof(float), "AABB must be six tightly packed floats.");
+
+
+Frustum::Frustum()
+{ }
+
+Frustum::Frustum(const Mat4& viewProjection)
+{
+	// Gribb and Hartmann's method: a point is inside a clip space plane when, for example, -w <= x, which in world space is
+	// ... dot(row3 + row0, p) >= 0, so each plane is the sum or difference of the matrix's last row and one of the others.
+	const Mat4& m = viewProjection;
+
+	for (int i = 0; i < 3; i++)
+	{
+		m_planes[2 * i] = Plane(
+			m(0, 3) + m(0, i),
+			m(1, 3) + m(1, i),
+			m(2, 3) + m(2, i),
+			m(3, 3) + m(3, i));
+
+		m_planes[2 * i + 1] = Plane(
+			m(0, 3) - m(0, i),
+			m(1, 3) - m(1, i),
+			m(2, 3) - m(2, i),
+			m(3, 3) - m(3, i));
+	}
+
+	for (int i = 0; i < 6; i++)
+		m_planes[i].normalize();
+}
+
+void Frustum::test(const AABB* boxes, size_t count, uint8_t* result) const
+{
+	if (count == 0)
+		return;
+
+	simd::frustumCullAABB(&m_planes[0].normal().x(), &boxes[0].min().x(), count, result);
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+/*!
+ * @file plane.cpp
+ * @brief Implimentation file for the Plane class.
+ * @author George McDonagh */
+
+
+// Local includes
+
+#include "maths/maths.h"
+
+// The Plane definitions are inlined from the header unless the out-of-line build is requested.
+#ifdef ENGINE_MATHS_OUT_OF_LINE
+#include "maths/geometry/plane.inl"
+#endif
\ No newline at end of file
@@ -0,0 +1,14 @@
+/*!
+ * @file ray.cpp
+ * @brief Implimentation file for the Ray class.
+ * @author George McDonagh */
+
+
+// Local includes
+
+#include "maths/maths.h"
+
+// The Ray definitions are inlined from the header unless the out-of-line build is requested.
+#ifdef ENGINE_MATHS_OUT_OF_LINE
+#include "maths/geometry/ray.inl"
+#endif
\ No newline at end of file
@@ -4,238 +4,229 @@
  * @author George McDonagh */
 
 
+// External includes
+
+#include <limits>
+
+
 // Local includes
 
-#include "maths\maths.h"
+#include "maths/maths.h"
+#include "maths/simd.h"
 
+#ifdef ENGINE_MATHS_OUT_OF_LINE
+#include "maths/maths.inl"
+#endif
 
-float engine::maths::degrees(float radians)
-{
-	return radians * 180.0f / MATH_PI;
-}
 
-float engine::maths::radians(float degrees)
+// The batched transforms treat arrays of Vec3 as tightly packed XYZ triples.
+static_assert(sizeof(engine::maths::Vec3) == 3 * sizeof(float), "Vec3 must be three tightly packed floats.");
+
+
+engine::maths::Mat3 engine::maths::inverse(const Mat3& mat3)
 {
-	return degrees * MATH_PI / 180.0f;
+	return (1.0f / mat3.determinant()) * transpose(Mat3(
+		 maths::Mat2(mat3(1, 1), mat3(1, 2), mat3(2, 1), mat3(2, 2)).determinant(),
+		-maths::Mat2(mat3(1, 0), mat3(1, 2), mat3(2, 0), mat3(2, 2)).determinant(),
+		 maths::Mat2(mat3(1, 0), mat3(1, 1), mat3(2, 0), mat3(2, 1)).determinant(),
+
+		-maths::Mat2(mat3(0, 1), mat3(0, 2), mat3(2, 1), mat3(2, 2)).determinant(),
+		 maths::Mat2(mat3(0, 0), mat3(0, 2), mat3(2, 0), mat3(2, 2)).determinant(),
+		-maths::Mat2(mat3(0, 0), mat3(0, 1), mat3(2, 0), mat3(2, 1)).determinant(),
+
+		 maths::Mat2(mat3(0, 1), mat3(0, 2), mat3(1, 1), mat3(1, 2)).determinant(),
+		-maths::Mat2(mat3(0, 0), mat3(0, 2), mat3(1, 0), mat3(1, 2)).determinant(),
+		 maths::Mat2(mat3(0, 0), mat3(0, 1), mat3(1, 0), mat3(1, 1)).determinant()));
 }
 
-engine::maths::Vec2 engine::maths::normalize(const Vec2& vec2)
+engine::maths::Mat4 engine::maths::inverse(const Mat4& mat4)
 {
-	return vec2 / vec2.magnitude();
+	Mat4 m;
+	simd::mat4Inverse(mat4.data_ptr(), &m(0, 0));
+
+	return m;
 }
 
-engine::maths::Vec3 engine::maths::normalize(const Vec3& vec3)
+engine::maths::Mat4 engine::maths::inverseAffine(const Mat4& mat4)
 {
-	return vec3 / vec3.magnitude();
+	Mat4 m;
+	simd::mat4InverseAffine(mat4.data_ptr(), &m(0, 0));
+
+	return m;
 }
 
-engine::maths::Vec4 engine::maths::normalize(const Vec4& vec4)
+engine::maths::Mat4 engine::maths::inverseRigid(const Mat4& mat4)
 {
-	return vec4 / vec4.magnitude();
+	Mat4 m;
+	simd::mat4InverseRigid(mat4.data_ptr(), &m(0, 0));
+
+	return m;
 }
 
-float engine::maths::dot(const Vec3& vec3a, const Vec3& vec3b)
+engine::maths::Quat engine::maths::rotationQuat(const Mat3& mat3)
 {
-	return vec3a.x() * vec3b.x() + vec3a.y() * vec3b.y() + vec3a.z() * vec3b.z();
+	// Shepperd's method: take the square root of whichever of w, x, y, or z is largest, to keep the division well conditioned.
+	float m00 = mat3(0, 0), m11 = mat3(1, 1), m22 = mat3(2, 2);
+	float trace = m00 + m11 + m22;
+
+	if (trace > 0.0f)
+	{
+		float s = 0.5f / sqrt(trace + 1.0f);
+		return Quat((mat3(1, 2) - mat3(2, 1)) * s, (mat3(2, 0) - mat3(0, 2)) * s, (mat3(0, 1) - mat3(1, 0)) * s, 0.25f / s);
+	}
+	else if (m00 > m11 && m00 > m22)
+	{
+		float s = 2.0f * sqrt(1.0f + m00 - m11 - m22);
+		return Quat(0.25f * s, (mat3(1, 0) + mat3(0, 1)) / s, (mat3(2, 0) + mat3(0, 2)) / s, (mat3(1, 2) - mat3(2, 1)) / s);
+	}
+	else if (m11 > m22)
+	{
+		float s = 2.0f * sqrt(1.0f + m11 - m00 - m22);
+		return Quat((mat3(1, 0) + mat3(0, 1)) / s, 0.25f * s, (mat3(2, 1) + mat3(1, 2)) / s, (mat3(2, 0) - mat3(0, 2)) / s);
+	}
+	else
+	{
+		float s = 2.0f * sqrt(1.0f + m22 - m00 - m11);
+		return Quat((mat3(2, 0) + mat3(0, 2)) / s, (mat3(2, 1) + mat3(1, 2)) / s, 0.25f * s, (mat3(0, 1) - mat3(1, 0)) / s);
+	}
 }
 
-engine::maths::Vec3 engine::maths::cross(const Vec3& vec3a, const Vec3& vec3b)
+engine::maths::Vec3 engine::maths::eulerAngles(const Quat& quat)
 {
+	float x = quat.x(), y = quat.y(), z = quat.z(), w = quat.w();
+
+	// Clamp the pitch's sine, as rounding can push it just outside [-1, 1] when looking straight up or down.
+	float sinY = 2.0f * (w * y - z * x);
+	sinY = sinY > 1.0f ? 1.0f : (sinY < -1.0f ? -1.0f : sinY);
+
 	return Vec3(
-		vec3a.y() * vec3b.z() - vec3a.z() * vec3b.y(),
-		vec3a.z() * vec3b.x() - vec3a.x() * vec3b.z(),
-		vec3a.x() * vec3b.y() - vec3a.y() * vec3b.x());
+		degrees(atan2(2.0f * (w * x + y * z), 1.0f - 2.0f * (x * x + y * y))),
+		degrees(asin(sinY)),
+		degrees(atan2(2.0f * (w * z + x * y), 1.0f - 2.0f * (y * y + z * z))));
 }
 
-engine::maths::Mat2 engine::maths::identityMat2()
+engine::maths::Quat engine::maths::slerp(const Quat& quatA, const Quat& quatB, float t)
 {
-	return Mat2();
-}
+	// q and -q are the same rotation; interpolate towards whichever of them is closest to quatA.
+	float cosTheta = dot(quatA, quatB);
+	Quat b = cosTheta < 0.0f ? -quatB : quatB;
+	cosTheta = fabs(cosTheta);
 
-engine::maths::Mat3 engine::maths::identityMat3()
-{
-	return Mat3();
-}
+	// Nearly parallel rotations would divide by a sin(theta) close to zero, and nlerp is indistinguishable from slerp there anyway.
+	if (cosTheta > 0.9995f)
+		return nlerp(quatA, b, t);
 
-engine::maths::Mat4 engine::maths::identityMat4()
-{
-	return Mat4();
-}
+	float theta = acos(cosTheta);
+	float invSinTheta = 1.0f / sin(theta);
 
-engine::maths::Mat4 engine::maths::translation(const Vec3& t)
-{
-	return Mat4(
-		1.0f,  0.0f,  0.0f,  0.0f,
-		0.0f,  1.0f,  0.0f,  0.0f,
-		0.0f,  0.0f,  1.0f,  0.0f,
-		t.x(), t.y(), t.z(), 1.0f);
+	return quatA * (sin((1.0f - t) * theta) * invSinTheta) + b * (sin(t * theta) * invSinTheta);
 }
 
-engine::maths::Mat4 engine::maths::scale(const Vec3& s)
+void engine::maths::sinCos(const float* angles, float* sines, float* cosines, size_t count)
 {
-	return Mat4(
-		s.x(), 0.0f,  0.0f,  0.0f,
-		0.0f,  s.y(), 0.0f,  0.0f,
-		0.0f,  0.0f,  s.z(), 0.0f,
-		0.0f,  0.0f,  0.0f,  1.0f);
+	simd::sinCos(angles, sines, cosines, count);
 }
 
-engine::maths::Mat4 engine::maths::rotationX(float x)
+void engine::maths::transformPoints(const Mat4& m, const Vec3* in, Vec3* out, size_t count)
 {
-	x = radians(x);
-	return Mat4(
-		1.0f,  0.0f,   0.0f,   0.0f,
-		0.0f,  cos(x), sin(x), 0.0f,
-		0.0f, -sin(x), cos(x), 0.0f,
-		0.0f,  0.0f,   0.0f,   1.0f);
+	simd::transformVec3(m.data_ptr(), reinterpret_cast<const float*>(in), reinterpret_cast<float*>(out), count, 1.0f);
 }
 
-engine::maths::Mat4 engine::maths::rotationY(float y)
+void engine::maths::transformDirections(const Mat4& m, const Vec3* in, Vec3* out, size_t count)
 {
-	y = radians(y);
-	return Mat4(
-		cos(y), 0.0f, -sin(y), 0.0f,
-		0.0f,	1.0f,  0.0f,   0.0f,
-		sin(y), 0.0f,  cos(y), 0.0f,
-		0.0f,   0.0f,  0.0f,   1.0f);
+	simd::transformVec3(m.data_ptr(), reinterpret_cast<const float*>(in), reinterpret_cast<float*>(out), count, 0.0f);
 }
 
-engine::maths::Mat4 engine::maths::rotationZ(float z)
+void engine::maths::transformPoints(const Mat4& m, const float* inX, const float* inY, const float* inZ, float* outX, float* outY, float* outZ, size_t count)
 {
-	z = radians(z);
-	return Mat4(
-		 cos(z),  sin(z), 0.0f, 0.0f,
-		-sin(z),  cos(z), 0.0f, 0.0f,
-		 0.0f,    0.0f,   1.0f, 0.0f,
-		 0.0f,    0.0f,   0.0f, 1.0f);
+	simd::transformSoA(m.data_ptr(), inX, inY, inZ, outX, outY, outZ, count, 1.0f);
 }
 
-engine::maths::Mat4 engine::maths::rotation(const Vec3& r)
+void engine::maths::transformDirections(const Mat4& m, const float* inX, const float* inY, const float* inZ, float* outX, float* outY, float* outZ, size_t count)
 {
-	return rotationZ(r.z()) * rotationY(r.y()) * rotationX(r.x());
+	simd::transformSoA(m.data_ptr(), inX, inY, inZ, outX, outY, outZ, count, 0.0f);
 }
 
-engine::maths::Mat2 engine::maths::inverse(const Mat2& mat2)
+engine::maths::AABB engine::maths::transform(const Mat4& m, const AABB& aabb)
 {
-	return (1.0f / mat2.determinant()) * Mat2(mat2(1, 1), -mat2(0, 1), -mat2(1, 0), mat2(0, 0));
-}
+	// Arvo's method: start from the translation and, for each output axis, add whichever of each matrix column's contributions from
+	// ... the box's minimum and maximum corners is smaller to the new minimum and the larger to the new maximum.
+	Vec3 lower(m(3, 0), m(3, 1), m(3, 2));
+	Vec3 upper(lower);
 
-engine::maths::Mat3 engine::maths::inverse(const Mat3& mat3)
-{
-	return (1.0f / mat3.determinant()) * transpose(Mat3(
-		 maths::Mat2(mat3(1, 1), mat3(1, 2), mat3(2, 1), mat3(2, 2)).determinant(),
-		-maths::Mat2(mat3(1, 0), mat3(1, 2), mat3(2, 0), mat3(2, 2)).determinant(),
-		 maths::Mat2(mat3(1, 0), mat3(1, 1), mat3(2, 0), mat3(2, 1)).determinant(),
+	for (int col = 0; col < 3; col++)
+	{
+		for (int row = 0; row < 3; row++)
+		{
+			float a = m(col, row) * aabb.min()(col);
+			float b = m(col, row) * aabb.max()(col);
 
-		-maths::Mat2(mat3(0, 1), mat3(0, 2), mat3(2, 1), mat3(2, 2)).determinant(),
-		 maths::Mat2(mat3(0, 0), mat3(0, 2), mat3(2, 0), mat3(2, 2)).determinant(),
-		-maths::Mat2(mat3(0, 0), mat3(0, 1), mat3(2, 0), mat3(2, 1)).determinant(),
+			lower(row) += a < b ? a : b;
+			upper(row) += a < b ? b : a;
+		}
+	}
 
-		 maths::Mat2(mat3(0, 1), mat3(0, 2), mat3(1, 1), mat3(1, 2)).determinant(),
-		-maths::Mat2(mat3(0, 0), mat3(0, 2), mat3(1, 0), mat3(1, 2)).determinant(),
-		 maths::Mat2(mat3(0, 0), mat3(0, 1), mat3(1, 0), mat3(1, 1)).determinant()));
+	return AABB(lower, upper);
 }
 
-engine::maths::Mat4 engine::maths::inverse(const Mat4& mat4)
-{
-	return (1.0f / mat4.determinant()) * transpose(Mat4(
-		 Mat3(mat4(1, 1), mat4(1, 2), mat4(1, 3), mat4(2, 1), mat4(2, 2), mat4(2, 3), mat4(3, 1), mat4(3, 2), mat4(3, 3)).determinant(),
-		-Mat3(mat4(1, 0), mat4(1, 2), mat4(1, 3), mat4(2, 0), mat4(2, 2), mat4(2, 3), mat4(3, 0), mat4(3, 2), mat4(3, 3)).determinant(),
-		 Mat3(mat4(1, 0), mat4(1, 1), mat4(1, 3), mat4(2, 0), mat4(2, 1), mat4(2, 3), mat4(3, 0), mat4(3, 1), mat4(3, 3)).determinant(),
-		-Mat3(mat4(1, 0), mat4(1, 1), mat4(1, 2), mat4(2, 0), mat4(2, 1), mat4(2, 2), mat4(3, 0), mat4(3, 1), mat4(3, 2)).determinant(),
+namespace {
 
-		-Mat3(mat4(0, 1), mat4(0, 2), mat4(0, 3), mat4(2, 1), mat4(2, 2), mat4(2, 3), mat4(3, 1), mat4(3, 2), mat4(3, 3)).determinant(),
-		 Mat3(mat4(0, 0), mat4(0, 2), mat4(0, 3), mat4(2, 0), mat4(2, 2), mat4(2, 3), mat4(3, 0), mat4(3, 2), mat4(3, 3)).determinant(),
-		-Mat3(mat4(0, 0), mat4(0, 1), mat4(0, 3), mat4(2, 0), mat4(2, 1), mat4(2, 3), mat4(3, 0), mat4(3, 1), mat4(3, 3)).determinant(),
-		 Mat3(mat4(0, 0), mat4(0, 1), mat4(0, 2), mat4(2, 0), mat4(2, 1), mat4(2, 2), mat4(3, 0), mat4(3, 1), mat4(3, 2)).determinant(),
+	// Hit distances from a single ray use the scalar kernels, so they match the batched results exactly on SSE2 and AVX.
+	bool intersectOne(engine::maths::simd::RayIntersectKernel kernel, const engine::maths::Ray& ray, const float* shape, float& t)
+	{
+		const engine::maths::Vec3& o = ray.origin();
+		const engine::maths::Vec3& d = ray.direction();
+		const float* origin[3] = { &o.x(), &o.y(), &o.z() };
+		const float* direction[3] = { &d.x(), &d.y(), &d.z() };
 
-		 Mat3(mat4(0, 1), mat4(0, 2), mat4(0, 3), mat4(1, 1), mat4(1, 2), mat4(1, 3), mat4(3, 1), mat4(3, 2), mat4(3, 3)).determinant(),
-		-Mat3(mat4(0, 0), mat4(0, 2), mat4(0, 3), mat4(1, 0), mat4(1, 2), mat4(1, 3), mat4(3, 0), mat4(3, 2), mat4(3, 3)).determinant(),
-		 Mat3(mat4(0, 0), mat4(0, 1), mat4(0, 3), mat4(1, 0), mat4(1, 1), mat4(1, 3), mat4(3, 0), mat4(3, 1), mat4(3, 3)).determinant(),
-		-Mat3(mat4(0, 0), mat4(0, 1), mat4(0, 2), mat4(1, 0), mat4(1, 1), mat4(1, 2), mat4(3, 0), mat4(3, 1), mat4(3, 2)).determinant(),
+		float hit;
+		kernel(origin, direction, shape, &hit, 1);
 
-		-Mat3(mat4(0, 1), mat4(0, 2), mat4(0, 3), mat4(1, 1), mat4(1, 2), mat4(1, 3), mat4(2, 1), mat4(2, 2), mat4(2, 3)).determinant(),
-		 Mat3(mat4(0, 0), mat4(0, 2), mat4(0, 3), mat4(1, 0), mat4(1, 2), mat4(1, 3), mat4(2, 0), mat4(2, 2), mat4(2, 3)).determinant(),
-		-Mat3(mat4(0, 0), mat4(0, 1), mat4(0, 3), mat4(1, 0), mat4(1, 1), mat4(1, 3), mat4(2, 0), mat4(2, 1), mat4(2, 3)).determinant(),
-		 Mat3(mat4(0, 0), mat4(0, 1), mat4(0, 2), mat4(1, 0), mat4(1, 1), mat4(1, 2), mat4(2, 0), mat4(2, 1), mat4(2, 2)).determinant()));
-}
+		if (hit == std::numeric_limits<float>::infinity())
+			return false;
+
+		t = hit;
+		return true;
+	}
 
-engine::maths::Mat2 engine::maths::transpose(const Mat2& mat2)
-{
-	return Mat2(
-		mat2(0, 0), mat2(1, 0),
-		mat2(0, 1), mat2(1, 1));
 }
 
-engine::maths::Mat3 engine::maths::transpose(const Mat3& mat3)
+bool engine::maths::intersect(const Ray& ray, const AABB& aabb, float& t)
 {
-	return Mat3(
-		mat3(0, 0), mat3(1, 0), mat3(2, 0),
-		mat3(0, 1), mat3(1, 1), mat3(2, 1),
-		mat3(0, 2), mat3(1, 2), mat3(2, 2));
+	return intersectOne(&simd::rayAABB_scalar, ray, &aabb.min().x(), t);
 }
 
-engine::maths::Mat4 engine::maths::transpose(const Mat4& mat4)
+bool engine::maths::intersect(const Ray& ray, const Sphere& sphere, float& t)
 {
-	return Mat4(
-		mat4(0, 0), mat4(1, 0), mat4(2, 0), mat4(3, 0),
-		mat4(0, 1), mat4(1, 1), mat4(2, 1), mat4(3, 1),
-		mat4(0, 2), mat4(1, 2), mat4(2, 2), mat4(3, 2),
-		mat4(0, 3), mat4(1, 3), mat4(2, 3), mat4(3, 3));
+	const float shape[4] = { sphere.center().x(), sphere.center().y(), sphere.center().z(), sphere.radius() };
+	return intersectOne(&simd::raySphere_scalar, ray, shape, t);
 }
 
-engine::maths::Mat4 engine::maths::lookAt(const Vec3& eye, const Vec3& at, const Vec3& up)
+bool engine::maths::intersect(const Ray& ray, const Vec3& a, const Vec3& b, const Vec3& c, float& t)
 {
-	Vec3 zAxis = normalize(at - eye);
-	Vec3 xAxis = normalize(cross(up, zAxis));
-	Vec3 yAxis = cross(zAxis, xAxis);
-
-	return Mat4(
-		xAxis.x(),		yAxis.x(),		zAxis.x(),		0.0f,
-		xAxis.y(),		yAxis.y(),		zAxis.y(),		0.0f,
-		xAxis.z(),		yAxis.z(),		zAxis.z(),		0.0f,
-		dot(xAxis, eye), dot(yAxis, eye), dot(zAxis, eye), 1.0f);
+	const float shape[9] = { a.x(), a.y(), a.z(), b.x(), b.y(), b.z(), c.x(), c.y(), c.z() };
+	return intersectOne(&simd::rayTriangle_scalar, ray, shape, t);
 }
 
-engine::maths::Mat4 engine::maths::perspective(float fov, float aspect, float nearClip, float farClip)
+void engine::maths::intersect(const Vec3Stream& origins, const Vec3Stream& directions, const AABB& aabb, float* t)
 {
-	float yScale = 1.0f / tan(0.5f * fov);
-	float xScale = yScale / aspect;
-	float nearmfar = nearClip - farClip;
-
-	return Mat4(
-		xScale, 0,		0,								   0,
-		0,		yScale, 0,								   0,
-		0,		0,		(farClip + nearClip) / nearmfar,  -1,
-		0,		0,		2 * farClip * nearClip / nearmfar, 0);
+	simd::rayAABB(origins.components(), directions.components(), &aabb.min().x(), t, origins.size());
 }
 
-engine::maths::Mat2 engine::maths::operator*(float f, const Mat2& mat2)
+void engine::maths::intersect(const Vec3Stream& origins, const Vec3Stream& directions, const Sphere& sphere, float* t)
 {
-	Mat2 m(mat2);
-	for (int i = 0; i < 2; i++)
-		for (int j = 0; j < 2; j++)
-			m(i, j) *= f;
-
-	return m;
+	const float shape[4] = { sphere.center().x(), sphere.center().y(), sphere.center().z(), sphere.radius() };
+	simd::raySphere(origins.components(), directions.components(), shape, t, origins.size());
 }
 
-engine::maths::Mat3 engine::maths::operator*(float f, const Mat3& mat3)
+void engine::maths::intersect(const Vec3Stream& origins, const Vec3Stream& directions, const Vec3& a, const Vec3& b, const Vec3& c, float* t)
 {
-	Mat3 m(mat3);
-	for (int i = 0; i < 3; i++)
-		for (int j = 0; j < 3; j++)
-			m(i, j) *= f;
-
-	return m;
+	const float shape[9] = { a.x(), a.y(), a.z(), b.x(), b.y(), b.z(), c.x(), c.y(), c.z() };
+	simd::rayTriangle(origins.components(), directions.components(), shape, t, origins.size());
 }
 
-engine::maths::Mat4 engine::maths::operator*(float f, const Mat4& mat4)
+void engine::maths::screenSize(const Vec3Stream& centres, const float* radii, const Vec3& eye, float scale, float* out)
 {
-	Mat4 m(mat4);
-	for (int i = 0; i < 4; i++)
-		for (int j = 0; j < 4; j++)
-			m(i, j) *= f;
-
-	return m;
+	const float camera[4] = { eye.x(), eye.y(), eye.z(), scale };
+	simd::sphereScreenSize(centres.components(), radii, camera, out, centres.size());
 }
\ No newline at end of file
@@ -0,0 +1,14 @@
+/*!
+ * @file quat.cpp
+ * @brief Implimentation file for the Quat class.
+ * @author George McDonagh */
+
+
+// Local includes
+
+#include "maths/maths.h"
+
+// The Quat definitions are inlined from the header unless the out-of-line build is requested.
+#ifdef ENGINE_MATHS_OUT_OF_LINE
+#include "maths/quaternion/quat.inl"
+#endif
\ No newline at end of file
@@ -0,0 +1,839 @@
+/*!
+ * @file simd.cpp
+ * @brief Implementation file for the scalar reference kernels and the SIMD kernel dispatch.
+ * @author George McDonagh */
+
+
+// Local includes
+
+#include "maths/simd.h"
+
+
+// External includes
+
+#ifdef ENGINE_SIMD_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+
+// Namespaces
+
+using namespace engine::maths;
+
+
+namespace {
+
+	simd::InstructionSet g_activeSet = simd::SIMD_SCALAR;
+
+#ifdef ENGINE_SIMD_X86
+	void cpuid(int leaf, int subleaf, unsigned int regs[4])
+	{
+#if defined(_MSC_VER)
+		int r[4];
+		__cpuidex(r, leaf, subleaf);
+		for (int i = 0; i < 4; i++)
+			regs[i] = (unsigned int)r[i];
+#else
+		__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+	}
+
+	unsigned long long xgetbv0()
+	{
+#if defined(_MSC_VER)
+		return _xgetbv(0);
+#else
+		unsigned int eax, edx;
+		__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		return ((unsigned long long)edx << 32) | eax;
+#endif
+	}
+#endif
+
+	simd::InstructionSet detectInstructionSet()
+	{
+		simd::InstructionSet set = simd::SIMD_SCALAR;
+
+#ifdef ENGINE_SIMD_X86
+		unsigned int regs[4];
+
+		cpuid(0, 0, regs);
+		unsigned int maxLeaf = regs[0];
+
+		cpuid(1, 0, regs);
+		bool sse2 = (regs[3] & (1u << 26)) != 0;
+		bool osxsave = (regs[2] & (1u << 27)) != 0;
+		bool avx = (regs[2] & (1u << 28)) != 0;
+		bool fma = (regs[2] & (1u << 12)) != 0;
+
+		// AVX also needs the OS to save the YMM registers on context switches (XCR0 bits 1 and 2).
+		bool ymmEnabled = osxsave && (xgetbv0() & 0x6) == 0x6;
+
+		bool avx2 = false;
+		if (maxLeaf >= 7)
+		{
+			cpuid(7, 0, regs);
+			avx2 = (regs[1] & (1u << 5)) != 0;
+		}
+
+		if (sse2)
+			set = simd::SIMD_SSE2;
+		if (sse2 && avx && ymmEnabled)
+			set = simd::SIMD_AVX;
+		if (set == simd::SIMD_AVX && avx2 && fma)
+			set = simd::SIMD_AVX2;
+#endif
+
+		return set;
+	}
+
+	// The dispatched pointers start off pointing at these so that the first call picks the kernels.
+	// ... this keeps the pointers constant-initialized, so they are safe to use during static initialization. Past that, EagerResolve has
+	// ... already picked them, so threads never race through these writing the pointers.
+
+	void mat4Mul_resolve(const float* a, const float* b, float* out)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::mat4Mul(a, b, out);
+	}
+
+	void mat4MulVec4_resolve(const float* m, const float* v, float* out)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::mat4MulVec4(m, v, out);
+	}
+
+	void transformVec3_resolve(const float* m, const float* in, float* out, size_t count, float w)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::transformVec3(m, in, out, count, w);
+	}
+
+	void mat4Inverse_resolve(const float* m, float* out)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::mat4Inverse(m, out);
+	}
+
+	void mat4InverseAffine_resolve(const float* m, float* out)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::mat4InverseAffine(m, out);
+	}
+
+	void mat4InverseRigid_resolve(const float* m, float* out)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::mat4InverseRigid(m, out);
+	}
+
+	void transformSoA_resolve(const float* m, const float* inX, const float* inY, const float* inZ, float* outX, float* outY, float* outZ, size_t count, float w)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::transformSoA(m, inX, inY, inZ, outX, outY, outZ, count, w);
+	}
+
+	void streamAdd_resolve(const float* a, const float* b, float* out, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::streamAdd(a, b, out, count);
+	}
+
+	void streamSubtract_resolve(const float* a, const float* b, float* out, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::streamSubtract(a, b, out, count);
+	}
+
+	void streamMultiply_resolve(const float* a, const float* b, float* out, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::streamMultiply(a, b, out, count);
+	}
+
+	void streamScale_resolve(const float* a, float s, float* out, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::streamScale(a, s, out, count);
+	}
+
+	void streamMultiplyAdd_resolve(const float* a, const float* b, const float* c, float* out, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::streamMultiplyAdd(a, b, c, out, count);
+	}
+
+	void streamScaleAdd_resolve(const float* a, float s, const float* c, float* out, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::streamScaleAdd(a, s, c, out, count);
+	}
+
+	void streamDot_resolve(const float* const* a, const float* const* b, int components, float* out, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::streamDot(a, b, components, out, count);
+	}
+
+	void streamLength_resolve(const float* const* v, int components, float* out, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::streamLength(v, components, out, count);
+	}
+
+	void streamNormalize_resolve(const float* const* in, float* const* out, int components, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::streamNormalize(in, out, components, count);
+	}
+
+	void streamCross_resolve(const float* const* a, const float* const* b, float* const* out, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::streamCross(a, b, out, count);
+	}
+
+	void sinCos_resolve(const float* angles, float* sines, float* cosines, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::sinCos(angles, sines, cosines, count);
+	}
+
+	void frustumCullAABB_resolve(const float* planes, const float* boxes, size_t count, uint8_t* result)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::frustumCullAABB(planes, boxes, count, result);
+	}
+
+	void rayAABB_resolve(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::rayAABB(origins, directions, shape, t, count);
+	}
+
+	void raySphere_resolve(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::raySphere(origins, directions, shape, t, count);
+	}
+
+	void rayTriangle_resolve(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::rayTriangle(origins, directions, shape, t, count);
+	}
+
+	void sphereScreenSize_resolve(const float* const* centres, const float* radii, const float* camera, float* out, size_t count)
+	{
+		simd::setInstructionSet(simd::supportedInstructionSet());
+		simd::sphereScreenSize(centres, radii, camera, out, count);
+	}
+
+	// Scalar equivalents of _mm_min_ps() and _mm_max_ps(), which return their second operand if either is NaN.
+	inline float selectMin(float a, float b)
+	{
+		return a < b ? a : b;
+	}
+
+	inline float selectMax(float a, float b)
+	{
+		return a > b ? a : b;
+	}
+
+}
+
+
+simd::Mat4MulKernel simd::mat4Mul = &mat4Mul_resolve;
+simd::Mat4MulVec4Kernel simd::mat4MulVec4 = &mat4MulVec4_resolve;
+simd::TransformVec3Kernel simd::transformVec3 = &transformVec3_resolve;
+simd::Mat4InverseKernel simd::mat4Inverse = &mat4Inverse_resolve;
+simd::Mat4InverseAffineKernel simd::mat4InverseAffine = &mat4InverseAffine_resolve;
+simd::Mat4InverseAffineKernel simd::mat4InverseRigid = &mat4InverseRigid_resolve;
+simd::TransformSoAKernel simd::transformSoA = &transformSoA_resolve;
+simd::StreamBinaryKernel simd::streamAdd = &streamAdd_resolve;
+simd::StreamBinaryKernel simd::streamSubtract = &streamSubtract_resolve;
+simd::StreamBinaryKernel simd::streamMultiply = &streamMultiply_resolve;
+simd::StreamScaleKernel simd::streamScale = &streamScale_resolve;
+simd::StreamMultiplyAddKernel simd::streamMultiplyAdd = &streamMultiplyAdd_resolve;
+simd::StreamScaleAddKernel simd::streamScaleAdd = &streamScaleAdd_resolve;
+simd::StreamDotKernel simd::streamDot = &streamDot_resolve;
+simd::StreamLengthKernel simd::streamLength = &streamLength_resolve;
+simd::StreamNormalizeKernel simd::streamNormalize = &streamNormalize_resolve;
+simd::StreamCrossKernel simd::streamCross = &streamCross_resolve;
+simd::SinCosKernel simd::sinCos = &sinCos_resolve;
+simd::FrustumCullKernel simd::frustumCullAABB = &frustumCullAABB_resolve;
+simd::RayIntersectKernel simd::rayAABB = &rayAABB_resolve;
+simd::RayIntersectKernel simd::raySphere = &raySphere_resolve;
+simd::RayIntersectKernel simd::rayTriangle = &rayTriangle_resolve;
+simd::SphereScreenSizeKernel simd::sphereScreenSize = &sphereScreenSize_resolve;
+
+
+namespace {
+
+	// Picks the kernels during static initialization, which runs on one thread, so they are never written while other threads call them.
+	// ... activeInstructionSet() leaves them alone if another file's static initializer has already used or set them.
+	struct EagerResolve
+	{
+		EagerResolve()
+		{
+			simd::activeInstructionSet();
+		}
+	} g_eagerResolve;
+
+}
+
+
+simd::InstructionSet simd::supportedInstructionSet()
+{
+	static const InstructionSet supported = detectInstructionSet();
+	return supported;
+}
+
+simd::InstructionSet simd::activeInstructionSet()
+{
+	// Make sure the kernels have been resolved before reporting them.
+	if (mat4Mul == &mat4Mul_resolve)
+		setInstructionSet(supportedInstructionSet());
+
+	return g_activeSet;
+}
+
+bool simd::setInstructionSet(InstructionSet set)
+{
+	if (set > supportedInstructionSet())
+		return false;
+
+	switch (set)
+	{
+#ifdef ENGINE_SIMD_X86
+	case SIMD_SSE2:
+		mat4Mul = &mat4Mul_sse2;
+		mat4MulVec4 = &mat4MulVec4_sse2;
+		transformVec3 = &transformVec3_sse2;
+		mat4Inverse = &mat4Inverse_sse2;
+		mat4InverseAffine = &mat4InverseAffine_sse2;
+		mat4InverseRigid = &mat4InverseRigid_sse2;
+		transformSoA = &transformSoA_sse2;
+		streamAdd = &streamAdd_sse2;
+		streamSubtract = &streamSubtract_sse2;
+		streamMultiply = &streamMultiply_sse2;
+		streamScale = &streamScale_sse2;
+		streamMultiplyAdd = &streamMultiplyAdd_sse2;
+		streamScaleAdd = &streamScaleAdd_sse2;
+		streamDot = &streamDot_sse2;
+		streamLength = &streamLength_sse2;
+		streamNormalize = &streamNormalize_sse2;
+		streamCross = &streamCross_sse2;
+		sinCos = &sinCos_sse2;
+		frustumCullAABB = &frustumCullAABB_sse2;
+		rayAABB = &rayAABB_sse2;
+		raySphere = &raySphere_sse2;
+		rayTriangle = &rayTriangle_sse2;
+		sphereScreenSize = &sphereScreenSize_sse2;
+		break;
+	case SIMD_AVX:
+		mat4Mul = &mat4Mul_avx;
+		mat4MulVec4 = &mat4MulVec4_avx;
+		transformVec3 = &transformVec3_avx;
+		mat4Inverse = &mat4Inverse_sse2;
+		mat4InverseAffine = &mat4InverseAffine_sse2;
+		mat4InverseRigid = &mat4InverseRigid_sse2;
+		transformSoA = &transformSoA_avx;
+		streamAdd = &streamAdd_avx;
+		streamSubtract = &streamSubtract_avx;
+		streamMultiply = &streamMultiply_avx;
+		streamScale = &streamScale_avx;
+		streamMultiplyAdd = &streamMultiplyAdd_avx;
+		streamScaleAdd = &streamScaleAdd_avx;
+		streamDot = &streamDot_avx;
+		streamLength = &streamLength_avx;
+		streamNormalize = &streamNormalize_avx;
+		streamCross = &streamCross_avx;
+		sinCos = &sinCos_avx;
+		frustumCullAABB = &frustumCullAABB_avx;
+		rayAABB = &rayAABB_avx;
+		raySphere = &raySphere_avx;
+		rayTriangle = &rayTriangle_avx;
+		sphereScreenSize = &sphereScreenSize_avx;
+		break;
+	case SIMD_AVX2:
+		mat4Mul = &mat4Mul_avx2;
+		mat4MulVec4 = &mat4MulVec4_avx2;
+		transformVec3 = &transformVec3_avx2;
+		mat4Inverse = &mat4Inverse_sse2;
+		mat4InverseAffine = &mat4InverseAffine_sse2;
+		mat4InverseRigid = &mat4InverseRigid_sse2;
+		transformSoA = &transformSoA_avx2;
+		streamAdd = &streamAdd_avx;
+		streamSubtract = &streamSubtract_avx;
+		streamMultiply = &streamMultiply_avx;
+		streamScale = &streamScale_avx;
+		streamMultiplyAdd = &streamMultiplyAdd_avx2;
+		streamScaleAdd = &streamScaleAdd_avx2;
+		streamDot = &streamDot_avx2;
+		streamLength = &streamLength_avx2;
+		streamNormalize = &streamNormalize_avx2;
+		streamCross = &streamCross_avx2;
+		sinCos = &sinCos_avx2;
+		frustumCullAABB = &frustumCullAABB_avx2;
+		rayAABB = &rayAABB_avx2;
+		raySphere = &raySphere_avx2;
+		rayTriangle = &rayTriangle_avx2;
+		sphereScreenSize = &sphereScreenSize_avx2;
+		break;
+#endif
+	default:
+		mat4Mul = &mat4Mul_scalar;
+		mat4MulVec4 = &mat4MulVec4_scalar;
+		transformVec3 = &transformVec3_scalar;
+		mat4Inverse = &mat4Inverse_scalar;
+		mat4InverseAffine = &mat4InverseAffine_scalar;
+		mat4InverseRigid = &mat4InverseRigid_scalar;
+		transformSoA = &transformSoA_scalar;
+		streamAdd = &streamAdd_scalar;
+		streamSubtract = &streamSubtract_scalar;
+		streamMultiply = &streamMultiply_scalar;
+		streamScale = &streamScale_scalar;
+		streamMultiplyAdd = &streamMultiplyAdd_scalar;
+		streamScaleAdd = &streamScaleAdd_scalar;
+		streamDot = &streamDot_scalar;
+		streamLength = &streamLength_scalar;
+		streamNormalize = &streamNormalize_scalar;
+		streamCross = &streamCross_scalar;
+		sinCos = &sinCos_scalar;
+		frustumCullAABB = &frustumCullAABB_scalar;
+		rayAABB = &rayAABB_scalar;
+		raySphere = &raySphere_scalar;
+		rayTriangle = &rayTriangle_scalar;
+		sphereScreenSize = &sphereScreenSize_scalar;
+		set = SIMD_SCALAR;
+		break;
+	}
+
+	g_activeSet = set;
+	return true;
+}
+
+void* simd::alignedAlloc(size_t bytes)
+{
+#if defined(_MSC_VER)
+	return _aligned_malloc(bytes, ENGINE_SIMD_ALIGNMENT);
+#else
+	void* ptr = nullptr;
+	if (posix_memalign(&ptr, ENGINE_SIMD_ALIGNMENT, bytes) != 0)
+		return nullptr;
+
+	return ptr;
+#endif
+}
+
+void simd::alignedFree(void* ptr)
+{
+#if defined(_MSC_VER)
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+const char* simd::instructionSetName(InstructionSet set)
+{
+	switch (set)
+	{
+	case SIMD_SSE2: return "SSE2";
+	case SIMD_AVX: return "AVX";
+	case SIMD_AVX2: return "AVX2+FMA";
+	default: return "Scalar";
+	}
+}
+
+void simd::mat4Mul_scalar(const float* a, const float* b, float* out)
+{
+	// Write to a temporary first as out may alias a or b.
+	float m[16];
+
+	for (int col = 0; col < 4; col++)
+		for (int row = 0; row < 4; row++)
+			m[4 * col + row] = a[row] * b[4 * col] + a[4 + row] * b[4 * col + 1] + a[8 + row] * b[4 * col + 2] + a[12 + row] * b[4 * col + 3];
+
+	for (int i = 0; i < 16; i++)
+		out[i] = m[i];
+}
+
+void simd::mat4MulVec4_scalar(const float* m, const float* v, float* out)
+{
+	float r[4];
+
+	for (int row = 0; row < 4; row++)
+		r[row] = m[row] * v[0] + m[4 + row] * v[1] + m[8 + row] * v[2] + m[12 + row] * v[3];
+
+	for (int i = 0; i < 4; i++)
+		out[i] = r[i];
+}
+
+void simd::transformVec3_scalar(const float* m, const float* in, float* out, size_t count, float w)
+{
+	float tx = m[12] * w;
+	float ty = m[13] * w;
+	float tz = m[14] * w;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		float x = in[3 * i];
+		float y = in[3 * i + 1];
+		float z = in[3 * i + 2];
+
+		out[3 * i    ] = m[0] * x + m[4] * y + m[8 ] * z + tx;
+		out[3 * i + 1] = m[1] * x + m[5] * y + m[9 ] * z + ty;
+		out[3 * i + 2] = m[2] * x + m[6] * y + m[10] * z + tz;
+	}
+}
+
+void simd::transformSoA_scalar(const float* m, const float* inX, const float* inY, const float* inZ, float* outX, float* outY, float* outZ, size_t count, float w)
+{
+	float tx = m[12] * w;
+	float ty = m[13] * w;
+	float tz = m[14] * w;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		float x = inX[i];
+		float y = inY[i];
+		float z = inZ[i];
+
+		outX[i] = m[0] * x + m[4] * y + m[8 ] * z + tx;
+		outY[i] = m[1] * x + m[5] * y + m[9 ] * z + ty;
+		outZ[i] = m[2] * x + m[6] * y + m[10] * z + tz;
+	}
+}
+
+void simd::mat4Inverse_scalar(const float* m, float* out)
+{
+	// Cofactor expansion using the twelve 2x2 determinants shared between the cofactors.
+	// ... inverse(transpose(M)) == transpose(inverse(M)), so the formulas read the same whether the storage is row or column-major.
+	float s0 = m[0] * m[5 ] - m[4] * m[1];
+	float s1 = m[0] * m[6 ] - m[4] * m[2];
+	float s2 = m[0] * m[7 ] - m[4] * m[3];
+	float s3 = m[1] * m[6 ] - m[5] * m[2];
+	float s4 = m[1] * m[7 ] - m[5] * m[3];
+	float s5 = m[2] * m[7 ] - m[6] * m[3];
+
+	float c5 = m[10] * m[15] - m[14] * m[11];
+	float c4 = m[9 ] * m[15] - m[13] * m[11];
+	float c3 = m[9 ] * m[14] - m[13] * m[10];
+	float c2 = m[8 ] * m[15] - m[12] * m[11];
+	float c1 = m[8 ] * m[14] - m[12] * m[10];
+	float c0 = m[8 ] * m[13] - m[12] * m[9 ];
+
+	float invDet = 1.0f / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+	float r[16];
+
+	r[0 ] = ( m[5 ] * c5 - m[6 ] * c4 + m[7 ] * c3) * invDet;
+	r[1 ] = (-m[1 ] * c5 + m[2 ] * c4 - m[3 ] * c3) * invDet;
+	r[2 ] = ( m[13] * s5 - m[14] * s4 + m[15] * s3) * invDet;
+	r[3 ] = (-m[9 ] * s5 + m[10] * s4 - m[11] * s3) * invDet;
+
+	r[4 ] = (-m[4 ] * c5 + m[6 ] * c2 - m[7 ] * c1) * invDet;
+	r[5 ] = ( m[0 ] * c5 - m[2 ] * c2 + m[3 ] * c1) * invDet;
+	r[6 ] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * invDet;
+	r[7 ] = ( m[8 ] * s5 - m[10] * s2 + m[11] * s1) * invDet;
+
+	r[8 ] = ( m[4 ] * c4 - m[5 ] * c2 + m[7 ] * c0) * invDet;
+	r[9 ] = (-m[0 ] * c4 + m[1 ] * c2 - m[3 ] * c0) * invDet;
+	r[10] = ( m[12] * s4 - m[13] * s2 + m[15] * s0) * invDet;
+	r[11] = (-m[8 ] * s4 + m[9 ] * s2 - m[11] * s0) * invDet;
+
+	r[12] = (-m[4 ] * c3 + m[5 ] * c1 - m[6 ] * c0) * invDet;
+	r[13] = ( m[0 ] * c3 - m[1 ] * c1 + m[2 ] * c0) * invDet;
+	r[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * invDet;
+	r[15] = ( m[8 ] * s3 - m[9 ] * s1 + m[10] * s0) * invDet;
+
+	for (int i = 0; i < 16; i++)
+		out[i] = r[i];
+}
+
+void simd::mat4InverseAffine_scalar(const float* m, float* out)
+{
+	// The rows of the upper 3x3's inverse are the cross products of pairs of its columns, over its determinant.
+	float r[16];
+
+	r[0 ] = m[5] * m[10] - m[6] * m[9 ];
+	r[4 ] = m[6] * m[8 ] - m[4] * m[10];
+	r[8 ] = m[4] * m[9 ] - m[5] * m[8 ];
+
+	float invDet = 1.0f / (m[0] * r[0] + m[1] * r[4] + m[2] * r[8]);
+
+	r[0 ] *= invDet;
+	r[4 ] *= invDet;
+	r[8 ] *= invDet;
+
+	r[1 ] = (m[9 ] * m[2] - m[10] * m[1]) * invDet;
+	r[5 ] = (m[10] * m[0] - m[8 ] * m[2]) * invDet;
+	r[9 ] = (m[8 ] * m[1] - m[9 ] * m[0]) * invDet;
+
+	r[2 ] = (m[1] * m[6] - m[2] * m[5]) * invDet;
+	r[6 ] = (m[2] * m[4] - m[0] * m[6]) * invDet;
+	r[10] = (m[0] * m[5] - m[1] * m[4]) * invDet;
+
+	// ... and the translation is the original translation taken back through that inverse.
+	r[12] = -(r[0] * m[12] + r[4] * m[13] + r[8 ] * m[14]);
+	r[13] = -(r[1] * m[12] + r[5] * m[13] + r[9 ] * m[14]);
+	r[14] = -(r[2] * m[12] + r[6] * m[13] + r[10] * m[14]);
+
+	r[3] = r[7] = r[11] = 0.0f;
+	r[15] = 1.0f;
+
+	for (int i = 0; i < 16; i++)
+		out[i] = r[i];
+}
+
+void simd::mat4InverseRigid_scalar(const float* m, float* out)
+{
+	// An orthonormal matrix's inverse is its transpose.
+	float r[16];
+
+	r[0] = m[0]; r[4] = m[1]; r[8 ] = m[2 ];
+	r[1] = m[4]; r[5] = m[5]; r[9 ] = m[6 ];
+	r[2] = m[8]; r[6] = m[9]; r[10] = m[10];
+
+	r[12] = -(m[0] * m[12] + m[1] * m[13] + m[2 ] * m[14]);
+	r[13] = -(m[4] * m[12] + m[5] * m[13] + m[6 ] * m[14]);
+	r[14] = -(m[8] * m[12] + m[9] * m[13] + m[10] * m[14]);
+
+	r[3] = r[7] = r[11] = 0.0f;
+	r[15] = 1.0f;
+
+	for (int i = 0; i < 16; i++)
+		out[i] = r[i];
+}
+
+void simd::streamAdd_scalar(const float* a, const float* b, float* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		out[i] = a[i] + b[i];
+}
+
+void simd::streamSubtract_scalar(const float* a, const float* b, float* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		out[i] = a[i] - b[i];
+}
+
+void simd::streamMultiply_scalar(const float* a, const float* b, float* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		out[i] = a[i] * b[i];
+}
+
+void simd::streamScale_scalar(const float* a, float s, float* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		out[i] = a[i] * s;
+}
+
+void simd::streamMultiplyAdd_scalar(const float* a, const float* b, const float* c, float* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		out[i] = a[i] * b[i] + c[i];
+}
+
+void simd::streamScaleAdd_scalar(const float* a, float s, const float* c, float* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		out[i] = a[i] * s + c[i];
+}
+
+void simd::streamDot_scalar(const float* const* a, const float* const* b, int components, float* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		float sum = a[0][i] * b[0][i];
+		for (int c = 1; c < components; c++)
+			sum += a[c][i] * b[c][i];
+
+		out[i] = sum;
+	}
+}
+
+void simd::streamLength_scalar(const float* const* v, int components, float* out, size_t count)
+{
+	streamDot_scalar(v, v, components, out, count);
+
+	for (size_t i = 0; i < count; i++)
+		out[i] = std::sqrt(out[i]);
+}
+
+void simd::streamNormalize_scalar(const float* const* in, float* const* out, int components, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		float lengthSquared = in[0][i] * in[0][i];
+		for (int c = 1; c < components; c++)
+			lengthSquared += in[c][i] * in[c][i];
+
+		// One divide per vector rather than per component. The SIMD kernels do the same so that their results agree.
+		float invLength = 1.0f / std::sqrt(lengthSquared);
+
+		for (int c = 0; c < components; c++)
+			out[c][i] = in[c][i] * invLength;
+	}
+}
+
+void simd::streamCross_scalar(const float* const* a, const float* const* b, float* const* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		// Read everything first as out may alias a or b.
+		float ax = a[0][i], ay = a[1][i], az = a[2][i];
+		float bx = b[0][i], by = b[1][i], bz = b[2][i];
+
+		out[0][i] = ay * bz - az * by;
+		out[1][i] = az * bx - ax * bz;
+		out[2][i] = ax * by - ay * bx;
+	}
+}
+
+void simd::sinCos_scalar(const float* angles, float* sines, float* cosines, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		float angle = angles[i];
+
+		sines[i] = std::sin(angle);
+		cosines[i] = std::cos(angle);
+	}
+}
+
+void simd::frustumCullAABB_scalar(const float* planes, const float* boxes, size_t count, uint8_t* result)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		const float* boxMin = boxes + 6 * i;
+		const float* boxMax = boxMin + 3;
+
+		uint8_t visible = 1;
+
+		for (int p = 0; p < 6 && visible; p++)
+		{
+			// Only the corner furthest along the plane's normal needs testing; if that's outside, the whole box is.
+			const float* n = planes + 4 * p;
+			float x = n[0] >= 0.0f ? boxMax[0] : boxMin[0];
+			float y = n[1] >= 0.0f ? boxMax[1] : boxMin[1];
+			float z = n[2] >= 0.0f ? boxMax[2] : boxMin[2];
+
+			if (n[0] * x + n[1] * y + n[2] * z + n[3] < 0.0f)
+				visible = 0;
+		}
+
+		result[i] = visible;
+	}
+}
+
+void simd::rayAABB_scalar(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count)
+{
+	const float* boxMin = shape;
+	const float* boxMax = shape + 3;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		float tNear = 0.0f;
+		float tFar = std::numeric_limits<float>::infinity();
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float origin = origins[axis][i];
+			float inverse = 1.0f / directions[axis][i];
+			float t1 = (boxMin[axis] - origin) * inverse;
+			float t2 = (boxMax[axis] - origin) * inverse;
+
+			// A ray starting exactly on a slab's plane and parallel to it gives a NaN distance. Putting the distances first makes min and max
+			// ... return tNear or tFar instead, so the slab is ignored.
+			tNear = selectMax(selectMin(t1, t2), tNear);
+			tFar = selectMin(selectMax(t1, t2), tFar);
+		}
+
+		t[i] = tNear <= tFar ? tNear : std::numeric_limits<float>::infinity();
+	}
+}
+
+void simd::raySphere_scalar(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count)
+{
+	const float radiusSquared = shape[3] * shape[3];
+
+	for (size_t i = 0; i < count; i++)
+	{
+		float dx = directions[0][i], dy = directions[1][i], dz = directions[2][i];
+
+		// Solve |o + t d - c|^2 = r^2 for t, with b being half the usual linear coefficient.
+		float ocx = origins[0][i] - shape[0], ocy = origins[1][i] - shape[1], ocz = origins[2][i] - shape[2];
+
+		float a = dx * dx + dy * dy + dz * dz;
+		float b = ocx * dx + ocy * dy + ocz * dz;
+		float c = (ocx * ocx + ocy * ocy + ocz * ocz) - radiusSquared;
+		float discriminant = b * b - a * c;
+
+		float root = std::sqrt(selectMax(discriminant, 0.0f));
+		float tNear = (0.0f - (b + root)) / a;
+		float tFar = (root - b) / a;
+
+		t[i] = discriminant >= 0.0f && tFar >= 0.0f ? selectMax(tNear, 0.0f) : std::numeric_limits<float>::infinity();
+	}
+}
+
+void simd::rayTriangle_scalar(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count)
+{
+	const float e1x = shape[3] - shape[0], e1y = shape[4] - shape[1], e1z = shape[5] - shape[2];
+	const float e2x = shape[6] - shape[0], e2y = shape[7] - shape[1], e2z = shape[8] - shape[2];
+
+	for (size_t i = 0; i < count; i++)
+	{
+		float dx = directions[0][i], dy = directions[1][i], dz = directions[2][i];
+
+		// Moller-Trumbore: solve o + t d = a + u e1 + v e2 by Cramer's rule, sharing the cross products p = d x e2 and q = s x e1.
+		float px = dy * e2z - dz * e2y;
+		float py = dz * e2x - dx * e2z;
+		float pz = dx * e2y - dy * e2x;
+		float det = e1x * px + e1y * py + e1z * pz;
+		float inverse = 1.0f / det;
+
+		float sx = origins[0][i] - shape[0], sy = origins[1][i] - shape[1], sz = origins[2][i] - shape[2];
+		float u = (sx * px + sy * py + sz * pz) * inverse;
+
+		float qx = sy * e1z - sz * e1y;
+		float qy = sz * e1x - sx * e1z;
+		float qz = sx * e1y - sy * e1x;
+		float v = (dx * qx + dy * qy + dz * qz) * inverse;
+		float tHit = (e2x * qx + e2y * qy + e2z * qz) * inverse;
+
+		bool hit = std::fabs(det) > RAY_TRIANGLE_EPSILON && u >= 0.0f && v >= 0.0f && u + v <= 1.0f && tHit >= 0.0f;
+		t[i] = hit ? tHit : std::numeric_limits<float>::infinity();
+	}
+}
+
+void simd::sphereScreenSize_scalar(const float* const* centres, const float* radii, const float* camera, float* out, size_t count)
+{
+	// The smallest normal float keeps a sphere of zero radius around the eye from dividing 0 by 0.
+	const float minDistance = std::numeric_limits<float>::min();
+
+	for (size_t i = 0; i < count; i++)
+	{
+		float dx = centres[0][i] - camera[0], dy = centres[1][i] - camera[1], dz = centres[2][i] - camera[2];
+		float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+		out[i] = radii[i] * camera[3] / selectMax(selectMax(distance, radii[i]), minDistance);
+	}
+}
\ No newline at end of file
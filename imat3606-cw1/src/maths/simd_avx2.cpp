@@ -0,0 +1,601 @@
+/*!
+ * @file simd_avx2.cpp
+ * @brief Implementation file for the AVX2 (with FMA) maths kernels.
+ * @author George McDonagh */
+
+
+// Local includes
+
+#include "maths/simd.h"
+
+#ifdef ENGINE_SIMD_X86
+
+
+// External includes
+
+#include <immintrin.h>
+#include <limits>
+
+
+// Namespaces
+
+using namespace engine::maths;
+
+
+// Broadcast element i of each 128-bit lane across that lane.
+#define SPLAT_LANES(v, i) _mm256_shuffle_ps(v, v, _MM_SHUFFLE(i, i, i, i))
+
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::mat4Mul_avx2(const float* a, const float* b, float* out)
+{
+	// Each of a's columns is duplicated in to both lanes so that two output columns are produced per iteration.
+	__m256 a0 = _mm256_broadcast_ps((const __m128*)(a));
+	__m256 a1 = _mm256_broadcast_ps((const __m128*)(a + 4));
+	__m256 a2 = _mm256_broadcast_ps((const __m128*)(a + 8));
+	__m256 a3 = _mm256_broadcast_ps((const __m128*)(a + 12));
+
+	for (int cols = 0; cols < 2; cols++)
+	{
+		__m256 bc = _mm256_loadu_ps(b + 8 * cols);
+
+		__m256 r = _mm256_mul_ps(a0, SPLAT_LANES(bc, 0));
+		r = _mm256_fmadd_ps(a1, SPLAT_LANES(bc, 1), r);
+		r = _mm256_fmadd_ps(a2, SPLAT_LANES(bc, 2), r);
+		r = _mm256_fmadd_ps(a3, SPLAT_LANES(bc, 3), r);
+
+		_mm256_storeu_ps(out + 8 * cols, r);
+	}
+}
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::mat4MulVec4_avx2(const float* m, const float* v, float* out)
+{
+	__m128 vv = _mm_loadu_ps(v);
+
+	// [x x x x | y y y y] and [z z z z | w w w w] against columns [0 | 1] and [2 | 3].
+	// ... AVX2's cross-lane permute builds both straight from the vector.
+	__m256 v2 = _mm256_castps128_ps256(vv);
+	__m256 vxy = _mm256_permutevar8x32_ps(v2, _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1));
+	__m256 vzw = _mm256_permutevar8x32_ps(v2, _mm256_setr_epi32(2, 2, 2, 2, 3, 3, 3, 3));
+
+	__m256 r = _mm256_fmadd_ps(_mm256_loadu_ps(m + 8), vzw, _mm256_mul_ps(_mm256_loadu_ps(m), vxy));
+
+	_mm_storeu_ps(out, _mm_add_ps(_mm256_castps256_ps128(r), _mm256_extractf128_ps(r, 1)));
+}
+
+namespace {
+
+	// Load two unaligned groups of four floats in to the low and high lanes.
+	ENGINE_SIMD_TARGET("avx2,fma")
+	inline __m256 loadLanes(const float* lo, const float* hi)
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lo)), _mm_loadu_ps(hi), 1);
+	}
+
+	// Store the low and high lanes to two unaligned groups of four floats.
+	ENGINE_SIMD_TARGET("avx2,fma")
+	inline void storeLanes(float* lo, float* hi, __m256 v)
+	{
+		_mm_storeu_ps(lo, _mm256_castps256_ps128(v));
+		_mm_storeu_ps(hi, _mm256_extractf128_ps(v, 1));
+	}
+
+	// Shuffle packed XYZ triples in to X, Y, and Z vectors. Each lane holds four triples (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3).
+	ENGINE_SIMD_TARGET("avx2,fma")
+	inline void deinterleave3(__m256 v0, __m256 v1, __m256 v2, __m256& x, __m256& y, __m256& z)
+	{
+		__m256 t = _mm256_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 1, 3, 2)); // x2 y2 x3 y3
+		__m256 u = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 0, 2, 1)); // y0 z0 y1 z1
+
+		x = _mm256_shuffle_ps(v0, t, _MM_SHUFFLE(2, 0, 3, 0));
+		y = _mm256_shuffle_ps(u, t, _MM_SHUFFLE(3, 1, 2, 0));
+		z = _mm256_shuffle_ps(u, v2, _MM_SHUFFLE(3, 0, 3, 1));
+	}
+
+	// The inverse of deinterleave3.
+	ENGINE_SIMD_TARGET("avx2,fma")
+	inline void interleave3(__m256 x, __m256 y, __m256 z, __m256& v0, __m256& v1, __m256& v2)
+	{
+		__m256 xy01 = _mm256_unpacklo_ps(x, y);
+		__m256 xy23 = _mm256_unpackhi_ps(x, y);
+
+		v0 = _mm256_shuffle_ps(xy01, _mm256_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+		v1 = _mm256_shuffle_ps(_mm256_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xy23, _MM_SHUFFLE(1, 0, 2, 0));
+
+		__m256 t = _mm256_shuffle_ps(z, xy23, _MM_SHUFFLE(3, 2, 3, 2));
+		v2 = _mm256_shuffle_ps(t, t, _MM_SHUFFLE(1, 3, 2, 0));
+	}
+
+	// Transform eight vectors held as X, Y, and Z vectors by the matrix's upper 3x4, where t holds the translation pre-multiplied by w.
+	ENGINE_SIMD_TARGET("avx2,fma")
+	inline void transform8(const __m256 m[9], const __m256 t[3], __m256& x, __m256& y, __m256& z)
+	{
+		__m256 ox = _mm256_add_ps(_mm256_fmadd_ps(m[6], z, _mm256_fmadd_ps(m[3], y, _mm256_mul_ps(m[0], x))), t[0]);
+		__m256 oy = _mm256_add_ps(_mm256_fmadd_ps(m[7], z, _mm256_fmadd_ps(m[4], y, _mm256_mul_ps(m[1], x))), t[1]);
+		__m256 oz = _mm256_add_ps(_mm256_fmadd_ps(m[8], z, _mm256_fmadd_ps(m[5], y, _mm256_mul_ps(m[2], x))), t[2]);
+
+		x = ox;
+		y = oy;
+		z = oz;
+	}
+
+	ENGINE_SIMD_TARGET("avx2,fma")
+	inline void splatMatrix(const float* m, float w, __m256 cols[9], __m256 t[3])
+	{
+		for (int col = 0; col < 3; col++)
+			for (int row = 0; row < 3; row++)
+				cols[3 * col + row] = _mm256_set1_ps(m[4 * col + row]);
+
+		for (int row = 0; row < 3; row++)
+			t[row] = _mm256_set1_ps(m[12 + row] * w);
+	}
+
+}
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::transformVec3_avx2(const float* m, const float* in, float* out, size_t count, float w)
+{
+	__m256 cols[9], t[3];
+	splatMatrix(m, w, cols, t);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		// Points 0-3 go in the low lanes, points 4-7 in the high lanes.
+		const float* src = in + 3 * i;
+		float* dst = out + 3 * i;
+
+		__m256 x, y, z;
+		deinterleave3(loadLanes(src, src + 12), loadLanes(src + 4, src + 16), loadLanes(src + 8, src + 20), x, y, z);
+		transform8(cols, t, x, y, z);
+
+		__m256 v0, v1, v2;
+		interleave3(x, y, z, v0, v1, v2);
+		storeLanes(dst, dst + 12, v0);
+		storeLanes(dst + 4, dst + 16, v1);
+		storeLanes(dst + 8, dst + 20, v2);
+	}
+
+	transformVec3_scalar(m, in + 3 * i, out + 3 * i, count - i, w);
+}
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::transformSoA_avx2(const float* m, const float* inX, const float* inY, const float* inZ, float* outX, float* outY, float* outZ, size_t count, float w)
+{
+	__m256 cols[9], t[3];
+	splatMatrix(m, w, cols, t);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 x = _mm256_loadu_ps(inX + i);
+		__m256 y = _mm256_loadu_ps(inY + i);
+		__m256 z = _mm256_loadu_ps(inZ + i);
+
+		transform8(cols, t, x, y, z);
+
+		_mm256_storeu_ps(outX + i, x);
+		_mm256_storeu_ps(outY + i, y);
+		_mm256_storeu_ps(outZ + i, z);
+	}
+
+	transformSoA_scalar(m, inX + i, inY + i, inZ + i, outX + i, outY + i, outZ + i, count - i, w);
+}
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::streamMultiplyAdd_avx2(const float* a, const float* b, const float* c, float* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+		_mm256_storeu_ps(out + i, _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), _mm256_loadu_ps(c + i)));
+
+	streamMultiplyAdd_scalar(a + i, b + i, c + i, out + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::streamScaleAdd_avx2(const float* a, float s, const float* c, float* out, size_t count)
+{
+	__m256 vs = _mm256_set1_ps(s);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+		_mm256_storeu_ps(out + i, _mm256_fmadd_ps(_mm256_loadu_ps(a + i), vs, _mm256_loadu_ps(c + i)));
+
+	streamScaleAdd_scalar(a + i, s, c + i, out + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::streamDot_avx2(const float* const* a, const float* const* b, int components, float* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 sum = _mm256_mul_ps(_mm256_loadu_ps(a[0] + i), _mm256_loadu_ps(b[0] + i));
+		for (int c = 1; c < components; c++)
+			sum = _mm256_fmadd_ps(_mm256_loadu_ps(a[c] + i), _mm256_loadu_ps(b[c] + i), sum);
+
+		_mm256_storeu_ps(out + i, sum);
+	}
+
+	const float* tailA[4];
+	const float* tailB[4];
+	for (int c = 0; c < components; c++)
+	{
+		tailA[c] = a[c] + i;
+		tailB[c] = b[c] + i;
+	}
+
+	streamDot_scalar(tailA, tailB, components, out + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::streamLength_avx2(const float* const* v, int components, float* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 v0 = _mm256_loadu_ps(v[0] + i);
+		__m256 sum = _mm256_mul_ps(v0, v0);
+		for (int c = 1; c < components; c++)
+		{
+			__m256 vc = _mm256_loadu_ps(v[c] + i);
+			sum = _mm256_fmadd_ps(vc, vc, sum);
+		}
+
+		_mm256_storeu_ps(out + i, _mm256_sqrt_ps(sum));
+	}
+
+	const float* tail[4];
+	for (int c = 0; c < components; c++)
+		tail[c] = v[c] + i;
+
+	streamLength_scalar(tail, components, out + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::streamNormalize_avx2(const float* const* in, float* const* out, int components, size_t count)
+{
+	const __m256 one = _mm256_set1_ps(1.0f);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 v0 = _mm256_loadu_ps(in[0] + i);
+		__m256 lengthSquared = _mm256_mul_ps(v0, v0);
+		for (int c = 1; c < components; c++)
+		{
+			__m256 vc = _mm256_loadu_ps(in[c] + i);
+			lengthSquared = _mm256_fmadd_ps(vc, vc, lengthSquared);
+		}
+
+		// A full precision divide rather than the approximate reciprocal square root, so the results match the scalar kernel.
+		__m256 invLength = _mm256_div_ps(one, _mm256_sqrt_ps(lengthSquared));
+
+		for (int c = 0; c < components; c++)
+			_mm256_storeu_ps(out[c] + i, _mm256_mul_ps(_mm256_loadu_ps(in[c] + i), invLength));
+	}
+
+	const float* tailIn[4];
+	float* tailOut[4];
+	for (int c = 0; c < components; c++)
+	{
+		tailIn[c] = in[c] + i;
+		tailOut[c] = out[c] + i;
+	}
+
+	streamNormalize_scalar(tailIn, tailOut, components, count - i);
+}
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::streamCross_avx2(const float* const* a, const float* const* b, float* const* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		// Everything is loaded before anything is stored, so out may alias a or b.
+		__m256 ax = _mm256_loadu_ps(a[0] + i), ay = _mm256_loadu_ps(a[1] + i), az = _mm256_loadu_ps(a[2] + i);
+		__m256 bx = _mm256_loadu_ps(b[0] + i), by = _mm256_loadu_ps(b[1] + i), bz = _mm256_loadu_ps(b[2] + i);
+
+		_mm256_storeu_ps(out[0] + i, _mm256_fmsub_ps(ay, bz, _mm256_mul_ps(az, by)));
+		_mm256_storeu_ps(out[1] + i, _mm256_fmsub_ps(az, bx, _mm256_mul_ps(ax, bz)));
+		_mm256_storeu_ps(out[2] + i, _mm256_fmsub_ps(ax, by, _mm256_mul_ps(ay, bx)));
+	}
+
+	const float* tailA[3] = { a[0] + i, a[1] + i, a[2] + i };
+	const float* tailB[3] = { b[0] + i, b[1] + i, b[2] + i };
+	float* tailOut[3] = { out[0] + i, out[1] + i, out[2] + i };
+
+	streamCross_scalar(tailA, tailB, tailOut, count - i);
+}
+
+namespace {
+
+	ENGINE_SIMD_TARGET("avx2,fma")
+	inline void sinCos8(__m256 x, __m256& sines, __m256& cosines)
+	{
+		using namespace simd::sinCosConstants;
+
+		// Work with |x| and put the sign back on the sine at the end.
+		const __m256 signMask = _mm256_set1_ps(-0.0f);
+		__m256 sinSign = _mm256_and_ps(x, signMask);
+		x = _mm256_andnot_ps(signMask, x);
+
+		// The octant, rounded up to an even number so that x is reduced in to [-pi/4, pi/4].
+		__m256i j = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(FOUR_OVER_PI)));
+		j = _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+		__m256 y = _mm256_cvtepi32_ps(j);
+
+		// Modulo 8, a rounded octant of 4 or 6 flips the sine, 2 or 4 flips the cosine, and 2 or 6 swaps the sine and cosine polynomials.
+		sinSign = _mm256_xor_ps(sinSign, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, _mm256_set1_epi32(4)), 29)));
+		__m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29));
+		__m256 sinPoly = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, _mm256_set1_epi32(2)), _mm256_setzero_si256()));
+
+		x = _mm256_fnmadd_ps(y, _mm256_set1_ps(PI_OVER_4_A), x);
+		x = _mm256_fnmadd_ps(y, _mm256_set1_ps(PI_OVER_4_B), x);
+		x = _mm256_fnmadd_ps(y, _mm256_set1_ps(PI_OVER_4_C), x);
+
+		__m256 z = _mm256_mul_ps(x, x);
+
+		__m256 c = _mm256_fmadd_ps(_mm256_set1_ps(COS_C0), z, _mm256_set1_ps(COS_C1));
+		c = _mm256_fmadd_ps(c, z, _mm256_set1_ps(COS_C2));
+		c = _mm256_mul_ps(_mm256_mul_ps(c, z), z);
+		c = _mm256_add_ps(_mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), c), _mm256_set1_ps(1.0f));
+
+		__m256 s = _mm256_fmadd_ps(_mm256_set1_ps(SIN_S0), z, _mm256_set1_ps(SIN_S1));
+		s = _mm256_fmadd_ps(s, z, _mm256_set1_ps(SIN_S2));
+		s = _mm256_fmadd_ps(_mm256_mul_ps(s, z), x, x);
+
+		sines = _mm256_xor_ps(_mm256_or_ps(_mm256_and_ps(sinPoly, s), _mm256_andnot_ps(sinPoly, c)), sinSign);
+		cosines = _mm256_xor_ps(_mm256_or_ps(_mm256_and_ps(sinPoly, c), _mm256_andnot_ps(sinPoly, s)), cosSign);
+	}
+
+}
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::sinCos_avx2(const float* angles, float* sines, float* cosines, size_t count)
+{
+	__m256 s, c;
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		sinCos8(_mm256_loadu_ps(angles + i), s, c);
+		_mm256_storeu_ps(sines + i, s);
+		_mm256_storeu_ps(cosines + i, c);
+	}
+
+	if (i == count)
+		return;
+
+	// Pad the tail out to a full register rather than falling back to the scalar kernel, so every angle gets the same polynomial.
+	float tail[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+	for (size_t t = 0; i + t < count; t++)
+		tail[t] = angles[i + t];
+
+	float tailSines[8], tailCosines[8];
+	sinCos8(_mm256_loadu_ps(tail), s, c);
+	_mm256_storeu_ps(tailSines, s);
+	_mm256_storeu_ps(tailCosines, c);
+
+	for (size_t t = 0; i + t < count; t++)
+	{
+		sines[i + t] = tailSines[t];
+		cosines[i + t] = tailCosines[t];
+	}
+}
+
+
+namespace {
+
+	// Load four floats from each of eight boxes, 6 floats apart, and transpose them so that c0 holds every box's first float and so on.
+	ENGINE_SIMD_TARGET("avx2,fma")
+	inline void transpose8(const float* b, __m256& c0, __m256& c1, __m256& c2, __m256& c3)
+	{
+		__m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(b)), _mm_loadu_ps(b + 24), 1);
+		__m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(b + 6)), _mm_loadu_ps(b + 30), 1);
+		__m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(b + 12)), _mm_loadu_ps(b + 36), 1);
+		__m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(b + 18)), _mm_loadu_ps(b + 42), 1);
+
+		__m256 t0 = _mm256_unpacklo_ps(r0, r1);
+		__m256 t1 = _mm256_unpackhi_ps(r0, r1);
+		__m256 t2 = _mm256_unpacklo_ps(r2, r3);
+		__m256 t3 = _mm256_unpackhi_ps(r2, r3);
+
+		c0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+		c1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+		c2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+		c3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+	}
+
+}
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::frustumCullAABB_avx2(const float* planes, const float* boxes, size_t count, uint8_t* result)
+{
+	__m256 normals[6][3], distances[6];
+	bool positive[6][3];
+
+	for (int p = 0; p < 6; p++)
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			normals[p][axis] = _mm256_set1_ps(planes[4 * p + axis]);
+			positive[p][axis] = planes[4 * p + axis] >= 0.0f;
+		}
+
+		distances[p] = _mm256_set1_ps(planes[4 * p + 3]);
+	}
+
+	const __m256 zero = _mm256_setzero_ps();
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		// Transpose eight boxes in to one register per component, boxes 0-3 in the low lane and 4-7 in the high lane. As with the SSE2
+		// ... kernel, each box's first and last four floats are transposed separately so nothing past the last box is read.
+		const float* b = boxes + 6 * i;
+
+		__m256 minX, minY, minZ, maxX, maxY, maxZ, unused;
+		transpose8(b, minX, minY, minZ, unused);
+		transpose8(b + 2, unused, maxX, maxY, maxZ);
+
+		__m256 visible = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+
+		for (int p = 0; p < 6; p++)
+		{
+			// Only the corner furthest along the plane's normal needs testing; if that's outside, the whole box is.
+			__m256 d = _mm256_mul_ps(normals[p][0], positive[p][0] ? maxX : minX);
+			d = _mm256_fmadd_ps(normals[p][1], positive[p][1] ? maxY : minY, d);
+			d = _mm256_fmadd_ps(normals[p][2], positive[p][2] ? maxZ : minZ, d);
+			d = _mm256_add_ps(d, distances[p]);
+
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(d, zero, _CMP_GE_OQ));
+		}
+
+		int mask = _mm256_movemask_ps(visible);
+		for (int k = 0; k < 8; k++)
+			result[i + k] = (mask >> k) & 1;
+	}
+
+	frustumCullAABB_scalar(planes, boxes + 6 * i, count - i, result + i);
+}
+
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::rayAABB_avx2(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count)
+{
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 infinity = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+	const __m256 boxMin[3] = { _mm256_set1_ps(shape[0]), _mm256_set1_ps(shape[1]), _mm256_set1_ps(shape[2]) };
+	const __m256 boxMax[3] = { _mm256_set1_ps(shape[3]), _mm256_set1_ps(shape[4]), _mm256_set1_ps(shape[5]) };
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 tNear = zero, tFar = infinity;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			__m256 origin = _mm256_loadu_ps(origins[axis] + i);
+			__m256 inverse = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_loadu_ps(directions[axis] + i));
+			__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(boxMin[axis], origin), inverse);
+			__m256 t2 = _mm256_mul_ps(_mm256_sub_ps(boxMax[axis], origin), inverse);
+
+			// As in the scalar kernel, the NaN-prone slab distances go first so that min and max return tNear or tFar instead of a NaN.
+			tNear = _mm256_max_ps(_mm256_min_ps(t1, t2), tNear);
+			tFar = _mm256_min_ps(_mm256_max_ps(t1, t2), tFar);
+		}
+
+		_mm256_storeu_ps(t + i, _mm256_or_ps(_mm256_and_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ), tNear), _mm256_andnot_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ), infinity)));
+	}
+
+	const float* originsTail[3] = { origins[0] + i, origins[1] + i, origins[2] + i };
+	const float* directionsTail[3] = { directions[0] + i, directions[1] + i, directions[2] + i };
+	rayAABB_scalar(originsTail, directionsTail, shape, t + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::raySphere_avx2(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count)
+{
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 infinity = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+	const __m256 cx = _mm256_set1_ps(shape[0]), cy = _mm256_set1_ps(shape[1]), cz = _mm256_set1_ps(shape[2]);
+	const __m256 radiusSquared = _mm256_set1_ps(shape[3] * shape[3]);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 ox = _mm256_loadu_ps(origins[0] + i), oy = _mm256_loadu_ps(origins[1] + i), oz = _mm256_loadu_ps(origins[2] + i);
+		__m256 dx = _mm256_loadu_ps(directions[0] + i), dy = _mm256_loadu_ps(directions[1] + i), dz = _mm256_loadu_ps(directions[2] + i);
+
+		// Solve |o + t d - c|^2 = r^2 for t, with b being half the usual linear coefficient.
+		__m256 ocx = _mm256_sub_ps(ox, cx), ocy = _mm256_sub_ps(oy, cy), ocz = _mm256_sub_ps(oz, cz);
+
+		__m256 a = _mm256_fmadd_ps(dz, dz, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx)));
+		__m256 b = _mm256_fmadd_ps(ocz, dz, _mm256_fmadd_ps(ocy, dy, _mm256_mul_ps(ocx, dx)));
+		__m256 c = _mm256_sub_ps(_mm256_fmadd_ps(ocz, ocz, _mm256_fmadd_ps(ocy, ocy, _mm256_mul_ps(ocx, ocx))), radiusSquared);
+		__m256 discriminant = _mm256_fmsub_ps(b, b, _mm256_mul_ps(a, c));
+
+		__m256 root = _mm256_sqrt_ps(_mm256_max_ps(discriminant, zero));
+		__m256 tNear = _mm256_div_ps(_mm256_sub_ps(zero, _mm256_add_ps(b, root)), a);
+		__m256 tFar = _mm256_div_ps(_mm256_sub_ps(root, b), a);
+
+		__m256 hit = _mm256_and_ps(_mm256_cmp_ps(discriminant, zero, _CMP_GE_OQ), _mm256_cmp_ps(tFar, zero, _CMP_GE_OQ));
+		_mm256_storeu_ps(t + i, _mm256_or_ps(_mm256_and_ps(hit, _mm256_max_ps(tNear, zero)), _mm256_andnot_ps(hit, infinity)));
+	}
+
+	const float* originsTail[3] = { origins[0] + i, origins[1] + i, origins[2] + i };
+	const float* directionsTail[3] = { directions[0] + i, directions[1] + i, directions[2] + i };
+	raySphere_scalar(originsTail, directionsTail, shape, t + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::rayTriangle_avx2(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count)
+{
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 infinity = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+	const __m256 epsilon = _mm256_set1_ps(RAY_TRIANGLE_EPSILON);
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	const __m256 ax = _mm256_set1_ps(shape[0]), ay = _mm256_set1_ps(shape[1]), az = _mm256_set1_ps(shape[2]);
+	const __m256 e1x = _mm256_set1_ps(shape[3] - shape[0]), e1y = _mm256_set1_ps(shape[4] - shape[1]), e1z = _mm256_set1_ps(shape[5] - shape[2]);
+	const __m256 e2x = _mm256_set1_ps(shape[6] - shape[0]), e2y = _mm256_set1_ps(shape[7] - shape[1]), e2z = _mm256_set1_ps(shape[8] - shape[2]);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 ox = _mm256_loadu_ps(origins[0] + i), oy = _mm256_loadu_ps(origins[1] + i), oz = _mm256_loadu_ps(origins[2] + i);
+		__m256 dx = _mm256_loadu_ps(directions[0] + i), dy = _mm256_loadu_ps(directions[1] + i), dz = _mm256_loadu_ps(directions[2] + i);
+
+		// Moller-Trumbore: solve o + t d = a + u e1 + v e2 by Cramer's rule, sharing the cross products p = d x e2 and q = s x e1.
+		__m256 px = _mm256_fmsub_ps(dy, e2z, _mm256_mul_ps(dz, e2y));
+		__m256 py = _mm256_fmsub_ps(dz, e2x, _mm256_mul_ps(dx, e2z));
+		__m256 pz = _mm256_fmsub_ps(dx, e2y, _mm256_mul_ps(dy, e2x));
+		__m256 det = _mm256_fmadd_ps(e1z, pz, _mm256_fmadd_ps(e1y, py, _mm256_mul_ps(e1x, px)));
+		__m256 inverse = _mm256_div_ps(one, det);
+
+		__m256 sx = _mm256_sub_ps(ox, ax), sy = _mm256_sub_ps(oy, ay), sz = _mm256_sub_ps(oz, az);
+		__m256 u = _mm256_mul_ps(_mm256_fmadd_ps(sz, pz, _mm256_fmadd_ps(sy, py, _mm256_mul_ps(sx, px))), inverse);
+
+		__m256 qx = _mm256_fmsub_ps(sy, e1z, _mm256_mul_ps(sz, e1y));
+		__m256 qy = _mm256_fmsub_ps(sz, e1x, _mm256_mul_ps(sx, e1z));
+		__m256 qz = _mm256_fmsub_ps(sx, e1y, _mm256_mul_ps(sy, e1x));
+		__m256 v = _mm256_mul_ps(_mm256_fmadd_ps(dz, qz, _mm256_fmadd_ps(dy, qy, _mm256_mul_ps(dx, qx))), inverse);
+		__m256 tHit = _mm256_mul_ps(_mm256_fmadd_ps(e2z, qz, _mm256_fmadd_ps(e2y, qy, _mm256_mul_ps(e2x, qx))), inverse);
+
+		__m256 hit = _mm256_cmp_ps(_mm256_andnot_ps(signMask, det), epsilon, _CMP_GT_OQ);
+		hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(v, zero, _CMP_GE_OQ)));
+		hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ), _mm256_cmp_ps(tHit, zero, _CMP_GE_OQ)));
+		_mm256_storeu_ps(t + i, _mm256_or_ps(_mm256_and_ps(hit, tHit), _mm256_andnot_ps(hit, infinity)));
+	}
+
+	const float* originsTail[3] = { origins[0] + i, origins[1] + i, origins[2] + i };
+	const float* directionsTail[3] = { directions[0] + i, directions[1] + i, directions[2] + i };
+	rayTriangle_scalar(originsTail, directionsTail, shape, t + i, count - i);
+}
+
+#endif
+
+ENGINE_SIMD_TARGET("avx2,fma")
+void simd::sphereScreenSize_avx2(const float* const* centres, const float* radii, const float* camera, float* out, size_t count)
+{
+	const __m256 minDistance = _mm256_set1_ps(std::numeric_limits<float>::min());
+	const __m256 ex = _mm256_set1_ps(camera[0]), ey = _mm256_set1_ps(camera[1]), ez = _mm256_set1_ps(camera[2]);
+	const __m256 scale = _mm256_set1_ps(camera[3]);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(centres[0] + i), ex);
+		__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(centres[1] + i), ey);
+		__m256 dz = _mm256_sub_ps(_mm256_loadu_ps(centres[2] + i), ez);
+		__m256 radius = _mm256_loadu_ps(radii + i);
+
+		__m256 distance = _mm256_sqrt_ps(_mm256_fmadd_ps(dz, dz, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx))));
+		_mm256_storeu_ps(out + i, _mm256_div_ps(_mm256_mul_ps(radius, scale), _mm256_max_ps(_mm256_max_ps(distance, radius), minDistance)));
+	}
+
+	const float* tail[3] = { centres[0] + i, centres[1] + i, centres[2] + i };
+	sphereScreenSize_scalar(tail, radii + i, camera, out + i, count - i);
+}
\ No newline at end of file
@@ -0,0 +1,765 @@
+/*!
+ * @file simd_sse2.cpp
+ * @brief Implementation file for the SSE2 maths kernels.
+ * @author George McDonagh */
+
+
+// Local includes
+
+#include "maths/simd.h"
+
+#ifdef ENGINE_SIMD_X86
+
+
+// External includes
+
+#include <emmintrin.h>
+#include <limits>
+
+
+// Namespaces
+
+using namespace engine::maths;
+
+
+#define SPLAT(v, i) _mm_shuffle_ps(v, v, _MM_SHUFFLE(i, i, i, i))
+
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::mat4Mul_sse2(const float* a, const float* b, float* out)
+{
+	// All of a's columns are loaded up front and each of b's columns is loaded before the matching output column is
+	// ... written, so out is free to alias either input.
+	__m128 a0 = _mm_loadu_ps(a);
+	__m128 a1 = _mm_loadu_ps(a + 4);
+	__m128 a2 = _mm_loadu_ps(a + 8);
+	__m128 a3 = _mm_loadu_ps(a + 12);
+
+	for (int col = 0; col < 4; col++)
+	{
+		__m128 bc = _mm_loadu_ps(b + 4 * col);
+
+		__m128 r = _mm_mul_ps(a0, SPLAT(bc, 0));
+		r = _mm_add_ps(r, _mm_mul_ps(a1, SPLAT(bc, 1)));
+		r = _mm_add_ps(r, _mm_mul_ps(a2, SPLAT(bc, 2)));
+		r = _mm_add_ps(r, _mm_mul_ps(a3, SPLAT(bc, 3)));
+
+		_mm_storeu_ps(out + 4 * col, r);
+	}
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::mat4MulVec4_sse2(const float* m, const float* v, float* out)
+{
+	__m128 vv = _mm_loadu_ps(v);
+
+	__m128 r = _mm_mul_ps(_mm_loadu_ps(m), SPLAT(vv, 0));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 4), SPLAT(vv, 1)));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 8), SPLAT(vv, 2)));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 12), SPLAT(vv, 3)));
+
+	_mm_storeu_ps(out, r);
+}
+
+namespace {
+
+	// Shuffle four packed XYZ triples (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) in to X, Y, and Z vectors.
+	ENGINE_SIMD_TARGET("sse2")
+	inline void deinterleave3(__m128 v0, __m128 v1, __m128 v2, __m128& x, __m128& y, __m128& z)
+	{
+		__m128 t = _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 1, 3, 2)); // x2 y2 x3 y3
+		__m128 u = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 0, 2, 1)); // y0 z0 y1 z1
+
+		x = _mm_shuffle_ps(v0, t, _MM_SHUFFLE(2, 0, 3, 0));
+		y = _mm_shuffle_ps(u, t, _MM_SHUFFLE(3, 1, 2, 0));
+		z = _mm_shuffle_ps(u, v2, _MM_SHUFFLE(3, 0, 3, 1));
+	}
+
+	// The inverse of deinterleave3.
+	ENGINE_SIMD_TARGET("sse2")
+	inline void interleave3(__m128 x, __m128 y, __m128 z, __m128& v0, __m128& v1, __m128& v2)
+	{
+		__m128 xy01 = _mm_unpacklo_ps(x, y);
+		__m128 xy23 = _mm_unpackhi_ps(x, y);
+
+		v0 = _mm_shuffle_ps(xy01, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+		v1 = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xy23, _MM_SHUFFLE(1, 0, 2, 0));
+
+		__m128 t = _mm_shuffle_ps(z, xy23, _MM_SHUFFLE(3, 2, 3, 2));
+		v2 = _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 3, 2, 0));
+	}
+
+	// Transform four vectors held as X, Y, and Z vectors by the matrix's upper 3x4, where t holds the translation pre-multiplied by w.
+	ENGINE_SIMD_TARGET("sse2")
+	inline void transform4(const __m128 m[9], const __m128 t[3], __m128& x, __m128& y, __m128& z)
+	{
+		__m128 ox = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0], x), _mm_mul_ps(m[3], y)), _mm_mul_ps(m[6], z)), t[0]);
+		__m128 oy = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[1], x), _mm_mul_ps(m[4], y)), _mm_mul_ps(m[7], z)), t[1]);
+		__m128 oz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[2], x), _mm_mul_ps(m[5], y)), _mm_mul_ps(m[8], z)), t[2]);
+
+		x = ox;
+		y = oy;
+		z = oz;
+	}
+
+	ENGINE_SIMD_TARGET("sse2")
+	inline void splatMatrix(const float* m, float w, __m128 cols[9], __m128 t[3])
+	{
+		for (int col = 0; col < 3; col++)
+			for (int row = 0; row < 3; row++)
+				cols[3 * col + row] = _mm_set1_ps(m[4 * col + row]);
+
+		for (int row = 0; row < 3; row++)
+			t[row] = _mm_set1_ps(m[12 + row] * w);
+	}
+
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::transformVec3_sse2(const float* m, const float* in, float* out, size_t count, float w)
+{
+	__m128 cols[9], t[3];
+	splatMatrix(m, w, cols, t);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const float* src = in + 3 * i;
+		float* dst = out + 3 * i;
+
+		__m128 x, y, z;
+		deinterleave3(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x, y, z);
+		transform4(cols, t, x, y, z);
+
+		__m128 v0, v1, v2;
+		interleave3(x, y, z, v0, v1, v2);
+		_mm_storeu_ps(dst, v0);
+		_mm_storeu_ps(dst + 4, v1);
+		_mm_storeu_ps(dst + 8, v2);
+	}
+
+	transformVec3_scalar(m, in + 3 * i, out + 3 * i, count - i, w);
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::transformSoA_sse2(const float* m, const float* inX, const float* inY, const float* inZ, float* outX, float* outY, float* outZ, size_t count, float w)
+{
+	__m128 cols[9], t[3];
+	splatMatrix(m, w, cols, t);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(inX + i);
+		__m128 y = _mm_loadu_ps(inY + i);
+		__m128 z = _mm_loadu_ps(inZ + i);
+
+		transform4(cols, t, x, y, z);
+
+		_mm_storeu_ps(outX + i, x);
+		_mm_storeu_ps(outY + i, y);
+		_mm_storeu_ps(outZ + i, z);
+	}
+
+	transformSoA_scalar(m, inX + i, inY + i, inZ + i, outX + i, outY + i, outZ + i, count - i, w);
+}
+
+namespace {
+
+	#define SWIZZLE(v, x, y, z, w) _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x))
+	#define SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+
+	// 2x2 matrices are held as (m00 m01 m10 m11).
+
+	// a * b
+	ENGINE_SIMD_TARGET("sse2")
+	inline __m128 mat2Mul(__m128 a, __m128 b)
+	{
+		return _mm_add_ps(_mm_mul_ps(a, SWIZZLE(b, 0, 3, 0, 3)), _mm_mul_ps(SWIZZLE(a, 1, 0, 3, 2), SWIZZLE(b, 2, 1, 2, 1)));
+	}
+
+	// adjugate(a) * b
+	ENGINE_SIMD_TARGET("sse2")
+	inline __m128 mat2AdjMul(__m128 a, __m128 b)
+	{
+		return _mm_sub_ps(_mm_mul_ps(SWIZZLE(a, 3, 3, 0, 0), b), _mm_mul_ps(SWIZZLE(a, 1, 1, 2, 2), SWIZZLE(b, 2, 3, 0, 1)));
+	}
+
+	// a * adjugate(b)
+	ENGINE_SIMD_TARGET("sse2")
+	inline __m128 mat2MulAdj(__m128 a, __m128 b)
+	{
+		return _mm_sub_ps(_mm_mul_ps(a, SWIZZLE(b, 3, 0, 3, 0)), _mm_mul_ps(SWIZZLE(a, 1, 0, 3, 2), SWIZZLE(b, 2, 1, 2, 1)));
+	}
+
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::mat4Inverse_sse2(const float* m, float* out)
+{
+	// Block-wise inversion over the four 2x2 sub-matrices:
+	//	M = | A B |		inverse(M) = 1/|M| * | X Y |
+	//		| C D |						 | Z W |
+	// As with the scalar kernel, the storage order doesn't matter because inverse(transpose(M)) == transpose(inverse(M)).
+	__m128 c0 = _mm_loadu_ps(m);
+	__m128 c1 = _mm_loadu_ps(m + 4);
+	__m128 c2 = _mm_loadu_ps(m + 8);
+	__m128 c3 = _mm_loadu_ps(m + 12);
+
+	__m128 a = _mm_movelh_ps(c0, c1);
+	__m128 b = _mm_movehl_ps(c1, c0);
+	__m128 c = _mm_movelh_ps(c2, c3);
+	__m128 d = _mm_movehl_ps(c3, c2);
+
+	// (|A| |B| |C| |D|)
+	__m128 detSub = _mm_sub_ps(
+		_mm_mul_ps(SHUFFLE(c0, c2, 0, 2, 0, 2), SHUFFLE(c1, c3, 1, 3, 1, 3)),
+		_mm_mul_ps(SHUFFLE(c0, c2, 1, 3, 1, 3), SHUFFLE(c1, c3, 0, 2, 0, 2)));
+
+	__m128 detA = SWIZZLE(detSub, 0, 0, 0, 0);
+	__m128 detB = SWIZZLE(detSub, 1, 1, 1, 1);
+	__m128 detC = SWIZZLE(detSub, 2, 2, 2, 2);
+	__m128 detD = SWIZZLE(detSub, 3, 3, 3, 3);
+
+	__m128 dc = mat2AdjMul(d, c);
+	__m128 ab = mat2AdjMul(a, b);
+
+	// The adjugates of X, Y, Z, and W.
+	__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2Mul(b, dc));
+	__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2Mul(c, ab));
+	__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mat2MulAdj(d, ab));
+	__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2MulAdj(a, dc));
+
+	// |M| = |A||D| + |B||C| - trace((A#B)(D#C))
+	__m128 tr = _mm_mul_ps(ab, SWIZZLE(dc, 0, 2, 1, 3));
+	tr = _mm_add_ps(tr, _mm_movehl_ps(tr, tr));
+	tr = _mm_add_ps(tr, SWIZZLE(tr, 1, 0, 0, 0));
+	tr = SWIZZLE(tr, 0, 0, 0, 0);
+
+	__m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+	__m128 rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+
+	x = _mm_mul_ps(x, rDetM);
+	y = _mm_mul_ps(y, rDetM);
+	z = _mm_mul_ps(z, rDetM);
+	w = _mm_mul_ps(w, rDetM);
+
+	// Undo the adjugates and scatter the blocks back in to columns in the same shuffle.
+	_mm_storeu_ps(out, SHUFFLE(x, y, 3, 1, 3, 1));
+	_mm_storeu_ps(out + 4, SHUFFLE(x, y, 2, 0, 2, 0));
+	_mm_storeu_ps(out + 8, SHUFFLE(z, w, 3, 1, 3, 1));
+	_mm_storeu_ps(out + 12, SHUFFLE(z, w, 2, 0, 2, 0));
+}
+
+namespace {
+
+	// The cross product of the XYZ of two vectors, with a W of 0.
+	ENGINE_SIMD_TARGET("sse2")
+	inline __m128 cross3(__m128 a, __m128 b)
+	{
+		return _mm_sub_ps(_mm_mul_ps(SWIZZLE(a, 1, 2, 0, 3), SWIZZLE(b, 2, 0, 1, 3)), _mm_mul_ps(SWIZZLE(a, 2, 0, 1, 3), SWIZZLE(b, 1, 2, 0, 3)));
+	}
+
+	// A column of the upper 3x3 with its W zeroed, so that the columns' transpose has a W of 0 whatever the matrix's bottom row holds.
+	ENGINE_SIMD_TARGET("sse2")
+	inline __m128 loadXYZ(const float* column)
+	{
+		return _mm_and_ps(_mm_loadu_ps(column), _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)));
+	}
+
+	// Store an inverted upper 3x3, given as columns, with the translation taken back through it.
+	ENGINE_SIMD_TARGET("sse2")
+	inline void storeAffine(__m128 c0, __m128 c1, __m128 c2, __m128 t, float* out)
+	{
+		__m128 rt = _mm_mul_ps(c0, SPLAT(t, 0));
+		rt = _mm_add_ps(rt, _mm_mul_ps(c1, SPLAT(t, 1)));
+		rt = _mm_add_ps(rt, _mm_mul_ps(c2, SPLAT(t, 2)));
+
+		_mm_storeu_ps(out, c0);
+		_mm_storeu_ps(out + 4, c1);
+		_mm_storeu_ps(out + 8, c2);
+		_mm_storeu_ps(out + 12, _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), rt));
+	}
+
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::mat4InverseAffine_sse2(const float* m, float* out)
+{
+	// Everything is read before anything is written, so out may alias m.
+	__m128 c0 = loadXYZ(m);
+	__m128 c1 = loadXYZ(m + 4);
+	__m128 c2 = loadXYZ(m + 8);
+	__m128 t = _mm_loadu_ps(m + 12);
+
+	// The rows of the upper 3x3's inverse are the cross products of pairs of its columns, over its determinant.
+	__m128 r0 = cross3(c1, c2);
+	__m128 r1 = cross3(c2, c0);
+	__m128 r2 = cross3(c0, c1);
+
+	__m128 det = _mm_mul_ps(c0, r0);
+	det = _mm_add_ps(det, _mm_movehl_ps(det, det));
+	det = _mm_add_ps(det, SWIZZLE(det, 1, 0, 0, 0));
+	__m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), SWIZZLE(det, 0, 0, 0, 0));
+
+	r0 = _mm_mul_ps(r0, invDet);
+	r1 = _mm_mul_ps(r1, invDet);
+	r2 = _mm_mul_ps(r2, invDet);
+	__m128 r3 = _mm_setzero_ps();
+
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+	storeAffine(r0, r1, r2, t, out);
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::mat4InverseRigid_sse2(const float* m, float* out)
+{
+	// An orthonormal matrix's inverse is its transpose.
+	__m128 c0 = loadXYZ(m);
+	__m128 c1 = loadXYZ(m + 4);
+	__m128 c2 = loadXYZ(m + 8);
+	__m128 c3 = _mm_setzero_ps();
+	__m128 t = _mm_loadu_ps(m + 12);
+
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+	storeAffine(c0, c1, c2, t, out);
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::streamAdd_sse2(const float* a, const float* b, float* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+
+	streamAdd_scalar(a + i, b + i, out + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::streamSubtract_sse2(const float* a, const float* b, float* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_ps(out + i, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+
+	streamSubtract_scalar(a + i, b + i, out + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::streamMultiply_sse2(const float* a, const float* b, float* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+
+	streamMultiply_scalar(a + i, b + i, out + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::streamScale_sse2(const float* a, float s, float* out, size_t count)
+{
+	__m128 vs = _mm_set1_ps(s);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), vs));
+
+	streamScale_scalar(a + i, s, out + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::streamMultiplyAdd_sse2(const float* a, const float* b, const float* c, float* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)), _mm_loadu_ps(c + i)));
+
+	streamMultiplyAdd_scalar(a + i, b + i, c + i, out + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::streamScaleAdd_sse2(const float* a, float s, const float* c, float* out, size_t count)
+{
+	__m128 vs = _mm_set1_ps(s);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i), vs), _mm_loadu_ps(c + i)));
+
+	streamScaleAdd_scalar(a + i, s, c + i, out + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::streamDot_sse2(const float* const* a, const float* const* b, int components, float* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 sum = _mm_mul_ps(_mm_loadu_ps(a[0] + i), _mm_loadu_ps(b[0] + i));
+		for (int c = 1; c < components; c++)
+			sum = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a[c] + i), _mm_loadu_ps(b[c] + i)), sum);
+
+		_mm_storeu_ps(out + i, sum);
+	}
+
+	const float* tailA[4];
+	const float* tailB[4];
+	for (int c = 0; c < components; c++)
+	{
+		tailA[c] = a[c] + i;
+		tailB[c] = b[c] + i;
+	}
+
+	streamDot_scalar(tailA, tailB, components, out + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::streamLength_sse2(const float* const* v, int components, float* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 v0 = _mm_loadu_ps(v[0] + i);
+		__m128 sum = _mm_mul_ps(v0, v0);
+		for (int c = 1; c < components; c++)
+		{
+			__m128 vc = _mm_loadu_ps(v[c] + i);
+			sum = _mm_add_ps(_mm_mul_ps(vc, vc), sum);
+		}
+
+		_mm_storeu_ps(out + i, _mm_sqrt_ps(sum));
+	}
+
+	const float* tail[4];
+	for (int c = 0; c < components; c++)
+		tail[c] = v[c] + i;
+
+	streamLength_scalar(tail, components, out + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::streamNormalize_sse2(const float* const* in, float* const* out, int components, size_t count)
+{
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 v0 = _mm_loadu_ps(in[0] + i);
+		__m128 lengthSquared = _mm_mul_ps(v0, v0);
+		for (int c = 1; c < components; c++)
+		{
+			__m128 vc = _mm_loadu_ps(in[c] + i);
+			lengthSquared = _mm_add_ps(_mm_mul_ps(vc, vc), lengthSquared);
+		}
+
+		// A full precision divide rather than the approximate reciprocal square root, so the results match the scalar kernel.
+		__m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(lengthSquared));
+
+		for (int c = 0; c < components; c++)
+			_mm_storeu_ps(out[c] + i, _mm_mul_ps(_mm_loadu_ps(in[c] + i), invLength));
+	}
+
+	const float* tailIn[4];
+	float* tailOut[4];
+	for (int c = 0; c < components; c++)
+	{
+		tailIn[c] = in[c] + i;
+		tailOut[c] = out[c] + i;
+	}
+
+	streamNormalize_scalar(tailIn, tailOut, components, count - i);
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::streamCross_sse2(const float* const* a, const float* const* b, float* const* out, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		// Everything is loaded before anything is stored, so out may alias a or b.
+		__m128 ax = _mm_loadu_ps(a[0] + i), ay = _mm_loadu_ps(a[1] + i), az = _mm_loadu_ps(a[2] + i);
+		__m128 bx = _mm_loadu_ps(b[0] + i), by = _mm_loadu_ps(b[1] + i), bz = _mm_loadu_ps(b[2] + i);
+
+		_mm_storeu_ps(out[0] + i, _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)));
+		_mm_storeu_ps(out[1] + i, _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz)));
+		_mm_storeu_ps(out[2] + i, _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx)));
+	}
+
+	const float* tailA[3] = { a[0] + i, a[1] + i, a[2] + i };
+	const float* tailB[3] = { b[0] + i, b[1] + i, b[2] + i };
+	float* tailOut[3] = { out[0] + i, out[1] + i, out[2] + i };
+
+	streamCross_scalar(tailA, tailB, tailOut, count - i);
+}
+
+namespace {
+
+	ENGINE_SIMD_TARGET("sse2")
+	inline void sinCos4(__m128 x, __m128& sines, __m128& cosines)
+	{
+		using namespace simd::sinCosConstants;
+
+		// Work with |x| and put the sign back on the sine at the end.
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		__m128 sinSign = _mm_and_ps(x, signMask);
+		x = _mm_andnot_ps(signMask, x);
+
+		// The octant, rounded up to an even number so that x is reduced in to [-pi/4, pi/4].
+		__m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(FOUR_OVER_PI)));
+		j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+		__m128 y = _mm_cvtepi32_ps(j);
+
+		// Modulo 8, a rounded octant of 4 or 6 flips the sine, 2 or 4 flips the cosine, and 2 or 6 swaps the sine and cosine polynomials.
+		sinSign = _mm_xor_ps(sinSign, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29)));
+		__m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+		__m128 sinPoly = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+
+		x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(PI_OVER_4_A)));
+		x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(PI_OVER_4_B)));
+		x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(PI_OVER_4_C)));
+
+		__m128 z = _mm_mul_ps(x, x);
+
+		__m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(COS_C0), z), _mm_set1_ps(COS_C1));
+		c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(COS_C2));
+		c = _mm_mul_ps(_mm_mul_ps(c, z), z);
+		c = _mm_add_ps(_mm_sub_ps(c, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+		__m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_S0), z), _mm_set1_ps(SIN_S1));
+		s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(SIN_S2));
+		s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, z), x), x);
+
+		sines = _mm_xor_ps(_mm_or_ps(_mm_and_ps(sinPoly, s), _mm_andnot_ps(sinPoly, c)), sinSign);
+		cosines = _mm_xor_ps(_mm_or_ps(_mm_and_ps(sinPoly, c), _mm_andnot_ps(sinPoly, s)), cosSign);
+	}
+
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::sinCos_sse2(const float* angles, float* sines, float* cosines, size_t count)
+{
+	__m128 s, c;
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		sinCos4(_mm_loadu_ps(angles + i), s, c);
+		_mm_storeu_ps(sines + i, s);
+		_mm_storeu_ps(cosines + i, c);
+	}
+
+	if (i == count)
+		return;
+
+	// Pad the tail out to a full register rather than falling back to the scalar kernel, so every angle gets the same polynomial.
+	float tail[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	for (size_t t = 0; i + t < count; t++)
+		tail[t] = angles[i + t];
+
+	float tailSines[4], tailCosines[4];
+	sinCos4(_mm_loadu_ps(tail), s, c);
+	_mm_storeu_ps(tailSines, s);
+	_mm_storeu_ps(tailCosines, c);
+
+	for (size_t t = 0; i + t < count; t++)
+	{
+		sines[i + t] = tailSines[t];
+		cosines[i + t] = tailCosines[t];
+	}
+}
+
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::frustumCullAABB_sse2(const float* planes, const float* boxes, size_t count, uint8_t* result)
+{
+	__m128 normals[6][3], distances[6];
+	bool positive[6][3];
+
+	for (int p = 0; p < 6; p++)
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			normals[p][axis] = _mm_set1_ps(planes[4 * p + axis]);
+			positive[p][axis] = planes[4 * p + axis] >= 0.0f;
+		}
+
+		distances[p] = _mm_set1_ps(planes[4 * p + 3]);
+	}
+
+	const __m128 zero = _mm_setzero_ps();
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		// Transpose four boxes in to one register per component. Each box's first four floats are (minX minY minZ maxX) and its last four
+		// ... are (minZ maxX maxY maxZ), so two 4x4 transposes cover all six components without reading past the last box.
+		const float* b = boxes + 6 * i;
+
+		__m128 minX = _mm_loadu_ps(b), minY = _mm_loadu_ps(b + 6), minZ = _mm_loadu_ps(b + 12), unused0 = _mm_loadu_ps(b + 18);
+		_MM_TRANSPOSE4_PS(minX, minY, minZ, unused0);
+
+		__m128 unused1 = _mm_loadu_ps(b + 2), maxX = _mm_loadu_ps(b + 8), maxY = _mm_loadu_ps(b + 14), maxZ = _mm_loadu_ps(b + 20);
+		_MM_TRANSPOSE4_PS(unused1, maxX, maxY, maxZ);
+
+		__m128 visible = _mm_cmpeq_ps(zero, zero);
+
+		for (int p = 0; p < 6; p++)
+		{
+			// Only the corner furthest along the plane's normal needs testing; if that's outside, the whole box is.
+			__m128 d = _mm_mul_ps(normals[p][0], positive[p][0] ? maxX : minX);
+			d = _mm_add_ps(d, _mm_mul_ps(normals[p][1], positive[p][1] ? maxY : minY));
+			d = _mm_add_ps(d, _mm_mul_ps(normals[p][2], positive[p][2] ? maxZ : minZ));
+			d = _mm_add_ps(d, distances[p]);
+
+			visible = _mm_and_ps(visible, _mm_cmpge_ps(d, zero));
+		}
+
+		int mask = _mm_movemask_ps(visible);
+		for (int k = 0; k < 4; k++)
+			result[i + k] = (mask >> k) & 1;
+	}
+
+	frustumCullAABB_scalar(planes, boxes + 6 * i, count - i, result + i);
+}
+
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::rayAABB_sse2(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count)
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+	const __m128 boxMin[3] = { _mm_set1_ps(shape[0]), _mm_set1_ps(shape[1]), _mm_set1_ps(shape[2]) };
+	const __m128 boxMax[3] = { _mm_set1_ps(shape[3]), _mm_set1_ps(shape[4]), _mm_set1_ps(shape[5]) };
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 tNear = zero, tFar = infinity;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			__m128 origin = _mm_loadu_ps(origins[axis] + i);
+			__m128 inverse = _mm_div_ps(_mm_set1_ps(1.0f), _mm_loadu_ps(directions[axis] + i));
+			__m128 t1 = _mm_mul_ps(_mm_sub_ps(boxMin[axis], origin), inverse);
+			__m128 t2 = _mm_mul_ps(_mm_sub_ps(boxMax[axis], origin), inverse);
+
+			// As in the scalar kernel, the NaN-prone slab distances go first so that min and max return tNear or tFar instead of a NaN.
+			tNear = _mm_max_ps(_mm_min_ps(t1, t2), tNear);
+			tFar = _mm_min_ps(_mm_max_ps(t1, t2), tFar);
+		}
+
+		_mm_storeu_ps(t + i, _mm_or_ps(_mm_and_ps(_mm_cmple_ps(tNear, tFar), tNear), _mm_andnot_ps(_mm_cmple_ps(tNear, tFar), infinity)));
+	}
+
+	const float* originsTail[3] = { origins[0] + i, origins[1] + i, origins[2] + i };
+	const float* directionsTail[3] = { directions[0] + i, directions[1] + i, directions[2] + i };
+	rayAABB_scalar(originsTail, directionsTail, shape, t + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::raySphere_sse2(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count)
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+	const __m128 cx = _mm_set1_ps(shape[0]), cy = _mm_set1_ps(shape[1]), cz = _mm_set1_ps(shape[2]);
+	const __m128 radiusSquared = _mm_set1_ps(shape[3] * shape[3]);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 ox = _mm_loadu_ps(origins[0] + i), oy = _mm_loadu_ps(origins[1] + i), oz = _mm_loadu_ps(origins[2] + i);
+		__m128 dx = _mm_loadu_ps(directions[0] + i), dy = _mm_loadu_ps(directions[1] + i), dz = _mm_loadu_ps(directions[2] + i);
+
+		// Solve |o + t d - c|^2 = r^2 for t, with b being half the usual linear coefficient.
+		__m128 ocx = _mm_sub_ps(ox, cx), ocy = _mm_sub_ps(oy, cy), ocz = _mm_sub_ps(oz, cz);
+
+		__m128 a = _mm_add_ps(_mm_mul_ps(dz, dz), _mm_add_ps(_mm_mul_ps(dy, dy), _mm_mul_ps(dx, dx)));
+		__m128 b = _mm_add_ps(_mm_mul_ps(ocz, dz), _mm_add_ps(_mm_mul_ps(ocy, dy), _mm_mul_ps(ocx, dx)));
+		__m128 c = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(ocz, ocz), _mm_add_ps(_mm_mul_ps(ocy, ocy), _mm_mul_ps(ocx, ocx))), radiusSquared);
+		__m128 discriminant = _mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(a, c));
+
+		__m128 root = _mm_sqrt_ps(_mm_max_ps(discriminant, zero));
+		__m128 tNear = _mm_div_ps(_mm_sub_ps(zero, _mm_add_ps(b, root)), a);
+		__m128 tFar = _mm_div_ps(_mm_sub_ps(root, b), a);
+
+		__m128 hit = _mm_and_ps(_mm_cmpge_ps(discriminant, zero), _mm_cmpge_ps(tFar, zero));
+		_mm_storeu_ps(t + i, _mm_or_ps(_mm_and_ps(hit, _mm_max_ps(tNear, zero)), _mm_andnot_ps(hit, infinity)));
+	}
+
+	const float* originsTail[3] = { origins[0] + i, origins[1] + i, origins[2] + i };
+	const float* directionsTail[3] = { directions[0] + i, directions[1] + i, directions[2] + i };
+	raySphere_scalar(originsTail, directionsTail, shape, t + i, count - i);
+}
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::rayTriangle_sse2(const float* const* origins, const float* const* directions, const float* shape, float* t, size_t count)
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+	const __m128 epsilon = _mm_set1_ps(RAY_TRIANGLE_EPSILON);
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 ax = _mm_set1_ps(shape[0]), ay = _mm_set1_ps(shape[1]), az = _mm_set1_ps(shape[2]);
+	const __m128 e1x = _mm_set1_ps(shape[3] - shape[0]), e1y = _mm_set1_ps(shape[4] - shape[1]), e1z = _mm_set1_ps(shape[5] - shape[2]);
+	const __m128 e2x = _mm_set1_ps(shape[6] - shape[0]), e2y = _mm_set1_ps(shape[7] - shape[1]), e2z = _mm_set1_ps(shape[8] - shape[2]);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 ox = _mm_loadu_ps(origins[0] + i), oy = _mm_loadu_ps(origins[1] + i), oz = _mm_loadu_ps(origins[2] + i);
+		__m128 dx = _mm_loadu_ps(directions[0] + i), dy = _mm_loadu_ps(directions[1] + i), dz = _mm_loadu_ps(directions[2] + i);
+
+		// Moller-Trumbore: solve o + t d = a + u e1 + v e2 by Cramer's rule, sharing the cross products p = d x e2 and q = s x e1.
+		__m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+		__m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+		__m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+		__m128 det = _mm_add_ps(_mm_mul_ps(e1z, pz), _mm_add_ps(_mm_mul_ps(e1y, py), _mm_mul_ps(e1x, px)));
+		__m128 inverse = _mm_div_ps(one, det);
+
+		__m128 sx = _mm_sub_ps(ox, ax), sy = _mm_sub_ps(oy, ay), sz = _mm_sub_ps(oz, az);
+		__m128 u = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(sz, pz), _mm_add_ps(_mm_mul_ps(sy, py), _mm_mul_ps(sx, px))), inverse);
+
+		__m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+		__m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+		__m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+		__m128 v = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(dz, qz), _mm_add_ps(_mm_mul_ps(dy, qy), _mm_mul_ps(dx, qx))), inverse);
+		__m128 tHit = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(e2z, qz), _mm_add_ps(_mm_mul_ps(e2y, qy), _mm_mul_ps(e2x, qx))), inverse);
+
+		__m128 hit = _mm_cmpgt_ps(_mm_andnot_ps(signMask, det), epsilon);
+		hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmpge_ps(v, zero)));
+		hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmple_ps(_mm_add_ps(u, v), one), _mm_cmpge_ps(tHit, zero)));
+		_mm_storeu_ps(t + i, _mm_or_ps(_mm_and_ps(hit, tHit), _mm_andnot_ps(hit, infinity)));
+	}
+
+	const float* originsTail[3] = { origins[0] + i, origins[1] + i, origins[2] + i };
+	const float* directionsTail[3] = { directions[0] + i, directions[1] + i, directions[2] + i };
+	rayTriangle_scalar(originsTail, directionsTail, shape, t + i, count - i);
+}
+
+#endif
+
+ENGINE_SIMD_TARGET("sse2")
+void simd::sphereScreenSize_sse2(const float* const* centres, const float* radii, const float* camera, float* out, size_t count)
+{
+	const __m128 minDistance = _mm_set1_ps(std::numeric_limits<float>::min());
+	const __m128 ex = _mm_set1_ps(camera[0]), ey = _mm_set1_ps(camera[1]), ez = _mm_set1_ps(camera[2]);
+	const __m128 scale = _mm_set1_ps(camera[3]);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(centres[0] + i), ex);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(centres[1] + i), ey);
+		__m128 dz = _mm_sub_ps(_mm_loadu_ps(centres[2] + i), ez);
+		__m128 radius = _mm_loadu_ps(radii + i);
+
+		__m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+		_mm_storeu_ps(out + i, _mm_div_ps(_mm_mul_ps(radius, scale), _mm_max_ps(_mm_max_ps(distance, radius), minDistance)));
+	}
+
+	const float* tail[3] = { centres[0] + i, centres[1] + i, centres[2] + i };
+	sphereScreenSize_scalar(tail, radii + i, camera, out + i, count - i);
+}
\ No newline at end of file
@@ -0,0 +1,269 @@
+/*!
+ * @file vec3_stream.cpp
+ * @brief Implementation file for the Vec3Stream class and its nonmember functions.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <utility>
+
+
+// Local includes
+
+#include "maths/maths.h"
+#include "maths/simd.h"
+
+// The Vec3Stream accessors are inlined from the header unless the out-of-line build is requested.
+#ifdef ENGINE_MATHS_OUT_OF_LINE
+#include "maths/vector/vec3_stream.inl"
+#endif
+
+
+// Namespaces
+
+using namespace engine::maths;
+
+
+namespace {
+
+	// Capacities are kept to multiples of 8 floats (32 bytes) so each component array after the first starts aligned.
+	size_t roundCapacity(size_t capacity)
+	{
+		return (capacity + 7) & ~static_cast<size_t>(7);
+	}
+
+}
+
+
+Vec3Stream::Vec3Stream()
+	: m_data(nullptr), m_components{ nullptr, nullptr, nullptr }, m_size(0), m_capacity(0)
+{ }
+
+Vec3Stream::Vec3Stream(size_t size)
+	: Vec3Stream()
+{
+	resize(size);
+}
+
+Vec3Stream::Vec3Stream(const std::vector<Vec3>& vectors)
+	: Vec3Stream()
+{
+	reserve(vectors.size());
+
+	for (size_t i = 0; i < vectors.size(); i++)
+		set(i, vectors[i]);
+
+	m_size = vectors.size();
+}
+
+Vec3Stream::Vec3Stream(const Vec3Stream& other)
+	: Vec3Stream()
+{
+	*this = other;
+}
+
+Vec3Stream::Vec3Stream(Vec3Stream&& other)
+	: Vec3Stream()
+{
+	*this = std::move(other);
+}
+
+Vec3Stream::~Vec3Stream()
+{
+	simd::alignedFree(m_data);
+}
+
+Vec3Stream& Vec3Stream::operator=(const Vec3Stream& other)
+{
+	if (this == &other)
+		return *this;
+
+	m_size = 0;
+	reserve(other.m_size);
+
+	for (int c = 0; c < 3; c++)
+		std::memcpy(m_components[c], other.m_components[c], other.m_size * sizeof(float));
+
+	m_size = other.m_size;
+	return *this;
+}
+
+Vec3Stream& Vec3Stream::operator=(Vec3Stream&& other)
+{
+	if (this == &other)
+		return *this;
+
+	simd::alignedFree(m_data);
+
+	m_data = other.m_data;
+	m_size = other.m_size;
+	m_capacity = other.m_capacity;
+
+	for (int c = 0; c < 3; c++)
+	{
+		m_components[c] = other.m_components[c];
+		other.m_components[c] = nullptr;
+	}
+
+	other.m_data = nullptr;
+	other.m_size = 0;
+	other.m_capacity = 0;
+	return *this;
+}
+
+void Vec3Stream::resize(size_t size)
+{
+	reserve(size);
+
+	if (size > m_size)
+		for (int c = 0; c < 3; c++)
+			std::memset(m_components[c] + m_size, 0, (size - m_size) * sizeof(float));
+
+	m_size = size;
+}
+
+void Vec3Stream::reserve(size_t capacity)
+{
+	if (capacity > m_capacity)
+		reallocate(roundCapacity(capacity));
+}
+
+void Vec3Stream::pushBack(const Vec3& vec3)
+{
+	if (m_size == m_capacity)
+		reallocate(m_capacity == 0 ? 8 : 2 * m_capacity);
+
+	set(m_size++, vec3);
+}
+
+std::vector<Vec3> Vec3Stream::toVector() const
+{
+	std::vector<Vec3> vectors;
+	vectors.reserve(m_size);
+
+	for (size_t i = 0; i < m_size; i++)
+		vectors.push_back(get(i));
+
+	return vectors;
+}
+
+void Vec3Stream::reallocate(size_t capacity)
+{
+	float* data = static_cast<float*>(simd::alignedAlloc(3 * capacity * sizeof(float)));
+	if (data == nullptr)
+		throw std::bad_alloc();
+
+	for (int c = 0; c < 3; c++)
+	{
+		if (m_size > 0)
+			std::memcpy(data + c * capacity, m_components[c], m_size * sizeof(float));
+
+		m_components[c] = data + c * capacity;
+	}
+
+	simd::alignedFree(m_data);
+
+	m_data = data;
+	m_capacity = capacity;
+}
+
+void engine::maths::add(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out)
+{
+	assert(b.size() == a.size());
+
+	out.resize(a.size());
+
+	for (int c = 0; c < 3; c++)
+		simd::streamAdd(a.components()[c], b.components()[c], out.components()[c], a.size());
+}
+
+void engine::maths::subtract(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out)
+{
+	assert(b.size() == a.size());
+
+	out.resize(a.size());
+
+	for (int c = 0; c < 3; c++)
+		simd::streamSubtract(a.components()[c], b.components()[c], out.components()[c], a.size());
+}
+
+void engine::maths::multiply(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out)
+{
+	assert(b.size() == a.size());
+
+	out.resize(a.size());
+
+	for (int c = 0; c < 3; c++)
+		simd::streamMultiply(a.components()[c], b.components()[c], out.components()[c], a.size());
+}
+
+void engine::maths::multiply(const Vec3Stream& a, float s, Vec3Stream& out)
+{
+	out.resize(a.size());
+
+	for (int c = 0; c < 3; c++)
+		simd::streamScale(a.components()[c], s, out.components()[c], a.size());
+}
+
+void engine::maths::multiplyAdd(const Vec3Stream& a, const Vec3Stream& b, const Vec3Stream& c, Vec3Stream& out)
+{
+	assert(b.size() == a.size());
+	assert(c.size() == a.size());
+
+	out.resize(a.size());
+
+	for (int i = 0; i < 3; i++)
+		simd::streamMultiplyAdd(a.components()[i], b.components()[i], c.components()[i], out.components()[i], a.size());
+}
+
+void engine::maths::multiplyAdd(const Vec3Stream& a, float s, const Vec3Stream& c, Vec3Stream& out)
+{
+	assert(c.size() == a.size());
+
+	out.resize(a.size());
+
+	for (int i = 0; i < 3; i++)
+		simd::streamScaleAdd(a.components()[i], s, c.components()[i], out.components()[i], a.size());
+}
+
+void engine::maths::dot(const Vec3Stream& a, const Vec3Stream& b, float* out)
+{
+	assert(b.size() == a.size());
+
+	simd::streamDot(a.components(), b.components(), 3, out, a.size());
+}
+
+void engine::maths::length(const Vec3Stream& vectors, float* out)
+{
+	simd::streamLength(vectors.components(), 3, out, vectors.size());
+}
+
+void engine::maths::normalize(const Vec3Stream& vectors, Vec3Stream& out)
+{
+	out.resize(vectors.size());
+	simd::streamNormalize(vectors.components(), out.components(), 3, vectors.size());
+}
+
+void engine::maths::cross(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out)
+{
+	assert(b.size() == a.size());
+
+	out.resize(a.size());
+	simd::streamCross(a.components(), b.components(), out.components(), a.size());
+}
+
+void engine::maths::transformPoints(const Mat4& m, const Vec3Stream& in, Vec3Stream& out)
+{
+	out.resize(in.size());
+	simd::transformSoA(m.data_ptr(), in.x(), in.y(), in.z(), out.x(), out.y(), out.z(), in.size(), 1.0f);
+}
+
+void engine::maths::transformDirections(const Mat4& m, const Vec3Stream& in, Vec3Stream& out)
+{
+	out.resize(in.size());
+	simd::transformSoA(m.data_ptr(), in.x(), in.y(), in.z(), out.x(), out.y(), out.z(), in.size(), 0.0f);
+}
\ No newline at end of file
@@ -0,0 +1,249 @@
+/*!
+ * @file vec4_stream.cpp
+ * @brief Implementation file for the Vec4Stream class and its nonmember functions.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <utility>
+
+
+// Local includes
+
+#include "maths/maths.h"
+#include "maths/simd.h"
+
+// The Vec4Stream accessors are inlined from the header unless the out-of-line build is requested.
+#ifdef ENGINE_MATHS_OUT_OF_LINE
+#include "maths/vector/vec4_stream.inl"
+#endif
+
+
+// Namespaces
+
+using namespace engine::maths;
+
+
+namespace {
+
+	// Capacities are kept to multiples of 8 floats (32 bytes) so each component array after the first starts aligned.
+	size_t roundCapacity(size_t capacity)
+	{
+		return (capacity + 7) & ~static_cast<size_t>(7);
+	}
+
+}
+
+
+Vec4Stream::Vec4Stream()
+	: m_data(nullptr), m_components{ nullptr, nullptr, nullptr, nullptr }, m_size(0), m_capacity(0)
+{ }
+
+Vec4Stream::Vec4Stream(size_t size)
+	: Vec4Stream()
+{
+	resize(size);
+}
+
+Vec4Stream::Vec4Stream(const std::vector<Vec4>& vectors)
+	: Vec4Stream()
+{
+	reserve(vectors.size());
+
+	for (size_t i = 0; i < vectors.size(); i++)
+		set(i, vectors[i]);
+
+	m_size = vectors.size();
+}
+
+Vec4Stream::Vec4Stream(const Vec4Stream& other)
+	: Vec4Stream()
+{
+	*this = other;
+}
+
+Vec4Stream::Vec4Stream(Vec4Stream&& other)
+	: Vec4Stream()
+{
+	*this = std::move(other);
+}
+
+Vec4Stream::~Vec4Stream()
+{
+	simd::alignedFree(m_data);
+}
+
+Vec4Stream& Vec4Stream::operator=(const Vec4Stream& other)
+{
+	if (this == &other)
+		return *this;
+
+	m_size = 0;
+	reserve(other.m_size);
+
+	for (int c = 0; c < 4; c++)
+		std::memcpy(m_components[c], other.m_components[c], other.m_size * sizeof(float));
+
+	m_size = other.m_size;
+	return *this;
+}
+
+Vec4Stream& Vec4Stream::operator=(Vec4Stream&& other)
+{
+	if (this == &other)
+		return *this;
+
+	simd::alignedFree(m_data);
+
+	m_data = other.m_data;
+	m_size = other.m_size;
+	m_capacity = other.m_capacity;
+
+	for (int c = 0; c < 4; c++)
+	{
+		m_components[c] = other.m_components[c];
+		other.m_components[c] = nullptr;
+	}
+
+	other.m_data = nullptr;
+	other.m_size = 0;
+	other.m_capacity = 0;
+	return *this;
+}
+
+void Vec4Stream::resize(size_t size)
+{
+	reserve(size);
+
+	if (size > m_size)
+		for (int c = 0; c < 4; c++)
+			std::memset(m_components[c] + m_size, 0, (size - m_size) * sizeof(float));
+
+	m_size = size;
+}
+
+void Vec4Stream::reserve(size_t capacity)
+{
+	if (capacity > m_capacity)
+		reallocate(roundCapacity(capacity));
+}
+
+void Vec4Stream::pushBack(const Vec4& vec4)
+{
+	if (m_size == m_capacity)
+		reallocate(m_capacity == 0 ? 8 : 2 * m_capacity);
+
+	set(m_size++, vec4);
+}
+
+std::vector<Vec4> Vec4Stream::toVector() const
+{
+	std::vector<Vec4> vectors;
+	vectors.reserve(m_size);
+
+	for (size_t i = 0; i < m_size; i++)
+		vectors.push_back(get(i));
+
+	return vectors;
+}
+
+void Vec4Stream::reallocate(size_t capacity)
+{
+	float* data = static_cast<float*>(simd::alignedAlloc(4 * capacity * sizeof(float)));
+	if (data == nullptr)
+		throw std::bad_alloc();
+
+	for (int c = 0; c < 4; c++)
+	{
+		if (m_size > 0)
+			std::memcpy(data + c * capacity, m_components[c], m_size * sizeof(float));
+
+		m_components[c] = data + c * capacity;
+	}
+
+	simd::alignedFree(m_data);
+
+	m_data = data;
+	m_capacity = capacity;
+}
+
+void engine::maths::add(const Vec4Stream& a, const Vec4Stream& b, Vec4Stream& out)
+{
+	assert(b.size() == a.size());
+
+	out.resize(a.size());
+
+	for (int c = 0; c < 4; c++)
+		simd::streamAdd(a.components()[c], b.components()[c], out.components()[c], a.size());
+}
+
+void engine::maths::subtract(const Vec4Stream& a, const Vec4Stream& b, Vec4Stream& out)
+{
+	assert(b.size() == a.size());
+
+	out.resize(a.size());
+
+	for (int c = 0; c < 4; c++)
+		simd::streamSubtract(a.components()[c], b.components()[c], out.components()[c], a.size());
+}
+
+void engine::maths::multiply(const Vec4Stream& a, const Vec4Stream& b, Vec4Stream& out)
+{
+	assert(b.size() == a.size());
+
+	out.resize(a.size());
+
+	for (int c = 0; c < 4; c++)
+		simd::streamMultiply(a.components()[c], b.components()[c], out.components()[c], a.size());
+}
+
+void engine::maths::multiply(const Vec4Stream& a, float s, Vec4Stream& out)
+{
+	out.resize(a.size());
+
+	for (int c = 0; c < 4; c++)
+		simd::streamScale(a.components()[c], s, out.components()[c], a.size());
+}
+
+void engine::maths::multiplyAdd(const Vec4Stream& a, const Vec4Stream& b, const Vec4Stream& c, Vec4Stream& out)
+{
+	assert(b.size() == a.size());
+	assert(c.size() == a.size());
+
+	out.resize(a.size());
+
+	for (int i = 0; i < 4; i++)
+		simd::streamMultiplyAdd(a.components()[i], b.components()[i], c.components()[i], out.components()[i], a.size());
+}
+
+void engine::maths::multiplyAdd(const Vec4Stream& a, float s, const Vec4Stream& c, Vec4Stream& out)
+{
+	assert(c.size() == a.size());
+
+	out.resize(a.size());
+
+	for (int i = 0; i < 4; i++)
+		simd::streamScaleAdd(a.components()[i], s, c.components()[i], out.components()[i], a.size());
+}
+
+void engine::maths::dot(const Vec4Stream& a, const Vec4Stream& b, float* out)
+{
+	assert(b.size() == a.size());
+
+	simd::streamDot(a.components(), b.components(), 4, out, a.size());
+}
+
+void engine::maths::length(const Vec4Stream& vectors, float* out)
+{
+	simd::streamLength(vectors.components(), 4, out, vectors.size());
+}
+
+void engine::maths::normalize(const Vec4Stream& vectors, Vec4Stream& out)
+{
+	out.resize(vectors.size());
+	simd::streamNormalize(vectors.components(), out.components(), 4, vectors.size());
+}
\ No newline at end of file
@@ -4,6 +4,11 @@
  * @author George McDonagh */
 
 
+// External includes
+
+#include <limits>
+
+
 // Local includes
 
 #include "utils\asset_manager.h"
@@ -16,7 +21,7 @@ using namespace engine;
 
 
 MeshComponent::MeshComponent(const graphics::Mesh* mesh)
-	: Component()
+	: Component(), m_lodCount(1), m_currentLOD(0)
 {
 	m_mesh = mesh;
 }
@@ -26,4 +31,48 @@ MeshComponent::~MeshComponent() { }
 const graphics::Mesh*& MeshComponent::mesh()
 {
 	return m_mesh;
+}
+
+bool MeshComponent::addLOD(const graphics::Mesh* mesh, float screenSize)
+{
+	if (m_lodCount == MAX_LODS || screenSize >= lodScreenSize(m_lodCount - 1))
+		return false;
+
+	m_lods[m_lodCount - 1].mesh = mesh;
+	m_lods[m_lodCount - 1].screenSize = screenSize;
+	m_lodCount++;
+	return true;
+}
+
+unsigned int MeshComponent::lodCount() const
+{
+	return m_lodCount;
+}
+
+const graphics::Mesh* MeshComponent::lodMesh(unsigned int level) const
+{
+	return level == 0 ? m_mesh : m_lods[level - 1].mesh;
+}
+
+float MeshComponent::lodScreenSize(unsigned int level) const
+{
+	return level == 0 ? std::numeric_limits<float>::infinity() : m_lods[level - 1].screenSize;
+}
+
+unsigned int MeshComponent::currentLOD() const
+{
+	return m_currentLOD;
+}
+
+unsigned int MeshComponent::selectLOD(float screenSize, float hysteresis)
+{
+	// Step to coarser levels while the SceneObject is well below their thresholds, then to finer levels while it is well above the current
+	// ... level's. Between the two the current level is kept.
+	while (m_currentLOD + 1 < m_lodCount && screenSize < m_lods[m_currentLOD].screenSize * (1.0f - hysteresis))
+		m_currentLOD++;
+
+	while (m_currentLOD > 0 && screenSize > m_lods[m_currentLOD - 1].screenSize * (1.0f + hysteresis))
+		m_currentLOD--;
+
+	return m_currentLOD;
 }
\ No newline at end of file
@@ -0,0 +1,302 @@
+/*!
+ * @file scene_bvh.cpp
+ * @brief Implementation file for the SceneBVH class.
+ * @author George McDonagh */
+
+
+// Local includes
+
+#include "bounds_component.h"
+#include "scene_bvh.h"
+
+
+// Namespaces
+
+using namespace engine;
+
+
+namespace {
+
+	// SceneObjects which haven't moved for this many updates count as static again.
+	const uint32_t SETTLE_UPDATES = 60;
+
+	// The static BVH is rebuilt once this many SceneObjects in the dynamic BVH have settled, plus one for every eight in the static BVH, so
+	// ... that the bigger the static BVH is, and the longer it takes to build, the rarer the rebuilds are.
+	const size_t MIN_SETTLED_FOR_REBUILD = 1024;
+
+	// The dynamic BVH is rebuilt once refitting has made queries this many times more expensive than they were just after it was built.
+	const float DYNAMIC_COST_LIMIT = 2.0f;
+
+	const ComponentMask BOUNDED = componentMask<TransformComponent, BoundsComponent>();
+
+}
+
+
+SceneBVH::SceneBVH()
+	: m_staticRemoved(0), m_dynamicChanged(false), m_dynamicBuildCost(0.0f), m_updates(0), m_structureVersion(0), m_built(false) { }
+
+void SceneBVH::update(const ComponentStore& store, const std::vector<SceneObject*>& moved, unsigned long long structureVersion)
+{
+	m_updates++;
+
+	if (!m_built || structureVersion != m_structureVersion)
+	{
+		reconcile(store);
+		m_structureVersion = structureVersion;
+	}
+
+	for (auto object : moved)
+	{
+		const SceneObjectHandle handle = object->getHandle();
+
+		if (handle.index >= m_proxies.size())
+			continue;
+
+		Proxy& proxy = m_proxies[handle.index];
+
+		// Skip SceneObjects without bounds, and those reconcile() has only just added.
+		if (proxy.tree == TREE_NONE || proxy.handle != handle || proxy.lastMoved == m_updates)
+			continue;
+
+		const maths::AABB box = maths::transform(object->getComponent<TransformComponent>()->getWorldMatrix(), object->getComponent<BoundsComponent>()->bounds());
+		proxy.lastMoved = m_updates;
+
+		if (proxy.tree == TREE_STATIC)
+		{
+			remove(proxy);
+			addDynamic(proxy, box);
+		}
+		else
+		{
+			m_dynamicBoxes[proxy.item] = box;
+
+			// The dynamic BVH is about to be rebuilt anyway if its items have changed.
+			if (!m_dynamicChanged)
+				m_dynamic.update(proxy.item, box);
+		}
+	}
+
+	// Everything in the scene when it is first updated is assumed to be static.
+	if (!m_built)
+	{
+		rebuildStatic(m_updates + 1);
+		m_built = true;
+		return;
+	}
+
+	size_t settled = 0;
+	for (auto it = m_dynamicObjects.begin(); it != m_dynamicObjects.end(); it++)
+		if (m_proxies[it->index].lastMoved + SETTLE_UPDATES < m_updates)
+			settled++;
+
+	const size_t staticCount = m_staticObjects.size() - m_staticRemoved;
+
+	// Rebuild the static BVH once the dynamic one is carrying a lot of settled SceneObjects, or the static one is mostly holes.
+	if (settled > MIN_SETTLED_FOR_REBUILD + staticCount / 8 || (m_staticRemoved > MIN_SETTLED_FOR_REBUILD && m_staticRemoved > staticCount))
+	{
+		rebuildStatic(m_updates > SETTLE_UPDATES ? m_updates - SETTLE_UPDATES : 0);
+		return;
+	}
+
+	m_static.refit();
+
+	if (m_dynamicChanged)
+		rebuildDynamic();
+	else
+	{
+		m_dynamic.refit();
+
+		if (m_dynamic.cost() > DYNAMIC_COST_LIMIT * m_dynamicBuildCost)
+			rebuildDynamic();
+	}
+}
+
+void SceneBVH::query(const maths::AABB& box, std::vector<SceneObjectHandle>& objects) const
+{
+	std::vector<uint32_t> items;
+
+	m_static.query(box, items);
+	for (auto item : items)
+		objects.push_back(m_staticObjects[item]);
+
+	items.clear();
+
+	m_dynamic.query(box, items);
+	for (auto item : items)
+		objects.push_back(m_dynamicObjects[item]);
+}
+
+void SceneBVH::query(const maths::Frustum& frustum, std::vector<SceneObjectHandle>& objects) const
+{
+	std::vector<uint32_t> items;
+
+	m_static.query(frustum, items);
+	for (auto item : items)
+		objects.push_back(m_staticObjects[item]);
+
+	items.clear();
+
+	m_dynamic.query(frustum, items);
+	for (auto item : items)
+		objects.push_back(m_dynamicObjects[item]);
+}
+
+SceneObjectHandle SceneBVH::raycast(const maths::Ray& ray, float& t) const
+{
+	SceneObjectHandle hit;
+	uint32_t item;
+	float staticT, dynamicT;
+
+	const bool hitStatic = m_static.raycast(ray, staticT, item);
+
+	if (hitStatic)
+	{
+		hit = m_staticObjects[item];
+		t = staticT;
+	}
+
+	if (m_dynamic.raycast(ray, dynamicT, item) && (!hitStatic || dynamicT < staticT))
+	{
+		hit = m_dynamicObjects[item];
+		t = dynamicT;
+	}
+
+	return hit;
+}
+
+size_t SceneBVH::size() const
+{
+	return m_staticObjects.size() - m_staticRemoved + m_dynamicObjects.size();
+}
+
+size_t SceneBVH::dynamicSize() const
+{
+	return m_dynamicObjects.size();
+}
+
+void SceneBVH::reconcile(const ComponentStore& store)
+{
+	for (auto it = store.archetypes().begin(); it != store.archetypes().end(); it++)
+	{
+		const Archetype& archetype = **it;
+
+		if ((archetype.mask() & BOUNDED) != BOUNDED)
+			continue;
+
+		const std::vector<SceneObject*>& objects = archetype.objects();
+		TypedColumn<TransformComponent>& transforms = archetype.column<TransformComponent>();
+		TypedColumn<BoundsComponent>& bounds = archetype.column<BoundsComponent>();
+
+		for (size_t row = 0; row < objects.size(); row++)
+		{
+			const SceneObjectHandle handle = objects[row]->getHandle();
+
+			if (handle.index >= m_proxies.size())
+				m_proxies.resize(handle.index + 1);
+
+			Proxy& proxy = m_proxies[handle.index];
+
+			// The proxy may still belong to a destroyed SceneObject whose slot this one has taken.
+			if (proxy.tree != TREE_NONE && proxy.handle != handle)
+				remove(proxy);
+
+			proxy.seen = m_updates;
+
+			if (proxy.tree == TREE_NONE)
+			{
+				proxy.handle = handle;
+				proxy.lastMoved = m_updates;
+				addDynamic(proxy, maths::transform(transforms[row].getWorldMatrix(), bounds[row].bounds()));
+			}
+		}
+	}
+
+	// Anything not seen has been destroyed or lost its bounds.
+	for (auto it = m_proxies.begin(); it != m_proxies.end(); it++)
+		if (it->tree != TREE_NONE && it->seen != m_updates)
+			remove(*it);
+}
+
+void SceneBVH::addDynamic(Proxy& proxy, const maths::AABB& box)
+{
+	proxy.tree = TREE_DYNAMIC;
+	proxy.item = (uint32_t)m_dynamicObjects.size();
+
+	m_dynamicObjects.push_back(proxy.handle);
+	m_dynamicBoxes.push_back(box);
+	m_dynamicChanged = true;
+}
+
+void SceneBVH::remove(Proxy& proxy)
+{
+	if (proxy.tree == TREE_STATIC)
+	{
+		// The static BVH keeps a hole where the item was until it is next rebuilt.
+		m_static.remove(proxy.item);
+		m_staticObjects[proxy.item] = SceneObjectHandle();
+		m_staticRemoved++;
+	}
+	else if (proxy.tree == TREE_DYNAMIC)
+	{
+		// Move the last item in to the gap.
+		const uint32_t item = proxy.item;
+
+		m_dynamicObjects[item] = m_dynamicObjects.back();
+		m_dynamicBoxes[item] = m_dynamicBoxes.back();
+		m_proxies[m_dynamicObjects[item].index].item = item;
+
+		m_dynamicObjects.pop_back();
+		m_dynamicBoxes.pop_back();
+		m_dynamicChanged = true;
+	}
+
+	proxy.tree = TREE_NONE;
+}
+
+void SceneBVH::rebuildStatic(uint32_t settledBefore)
+{
+	std::vector<SceneObjectHandle> staticObjects, dynamicObjects;
+	std::vector<maths::AABB> staticBoxes, dynamicBoxes;
+
+	auto place = [&](SceneObjectHandle handle, const maths::AABB& box) {
+		Proxy& proxy = m_proxies[handle.index];
+
+		if (proxy.lastMoved < settledBefore)
+		{
+			proxy.tree = TREE_STATIC;
+			proxy.item = (uint32_t)staticObjects.size();
+			staticObjects.push_back(handle);
+			staticBoxes.push_back(box);
+		}
+		else
+		{
+			proxy.tree = TREE_DYNAMIC;
+			proxy.item = (uint32_t)dynamicObjects.size();
+			dynamicObjects.push_back(handle);
+			dynamicBoxes.push_back(box);
+		}
+	};
+
+	for (uint32_t item = 0; item < m_staticObjects.size(); item++)
+		if (!m_staticObjects[item].isNull())
+			place(m_staticObjects[item], m_static.bounds(item));
+
+	for (uint32_t item = 0; item < m_dynamicObjects.size(); item++)
+		place(m_dynamicObjects[item], m_dynamicBoxes[item]);
+
+	m_staticObjects.swap(staticObjects);
+	m_dynamicObjects.swap(dynamicObjects);
+	m_dynamicBoxes.swap(dynamicBoxes);
+
+	m_static.build(staticBoxes);
+	m_staticRemoved = 0;
+
+	rebuildDynamic();
+}
+
+void SceneBVH::rebuildDynamic()
+{
+	m_dynamic.build(m_dynamicBoxes);
+	m_dynamicBuildCost = m_dynamic.cost();
+	m_dynamicChanged = false;
+}
\ No newline at end of file
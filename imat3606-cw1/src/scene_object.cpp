@@ -4,6 +4,11 @@
  * @author George McDonagh */
 
 
+// External includes
+
+#include <algorithm>
+
+
 // Local includes
 
 #include "scene_object.h"
@@ -14,20 +19,84 @@
 using namespace engine;
 
 
-SceneObject::SceneObject()
+SceneObject::SceneObject(ComponentStore& store)
+	: m_store(nullptr), m_archetype(nullptr), m_row(0), m_parent(nullptr)
+{
+	store.insert(this);
+
+	addComponent(TransformComponent(maths::Vec3(), maths::Vec3(1.0f), maths::Vec3()));
+}
+
+SceneObject::~SceneObject()
+{
+	setParent(nullptr);
+
+	while (!m_children.empty())
+		m_children.back()->setParent(nullptr);
+
+	if (m_store)
+		m_store->remove(this);
+}
+
+bool SceneObject::hasComponents(ComponentMask mask) const
 {
-	addComponent<engine::TransformComponent>(new TransformComponent(maths::Vec3(), maths::Vec3(1.0f), maths::Vec3()));
+	return (m_archetype->mask() & mask) == mask;
 }
 
-SceneObject::~SceneObject() { }
+ComponentMask SceneObject::getComponentMask() const
+{
+	return m_archetype->mask();
+}
 
 std::vector<Component*> SceneObject::getComponents()
 {
 	std::vector<Component*> components;
-	components.reserve(m_components.size());
+	components.reserve(COMPONENT_TYPES_COUNT);
 
-	for (auto component : m_components)
-		components.push_back(component.second);
+	for (int type = 0; type < COMPONENT_TYPES_COUNT; type++)
+		if (m_archetype->column((ComponentType)type))
+			components.push_back(&m_archetype->column((ComponentType)type)->get(m_row));
 
 	return components;
+}
+
+bool SceneObject::setParent(SceneObject* parent)
+{
+	for (SceneObject* ancestor = parent; ancestor; ancestor = ancestor->m_parent)
+		if (ancestor == this)
+			return false;
+
+	if (parent == m_parent)
+		return true;
+
+	if (m_parent)
+	{
+		std::vector<SceneObject*>& siblings = m_parent->m_children;
+		siblings.erase(std::find(siblings.begin(), siblings.end(), this));
+	}
+
+	m_parent = parent;
+
+	if (m_parent)
+		m_parent->m_children.push_back(this);
+
+	if (m_store)
+		m_store->m_structureVersion++;
+
+	return true;
+}
+
+SceneObject* SceneObject::getParent() const
+{
+	return m_parent;
+}
+
+const std::vector<SceneObject*>& SceneObject::getChildren() const
+{
+	return m_children;
+}
+
+SceneObjectHandle SceneObject::getHandle() const
+{
+	return m_handle;
 }
\ No newline at end of file
@@ -0,0 +1,353 @@
+/*!
+ * @file spatial_hash.cpp
+ * @brief Implementation file for the SpatialHash class.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <algorithm>
+#include <cmath>
+
+
+// Local includes
+
+#include "spatial_hash.h"
+
+
+// Namespaces
+
+using namespace engine;
+
+
+namespace {
+
+	// Each cell coordinate is packed in to 21 bits of the key, so coordinates are clamped to this far either side of 0. Positions further out
+	// ... share the cells at the edge, which is slower but still correct, as every query tests the positions themselves.
+	const int MAX_COORDINATE = (1 << 20) - 1;
+
+	// The most cells a batched query remembers between points. Enough for a radius up to the cell size, however the point sits in its cell.
+	const size_t MAX_CACHED_CELLS = 64;
+
+	int cellCoordinate(float position, float inverseCellSize)
+	{
+		// Clamped before converting, as converting a float too big for an int is undefined.
+		const float coordinate = std::floor(position * inverseCellSize);
+		return (int)std::max(-(float)MAX_COORDINATE, std::min((float)MAX_COORDINATE, coordinate));
+	}
+
+	// Fibonacci hashing spreads neighbouring cells' keys across the table.
+	size_t hashSlot(uint64_t key, size_t mask)
+	{
+		return (size_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+	}
+
+	size_t searchSphere(const std::vector<maths::Vec3>& positions, const std::vector<SceneObjectHandle>& handles, const maths::Vec3& centre,
+		float radiusSquared, SceneObjectHandle* results, size_t found, size_t capacity)
+	{
+		for (size_t i = 0; i < positions.size(); i++)
+		{
+			const maths::Vec3 offset = positions[i] - centre;
+
+			if (maths::dot(offset, offset) <= radiusSquared)
+			{
+				if (found < capacity)
+					results[found] = handles[i];
+
+				found++;
+			}
+		}
+
+		return found;
+	}
+
+}
+
+
+SpatialHash::SpatialHash(float cellSize)
+	: m_inverseCellSize(1.0f / cellSize), m_size(0) { }
+
+void SpatialHash::insert(SceneObjectHandle handle, const maths::Vec3& position)
+{
+	if (move(handle, position))
+		return;
+
+	if (handle.index >= m_entries.size())
+	{
+		Entry none = { 0, 0, 0 };
+		m_entries.resize(handle.index + 1, none);
+	}
+
+	attach(handle, position, findOrCreateCell(cellKey(position)));
+	m_size++;
+}
+
+bool SpatialHash::move(SceneObjectHandle handle, const maths::Vec3& position)
+{
+	if (!contains(handle))
+		return false;
+
+	const Entry entry = m_entries[handle.index];
+	const uint64_t key = cellKey(position);
+
+	// Most moves are small enough to stay in the same cell.
+	if (m_cells[entry.cell].key == key)
+	{
+		m_cells[entry.cell].positions[entry.slot] = position;
+		return true;
+	}
+
+	detach(entry);
+	attach(handle, position, findOrCreateCell(key));
+	return true;
+}
+
+bool SpatialHash::remove(SceneObjectHandle handle)
+{
+	if (!contains(handle))
+		return false;
+
+	detach(m_entries[handle.index]);
+	m_entries[handle.index].generation = 0;
+	m_size--;
+	return true;
+}
+
+void SpatialHash::update(const std::vector<SceneObject*>& moved)
+{
+	for (auto object : moved)
+	{
+		const SceneObjectHandle handle = object->getHandle();
+
+		if (!contains(handle))
+			continue;
+
+		const maths::Mat4& world = object->getComponent<TransformComponent>()->getWorldMatrix();
+		move(handle, maths::Vec3(world(3, 0), world(3, 1), world(3, 2)));
+	}
+}
+
+bool SpatialHash::contains(SceneObjectHandle handle) const
+{
+	return !handle.isNull() && handle.index < m_entries.size() && m_entries[handle.index].generation == handle.generation;
+}
+
+void SpatialHash::clear()
+{
+	for (auto it = m_cells.begin(); it != m_cells.end(); it++)
+	{
+		it->positions.clear();
+		it->handles.clear();
+	}
+
+	for (auto it = m_entries.begin(); it != m_entries.end(); it++)
+		it->generation = 0;
+
+	m_size = 0;
+}
+
+size_t SpatialHash::size() const
+{
+	return m_size;
+}
+
+size_t SpatialHash::queryRadius(const maths::Vec3& centre, float radius, SceneObjectHandle* results, size_t capacity) const
+{
+	const float radiusSquared = radius * radius;
+	size_t found = 0;
+
+	eachCell(cellRange(centre - maths::Vec3(radius), centre + maths::Vec3(radius)), [&](const Cell& cell) {
+		found = searchSphere(cell.positions, cell.handles, centre, radiusSquared, results, found, capacity);
+	});
+
+	return found;
+}
+
+size_t SpatialHash::queryRadius(const maths::Vec3* centres, size_t count, float radius, SceneObjectHandle* results, size_t capacity, size_t* offsets) const
+{
+	const float radiusSquared = radius * radius;
+	size_t found = 0;
+
+	// The cells around the last point, which the next point can reuse if it is in the same cell.
+	const Cell* cached[MAX_CACHED_CELLS];
+	size_t cachedCount = 0;
+	CellRange cachedRange;
+	bool cacheValid = false;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		offsets[i] = std::min(found, capacity);
+
+		const maths::Vec3& centre = centres[i];
+		const CellRange range = cellRange(centre - maths::Vec3(radius), centre + maths::Vec3(radius));
+
+		const bool sameRange = cacheValid && std::equal(range.min, range.min + 3, cachedRange.min) && std::equal(range.max, range.max + 3, cachedRange.max);
+
+		if (!sameRange)
+		{
+			const size_t volume = (size_t)(range.max[0] - range.min[0] + 1) * (range.max[1] - range.min[1] + 1) * (range.max[2] - range.min[2] + 1);
+			cacheValid = volume <= MAX_CACHED_CELLS;
+
+			if (cacheValid)
+			{
+				cachedRange = range;
+				cachedCount = 0;
+
+				eachCell(range, [&](const Cell& cell) {
+					cached[cachedCount++] = &cell;
+				});
+			}
+		}
+
+		if (cacheValid)
+		{
+			for (size_t c = 0; c < cachedCount; c++)
+				found = searchSphere(cached[c]->positions, cached[c]->handles, centre, radiusSquared, results, found, capacity);
+		}
+		else
+		{
+			eachCell(range, [&](const Cell& cell) {
+				found = searchSphere(cell.positions, cell.handles, centre, radiusSquared, results, found, capacity);
+			});
+		}
+	}
+
+	offsets[count] = std::min(found, capacity);
+	return found;
+}
+
+size_t SpatialHash::queryBox(const maths::AABB& box, SceneObjectHandle* results, size_t capacity) const
+{
+	size_t found = 0;
+
+	eachCell(cellRange(box.min(), box.max()), [&](const Cell& cell) {
+		for (size_t i = 0; i < cell.positions.size(); i++)
+		{
+			if (box.contains(cell.positions[i]))
+			{
+				if (found < capacity)
+					results[found] = cell.handles[i];
+
+				found++;
+			}
+		}
+	});
+
+	return found;
+}
+
+uint32_t SpatialHash::findCell(uint64_t key) const
+{
+	if (m_table.empty())
+		return NO_CELL;
+
+	const size_t mask = m_table.size() - 1;
+
+	// Collisions are resolved by trying the next slot.
+	for (size_t slot = hashSlot(key, mask);; slot = (slot + 1) & mask)
+	{
+		const uint32_t cell = m_table[slot];
+
+		if (cell == NO_CELL || m_cells[cell].key == key)
+			return cell;
+	}
+}
+
+uint32_t SpatialHash::findOrCreateCell(uint64_t key)
+{
+	const uint32_t existing = findCell(key);
+
+	if (existing != NO_CELL)
+		return existing;
+
+	// Keep the table at most half full, so lookups rarely have to try more than a slot or two.
+	if ((m_cells.size() + 1) * 2 > m_table.size())
+	{
+		m_table.assign(std::max<size_t>(64, m_table.size() * 2), (uint32_t)NO_CELL);
+		const size_t mask = m_table.size() - 1;
+
+		for (uint32_t cell = 0; cell < m_cells.size(); cell++)
+		{
+			size_t slot = hashSlot(m_cells[cell].key, mask);
+
+			while (m_table[slot] != NO_CELL)
+				slot = (slot + 1) & mask;
+
+			m_table[slot] = cell;
+		}
+	}
+
+	const uint32_t cell = (uint32_t)m_cells.size();
+	m_cells.push_back(Cell());
+	m_cells.back().key = key;
+
+	const size_t mask = m_table.size() - 1;
+	size_t slot = hashSlot(key, mask);
+
+	while (m_table[slot] != NO_CELL)
+		slot = (slot + 1) & mask;
+
+	m_table[slot] = cell;
+	return cell;
+}
+
+uint64_t SpatialHash::cellKey(const maths::Vec3& position) const
+{
+	return packKey(cellCoordinate(position.x(), m_inverseCellSize), cellCoordinate(position.y(), m_inverseCellSize), cellCoordinate(position.z(), m_inverseCellSize));
+}
+
+SpatialHash::CellRange SpatialHash::cellRange(const maths::Vec3& min, const maths::Vec3& max) const
+{
+	CellRange range;
+
+	for (int i = 0; i < 3; i++)
+	{
+		range.min[i] = cellCoordinate(min(i), m_inverseCellSize);
+		range.max[i] = cellCoordinate(max(i), m_inverseCellSize);
+	}
+
+	return range;
+}
+
+uint64_t SpatialHash::packKey(int x, int y, int z)
+{
+	return ((uint64_t)(x + MAX_COORDINATE) << 42) | ((uint64_t)(y + MAX_COORDINATE) << 21) | (uint64_t)(z + MAX_COORDINATE);
+}
+
+bool SpatialHash::inRange(uint64_t key, const CellRange& range)
+{
+	const int coordinates[3] = {
+		(int)((key >> 42) & 0x1FFFFF) - MAX_COORDINATE,
+		(int)((key >> 21) & 0x1FFFFF) - MAX_COORDINATE,
+		(int)(key & 0x1FFFFF) - MAX_COORDINATE
+	};
+
+	for (int i = 0; i < 3; i++)
+		if (coordinates[i] < range.min[i] || coordinates[i] > range.max[i])
+			return false;
+
+	return true;
+}
+
+void SpatialHash::detach(const Entry& entry)
+{
+	Cell& cell = m_cells[entry.cell];
+
+	cell.positions[entry.slot] = cell.positions.back();
+	cell.handles[entry.slot] = cell.handles.back();
+	m_entries[cell.handles[entry.slot].index].slot = entry.slot;
+
+	cell.positions.pop_back();
+	cell.handles.pop_back();
+}
+
+void SpatialHash::attach(SceneObjectHandle handle, const maths::Vec3& position, uint32_t cell)
+{
+	Entry& entry = m_entries[handle.index];
+	entry.generation = handle.generation;
+	entry.cell = cell;
+	entry.slot = (uint32_t)m_cells[cell].handles.size();
+
+	m_cells[cell].positions.push_back(position);
+	m_cells[cell].handles.push_back(handle);
+}
\ No newline at end of file
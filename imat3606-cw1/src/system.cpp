@@ -0,0 +1,43 @@
+/*!
+ * @file system.cpp
+ * @brief Implementation file for the System class.
+ * @author George McDonagh */
+
+
+// Local includes
+
+#include "system.h"
+
+
+// Namespaces
+
+using namespace engine;
+
+
+System::System(const char* name, ComponentMask reads, ComponentMask writes)
+	: m_name(name), m_reads(reads), m_writes(writes), m_lastUpdateTime(0.0) { }
+
+const char* System::name() const
+{
+	return m_name;
+}
+
+ComponentMask System::reads() const
+{
+	return m_reads;
+}
+
+ComponentMask System::writes() const
+{
+	return m_writes;
+}
+
+bool System::conflicts(const System& other) const
+{
+	return (m_writes & (other.m_reads | other.m_writes)) != 0 || (other.m_writes & m_reads) != 0;
+}
+
+double System::lastUpdateTime() const
+{
+	return m_lastUpdateTime;
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+/*!
+ * @file system_scheduler.cpp
+ * @brief Implementation file for the SystemScheduler class.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <algorithm>
+#include <chrono>
+
+
+// Local includes
+
+#include "system_scheduler.h"
+
+
+// Namespaces
+
+using namespace engine;
+
+
+namespace {
+
+	typedef std::chrono::steady_clock Clock;
+
+	double millisecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+}
+
+
+SystemScheduler::SystemScheduler()
+	: m_lastUpdateTime(0.0), m_nextReady(0), m_finished(0), m_scene(nullptr), m_deltaTime(0.0f) { }
+
+System* SystemScheduler::add(System* system)
+{
+	m_systems.push_back(std::unique_ptr<System>(system));
+	return system;
+}
+
+bool SystemScheduler::remove(System* system)
+{
+	auto it = std::find_if(m_systems.begin(), m_systems.end(), [system](const std::unique_ptr<System>& added) { return added.get() == system; });
+
+	if (it == m_systems.end())
+		return false;
+
+	m_systems.erase(it);
+	return true;
+}
+
+size_t SystemScheduler::size() const
+{
+	return m_systems.size();
+}
+
+System* SystemScheduler::get(size_t index) const
+{
+	return m_systems[index].get();
+}
+
+void SystemScheduler::update(graphics::Scene3D& scene, float deltaTime, utils::ThreadPool* threadPool)
+{
+	const Clock::time_point start = Clock::now();
+
+	m_scene = &scene;
+	m_deltaTime = deltaTime;
+
+	const size_t threads = threadPool ? std::min<size_t>(threadPool->threadCount(), m_systems.size()) : 1;
+
+	if (threads <= 1)
+	{
+		for (auto& system : m_systems)
+			runSystem(*system);
+	}
+	else
+	{
+		buildGraph();
+
+		// One chunk per thread, each of which keeps taking Systems until they have all finished.
+		threadPool->parallelFor(threads, 1, [this](size_t, size_t) { runReady(); });
+	}
+
+	m_scene = nullptr;
+	m_lastUpdateTime = millisecondsSince(start);
+}
+
+double SystemScheduler::lastUpdateTime() const
+{
+	return m_lastUpdateTime;
+}
+
+void SystemScheduler::buildGraph()
+{
+	const size_t count = m_systems.size();
+
+	m_dependents.resize(count);
+	m_waitingFor.assign(count, 0);
+	m_ready.clear();
+	m_ready.reserve(count);
+	m_nextReady = 0;
+	m_finished = 0;
+
+	// A System only waits for conflicting Systems added before it, so the graph can't have cycles.
+	for (uint32_t i = 0; i < count; i++)
+	{
+		m_dependents[i].clear();
+
+		for (uint32_t j = 0; j < i; j++)
+		{
+			if (m_systems[i]->conflicts(*m_systems[j]))
+			{
+				m_dependents[j].push_back(i);
+				m_waitingFor[i]++;
+			}
+		}
+
+		if (m_waitingFor[i] == 0)
+			m_ready.push_back(i);
+	}
+}
+
+void SystemScheduler::runReady()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	for (;;)
+	{
+		m_readyChanged.wait(lock, [this]() { return m_nextReady < m_ready.size() || m_finished == m_systems.size(); });
+
+		if (m_nextReady == m_ready.size())
+			return;
+
+		const uint32_t index = m_ready[m_nextReady++];
+
+		lock.unlock();
+		runSystem(*m_systems[index]);
+		lock.lock();
+
+		const size_t readyBefore = m_ready.size();
+
+		for (auto dependent : m_dependents[index])
+			if (--m_waitingFor[dependent] == 0)
+				m_ready.push_back(dependent);
+
+		m_finished++;
+
+		// Wake the other threads for the Systems this one has let go, or so they can return once everything has finished.
+		if (m_ready.size() > readyBefore || m_finished == m_systems.size())
+			m_readyChanged.notify_all();
+	}
+}
+
+void SystemScheduler::runSystem(System& system)
+{
+	const Clock::time_point start = Clock::now();
+	system.update(*m_scene, m_deltaTime);
+	system.m_lastUpdateTime = millisecondsSince(start);
+}
\ No newline at end of file
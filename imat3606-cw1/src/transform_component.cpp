@@ -7,6 +7,7 @@
 // Local includes
 
 #include "transform_component.h"
+#include "transform_hierarchy.h"
 
 
 // Namespaces
@@ -14,8 +15,20 @@
 using namespace engine;
 
 
+// Static variables
+
+std::atomic<unsigned long long> TransformComponent::s_nextVersion(1);
+
+
 TransformComponent::TransformComponent(maths::Vec3 position, maths::Vec3 scale, maths::Vec3 orientation)
-	: Component(), m_position(position), m_scale(scale), m_orientation(orientation) { }
+	: Component(), m_position(position), m_scale(scale), m_rotation(maths::rotationQuat(orientation)), m_dirty(true), m_version(newVersion()),
+	m_worldMatrix(1.0f), m_worldNormalMatrix(1.0f), m_worldVersion(0), m_worldSourceVersion(0), m_parentWorldVersion(0),
+	m_previousWorldMatrix(1.0f), m_worldUpdate(0) { }
+
+TransformComponent::TransformComponent(maths::Vec3 position, maths::Vec3 scale, maths::Quat rotation)
+	: Component(), m_position(position), m_scale(scale), m_rotation(rotation), m_dirty(true), m_version(newVersion()),
+	m_worldMatrix(1.0f), m_worldNormalMatrix(1.0f), m_worldVersion(0), m_worldSourceVersion(0), m_parentWorldVersion(0),
+	m_previousWorldMatrix(1.0f), m_worldUpdate(0) { }
 
 TransformComponent::~TransformComponent() { }
 
@@ -29,27 +42,215 @@ const maths::Vec3& TransformComponent::scale() const
 	return m_scale;
 }
 
-const maths::Vec3& TransformComponent::orientation() const
+maths::Vec3 TransformComponent::orientation() const
+{
+	return maths::eulerAngles(m_rotation);
+}
+
+const maths::Quat& TransformComponent::rotation() const
+{
+	return m_rotation;
+}
+
+void TransformComponent::setPosition(const maths::Vec3& position)
 {
-	return m_orientation;
+	if (position != m_position)
+	{
+		m_position = position;
+		changed();
+	}
+}
+
+void TransformComponent::setScale(const maths::Vec3& scale)
+{
+	if (scale != m_scale)
+	{
+		m_scale = scale;
+		changed();
+	}
+}
+
+void TransformComponent::setRotation(const maths::Quat& rotation)
+{
+	if (rotation != m_rotation)
+	{
+		m_rotation = rotation;
+		changed();
+	}
+}
+
+void TransformComponent::setOrientation(const maths::Vec3& orientation)
+{
+	setRotation(maths::rotationQuat(orientation));
 }
 
 maths::Vec3& TransformComponent::position()
 {
+	changed();
 	return m_position;
 }
 
 maths::Vec3& TransformComponent::scale()
 {
+	changed();
 	return m_scale;
 }
 
-maths::Vec3& TransformComponent::orientation()
+maths::Quat& TransformComponent::rotation()
 {
-	return m_orientation;
+	changed();
+	return m_rotation;
 }
 
 maths::Mat4 TransformComponent::getMatrix() const
 {
-	return maths::Mat4();
+	if (!m_dirty)
+		return m_matrix;
+
+	maths::Mat4 matrix;
+	maths::Mat3 normalMatrix;
+	calculateMatrices(matrix, normalMatrix);
+	return matrix;
+}
+
+maths::Mat3 TransformComponent::getNormalMatrix() const
+{
+	if (!m_dirty)
+		return m_normalMatrix;
+
+	maths::Mat4 matrix;
+	maths::Mat3 normalMatrix;
+	calculateMatrices(matrix, normalMatrix);
+	return normalMatrix;
+}
+
+unsigned long long TransformComponent::version() const
+{
+	return m_version;
+}
+
+const maths::Mat4& TransformComponent::getWorldMatrix() const
+{
+	return m_worldMatrix;
+}
+
+const maths::Mat3& TransformComponent::getWorldNormalMatrix() const
+{
+	return m_worldNormalMatrix;
+}
+
+unsigned long long TransformComponent::worldVersion() const
+{
+	return m_worldVersion;
+}
+
+const maths::Mat4& TransformComponent::getPreviousWorldMatrix() const
+{
+	return m_previousWorldMatrix;
+}
+
+unsigned long long TransformComponent::worldUpdate() const
+{
+	return m_worldUpdate;
+}
+
+maths::Mat4 TransformComponent::getInterpolatedWorldMatrix(unsigned long long update, float t) const
+{
+	if (m_worldUpdate != update)
+		return m_worldMatrix;
+
+	return m_previousWorldMatrix + t * (m_worldMatrix - m_previousWorldMatrix);
+}
+
+bool TransformComponent::updateWorldMatrix(const TransformComponent* parent, unsigned long long update)
+{
+	// World versions are unique, so comparing the parent's also catches the parent itself changing.
+	const unsigned long long parentWorldVersion = parent ? parent->m_worldVersion : 0;
+
+	if (m_worldSourceVersion == m_version && m_parentWorldVersion == parentWorldVersion)
+		return false;
+
+	m_previousWorldMatrix = m_worldMatrix;
+	updateMatrices();
+
+	if (parent)
+	{
+		// (P * L)^-T = P^-T * L^-T, so the normal matrices combine the same way as the matrices.
+		m_worldMatrix = parent->m_worldMatrix * m_matrix;
+		m_worldNormalMatrix = parent->m_worldNormalMatrix * m_normalMatrix;
+	}
+	else
+	{
+		m_worldMatrix = m_matrix;
+		m_worldNormalMatrix = m_normalMatrix;
+	}
+
+	// The identity matrix a Transform starts with isn't a state it was ever in, so there is nothing to blend from the first time.
+	if (m_worldVersion == 0)
+		m_previousWorldMatrix = m_worldMatrix;
+
+	m_worldVersion = newVersion();
+	m_worldUpdate = update;
+	m_worldSourceVersion = m_version;
+	m_parentWorldVersion = parentWorldVersion;
+	return true;
+}
+
+void TransformComponent::changed()
+{
+	m_dirty = true;
+	m_version = newVersion();
+
+	if (m_hierarchySlot.hierarchy)
+		m_hierarchySlot.hierarchy->changed(m_hierarchySlot.index);
+}
+
+TransformComponent::HierarchySlot& TransformComponent::HierarchySlot::operator=(const HierarchySlot&)
+{
+	if (hierarchy)
+		hierarchy->changed(index);
+
+	return *this;
+}
+
+unsigned long long TransformComponent::newVersion()
+{
+	const unsigned long long blockSize = 1024;
+
+	thread_local unsigned long long next = 0, end = 0;
+
+	if (next == end)
+	{
+		next = s_nextVersion.fetch_add(blockSize);
+		end = next + blockSize;
+	}
+
+	return next++;
+}
+
+void TransformComponent::calculateMatrices(maths::Mat4& matrix, maths::Mat3& normalMatrix) const
+{
+	// translation(position) * rotation(rotation) * scale(scale), without the matrix products.
+	maths::Mat3 r = maths::rotationMat3(m_rotation);
+
+	matrix = maths::Mat4(
+		maths::Vec4(r(0, 0) * m_scale.x(), r(0, 1) * m_scale.x(), r(0, 2) * m_scale.x(), 0.0f),
+		maths::Vec4(r(1, 0) * m_scale.y(), r(1, 1) * m_scale.y(), r(1, 2) * m_scale.y(), 0.0f),
+		maths::Vec4(r(2, 0) * m_scale.z(), r(2, 1) * m_scale.z(), r(2, 2) * m_scale.z(), 0.0f),
+		maths::Vec4(m_position));
+
+	// The upper 3x3 is R * S, so its inverse transpose is R * S^-1: the rotation's columns divided by the scale rather than multiplied.
+	normalMatrix = maths::Mat3(
+		r(0, 0) / m_scale.x(), r(0, 1) / m_scale.x(), r(0, 2) / m_scale.x(),
+		r(1, 0) / m_scale.y(), r(1, 1) / m_scale.y(), r(1, 2) / m_scale.y(),
+		r(2, 0) / m_scale.z(), r(2, 1) / m_scale.z(), r(2, 2) / m_scale.z());
+}
+
+void TransformComponent::updateMatrices()
+{
+	if (!m_dirty)
+		return;
+
+	calculateMatrices(m_matrix, m_normalMatrix);
+	m_dirty = false;
 }
\ No newline at end of file
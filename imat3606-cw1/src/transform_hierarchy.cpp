@@ -0,0 +1,216 @@
+/*!
+ * @file transform_hierarchy.cpp
+ * @brief Implementation file for the TransformHierarchy class.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <utility>
+
+
+// Local includes
+
+#include "scene_object.h"
+#include "transform_hierarchy.h"
+
+
+// Namespaces
+
+using namespace engine;
+
+
+namespace {
+
+	// Enough subtrees per chunk that handing chunks to threads costs little next to the matrix maths.
+	const size_t CHUNK_SIZE = 64;
+
+}
+
+
+TransformHierarchy::TransformHierarchy()
+	: m_dirtyCount(0), m_structureVersion(0), m_updates(0), m_built(false) { }
+
+void TransformHierarchy::update(const std::vector<SceneObject*>& objects, unsigned long long structureVersion, utils::ThreadPool* threadPool)
+{
+	// The arrays point in to the component columns, which move when the structure changes.
+	if (!m_built || structureVersion != m_structureVersion)
+	{
+		rebuild(objects);
+
+		m_structureVersion = structureVersion;
+		m_built = true;
+	}
+
+	m_updates++;
+	m_moved.clear();
+
+	// A changed transform under another one is visited with the other's subtree, so only the highest on each path from a root is kept. The
+	// ... walk up is as long as the hierarchy is deep, which is far less than the number of transforms.
+	m_subtrees.clear();
+
+	const size_t dirtyCount = m_dirtyCount;
+
+	for (size_t i = 0; i < dirtyCount; i++)
+	{
+		const uint32_t index = m_dirty[i];
+		int ancestor = m_parents[index];
+
+		while (ancestor >= 0 && !m_changed[ancestor])
+			ancestor = m_parents[ancestor];
+
+		if (ancestor < 0)
+			m_subtrees.push_back(index);
+	}
+
+	m_dirtyCount = 0;
+
+	if (!threadPool)
+	{
+		for (auto index : m_subtrees)
+			updateSubtree(index, false, m_moved);
+
+		return;
+	}
+
+	// Each chunk lists the SceneObjects it moved itself rather than contending for m_moved, and the lists are joined afterwards.
+	m_chunkMoved.resize((m_subtrees.size() + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+	threadPool->parallelFor(m_subtrees.size(), CHUNK_SIZE, [this](size_t chunkBegin, size_t chunkEnd) {
+		std::vector<SceneObject*>& moved = m_chunkMoved[chunkBegin / CHUNK_SIZE];
+		moved.clear();
+
+		for (size_t i = chunkBegin; i < chunkEnd; i++)
+			updateSubtree(m_subtrees[i], false, moved);
+	});
+
+	for (const auto& moved : m_chunkMoved)
+		m_moved.insert(m_moved.end(), moved.begin(), moved.end());
+}
+
+size_t TransformHierarchy::size() const
+{
+	return m_transforms.size();
+}
+
+size_t TransformHierarchy::depth() const
+{
+	return m_levels.empty() ? 0 : m_levels.size() - 1;
+}
+
+unsigned long long TransformHierarchy::updates() const
+{
+	return m_updates;
+}
+
+const std::vector<SceneObject*>& TransformHierarchy::moved() const
+{
+	return m_moved;
+}
+
+void TransformHierarchy::rebuild(const std::vector<SceneObject*>& objects)
+{
+	m_transforms.clear();
+	m_objects.clear();
+	m_parents.clear();
+	m_levels.clear();
+
+	// SceneObjects still to place at the current depth, with the index of the nearest ancestor that has a transform.
+	std::vector<std::pair<SceneObject*, int>> level, nextLevel;
+
+	for (auto object : objects)
+		if (!object->getParent())
+			level.push_back(std::make_pair(object, -1));
+
+	while (!level.empty())
+	{
+		m_levels.push_back(m_transforms.size());
+
+		// The loop can't use iterators, as SceneObjects without a transform add their children to the depth they're on.
+		for (size_t i = 0; i < level.size(); i++)
+		{
+			SceneObject* object = level[i].first;
+			int parent = level[i].second;
+
+			TransformComponent* transform = object->getComponent<TransformComponent>();
+
+			if (transform)
+			{
+				m_transforms.push_back(transform);
+				m_objects.push_back(object);
+				m_parents.push_back(parent);
+				parent = (int)m_transforms.size() - 1;
+			}
+
+			for (auto child : object->getChildren())
+				(transform ? nextLevel : level).push_back(std::make_pair(child, parent));
+		}
+
+		std::swap(level, nextLevel);
+		nextLevel.clear();
+	}
+
+	m_levels.push_back(m_transforms.size());
+
+	// Each transform comes after its parent, so the children are listed in order by counting them, then placing them.
+	m_childStarts.assign(m_transforms.size() + 1, 0);
+
+	for (auto parent : m_parents)
+		if (parent >= 0)
+			m_childStarts[parent + 1]++;
+
+	for (size_t i = 0; i < m_transforms.size(); i++)
+		m_childStarts[i + 1] += m_childStarts[i];
+
+	m_children.resize(m_childStarts.back());
+	std::vector<uint32_t> next(m_childStarts.begin(), m_childStarts.end() - 1);
+
+	for (size_t i = 0; i < m_parents.size(); i++)
+		if (m_parents[i] >= 0)
+			m_children[next[m_parents[i]]++] = (uint32_t)i;
+
+	// Transforms can't have told the hierarchy about changes while they weren't in the arrays, so every one is checked in full once.
+	m_changed.assign(m_transforms.size(), 1);
+	m_dirty.resize(m_transforms.size());
+	m_dirtyCount = m_transforms.size();
+
+	for (size_t i = 0; i < m_transforms.size(); i++)
+	{
+		m_dirty[i] = (uint32_t)i;
+		m_transforms[i]->m_hierarchySlot.hierarchy = this;
+		m_transforms[i]->m_hierarchySlot.index = (uint32_t)i;
+	}
+}
+
+void TransformHierarchy::changed(uint32_t index)
+{
+	// The flag keeps a transform which changes several times from being listed more than once, so the list never outgrows m_dirty. Only
+	// ... one thread changes a transform at a time, but several can be listing different ones.
+	if (m_changed[index])
+		return;
+
+	m_changed[index] = 1;
+	m_dirty[m_dirtyCount.fetch_add(1, std::memory_order_relaxed)] = index;
+}
+
+void TransformHierarchy::updateSubtree(uint32_t index, bool parentRecalculated, std::vector<SceneObject*>& moved)
+{
+	// A transform's world matrix can only be stale if it changed or its parent was recalculated, which the flat arrays tell without
+	// ... touching the transform.
+	bool recalculated = false;
+
+	if (m_changed[index] || parentRecalculated)
+	{
+		const int parent = m_parents[index];
+
+		m_changed[index] = 0;
+		recalculated = m_transforms[index]->updateWorldMatrix(parent < 0 ? nullptr : m_transforms[parent], m_updates);
+
+		if (recalculated)
+			moved.push_back(m_objects[index]);
+	}
+
+	// Changed descendants weren't listed as subtrees of their own, so the children are visited even if this transform wasn't recalculated.
+	for (uint32_t i = m_childStarts[index]; i < m_childStarts[index + 1]; i++)
+		updateSubtree(m_children[i], recalculated, moved);
+}
\ No newline at end of file
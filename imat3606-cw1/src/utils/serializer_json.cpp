@@ -4,6 +4,14 @@
  * @author George McDonagh */
 
 
+// External includes
+
+#include <cmath>
+#include <map>
+#include <string>
+#include <unordered_set>
+
+
 // Local includes
 
 #include "utils\serializer_json.h"
@@ -14,6 +22,37 @@
 using namespace engine::utils;
 
 
+namespace {
+
+	engine::maths::Vec3 readVec3(const Json::Value& value, const engine::maths::Vec3& fallback)
+	{
+		if (!value.isArray() || value.size() < 3)
+			return fallback;
+
+		return engine::maths::Vec3(value[0].asFloat(), value[1].asFloat(), value[2].asFloat());
+	}
+
+	Json::Value writeVec3(const engine::maths::Vec3& vector)
+	{
+		Json::Value value(Json::arrayValue);
+		value.append(vector.x());
+		value.append(vector.y());
+		value.append(vector.z());
+		return value;
+	}
+
+	// Append an object and its descendants, parents first, so that each object's parent already has an index when the object is written.
+	void appendHierarchy(engine::SceneObject* object, std::vector<engine::SceneObject*>& objects)
+	{
+		objects.push_back(object);
+
+		for (auto child : object->getChildren())
+			appendHierarchy(child, objects);
+	}
+
+}
+
+
 bool SerializerJSON::openFile(const char* filepath)
 {
 	std::fstream file;
@@ -36,4 +75,227 @@ bool SerializerJSON::openFile(const char* filepath)
 	}
 
 	return true;
+}
+
+bool SerializerJSON::readCell(const char* filepath, std::vector<engine::CellObject>& objects)
+{
+	std::ifstream file(filepath);
+
+	Json::Value root;
+	Json::Reader reader;
+
+	if (!file.is_open() || !reader.parse(file, root))
+		return false;
+
+	const Json::Value& jsonObjects = root["objects"];
+
+	for (int i = 0; i < jsonObjects.size(); i++)
+	{
+		CellObject object;
+		object.position = maths::Vec3(0.0f, 0.0f, 0.0f);
+		object.scale = maths::Vec3(1.0f, 1.0f, 1.0f);
+		object.orientation = maths::Vec3(0.0f, 0.0f, 0.0f);
+		object.hasBounds = false;
+		object.parent = jsonObjects[i].get("parent", -1).asInt();
+
+		const Json::Value& components = jsonObjects[i]["components"];
+
+		for (int j = 0; j < components.size(); j++)
+		{
+			const std::string type = components[j]["type"].asString();
+
+			if (type == typeid(TransformComponent).name())
+			{
+				object.position = readVec3(components[j]["position"], object.position);
+				object.scale = readVec3(components[j]["scale"], object.scale);
+				object.orientation = readVec3(components[j]["orientation"], object.orientation);
+			}
+			else if (type == typeid(MeshComponent).name())
+			{
+				object.mesh = components[j]["filepath"].asString();
+
+				const Json::Value& lods = components[j]["lods"];
+				for (int k = 0; k < lods.size(); k++)
+					object.lods.push_back(std::make_pair(lods[k]["filepath"].asString(), lods[k]["screenSize"].asFloat()));
+			}
+			else if (type == typeid(BoundsComponent).name())
+			{
+				object.hasBounds = true;
+				object.bounds = maths::AABB(readVec3(components[j]["min"], maths::Vec3()), readVec3(components[j]["max"], maths::Vec3()));
+			}
+		}
+
+		objects.push_back(object);
+	}
+
+	return true;
+}
+
+bool SerializerJSON::readCellIndex(const char* filepath, engine::CellIndex& index)
+{
+	if (!openFile(filepath))
+		return false;
+
+	std::ifstream file(filepath);
+
+	Json::Value root;
+	file >> root;
+
+	index.cellSize = root["cellSize"].asFloat();
+	index.cells.clear();
+
+	const Json::Value& cells = root["cells"];
+
+	for (int i = 0; i < cells.size(); i++)
+	{
+		CellInfo cell;
+		cell.x = cells[i]["x"].asInt();
+		cell.z = cells[i]["z"].asInt();
+		cell.filepath = cells[i]["filepath"].asString();
+		cell.bytes = (size_t)cells[i]["bytes"].asUInt64();
+		index.cells.push_back(cell);
+	}
+
+	return index.cellSize > 0.0f;
+}
+
+bool SerializerJSON::writeCells(const engine::graphics::Scene3D& scene, const char* directory, float cellSize)
+{
+	// Group the hierarchies by the cell their roots are in. An ordered map keeps the index in the same order each time it is written.
+	std::map<std::pair<int, int>, std::vector<SceneObject*>> cells;
+
+	for (auto object : scene.getObjects())
+	{
+		if (object->getParent())
+			continue;
+
+		// Read through a const pointer, as the mutable accessors mark the transform as changed.
+		const TransformComponent* transform = static_cast<const SceneObject*>(object)->getComponent<TransformComponent>();
+		const maths::Vec3 position = transform ? transform->position() : maths::Vec3(0.0f, 0.0f, 0.0f);
+
+		appendHierarchy(object, cells[std::make_pair((int)std::floor(position.x() / cellSize), (int)std::floor(position.z() / cellSize))]);
+	}
+
+	Json::Value index;
+	index["cellSize"] = cellSize;
+	index["cells"] = Json::Value(Json::arrayValue);
+
+	Json::StyledWriter styledWriter;
+
+	for (const auto& cell : cells)
+	{
+		const std::string filepath = std::string(directory) + "/" + std::to_string(cell.first.first) + "_" + std::to_string(cell.first.second) + ".json";
+
+		Json::Value root;
+		root["objects"] = Json::Value(Json::arrayValue);
+
+		std::unordered_map<const SceneObject*, int> objectIndices;
+		std::unordered_set<const graphics::Mesh*> meshes;
+
+		for (int i = 0; i < cell.second.size(); i++)
+		{
+			SceneObject* object = cell.second[i];
+			objectIndices[object] = i;
+			root["objects"].append(writeObject(*object, object->getParent() ? objectIndices[object->getParent()] : -1));
+
+			if (const MeshComponent* meshComponent = static_cast<const SceneObject*>(object)->getComponent<MeshComponent>())
+				for (unsigned int level = 0; level < meshComponent->lodCount(); level++)
+					meshes.insert(meshComponent->lodMesh(level));
+		}
+
+		size_t bytes = 0;
+		for (auto mesh : meshes)
+			bytes += mesh->getByteSize();
+
+		std::ofstream file(filepath);
+		file << styledWriter.write(root);
+
+		if (!file.good())
+		{
+			utils::Logger::log("ERROR::SERIALIZER_JSON::WRITE_CELLS - Failed to write file: \"%s\".", filepath.c_str());
+			return false;
+		}
+
+		Json::Value cellValue;
+		cellValue["x"] = cell.first.first;
+		cellValue["z"] = cell.first.second;
+		cellValue["filepath"] = filepath;
+		cellValue["bytes"] = (Json::UInt64)bytes;
+		index["cells"].append(cellValue);
+	}
+
+	const std::string indexFilepath = std::string(directory) + "/index.json";
+	std::ofstream file(indexFilepath);
+	file << styledWriter.write(index);
+
+	if (!file.good())
+	{
+		utils::Logger::log("ERROR::SERIALIZER_JSON::WRITE_CELLS - Failed to write file: \"%s\".", indexFilepath.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+Json::Value SerializerJSON::writeObject(engine::SceneObject& object, int parent)
+{
+	std::vector<Component*> components = object.getComponents();
+
+	// A single scene object, containing its components.
+	Json::Value value;
+
+	value["parent"] = parent;
+
+	value["components"] = Json::Value(Json::arrayValue);
+
+	for (int j = 0; j < components.size(); j++)
+	{
+		value["components"].append(Json::Value());
+
+		if (dynamic_cast<TransformComponent*>(components[j]))
+		{
+			// Read through a const pointer, as the mutable accessors mark the transform as changed.
+			const TransformComponent* transform = dynamic_cast<TransformComponent*>(components[j]);
+
+			value["components"][j]["type"] = typeid(TransformComponent).name();
+
+			value["components"][j]["position"] = writeVec3(transform->position());
+			value["components"][j]["scale"] = writeVec3(transform->scale());
+
+			// The orientation is stored as a quaternion and converted to Euler angles, so only convert it once.
+			value["components"][j]["orientation"] = writeVec3(transform->orientation());
+		}
+		else if (dynamic_cast<MeshComponent*>(components[j]))
+		{
+			MeshComponent* meshComponent = dynamic_cast<MeshComponent*>(components[j]);
+
+			value["components"][j]["type"] = typeid(MeshComponent).name();
+
+			value["components"][j]["filepath"] = Json::Value(meshComponent->mesh()->getFilepath());
+
+			if (meshComponent->lodCount() > 1)
+			{
+				value["components"][j]["lods"] = Json::Value(Json::arrayValue);
+
+				for (unsigned int level = 1; level < meshComponent->lodCount(); level++)
+				{
+					Json::Value lod;
+					lod["filepath"] = Json::Value(meshComponent->lodMesh(level)->getFilepath());
+					lod["screenSize"] = meshComponent->lodScreenSize(level);
+					value["components"][j]["lods"].append(lod);
+				}
+			}
+		}
+		else if (dynamic_cast<BoundsComponent*>(components[j]))
+		{
+			const maths::AABB& bounds = dynamic_cast<BoundsComponent*>(components[j])->bounds();
+
+			value["components"][j]["type"] = typeid(BoundsComponent).name();
+
+			value["components"][j]["min"] = writeVec3(bounds.min());
+			value["components"][j]["max"] = writeVec3(bounds.max());
+		}
+	}
+
+	return value;
 }
\ No newline at end of file
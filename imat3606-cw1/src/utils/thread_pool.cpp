@@ -0,0 +1,121 @@
+/*!
+ * @file thread_pool.cpp
+ * @brief Implementation file for the ThreadPool class.
+ * @author George McDonagh */
+
+
+// External includes
+
+#include <algorithm>
+
+
+// Local includes
+
+#include "utils/thread_pool.h"
+
+
+// Namespaces
+
+using namespace engine::utils;
+
+
+ThreadPool::ThreadPool(unsigned int threads)
+	: m_generation(0), m_busy(0), m_stop(false), m_func(nullptr), m_count(0), m_grain(1), m_next(0)
+{
+	if (threads == 0)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+
+	for (unsigned int i = 1; i < threads; i++)
+		m_workers.push_back(std::thread(&ThreadPool::workerMain, this));
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+
+	m_wake.notify_all();
+
+	for (auto& worker : m_workers)
+		worker.join();
+}
+
+unsigned int ThreadPool::threadCount() const
+{
+	return (unsigned int)m_workers.size() + 1;
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& func)
+{
+	grain = std::max<size_t>(grain, 1);
+
+	// Waking the workers costs more than a single chunk is worth.
+	if (m_workers.empty() || count <= grain)
+	{
+		if (count > 0)
+			func(0, count);
+
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_func = &func;
+		m_count = count;
+		m_grain = grain;
+		m_next = 0;
+		m_busy = (unsigned int)m_workers.size();
+		m_generation++;
+	}
+
+	m_wake.notify_all();
+
+	runChunks();
+
+	// Every worker has to have seen this loop before the next can start, so wait for all of them rather than just for the chunks.
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done.wait(lock, [this]() { return m_busy == 0; });
+
+	m_func = nullptr;
+}
+
+void ThreadPool::runChunks()
+{
+	for (;;)
+	{
+		const size_t begin = m_next.fetch_add(m_grain);
+
+		if (begin >= m_count)
+			return;
+
+		(*m_func)(begin, std::min(begin + m_grain, m_count));
+	}
+}
+
+void ThreadPool::workerMain()
+{
+	unsigned long long generation = 0;
+
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [&]() { return m_stop || m_generation != generation; });
+
+			if (m_stop)
+				return;
+
+			generation = m_generation;
+		}
+
+		runChunks();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (--m_busy == 0)
+			m_done.notify_one();
+	}
+}
\ No newline at end of file